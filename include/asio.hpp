@@ -15,6 +15,7 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include "asio/admission_statistics.hpp"
 #include "asio/any_completion_executor.hpp"
 #include "asio/any_completion_handler.hpp"
 #include "asio/any_io_executor.hpp"
@@ -24,6 +25,7 @@
 #include "asio/associated_cancellation_slot.hpp"
 #include "asio/associated_executor.hpp"
 #include "asio/associated_immediate_executor.hpp"
+#include "asio/associated_trace_context.hpp"
 #include "asio/associator.hpp"
 #include "asio/async_result.hpp"
 #include "asio/awaitable.hpp"
@@ -49,6 +51,7 @@
 #include "asio/bind_cancellation_slot.hpp"
 #include "asio/bind_executor.hpp"
 #include "asio/bind_immediate_executor.hpp"
+#include "asio/bind_trace_context.hpp"
 #include "asio/buffer.hpp"
 #include "asio/buffer_registration.hpp"
 #include "asio/buffered_read_stream_fwd.hpp"
@@ -94,6 +97,7 @@
 #include "asio/execution/occupancy.hpp"
 #include "asio/execution/outstanding_work.hpp"
 #include "asio/execution/prefer_only.hpp"
+#include "asio/execution/priority.hpp"
 #include "asio/execution/relationship.hpp"
 #include "asio/executor.hpp"
 #include "asio/executor_work_guard.hpp"
@@ -153,6 +157,7 @@
 #include "asio/posix/descriptor_base.hpp"
 #include "asio/posix/stream_descriptor.hpp"
 #include "asio/post.hpp"
+#include "asio/post_bulk.hpp"
 #include "asio/prefer.hpp"
 #include "asio/prepend.hpp"
 #include "asio/query.hpp"
@@ -184,6 +189,7 @@
 #include "asio/this_coro.hpp"
 #include "asio/thread.hpp"
 #include "asio/thread_pool.hpp"
+#include "asio/trace_context.hpp"
 #include "asio/use_awaitable.hpp"
 #include "asio/use_future.hpp"
 #include "asio/uses_executor.hpp"
@@ -0,0 +1,93 @@
+//
+// admission_statistics.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_ADMISSION_STATISTICS_HPP
+#define ASIO_ADMISSION_STATISTICS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/execution_context.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Counters that describe the admission control state of an execution
+/// context.
+/**
+ * The limits themselves are specified using the @c admission section of the
+ * context's configuration. See @ref asio.overview.configuration.
+ */
+struct admission_statistics
+{
+  /// The amount of outstanding work, including handlers that are waiting to
+  /// run and asynchronous operations that have not yet completed.
+  long outstanding_work;
+
+  /// The number of function objects that are queued. Counted only if there
+  /// is a @c handler_limit.
+  long handlers_queued;
+
+  /// The number of new function objects that were submitted while the number
+  /// of queued function objects was at the @c handler_limit.
+  long handlers_over_limit;
+
+  /// The number of new function objects whose submitters were blocked by the
+  /// @c block policy.
+  long handlers_blocked;
+
+  /// The number of new function objects that were rejected by the @c reject
+  /// policy.
+  long handlers_rejected;
+
+  /// The number of new function objects that were shed by the @c shed
+  /// policy.
+  long handlers_shed;
+
+  /// The number of new accept operations that were initiated while the
+  /// number of accept operations in flight was at the @c accept_limit.
+  long accepts_over_limit;
+
+  /// The number of new read operations that were initiated while the number
+  /// of read operations in flight was at the @c read_limit.
+  long reads_over_limit;
+
+  /// The number of accept operations in flight. Counted only if there is an
+  /// @c accept_limit.
+  long accepts_in_flight;
+
+  /// The number of read operations in flight. Counted only if there is a
+  /// @c read_limit.
+  long reads_in_flight;
+};
+
+/// Obtain the admission control counters for an execution context.
+/**
+ * @param ctx The execution context, such as an @c io_context or
+ * @c thread_pool.
+ *
+ * @returns The current counter values. All counters are zero if the execution
+ * context does not support admission control.
+ */
+ASIO_DECL admission_statistics get_admission_statistics(
+    execution_context& ctx);
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/impl/admission_statistics.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_ADMISSION_STATISTICS_HPP
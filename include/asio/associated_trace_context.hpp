@@ -0,0 +1,251 @@
+//
+// associated_trace_context.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_ASSOCIATED_TRACE_CONTEXT_HPP
+#define ASIO_ASSOCIATED_TRACE_CONTEXT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/associator.hpp"
+#include "asio/trace_context.hpp"
+#include "asio/detail/functional.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+template <typename T, typename TraceContext>
+struct associated_trace_context;
+
+namespace detail {
+
+template <typename T, typename = void>
+struct has_trace_context_type : false_type
+{
+};
+
+template <typename T>
+struct has_trace_context_type<T, void_t<typename T::trace_context_type>>
+  : true_type
+{
+};
+
+template <typename T, typename C, typename = void, typename = void>
+struct associated_trace_context_impl
+{
+  typedef void asio_associated_trace_context_is_unspecialised;
+
+  typedef C type;
+
+  static type get(const T&) noexcept
+  {
+    return type();
+  }
+
+  static const type& get(const T&, const C& c) noexcept
+  {
+    return c;
+  }
+};
+
+template <typename T, typename C>
+struct associated_trace_context_impl<T, C,
+  void_t<typename T::trace_context_type>>
+{
+  typedef typename T::trace_context_type type;
+
+  static auto get(const T& t) noexcept
+    -> decltype(t.get_trace_context())
+  {
+    return t.get_trace_context();
+  }
+
+  static auto get(const T& t, const C&) noexcept
+    -> decltype(t.get_trace_context())
+  {
+    return t.get_trace_context();
+  }
+};
+
+template <typename T, typename C>
+struct associated_trace_context_impl<T, C,
+  enable_if_t<
+    !has_trace_context_type<T>::value
+  >,
+  void_t<
+    typename associator<associated_trace_context, T, C>::type
+  >> : associator<associated_trace_context, T, C>
+{
+};
+
+} // namespace detail
+
+/// Traits type used to obtain the trace_context associated with an object.
+/**
+ * A program may specialise this traits type if the @c T template parameter in
+ * the specialisation is a user-defined type. The template parameter @c
+ * TraceContext shall be asio::trace_context, or a copyable type that is
+ * convertible to it.
+ *
+ * Specialisations shall meet the following requirements, where @c t is a const
+ * reference to an object of type @c T, and @c c is an object of type @c
+ * TraceContext.
+ *
+ * @li Provide a nested typedef @c type that identifies a copyable type that is
+ * convertible to asio::trace_context.
+ *
+ * @li Provide a noexcept static member function named @c get, callable as @c
+ * get(t) and with return type @c type or a (possibly const) reference to @c
+ * type.
+ *
+ * @li Provide a noexcept static member function named @c get, callable as @c
+ * get(t,c) and with return type @c type or a (possibly const) reference to @c
+ * type.
+ */
+template <typename T, typename TraceContext = trace_context>
+struct associated_trace_context
+#if !defined(GENERATING_DOCUMENTATION)
+  : detail::associated_trace_context_impl<T, TraceContext>
+#endif // !defined(GENERATING_DOCUMENTATION)
+{
+#if defined(GENERATING_DOCUMENTATION)
+  /// If @c T has a nested type @c trace_context_type,
+  /// <tt>T::trace_context_type</tt>. Otherwise
+  /// @c TraceContext.
+  typedef see_below type;
+
+  /// If @c T has a nested type @c trace_context_type, returns
+  /// <tt>t.get_trace_context()</tt>. Otherwise returns @c type().
+  static decltype(auto) get(const T& t) noexcept;
+
+  /// If @c T has a nested type @c trace_context_type, returns
+  /// <tt>t.get_trace_context()</tt>. Otherwise returns @c c.
+  static decltype(auto) get(const T& t,
+      const TraceContext& c) noexcept;
+#endif // defined(GENERATING_DOCUMENTATION)
+};
+
+/// Helper function to obtain an object's associated trace_context.
+/**
+ * @returns <tt>associated_trace_context<T>::get(t)</tt>
+ */
+template <typename T>
+ASIO_NODISCARD inline typename associated_trace_context<T>::type
+get_associated_trace_context(const T& t) noexcept
+{
+  return associated_trace_context<T>::get(t);
+}
+
+/// Helper function to obtain an object's associated trace_context.
+/**
+ * @returns <tt>associated_trace_context<T, TraceContext>::get(t, c)</tt>
+ */
+template <typename T, typename TraceContext>
+ASIO_NODISCARD inline auto get_associated_trace_context(
+    const T& t, const TraceContext& c) noexcept
+  -> decltype(associated_trace_context<T, TraceContext>::get(t, c))
+{
+  return associated_trace_context<T, TraceContext>::get(t, c);
+}
+
+template <typename T, typename TraceContext = trace_context>
+using associated_trace_context_t =
+  typename associated_trace_context<T, TraceContext>::type;
+
+namespace detail {
+
+template <typename T, typename C, typename = void>
+struct associated_trace_context_forwarding_base
+{
+};
+
+template <typename T, typename C>
+struct associated_trace_context_forwarding_base<T, C,
+    enable_if_t<
+      is_same<
+        typename associated_trace_context<T,
+          C>::asio_associated_trace_context_is_unspecialised,
+        void
+      >::value
+    >>
+{
+  typedef void asio_associated_trace_context_is_unspecialised;
+};
+
+} // namespace detail
+
+/// Specialisation of associated_trace_context for @c
+/// std::reference_wrapper.
+template <typename T, typename TraceContext>
+struct associated_trace_context<reference_wrapper<T>, TraceContext>
+#if !defined(GENERATING_DOCUMENTATION)
+  : detail::associated_trace_context_forwarding_base<T, TraceContext>
+#endif // !defined(GENERATING_DOCUMENTATION)
+{
+  /// Forwards @c type to the associator specialisation for the unwrapped type
+  /// @c T.
+  typedef typename associated_trace_context<T, TraceContext>::type type;
+
+  /// Forwards the request to get the trace context to the associator
+  /// specialisation for the unwrapped type @c T.
+  static type get(reference_wrapper<T> t) noexcept
+  {
+    return associated_trace_context<T, TraceContext>::get(t.get());
+  }
+
+  /// Forwards the request to get the trace context to the associator
+  /// specialisation for the unwrapped type @c T.
+  static auto get(reference_wrapper<T> t, const TraceContext& c) noexcept
+    -> decltype(
+      associated_trace_context<T, TraceContext>::get(t.get(), c))
+  {
+    return associated_trace_context<T, TraceContext>::get(t.get(), c);
+  }
+};
+
+namespace detail {
+
+// Makes the trace context associated with a handler current for the lifetime
+// of the scope object. Handlers without an associated trace context leave the
+// current trace context unchanged, at no cost.
+template <typename Handler, typename = void>
+class associated_trace_context_scope
+  : public trace_context_scope
+{
+public:
+  explicit associated_trace_context_scope(const Handler& h) noexcept
+    : trace_context_scope((get_associated_trace_context)(h))
+  {
+  }
+};
+
+template <typename Handler>
+class associated_trace_context_scope<Handler,
+    void_t<
+      typename associated_trace_context<
+        Handler>::asio_associated_trace_context_is_unspecialised
+    >>
+{
+public:
+  explicit associated_trace_context_scope(const Handler&) noexcept
+  {
+  }
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_ASSOCIATED_TRACE_CONTEXT_HPP
@@ -19,13 +19,19 @@
 
 #if !defined(ASIO_NO_IOSTREAM)
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
 #include <streambuf>
+#include <utility>
 #include <vector>
 #include "asio/basic_socket.hpp"
 #include "asio/basic_stream_socket.hpp"
 #include "asio/detail/buffer_sequence_adapter.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/throw_error.hpp"
+#include "asio/detail/throw_exception.hpp"
 #include "asio/io_context.hpp"
 #include "asio/steady_timer.hpp"
 
@@ -56,14 +62,19 @@ class socket_streambuf_buffers
 {
 protected:
   socket_streambuf_buffers()
-    : get_buffer_(buffer_size),
-      put_buffer_(buffer_size)
+    : get_buffer_(putback_max + default_buffer_size),
+      put_buffer_(default_buffer_size),
+      buffer_size_(default_buffer_size)
   {
   }
 
-  enum { buffer_size = 512 };
+  enum { putback_max = 8, default_buffer_size = 512 };
   std::vector<char> get_buffer_;
   std::vector<char> put_buffer_;
+
+  // The configured size of the get and put areas. An area may be temporarily
+  // larger while it retains data from before the size was changed.
+  std::size_t buffer_size_;
 };
 
 } // namespace detail
@@ -144,6 +155,7 @@ public:
   {
     get_buffer_.swap(other.get_buffer_);
     put_buffer_.swap(other.put_buffer_);
+    std::swap(buffer_size_, other.buffer_size_);
     setg(other.eback(), other.gptr(), other.egptr());
     setp(other.pptr(), other.epptr());
     other.ec_ = asio::error_code();
@@ -161,11 +173,12 @@ public:
     expiry_time_ = other.expiry_time_;
     get_buffer_.swap(other.get_buffer_);
     put_buffer_.swap(other.put_buffer_);
+    std::swap(buffer_size_, other.buffer_size_);
     setg(other.eback(), other.gptr(), other.egptr());
     setp(other.pptr(), other.epptr());
     other.ec_ = asio::error_code();
     other.expiry_time_ = max_expiry_time();
-    other.put_buffer_.resize(buffer_size);
+    other.put_buffer_.resize(other.buffer_size_);
     other.init_buffers();
     return *this;
   }
@@ -231,6 +244,55 @@ public:
     return *this;
   }
 
+  /// Get the size of the stream buffer's get and put areas.
+  std::size_t buffer_size() const
+  {
+    return buffer_size_;
+  }
+
+  /// Set the size of the stream buffer's get and put areas.
+  /**
+   * Buffered output is flushed before the put area is resized, and unread
+   * input is retained. An area that must hold more than @c n bytes of retained
+   * data is shrunk to the new size once that data has been consumed. Reads and
+   * writes that are at least as large as the buffer are transferred directly
+   * between the caller and the socket, so a larger buffer mainly benefits
+   * programs that perform many small operations.
+   *
+   * @param n The new size of the get and put areas, in bytes.
+   *
+   * @throws std::invalid_argument Thrown if @c n is zero.
+   */
+  void buffer_size(std::size_t n)
+  {
+    if (n == 0)
+    {
+      std::invalid_argument ex("buffer size must be non-zero");
+      asio::detail::throw_exception(ex);
+    }
+
+    buffer_size_ = n;
+
+    // Retain any unread input.
+    std::size_t unread = egptr() - gptr();
+    std::vector<char> get_buffer(putback_max + (n < unread ? unread : n));
+    if (unread > 0)
+      std::memcpy(&get_buffer[putback_max], gptr(), unread);
+    get_buffer_.swap(get_buffer);
+    setg(&get_buffer_[0], &get_buffer_[0] + putback_max,
+        &get_buffer_[0] + putback_max + unread);
+
+    // Retain any output that could not be flushed.
+    sync();
+    std::size_t unsent = pptr() - pbase();
+    std::vector<char> put_buffer(n < unsent ? unsent : n);
+    if (unsent > 0)
+      std::memcpy(&put_buffer[0], pbase(), unsent);
+    put_buffer_.swap(put_buffer);
+    setp(&put_buffer_[0], &put_buffer_[0] + put_buffer_.size());
+    pbump(static_cast<int>(unsent));
+  }
+
   /// Get the last error associated with the stream buffer.
   /**
    * @return An \c error_code corresponding to the last error from the stream
@@ -289,48 +351,56 @@ protected:
     if (gptr() != egptr())
       return traits_type::eof();
 
-    for (;;)
-    {
-      // Check if we are past the expiry time.
-      if (traits_helper::less_than(expiry_time_, traits_helper::now()))
-      {
-        ec_ = asio::error::timed_out;
-        return traits_type::eof();
-      }
+    // Unread input has been consumed, so the get area can return to its
+    // configured size.
+    if (get_buffer_.size() != putback_max + buffer_size_)
+      get_buffer_.resize(putback_max + buffer_size_);
 
-      // Try to complete the operation without blocking.
-      if (!socket().native_non_blocking())
-        socket().native_non_blocking(true, ec_);
-      detail::buffer_sequence_adapter<mutable_buffer, mutable_buffer>
-        bufs(asio::buffer(get_buffer_) + putback_max);
-      detail::signed_size_type bytes = detail::socket_ops::recv(
-          socket().native_handle(), bufs.buffers(), bufs.count(), 0, ec_);
+    std::size_t bytes = receive_some(&get_buffer_[0] + putback_max,
+        get_buffer_.size() - putback_max);
+    if (bytes == 0)
+      return traits_type::eof();
 
-      // Check if operation succeeded.
-      if (bytes > 0)
+    setg(&get_buffer_[0], &get_buffer_[0] + putback_max,
+        &get_buffer_[0] + putback_max + bytes);
+    return traits_type::to_int_type(*gptr());
+#endif // defined(ASIO_WINDOWS_RUNTIME)
+  }
+
+  std::streamsize xsgetn(char_type* s, std::streamsize n)
+  {
+#if defined(ASIO_WINDOWS_RUNTIME)
+    return std::streambuf::xsgetn(s, n);
+#else // defined(ASIO_WINDOWS_RUNTIME)
+    std::streamsize total = 0;
+    const std::streamsize capacity =
+      static_cast<std::streamsize>(buffer_size_);
+    while (total < n)
+    {
+      // Satisfy as much of the request as possible from the get area.
+      std::streamsize available = egptr() - gptr();
+      if (available > 0)
       {
-        setg(&get_buffer_[0], &get_buffer_[0] + putback_max,
-            &get_buffer_[0] + putback_max + bytes);
-        return traits_type::to_int_type(*gptr());
+        std::streamsize length = (std::min)(available, n - total);
+        traits_type::copy(s + total, gptr(), static_cast<std::size_t>(length));
+        gbump(static_cast<int>(length));
+        total += length;
+        continue;
       }
 
-      // Check for EOF.
-      if (bytes == 0)
+      // Requests that would fill the get area bypass it altogether.
+      if (n - total >= capacity)
       {
-        ec_ = asio::error::eof;
-        return traits_type::eof();
+        std::size_t bytes = receive_some(s + total,
+            static_cast<std::size_t>(n - total));
+        if (bytes == 0)
+          break;
+        total += static_cast<std::streamsize>(bytes);
       }
-
-      // Operation failed.
-      if (ec_ != asio::error::would_block
-          && ec_ != asio::error::try_again)
-        return traits_type::eof();
-
-      // Wait for socket to become ready.
-      if (detail::socket_ops::poll_read(
-            socket().native_handle(), 0, timeout(), ec_) < 0)
-        return traits_type::eof();
+      else if (traits_type::eq_int_type(underflow(), traits_type::eof()))
+        break;
     }
+    return total;
 #endif // defined(ASIO_WINDOWS_RUNTIME)
   }
 
@@ -343,57 +413,26 @@ protected:
     char_type ch = traits_type::to_char_type(c);
 
     // Determine what needs to be sent.
-    const_buffer output_buffer;
+    std::array<const_buffer, 2> output_buffers;
     if (put_buffer_.empty())
     {
       if (traits_type::eq_int_type(c, traits_type::eof()))
         return traits_type::not_eof(c); // Nothing to do.
-      output_buffer = asio::buffer(&ch, sizeof(char_type));
+      output_buffers[0] = asio::buffer(&ch, sizeof(char_type));
     }
     else
     {
-      output_buffer = asio::buffer(pbase(),
+      output_buffers[0] = asio::buffer(pbase(),
           (pptr() - pbase()) * sizeof(char_type));
     }
 
-    while (output_buffer.size() > 0)
-    {
-      // Check if we are past the expiry time.
-      if (traits_helper::less_than(expiry_time_, traits_helper::now()))
-      {
-        ec_ = asio::error::timed_out;
-        return traits_type::eof();
-      }
-
-      // Try to complete the operation without blocking.
-      if (!socket().native_non_blocking())
-        socket().native_non_blocking(true, ec_);
-      detail::buffer_sequence_adapter<
-        const_buffer, const_buffer> bufs(output_buffer);
-      detail::signed_size_type bytes = detail::socket_ops::send(
-          socket().native_handle(), bufs.buffers(), bufs.count(), 0, ec_);
-
-      // Check if operation succeeded.
-      if (bytes > 0)
-      {
-        output_buffer += static_cast<std::size_t>(bytes);
-        continue;
-      }
-
-      // Operation failed.
-      if (ec_ != asio::error::would_block
-          && ec_ != asio::error::try_again)
-        return traits_type::eof();
-
-      // Wait for socket to become ready.
-      if (detail::socket_ops::poll_write(
-            socket().native_handle(), 0, timeout(), ec_) < 0)
-        return traits_type::eof();
-    }
+    std::size_t size = output_buffers[0].size();
+    if (send_all(output_buffers) != size)
+      return traits_type::eof();
 
     if (!put_buffer_.empty())
     {
-      setp(&put_buffer_[0], &put_buffer_[0] + put_buffer_.size());
+      reset_put_area();
 
       // If the new character is eof then our work here is done.
       if (traits_type::eq_int_type(c, traits_type::eof()))
@@ -408,6 +447,43 @@ protected:
 #endif // defined(ASIO_WINDOWS_RUNTIME)
   }
 
+  std::streamsize xsputn(const char_type* s, std::streamsize n)
+  {
+#if defined(ASIO_WINDOWS_RUNTIME)
+    return std::streambuf::xsputn(s, n);
+#else // defined(ASIO_WINDOWS_RUNTIME)
+    // Copy the data into the put area if it fits.
+    if (n < epptr() - pptr())
+    {
+      traits_type::copy(pptr(), s, static_cast<std::size_t>(n));
+      pbump(static_cast<int>(n));
+      return n;
+    }
+
+    // Otherwise send any buffered output together with the new data, without
+    // first copying the new data into the put area.
+    std::size_t buffered = (pptr() - pbase()) * sizeof(char_type);
+    std::array<const_buffer, 2> output_buffers = {{
+      asio::buffer(pbase(), buffered),
+      asio::buffer(s, static_cast<std::size_t>(n) * sizeof(char_type))
+    }};
+    std::size_t bytes = send_all(output_buffers);
+
+    if (bytes < buffered)
+    {
+      // Keep the buffered output that could not be sent.
+      std::memmove(pbase(), pbase() + bytes, buffered - bytes);
+      setp(pbase(), epptr());
+      pbump(static_cast<int>(buffered - bytes));
+      return 0;
+    }
+
+    if (!put_buffer_.empty())
+      reset_put_area();
+    return static_cast<std::streamsize>(bytes - buffered);
+#endif // defined(ASIO_WINDOWS_RUNTIME)
+  }
+
   int sync()
   {
     return overflow(traits_type::eof());
@@ -432,6 +508,15 @@ private:
   basic_socket_streambuf& operator=(
       const basic_socket_streambuf&) = delete;
 
+  // Make the whole put buffer available once its contents have been sent,
+  // returning it to the configured size if it was enlarged to retain output.
+  void reset_put_area()
+  {
+    if (put_buffer_.size() != buffer_size_)
+      put_buffer_.resize(buffer_size_);
+    setp(&put_buffer_[0], &put_buffer_[0] + put_buffer_.size());
+  }
+
   void init_buffers()
   {
     setg(&get_buffer_[0],
@@ -444,6 +529,99 @@ private:
       setp(&put_buffer_[0], &put_buffer_[0] + put_buffer_.size());
   }
 
+#if !defined(ASIO_WINDOWS_RUNTIME)
+  // Receive data into the supplied memory, waiting for the socket to become
+  // ready as required. Returns 0 and sets ec_ on failure or end of file.
+  std::size_t receive_some(void* data, std::size_t size)
+  {
+    for (;;)
+    {
+      // Check if we are past the expiry time.
+      if (traits_helper::less_than(expiry_time_, traits_helper::now()))
+      {
+        ec_ = asio::error::timed_out;
+        return 0;
+      }
+
+      // Try to complete the operation without blocking.
+      if (!socket().native_non_blocking())
+        socket().native_non_blocking(true, ec_);
+      detail::buffer_sequence_adapter<mutable_buffer, mutable_buffer>
+        bufs(asio::buffer(data, size));
+      detail::signed_size_type bytes = detail::socket_ops::recv(
+          socket().native_handle(), bufs.buffers(), bufs.count(), 0, ec_);
+
+      // Check if operation succeeded.
+      if (bytes > 0)
+        return static_cast<std::size_t>(bytes);
+
+      // Check for EOF.
+      if (bytes == 0)
+      {
+        ec_ = asio::error::eof;
+        return 0;
+      }
+
+      // Operation failed.
+      if (ec_ != asio::error::would_block
+          && ec_ != asio::error::try_again)
+        return 0;
+
+      // Wait for socket to become ready.
+      if (detail::socket_ops::poll_read(
+            socket().native_handle(), 0, timeout(), ec_) < 0)
+        return 0;
+    }
+  }
+
+  // Send all of the supplied data, waiting for the socket to become ready as
+  // required. Returns the number of bytes sent, which is less than the total
+  // size of the buffers only if an error occurred.
+  std::size_t send_all(std::array<const_buffer, 2>& buffers)
+  {
+    std::size_t total = 0;
+    while (buffers[0].size() + buffers[1].size() > 0)
+    {
+      // Check if we are past the expiry time.
+      if (traits_helper::less_than(expiry_time_, traits_helper::now()))
+      {
+        ec_ = asio::error::timed_out;
+        return total;
+      }
+
+      // Try to complete the operation without blocking.
+      if (!socket().native_non_blocking())
+        socket().native_non_blocking(true, ec_);
+      detail::buffer_sequence_adapter<const_buffer,
+        std::array<const_buffer, 2>> bufs(buffers);
+      detail::signed_size_type bytes = detail::socket_ops::send(
+          socket().native_handle(), bufs.buffers(), bufs.count(), 0, ec_);
+
+      // Check if operation succeeded.
+      if (bytes > 0)
+      {
+        std::size_t n = static_cast<std::size_t>(bytes);
+        std::size_t first = (std::min)(n, buffers[0].size());
+        buffers[0] += first;
+        buffers[1] += n - first;
+        total += n;
+        continue;
+      }
+
+      // Operation failed.
+      if (ec_ != asio::error::would_block
+          && ec_ != asio::error::try_again)
+        return total;
+
+      // Wait for socket to become ready.
+      if (detail::socket_ops::poll_write(
+            socket().native_handle(), 0, timeout(), ec_) < 0)
+        return total;
+    }
+    return total;
+  }
+#endif // !defined(ASIO_WINDOWS_RUNTIME)
+
   int timeout() const
   {
     int64_t msec = traits_helper::to_posix_duration(
@@ -531,7 +709,6 @@ private:
     return (time_point::max)();
   }
 
-  enum { putback_max = 8 };
   asio::error_code ec_;
   time_point expiry_time_;
 };
@@ -339,6 +339,69 @@ public:
   {
   }
 
+  /// Gets the auto-cork mode of the socket.
+  /**
+   * @returns @c true if asynchronous send operations that are queued behind
+   * one another are coalesced into as few segments as possible.
+   */
+  bool auto_cork() const
+  {
+    return this->impl_.get_service().auto_cork(
+        this->impl_.get_implementation());
+  }
+
+  /// Sets the auto-cork mode of the socket.
+  /**
+   * @param mode If @c true, asynchronous send operations that are started
+   * before the socket is next ready to send are performed together, and each
+   * but the last is marked with @c MSG_MORE. A small write, such as a header
+   * followed by a body, is then not sent in a segment of its own. The final
+   * queued send flushes the data to the peer.
+   *
+   * @throws asio::system_error Thrown on failure. If the platform does not
+   * support the mode, the error is asio::error::operation_not_supported.
+   *
+   * @note The auto-cork mode affects only asynchronous send operations, each
+   * of which waits for the socket to become ready rather than first trying to
+   * send immediately. Data held back by a send that is not followed by another
+   * is pushed out by clearing the TCP_CORK option, so the mode should not be
+   * combined with an application's own use of that option. The mode is
+   * cleared when the socket is closed.
+   */
+  void auto_cork(bool mode)
+  {
+    asio::error_code ec;
+    this->impl_.get_service().auto_cork(
+        this->impl_.get_implementation(), mode, ec);
+    asio::detail::throw_error(ec, "auto_cork");
+  }
+
+  /// Sets the auto-cork mode of the socket.
+  /**
+   * @param mode If @c true, asynchronous send operations that are started
+   * before the socket is next ready to send are performed together, and each
+   * but the last is marked with @c MSG_MORE. A small write, such as a header
+   * followed by a body, is then not sent in a segment of its own. The final
+   * queued send flushes the data to the peer.
+   *
+   * @param ec Set to indicate what error occurred, if any. If the platform
+   * does not support the mode, the error is
+   * asio::error::operation_not_supported.
+   *
+   * @note The auto-cork mode affects only asynchronous send operations, each
+   * of which waits for the socket to become ready rather than first trying to
+   * send immediately. Data held back by a send that is not followed by another
+   * is pushed out by clearing the TCP_CORK option, so the mode should not be
+   * combined with an application's own use of that option. The mode is
+   * cleared when the socket is closed.
+   */
+  ASIO_SYNC_OP_VOID auto_cork(bool mode, asio::error_code& ec)
+  {
+    this->impl_.get_service().auto_cork(
+        this->impl_.get_implementation(), mode, ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
   /// Send some data on the socket.
   /**
    * This function is used to send data on the stream socket. The function
@@ -0,0 +1,628 @@
+//
+// bind_trace_context.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_BIND_TRACE_CONTEXT_HPP
+#define ASIO_BIND_TRACE_CONTEXT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/associated_executor.hpp"
+#include "asio/associated_trace_context.hpp"
+#include "asio/associator.hpp"
+#include "asio/async_result.hpp"
+#include "asio/detail/initiation_base.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/trace_context.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Helper to automatically define nested typedef result_type.
+
+template <typename T, typename = void>
+struct trace_context_binder_result_type
+{
+protected:
+  typedef void result_type_or_void;
+};
+
+template <typename T>
+struct trace_context_binder_result_type<T, void_t<typename T::result_type>>
+{
+  typedef typename T::result_type result_type;
+protected:
+  typedef result_type result_type_or_void;
+};
+
+template <typename R>
+struct trace_context_binder_result_type<R(*)()>
+{
+  typedef R result_type;
+protected:
+  typedef result_type result_type_or_void;
+};
+
+template <typename R>
+struct trace_context_binder_result_type<R(&)()>
+{
+  typedef R result_type;
+protected:
+  typedef result_type result_type_or_void;
+};
+
+template <typename R, typename A1>
+struct trace_context_binder_result_type<R(*)(A1)>
+{
+  typedef R result_type;
+protected:
+  typedef result_type result_type_or_void;
+};
+
+template <typename R, typename A1>
+struct trace_context_binder_result_type<R(&)(A1)>
+{
+  typedef R result_type;
+protected:
+  typedef result_type result_type_or_void;
+};
+
+template <typename R, typename A1, typename A2>
+struct trace_context_binder_result_type<R(*)(A1, A2)>
+{
+  typedef R result_type;
+protected:
+  typedef result_type result_type_or_void;
+};
+
+template <typename R, typename A1, typename A2>
+struct trace_context_binder_result_type<R(&)(A1, A2)>
+{
+  typedef R result_type;
+protected:
+  typedef result_type result_type_or_void;
+};
+
+// Helper to automatically define nested typedef argument_type.
+
+template <typename T, typename = void>
+struct trace_context_binder_argument_type {};
+
+template <typename T>
+struct trace_context_binder_argument_type<T,
+    void_t<typename T::argument_type>>
+{
+  typedef typename T::argument_type argument_type;
+};
+
+template <typename R, typename A1>
+struct trace_context_binder_argument_type<R(*)(A1)>
+{
+  typedef A1 argument_type;
+};
+
+template <typename R, typename A1>
+struct trace_context_binder_argument_type<R(&)(A1)>
+{
+  typedef A1 argument_type;
+};
+
+// Helper to automatically define nested typedefs first_argument_type and
+// second_argument_type.
+
+template <typename T, typename = void>
+struct trace_context_binder_argument_types {};
+
+template <typename T>
+struct trace_context_binder_argument_types<T,
+    void_t<typename T::first_argument_type>>
+{
+  typedef typename T::first_argument_type first_argument_type;
+  typedef typename T::second_argument_type second_argument_type;
+};
+
+template <typename R, typename A1, typename A2>
+struct trace_context_binder_argument_type<R(*)(A1, A2)>
+{
+  typedef A1 first_argument_type;
+  typedef A2 second_argument_type;
+};
+
+template <typename R, typename A1, typename A2>
+struct trace_context_binder_argument_type<R(&)(A1, A2)>
+{
+  typedef A1 first_argument_type;
+  typedef A2 second_argument_type;
+};
+
+} // namespace detail
+
+/// A call wrapper type to bind a trace context of type @c TraceContext
+/// to an object of type @c T.
+/**
+ * While the target object is invoked through the wrapper, the bound trace
+ * context is the one returned by asio::trace_context::current().
+ */
+template <typename T, typename TraceContext>
+class trace_context_binder
+#if !defined(GENERATING_DOCUMENTATION)
+  : public detail::trace_context_binder_result_type<T>,
+    public detail::trace_context_binder_argument_type<T>,
+    public detail::trace_context_binder_argument_types<T>
+#endif // !defined(GENERATING_DOCUMENTATION)
+{
+public:
+  /// The type of the target object.
+  typedef T target_type;
+
+  /// The type of the associated trace context.
+  typedef TraceContext trace_context_type;
+
+#if defined(GENERATING_DOCUMENTATION)
+  /// The return type if a function.
+  /**
+   * The type of @c result_type is based on the type @c T of the wrapper's
+   * target object:
+   *
+   * @li if @c T is a pointer to function type, @c result_type is a synonym for
+   * the return type of @c T;
+   *
+   * @li if @c T is a class type with a member type @c result_type, then @c
+   * result_type is a synonym for @c T::result_type;
+   *
+   * @li otherwise @c result_type is not defined.
+   */
+  typedef see_below result_type;
+
+  /// The type of the function's argument.
+  /**
+   * The type of @c argument_type is based on the type @c T of the wrapper's
+   * target object:
+   *
+   * @li if @c T is a pointer to a function type accepting a single argument,
+   * @c argument_type is a synonym for the return type of @c T;
+   *
+   * @li if @c T is a class type with a member type @c argument_type, then @c
+   * argument_type is a synonym for @c T::argument_type;
+   *
+   * @li otherwise @c argument_type is not defined.
+   */
+  typedef see_below argument_type;
+
+  /// The type of the function's first argument.
+  /**
+   * The type of @c first_argument_type is based on the type @c T of the
+   * wrapper's target object:
+   *
+   * @li if @c T is a pointer to a function type accepting two arguments, @c
+   * first_argument_type is a synonym for the return type of @c T;
+   *
+   * @li if @c T is a class type with a member type @c first_argument_type,
+   * then @c first_argument_type is a synonym for @c T::first_argument_type;
+   *
+   * @li otherwise @c first_argument_type is not defined.
+   */
+  typedef see_below first_argument_type;
+
+  /// The type of the function's second argument.
+  /**
+   * The type of @c second_argument_type is based on the type @c T of the
+   * wrapper's target object:
+   *
+   * @li if @c T is a pointer to a function type accepting two arguments, @c
+   * second_argument_type is a synonym for the return type of @c T;
+   *
+   * @li if @c T is a class type with a member type @c first_argument_type,
+   * then @c second_argument_type is a synonym for @c T::second_argument_type;
+   *
+   * @li otherwise @c second_argument_type is not defined.
+   */
+  typedef see_below second_argument_type;
+#endif // defined(GENERATING_DOCUMENTATION)
+
+  /// Construct a trace context wrapper for the specified object.
+  /**
+   * This constructor is only valid if the type @c T is constructible from type
+   * @c U.
+   */
+  template <typename U>
+  trace_context_binder(const trace_context_type& c, U&& u)
+    : context_(c),
+      target_(static_cast<U&&>(u))
+  {
+  }
+
+  /// Copy constructor.
+  trace_context_binder(const trace_context_binder& other)
+    : context_(other.get_trace_context()),
+      target_(other.get())
+  {
+  }
+
+  /// Construct a copy, but specify a different trace context.
+  trace_context_binder(const trace_context_type& c,
+      const trace_context_binder& other)
+    : context_(c),
+      target_(other.get())
+  {
+  }
+
+  /// Construct a copy of a different trace context wrapper type.
+  /**
+   * This constructor is only valid if the @c TraceContext type is
+   * constructible from type @c OtherTraceContext, and the type @c T is
+   * constructible from type @c U.
+   */
+  template <typename U, typename OtherTraceContext>
+  trace_context_binder(
+      const trace_context_binder<U, OtherTraceContext>& other,
+      constraint_t<is_constructible<TraceContext,
+        OtherTraceContext>::value> = 0,
+      constraint_t<is_constructible<T, U>::value> = 0)
+    : context_(other.get_trace_context()),
+      target_(other.get())
+  {
+  }
+
+  /// Construct a copy of a different trace context wrapper type, but
+  /// specify a different trace context.
+  /**
+   * This constructor is only valid if the type @c T is constructible from type
+   * @c U.
+   */
+  template <typename U, typename OtherTraceContext>
+  trace_context_binder(const trace_context_type& c,
+      const trace_context_binder<U, OtherTraceContext>& other,
+      constraint_t<is_constructible<T, U>::value> = 0)
+    : context_(c),
+      target_(other.get())
+  {
+  }
+
+  /// Move constructor.
+  trace_context_binder(trace_context_binder&& other)
+    : context_(static_cast<trace_context_type&&>(
+          other.get_trace_context())),
+      target_(static_cast<T&&>(other.get()))
+  {
+  }
+
+  /// Move construct the target object, but specify a different trace
+  /// context.
+  trace_context_binder(const trace_context_type& c,
+      trace_context_binder&& other)
+    : context_(c),
+      target_(static_cast<T&&>(other.get()))
+  {
+  }
+
+  /// Move construct from a different trace context wrapper type.
+  template <typename U, typename OtherTraceContext>
+  trace_context_binder(
+      trace_context_binder<U, OtherTraceContext>&& other,
+      constraint_t<is_constructible<TraceContext,
+        OtherTraceContext>::value> = 0,
+      constraint_t<is_constructible<T, U>::value> = 0)
+    : context_(static_cast<OtherTraceContext&&>(
+          other.get_trace_context())),
+      target_(static_cast<U&&>(other.get()))
+  {
+  }
+
+  /// Move construct from a different trace context wrapper type, but
+  /// specify a different trace context.
+  template <typename U, typename OtherTraceContext>
+  trace_context_binder(const trace_context_type& c,
+      trace_context_binder<U, OtherTraceContext>&& other,
+      constraint_t<is_constructible<T, U>::value> = 0)
+    : context_(c),
+      target_(static_cast<U&&>(other.get()))
+  {
+  }
+
+  /// Destructor.
+  ~trace_context_binder()
+  {
+  }
+
+  /// Obtain a reference to the target object.
+  target_type& get() noexcept
+  {
+    return target_;
+  }
+
+  /// Obtain a reference to the target object.
+  const target_type& get() const noexcept
+  {
+    return target_;
+  }
+
+  /// Obtain the associated trace context.
+  trace_context_type get_trace_context() const noexcept
+  {
+    return context_;
+  }
+
+  /// Forwarding function call operator.
+  template <typename... Args>
+  result_of_t<T(Args...)> operator()(Args&&... args) &
+  {
+    detail::trace_context_scope scope(context_);
+    return target_(static_cast<Args&&>(args)...);
+  }
+
+  /// Forwarding function call operator.
+  template <typename... Args>
+  result_of_t<T(Args...)> operator()(Args&&... args) &&
+  {
+    detail::trace_context_scope scope(context_);
+    return static_cast<T&&>(target_)(static_cast<Args&&>(args)...);
+  }
+
+  /// Forwarding function call operator.
+  template <typename... Args>
+  result_of_t<T(Args...)> operator()(Args&&... args) const&
+  {
+    detail::trace_context_scope scope(context_);
+    return target_(static_cast<Args&&>(args)...);
+  }
+
+private:
+  TraceContext context_;
+  T target_;
+};
+
+/// A function object type that adapts a @ref completion_token to specify that
+/// the completion handler should have the supplied trace context as its
+/// associated trace context.
+/**
+ * May also be used directly as a completion token, in which case it adapts the
+ * asynchronous operation's default completion token (or asio::deferred
+ * if no default is available).
+ */
+template <typename TraceContext>
+struct partial_trace_context_binder
+{
+  /// Constructor that specifies associated trace context.
+  explicit partial_trace_context_binder(const TraceContext& c)
+    : trace_context_(c)
+  {
+  }
+
+  /// Adapt a @ref completion_token to specify that the completion handler
+  /// should have the trace context as its associated trace context.
+  template <typename CompletionToken>
+  ASIO_NODISCARD inline
+  constexpr trace_context_binder<decay_t<CompletionToken>, TraceContext>
+  operator()(CompletionToken&& completion_token) const
+  {
+    return trace_context_binder<decay_t<CompletionToken>, TraceContext>(
+        trace_context_, static_cast<CompletionToken&&>(completion_token));
+  }
+
+//private:
+  TraceContext trace_context_;
+};
+
+/// Create a partial completion token that associates a trace context.
+template <typename TraceContext>
+ASIO_NODISCARD inline partial_trace_context_binder<TraceContext>
+bind_trace_context(const TraceContext& c)
+{
+  return partial_trace_context_binder<TraceContext>(c);
+}
+
+/// Associate an object of type @c T with a trace context of type
+/// @c TraceContext.
+template <typename TraceContext, typename T>
+ASIO_NODISCARD inline
+trace_context_binder<decay_t<T>, TraceContext>
+bind_trace_context(const TraceContext& c, T&& t)
+{
+  return trace_context_binder<decay_t<T>, TraceContext>(
+      c, static_cast<T&&>(t));
+}
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+namespace detail {
+
+template <typename TargetAsyncResult,
+    typename TraceContext, typename = void>
+class trace_context_binder_completion_handler_async_result
+{
+public:
+  template <typename T>
+  explicit trace_context_binder_completion_handler_async_result(T&)
+  {
+  }
+};
+
+template <typename TargetAsyncResult, typename TraceContext>
+class trace_context_binder_completion_handler_async_result<
+    TargetAsyncResult, TraceContext,
+    void_t<typename TargetAsyncResult::completion_handler_type>>
+{
+private:
+  TargetAsyncResult target_;
+
+public:
+  typedef trace_context_binder<
+    typename TargetAsyncResult::completion_handler_type, TraceContext>
+      completion_handler_type;
+
+  explicit trace_context_binder_completion_handler_async_result(
+      typename TargetAsyncResult::completion_handler_type& handler)
+    : target_(handler)
+  {
+  }
+
+  auto get() -> decltype(target_.get())
+  {
+    return target_.get();
+  }
+};
+
+template <typename TargetAsyncResult, typename = void>
+struct trace_context_binder_async_result_return_type
+{
+};
+
+template <typename TargetAsyncResult>
+struct trace_context_binder_async_result_return_type<
+    TargetAsyncResult, void_t<typename TargetAsyncResult::return_type>>
+{
+  typedef typename TargetAsyncResult::return_type return_type;
+};
+
+} // namespace detail
+
+template <typename T, typename TraceContext, typename Signature>
+class async_result<trace_context_binder<T, TraceContext>, Signature> :
+  public detail::trace_context_binder_completion_handler_async_result<
+      async_result<T, Signature>, TraceContext>,
+  public detail::trace_context_binder_async_result_return_type<
+      async_result<T, Signature>>
+{
+public:
+  explicit async_result(trace_context_binder<T, TraceContext>& b)
+    : detail::trace_context_binder_completion_handler_async_result<
+        async_result<T, Signature>, TraceContext>(b.get())
+  {
+  }
+
+  template <typename Initiation>
+  struct init_wrapper : detail::initiation_base<Initiation>
+  {
+    using detail::initiation_base<Initiation>::initiation_base;
+
+    template <typename Handler, typename... Args>
+    void operator()(Handler&& handler,
+        const TraceContext& context, Args&&... args) &&
+    {
+      static_cast<Initiation&&>(*this)(
+          trace_context_binder<decay_t<Handler>, TraceContext>(
+              context, static_cast<Handler&&>(handler)),
+          static_cast<Args&&>(args)...);
+    }
+
+    template <typename Handler, typename... Args>
+    void operator()(Handler&& handler,
+        const TraceContext& context, Args&&... args) const &
+    {
+      static_cast<const Initiation&>(*this)(
+          trace_context_binder<decay_t<Handler>, TraceContext>(
+              context, static_cast<Handler&&>(handler)),
+          static_cast<Args&&>(args)...);
+    }
+  };
+
+  template <typename Initiation, typename RawCompletionToken, typename... Args>
+  static auto initiate(Initiation&& initiation,
+      RawCompletionToken&& token, Args&&... args)
+    -> decltype(
+      async_initiate<
+        conditional_t<
+          is_const<remove_reference_t<RawCompletionToken>>::value, const T, T>,
+        Signature>(
+        declval<init_wrapper<decay_t<Initiation>>>(),
+        token.get(), token.get_trace_context(),
+        static_cast<Args&&>(args)...))
+  {
+    return async_initiate<
+      conditional_t<
+        is_const<remove_reference_t<RawCompletionToken>>::value, const T, T>,
+      Signature>(
+        init_wrapper<decay_t<Initiation>>(
+          static_cast<Initiation&&>(initiation)),
+        token.get(), token.get_trace_context(),
+        static_cast<Args&&>(args)...);
+  }
+
+private:
+  async_result(const async_result&) = delete;
+  async_result& operator=(const async_result&) = delete;
+
+  async_result<T, Signature> target_;
+};
+
+template <typename TraceContext, typename... Signatures>
+struct async_result<partial_trace_context_binder<TraceContext>,
+    Signatures...>
+{
+  template <typename Initiation, typename RawCompletionToken, typename... Args>
+  static auto initiate(Initiation&& initiation,
+      RawCompletionToken&& token, Args&&... args)
+    -> decltype(
+      async_initiate<Signatures...>(
+        static_cast<Initiation&&>(initiation),
+        trace_context_binder<
+          default_completion_token_t<associated_executor_t<Initiation>>,
+          TraceContext>(token.trace_context_,
+            default_completion_token_t<associated_executor_t<Initiation>>{}),
+        static_cast<Args&&>(args)...))
+  {
+    return async_initiate<Signatures...>(
+        static_cast<Initiation&&>(initiation),
+        trace_context_binder<
+          default_completion_token_t<associated_executor_t<Initiation>>,
+          TraceContext>(token.trace_context_,
+            default_completion_token_t<associated_executor_t<Initiation>>{}),
+        static_cast<Args&&>(args)...);
+  }
+};
+
+template <template <typename, typename> class Associator,
+    typename T, typename TraceContext, typename DefaultCandidate>
+struct associator<Associator,
+    trace_context_binder<T, TraceContext>,
+    DefaultCandidate>
+  : Associator<T, DefaultCandidate>
+{
+  static typename Associator<T, DefaultCandidate>::type get(
+      const trace_context_binder<T, TraceContext>& b) noexcept
+  {
+    return Associator<T, DefaultCandidate>::get(b.get());
+  }
+
+  static auto get(const trace_context_binder<T, TraceContext>& b,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<T, DefaultCandidate>::get(b.get(), c))
+  {
+    return Associator<T, DefaultCandidate>::get(b.get(), c);
+  }
+};
+
+template <typename T, typename TraceContext, typename TraceContext1>
+struct associated_trace_context<
+    trace_context_binder<T, TraceContext>,
+    TraceContext1>
+{
+  typedef TraceContext type;
+
+  static auto get(const trace_context_binder<T, TraceContext>& b,
+      const TraceContext1& = TraceContext1()) noexcept
+    -> decltype(b.get_trace_context())
+  {
+    return b.get_trace_context();
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_BIND_TRACE_CONTEXT_HPP
@@ -17,6 +17,7 @@
 
 #include "asio/detail/config.hpp"
 #include "asio/associated_executor.hpp"
+#include "asio/associated_trace_context.hpp"
 #include "asio/async_result.hpp"
 #include "asio/detail/base_from_cancellation_state.hpp"
 #include "asio/detail/composed_work.hpp"
@@ -88,6 +89,7 @@ public:
     if (invocations_ < ~0u)
       ++invocations_;
     this->get_cancellation_state().slot().clear();
+    associated_trace_context_scope<Handler> trace_scope(handler_);
     impl_(*this, static_cast<T&&>(t)...);
   }
 
@@ -145,6 +147,7 @@ public:
     if (this->invocations_ < ~0u)
       ++this->invocations_;
     this->get_cancellation_state().slot().clear();
+    associated_trace_context_scope<Handler> trace_scope(this->handler_);
     this->impl_(*this, static_cast<T&&>(t)...);
   }
 
@@ -169,6 +172,7 @@ public:
     if (this->invocations_ < ~0u)
       ++this->invocations_;
     this->get_cancellation_state().slot().clear();
+    associated_trace_context_scope<Handler> trace_scope(this->handler_);
     this->impl_(*this, static_cast<T&&>(t)...);
   }
 
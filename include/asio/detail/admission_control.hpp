@@ -0,0 +1,370 @@
+//
+// detail/admission_control.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_ADMISSION_CONTROL_HPP
+#define ASIO_DETAIL_ADMISSION_CONTROL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/event.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Decides whether new work may be admitted to an execution context, and counts
+// the work that exceeds the limits. New function objects are limited by the
+// number of function objects that are queued, and new operations by the number
+// of operations of the same class that are already in flight.
+class admission_control
+  : private noncopyable
+{
+public:
+  // The classes of new work that are subject to admission control.
+  enum work_class
+  {
+    handler_work = 0,
+    accept_work = 1,
+    read_work = 2,
+    max_work_classes = 3
+  };
+
+  // The ways in which a new function object that exceeds the limit is handled.
+  enum handler_policy
+  {
+    block_handlers,
+    reject_handlers,
+    shed_handlers
+  };
+
+  // The result of submitting a new function object.
+  enum handler_result
+  {
+    handler_admitted,
+    handler_rejected,
+    handler_shed
+  };
+
+  // Constructor. A limit of 0 or less means that the work class is unlimited.
+  // Submitters are blocked by the block_handlers policy only if locking is
+  // enabled, as otherwise no other thread may be running the context.
+  admission_control(long handler_limit, long accept_limit, long read_limit,
+      bool enforce, handler_policy policy, bool locking)
+    : enforce_(enforce),
+      policy_(policy),
+      locking_(locking),
+      blocked_(0),
+      rejected_(0),
+      shed_(0),
+      runners_(0),
+      waiters_(0)
+  {
+    limits_[handler_work] = handler_limit;
+    limits_[accept_work] = accept_limit;
+    limits_[read_work] = read_limit;
+    for (int i = 0; i < max_work_classes; ++i)
+    {
+      over_limit_[i] = 0;
+      in_flight_[i] = 0;
+    }
+  }
+
+  // Get the limit for the specified class of work.
+  long limit(work_class c) const
+  {
+    return limits_[c];
+  }
+
+  // Count a new function object as queued. Function objects that exceed the
+  // limit are always counted, but the policy is applied only if the limits are
+  // being enforced and the function object is not a continuation. A submitter
+  // is blocked only if it may block and another thread is running the context,
+  // and is released when the queue falls below the limit or when no threads
+  // are left running the context. If the function object is admitted, sets
+  // admission to the controller that must be notified once the function
+  // object has left the queue.
+  handler_result start_handler(bool is_continuation,
+      bool may_block, admission_control*& admission)
+  {
+    admission = 0;
+    const long limit = limits_[handler_work];
+    if (limit <= 0)
+      return handler_admitted;
+    if (++in_flight_[handler_work] > limit && !is_continuation)
+    {
+      ++over_limit_[handler_work];
+      if (enforce_)
+      {
+        switch (policy_)
+        {
+        case reject_handlers:
+          decrement(in_flight_[handler_work], 1);
+          ++rejected_;
+          return handler_rejected;
+        case shed_handlers:
+          decrement(in_flight_[handler_work], 1);
+          ++shed_;
+          return handler_shed;
+        default:
+          if (may_block && locking_)
+            wait_for_queue_space(limit);
+          break;
+        }
+      }
+    }
+    admission = this;
+    return handler_admitted;
+  }
+
+  // Notify that a queued function object has been invoked or destroyed.
+  void handler_finished()
+  {
+    decrement(in_flight_[handler_work], 1);
+    if (waiters_ != 0)
+    {
+      mutex::scoped_lock lock(mutex_);
+      event_.signal_all(lock);
+    }
+  }
+
+  // Counts the current thread as running the context until block exit.
+  class runner
+    : private noncopyable
+  {
+  public:
+    explicit runner(admission_control& admission)
+      : admission_(admission)
+    {
+      admission_.runner_started();
+    }
+
+    ~runner()
+    {
+      admission_.runner_finished();
+    }
+
+  private:
+    admission_control& admission_;
+  };
+
+  // Notify that a thread has started running the context.
+  void runner_started()
+  {
+    if (limits_[handler_work] > 0 && locking_)
+    {
+      mutex::scoped_lock lock(mutex_);
+      ++runners_;
+    }
+  }
+
+  // Notify that a thread has stopped running the context. Blocked submitters
+  // are released once no threads are left to drain the queue.
+  void runner_finished()
+  {
+    if (limits_[handler_work] > 0 && locking_)
+    {
+      mutex::scoped_lock lock(mutex_);
+      if (--runners_ == 0)
+        event_.signal_all(lock);
+    }
+  }
+
+  // Count a new operation of the specified class as in flight. Operations
+  // that exceed the limit are always counted, but are refused only if the
+  // limits are being enforced and the operation is not a continuation of an
+  // earlier one. Returns false if the operation is refused. Otherwise, sets
+  // count to the count that the operation must decrement when it finishes, or
+  // to 0 if the class is unlimited.
+  bool start_op(work_class c, bool is_continuation, atomic_count*& count)
+  {
+    count = 0;
+    if (limits_[c] <= 0)
+      return true;
+    if (++in_flight_[c] > limits_[c] && !is_continuation)
+    {
+      ++over_limit_[c];
+      if (enforce_)
+      {
+        decrement(in_flight_[c], 1);
+        return false;
+      }
+    }
+    count = &in_flight_[c];
+    return true;
+  }
+
+  // Get the number of times that new work exceeded the specified limit.
+  long over_limit(work_class c) const
+  {
+    return over_limit_[c];
+  }
+
+  // Get the amount of work of the specified class that is in flight. For
+  // function objects, this is the number that are queued. Work is counted
+  // only if its class is limited.
+  long in_flight(work_class c) const
+  {
+    return in_flight_[c];
+  }
+
+  // Get the number of function objects whose submitters were blocked.
+  long handlers_blocked() const
+  {
+    return blocked_;
+  }
+
+  // Get the number of function objects that were rejected.
+  long handlers_rejected() const
+  {
+    return rejected_;
+  }
+
+  // Get the number of function objects that were shed.
+  long handlers_shed() const
+  {
+    return shed_;
+  }
+
+private:
+  // Wait until the number of queued function objects falls below the limit,
+  // or until no threads are running the context. The caller's function object
+  // is not counted while it waits.
+  void wait_for_queue_space(long limit)
+  {
+    decrement(in_flight_[handler_work], 1);
+    mutex::scoped_lock lock(mutex_);
+    if (runners_ > 0 && in_flight_[handler_work] >= limit)
+    {
+      // The waiter count is incremented before the queue is checked again, so
+      // that handler_finished() either sees the waiter or the waiter sees the
+      // shorter queue.
+      ++blocked_;
+      ++waiters_;
+      while (runners_ > 0 && in_flight_[handler_work] >= limit)
+      {
+        event_.clear(lock);
+        event_.wait(lock);
+      }
+      decrement(waiters_, 1);
+    }
+    ++in_flight_[handler_work];
+  }
+
+  // The limits on outstanding work for each class of new work.
+  long limits_[max_work_classes];
+
+  // Whether work that exceeds a limit is refused.
+  const bool enforce_;
+
+  // How function objects that exceed the limit are handled.
+  const handler_policy policy_;
+
+  // Whether the context's scheduler uses locking.
+  const bool locking_;
+
+  // The number of times that new work exceeded each limit.
+  atomic_count over_limit_[max_work_classes];
+
+  // The number of operations of each class that are in flight.
+  atomic_count in_flight_[max_work_classes];
+
+  // The number of function objects that were blocked, rejected or shed.
+  atomic_count blocked_;
+  atomic_count rejected_;
+  atomic_count shed_;
+
+  // Mutex and event used to block submitters while the queue is full.
+  mutex mutex_;
+  event event_;
+
+  // The number of threads running the context. Protected by mutex_.
+  long runners_;
+
+  // The number of blocked submitters.
+  atomic_count waiters_;
+};
+
+// Counts a function object against the handler limit while it is queued.
+class handler_admission
+  : private noncopyable
+{
+public:
+  explicit handler_admission(admission_control* admission)
+    : admission_(admission)
+  {
+  }
+
+  handler_admission(handler_admission&& other)
+    : admission_(other.admission_)
+  {
+    other.admission_ = 0;
+  }
+
+  ~handler_admission()
+  {
+    release();
+  }
+
+  void release()
+  {
+    if (admission_)
+    {
+      admission_->handler_finished();
+      admission_ = 0;
+    }
+  }
+
+private:
+  admission_control* admission_;
+};
+
+// Wraps a submitted function object so that it leaves the admission count
+// when it is invoked or destroyed, whichever happens first.
+template <typename Function>
+class admitted_function
+{
+public:
+  template <typename F>
+  admitted_function(F&& f, admission_control* admission)
+    : admission_(admission),
+      function_(static_cast<F&&>(f))
+  {
+  }
+
+  admitted_function(admitted_function&& other)
+    : admission_(static_cast<handler_admission&&>(other.admission_)),
+      function_(static_cast<Function&&>(other.function_))
+  {
+  }
+
+  void operator()()
+  {
+    admission_.release();
+    static_cast<Function&&>(function_)();
+  }
+
+private:
+  handler_admission admission_;
+  Function function_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_ADMISSION_CONTROL_HPP
@@ -896,6 +896,19 @@
 # endif // !defined(ASIO_HAS_DEV_POLL)
 #endif // defined(__sun)
 
+// USDT static probes, for tracing with tools such as perf and bpftrace. These
+// require <sys/sdt.h> and must be explicitly enabled.
+#if !defined(ASIO_HAS_USDT_PROBES)
+# if defined(ASIO_ENABLE_USDT_PROBES)
+#  if defined(__has_include)
+#   if !__has_include(<sys/sdt.h>)
+#    error ASIO_ENABLE_USDT_PROBES requires <sys/sdt.h>
+#   endif // !__has_include(<sys/sdt.h>)
+#  endif // defined(__has_include)
+#  define ASIO_HAS_USDT_PROBES 1
+# endif // defined(ASIO_ENABLE_USDT_PROBES)
+#endif // !defined(ASIO_HAS_USDT_PROBES)
+
 // Serial ports.
 #if !defined(ASIO_HAS_SERIAL_PORT)
 # if defined(ASIO_HAS_IOCP) \
@@ -1415,6 +1428,24 @@
 # endif // defined(_POSIX_VERSION)
 #endif // !defined(ASIO_HAS_MSG_NOSIGNAL)
 
+// Kernel support for MSG_MORE.
+#if !defined(ASIO_HAS_MSG_MORE)
+# if !defined(ASIO_DISABLE_MSG_MORE)
+#  if defined(__linux__)
+#   define ASIO_HAS_MSG_MORE 1
+#  endif // defined(__linux__)
+# endif // !defined(ASIO_DISABLE_MSG_MORE)
+#endif // !defined(ASIO_HAS_MSG_MORE)
+
+// Kernel support for the TCP_NOTSENT_LOWAT socket option.
+#if !defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
+# if !defined(ASIO_DISABLE_TCP_NOTSENT_LOWAT)
+#  if defined(__linux__) || (defined(__MACH__) && defined(__APPLE__))
+#   define ASIO_HAS_TCP_NOTSENT_LOWAT 1
+#  endif // defined(__linux__) || (defined(__MACH__) && defined(__APPLE__))
+# endif // !defined(ASIO_DISABLE_TCP_NOTSENT_LOWAT)
+#endif // !defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
+
 // Standard library support for std::to_address.
 #if !defined(ASIO_HAS_STD_TO_ADDRESS)
 # if !defined(ASIO_DISABLE_STD_TO_ADDRESS)
@@ -19,6 +19,7 @@
 
 #if defined(ASIO_HAS_EPOLL)
 
+#include <chrono>
 #include "asio/detail/atomic_count.hpp"
 #include "asio/detail/conditionally_enabled_mutex.hpp"
 #include "asio/detail/limits.hpp"
@@ -66,6 +67,7 @@ public:
     uint32_t registered_events_;
     op_queue<reactor_op> op_queue_[max_ops];
     bool try_speculative_[max_ops];
+    int speculative_count_[max_ops];
     bool shutdown_;
 
     ASIO_DECL descriptor_state(bool locking, int spin_count);
@@ -244,8 +246,16 @@ private:
   // Get the timeout value for the timer descriptor. The return value is the
   // flag argument to be used when calling timerfd_settime.
   ASIO_DECL int get_timeout(itimerspec& ts);
+
+  // Update the timer spin interval from the lateness of a timer descriptor
+  // wakeup.
+  ASIO_DECL void calibrate_timer_spin();
 #endif // defined(ASIO_HAS_TIMERFD)
 
+  // Busy-wait for the earliest timer to expire, if it will expire within the
+  // maximum spin interval. The lock is released while waiting.
+  ASIO_DECL void spin_until_timer_expiry(mutex::scoped_lock& lock);
+
   // The scheduler implementation used to post completions.
   scheduler& scheduler_;
 
@@ -273,6 +283,30 @@ private:
   // How any times to spin waiting for the I/O mutex.
   const int io_locking_spin_count_;
 
+  // The maximum number of consecutive speculative completions permitted for
+  // each descriptor and operation type before the operation must instead
+  // wait for the reactor. A value of 0 means there is no limit.
+  const int max_speculative_completions_;
+
+  // The maximum interval, in microseconds, for which the reactor busy-waits
+  // for a timer to expire. A value of 0 disables busy-waiting.
+  const long timer_spin_usec_;
+
+  // Whether the spin interval is calibrated from observed wakeup latency.
+  const bool timer_spin_calibrate_;
+
+  // The interval, in microseconds, by which the reactor wakes ahead of the
+  // earliest timer so that it can busy-wait for the remainder.
+  long timer_spin_slack_usec_;
+
+  // The average lateness of timer descriptor wakeups, in microseconds, scaled
+  // by a factor of 8.
+  long timer_wakeup_lateness_;
+
+  // When the timer descriptor is next expected to wake the reactor, or the
+  // epoch if no calibration sample is pending.
+  std::chrono::steady_clock::time_point timer_wakeup_target_;
+
   // Mutex to protect access to the registered descriptors.
   mutex registered_descriptors_mutex_;
 
@@ -18,6 +18,7 @@
 #include "asio/detail/config.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/recycling_allocator.hpp"
+#include "asio/detail/reusable_op_storage.hpp"
 #include "asio/associated_allocator.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -34,6 +35,9 @@
     } \
     static op* allocate(Handler& handler) \
     { \
+      if (void* reused = ::asio::detail::take_reusable_op_storage( \
+            ::asio::detail::addressof(handler), sizeof(op), alignof(op))) \
+        return static_cast<op*>(reused); \
       typedef typename ::asio::associated_allocator< \
         Handler>::type associated_allocator_type; \
       typedef typename ::asio::detail::get_recycling_allocator< \
@@ -44,6 +48,19 @@
                 ::asio::get_associated_allocator(handler))); \
       return a.allocate(1); \
     } \
+    static void deallocate(void* block, void* owner) \
+    { \
+      typedef typename ::asio::associated_allocator< \
+        Handler>::type associated_allocator_type; \
+      typedef typename ::asio::detail::get_recycling_allocator< \
+        associated_allocator_type, purpose>::type default_allocator_type; \
+      ASIO_REBIND_ALLOC(default_allocator_type, op) a( \
+            ::asio::detail::get_recycling_allocator< \
+              associated_allocator_type, purpose>::get( \
+                ::asio::get_associated_allocator( \
+                  *static_cast<Handler*>(owner)))); \
+      a.deallocate(static_cast<op*>(block), 1); \
+    } \
     void reset() \
     { \
       if (p) \
@@ -53,15 +70,9 @@
       } \
       if (v) \
       { \
-        typedef typename ::asio::associated_allocator< \
-          Handler>::type associated_allocator_type; \
-        typedef typename ::asio::detail::get_recycling_allocator< \
-          associated_allocator_type, purpose>::type default_allocator_type; \
-        ASIO_REBIND_ALLOC(default_allocator_type, op) a( \
-              ::asio::detail::get_recycling_allocator< \
-                associated_allocator_type, purpose>::get( \
-                  ::asio::get_associated_allocator(*h))); \
-        a.deallocate(static_cast<op*>(v), 1); \
+        if (!::asio::detail::keep_reusable_op_storage(h, v, \
+              sizeof(op), alignof(op), &ptr::deallocate)) \
+          deallocate(v, h); \
         v = 0; \
       } \
     } \
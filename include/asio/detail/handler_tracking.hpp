@@ -30,6 +30,8 @@ class execution_context;
 # include "asio/detail/cstdint.hpp"
 # include "asio/detail/static_mutex.hpp"
 # include "asio/detail/tss_ptr.hpp"
+#elif defined(ASIO_HAS_USDT_PROBES)
+# include "asio/detail/usdt_probes.hpp"
 #endif // defined(ASIO_ENABLE_HANDLER_TRACKING)
 
 #include "asio/detail/push_options.hpp"
@@ -231,6 +233,31 @@ private:
 # define ASIO_HANDLER_REACTOR_OPERATION(args) \
   asio::detail::handler_tracking::reactor_operation args
 
+#elif defined(ASIO_HAS_USDT_PROBES)
+
+// When handler tracking is disabled, the tracking points emit USDT probes.
+
+# define ASIO_INHERIT_TRACKED_HANDLER
+# define ASIO_ALSO_INHERIT_TRACKED_HANDLER
+# define ASIO_HANDLER_TRACKING_INIT (void)0
+# define ASIO_HANDLER_LOCATION(loc) (void)0
+# define ASIO_HANDLER_CREATION(args) ASIO_USDT_HANDLER_CREATION args
+# define ASIO_HANDLER_COMPLETION(args) ASIO_USDT_HANDLER_COMPLETION args
+# define ASIO_HANDLER_INVOCATION_BEGIN(args) \
+  ASIO_USDT_PROBE0(handler__invocation__begin)
+# define ASIO_HANDLER_INVOCATION_END \
+  ASIO_USDT_PROBE0(handler__invocation__end)
+# define ASIO_HANDLER_OPERATION(args) ASIO_USDT_HANDLER_OPERATION args
+# define ASIO_HANDLER_REACTOR_REGISTRATION(args) \
+  ASIO_USDT_REACTOR_REGISTRATION args
+# define ASIO_HANDLER_REACTOR_DEREGISTRATION(args) \
+  ASIO_USDT_REACTOR_DEREGISTRATION args
+# define ASIO_HANDLER_REACTOR_READ_EVENT 0
+# define ASIO_HANDLER_REACTOR_WRITE_EVENT 0
+# define ASIO_HANDLER_REACTOR_ERROR_EVENT 0
+# define ASIO_HANDLER_REACTOR_EVENTS(args) (void)0
+# define ASIO_HANDLER_REACTOR_OPERATION(args) ASIO_USDT_REACTOR_OPERATION args
+
 #else // defined(ASIO_ENABLE_HANDLER_TRACKING)
 
 # define ASIO_INHERIT_TRACKED_HANDLER
@@ -24,7 +24,9 @@
 #include "asio/config.hpp"
 #include "asio/detail/epoll_reactor.hpp"
 #include "asio/detail/scheduler.hpp"
+#include "asio/detail/socket_ops.hpp"
 #include "asio/detail/throw_error.hpp"
+#include "asio/detail/usdt_probes.hpp"
 #include "asio/error.hpp"
 
 #if defined(ASIO_HAS_TIMERFD)
@@ -49,6 +51,13 @@ epoll_reactor::epoll_reactor(asio::execution_context& ctx)
     io_locking_(config(ctx).get("reactor", "io_locking", true)),
     io_locking_spin_count_(
         config(ctx).get("reactor", "io_locking_spin_count", 0)),
+    max_speculative_completions_(
+        config(ctx).get("reactor", "max_speculative_completions", 0)),
+    timer_spin_usec_(config(ctx).get("reactor", "timer_spin_usec", 0L)),
+    timer_spin_calibrate_(
+        config(ctx).get("reactor", "timer_spin_calibrate", true)),
+    timer_spin_slack_usec_(timer_spin_usec_),
+    timer_wakeup_lateness_(0),
     registered_descriptors_mutex_(mutex_.enabled(), mutex_.spin_count()),
     registered_descriptors_(execution_context::allocator<void>(ctx),
         config(ctx).get("reactor", "preallocated_io_objects", 0U),
@@ -178,7 +187,10 @@ int epoll_reactor::register_descriptor(socket_type descriptor,
     descriptor_data->descriptor_ = descriptor;
     descriptor_data->shutdown_ = false;
     for (int i = 0; i < max_ops; ++i)
+    {
       descriptor_data->try_speculative_[i] = true;
+      descriptor_data->speculative_count_[i] = 0;
+    }
   }
 
   epoll_event ev = { 0, { 0 } };
@@ -221,7 +233,10 @@ int epoll_reactor::register_internal_descriptor(
     descriptor_data->shutdown_ = false;
     descriptor_data->op_queue_[op_type].push(op);
     for (int i = 0; i < max_ops; ++i)
+    {
       descriptor_data->try_speculative_[i] = true;
+      descriptor_data->speculative_count_[i] = 0;
+    }
   }
 
   epoll_event ev = { 0, { 0 } };
@@ -277,6 +292,15 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
 
   if (descriptor_data->op_queue_[op_type].empty())
   {
+    // Once a descriptor has used up its budget of consecutive speculative
+    // completions, the operation must make a trip through the reactor so that
+    // other descriptors get a chance to have their events processed.
+    if (allow_speculative && max_speculative_completions_ > 0
+        && descriptor_data->registered_events_ != 0
+        && descriptor_data->speculative_count_[op_type]
+          >= max_speculative_completions_)
+      allow_speculative = false;
+
     if (allow_speculative
         && (op_type != read_op
           || descriptor_data->op_queue_[except_op].empty()))
@@ -288,6 +312,7 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
           if (status == reactor_op::done_and_exhausted)
             if (descriptor_data->registered_events_ != 0)
               descriptor_data->try_speculative_[op_type] = false;
+          ++descriptor_data->speculative_count_[op_type];
           descriptor_lock.unlock();
           on_immediate(op, is_continuation, immediate_arg);
           return;
@@ -525,6 +550,7 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
   // Block on the epoll descriptor.
   epoll_event events[128];
   int num_events = epoll_wait(epoll_fd_, events, 128, timeout);
+  ASIO_USDT_PROBE2(reactor__events, num_events, events);
 
 #if defined(ASIO_ENABLE_HANDLER_TRACKING)
   // Trace the waiting events.
@@ -558,6 +584,7 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
 
 #if defined(ASIO_HAS_TIMERFD)
   bool check_timers = (timer_fd_ == -1);
+  bool timer_fd_fired = false;
 #else // defined(ASIO_HAS_TIMERFD)
   bool check_timers = true;
 #endif // defined(ASIO_HAS_TIMERFD)
@@ -584,6 +611,7 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
     else if (ptr == &timer_fd_)
     {
       check_timers = true;
+      timer_fd_fired = true;
     }
 #endif // defined(ASIO_HAS_TIMERFD)
     else
@@ -607,6 +635,18 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
   if (check_timers)
   {
     mutex::scoped_lock common_lock(mutex_);
+    if (timer_spin_usec_ > 0)
+    {
+#if defined(ASIO_HAS_TIMERFD)
+      if (timer_fd_fired)
+        calibrate_timer_spin();
+#endif // defined(ASIO_HAS_TIMERFD)
+
+      // Spinning would delay any I/O completions already collected, and a
+      // caller polling with a zero timeout does not expect to be held.
+      if (usec != 0 && ops.empty())
+        spin_until_timer_expiry(common_lock);
+    }
     timer_queues_.get_ready_timers(ops);
 
 #if defined(ASIO_HAS_TIMERFD)
@@ -722,8 +762,19 @@ int epoll_reactor::get_timeout(int msec)
   // By default we will wait no longer than 5 minutes. This will ensure that
   // any changes to the system clock are detected after no longer than this.
   const int max_msec = 5 * 60 * 1000;
-  return timer_queues_.wait_duration_msec(
-      (msec < 0 || max_msec < msec) ? max_msec : msec);
+  if (msec < 0 || max_msec < msec)
+    msec = max_msec;
+
+  // When busy-waiting is enabled, wake ahead of the earliest timer. The
+  // duration is rounded down so that the wakeup is never late.
+  if (timer_spin_usec_ > 0)
+  {
+    long usec = timer_queues_.wait_duration_usec(msec * 1000L);
+    usec = (usec > timer_spin_usec_) ? usec - timer_spin_usec_ : 0;
+    return static_cast<int>(usec / 1000);
+  }
+
+  return timer_queues_.wait_duration_msec(msec);
 }
 
 #if defined(ASIO_HAS_TIMERFD)
@@ -733,13 +784,69 @@ int epoll_reactor::get_timeout(itimerspec& ts)
   ts.it_interval.tv_nsec = 0;
 
   long usec = timer_queues_.wait_duration_usec(5 * 60 * 1000 * 1000);
+
+  // When busy-waiting is enabled, wake ahead of the earliest timer.
+  if (timer_spin_usec_ > 0)
+  {
+    timer_wakeup_target_ = std::chrono::steady_clock::time_point();
+    if (usec > timer_spin_slack_usec_)
+    {
+      usec -= timer_spin_slack_usec_;
+      timer_wakeup_target_ = std::chrono::steady_clock::now()
+        + std::chrono::microseconds(usec);
+    }
+    else
+      usec = 0;
+  }
+
   ts.it_value.tv_sec = usec / 1000000;
   ts.it_value.tv_nsec = usec ? (usec % 1000000) * 1000 : 1;
 
   return usec ? 0 : TFD_TIMER_ABSTIME;
 }
+
+void epoll_reactor::calibrate_timer_spin()
+{
+  if (!timer_spin_calibrate_
+      || timer_wakeup_target_ == std::chrono::steady_clock::time_point())
+    return;
+
+  std::chrono::steady_clock::duration lateness =
+    std::chrono::steady_clock::now() - timer_wakeup_target_;
+  long lateness_usec = static_cast<long>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+        lateness).count());
+  if (lateness_usec < 0)
+    lateness_usec = 0;
+  else if (lateness_usec > timer_spin_usec_)
+    lateness_usec = timer_spin_usec_;
+
+  // Keep a moving average of the lateness, and spin for twice that long so
+  // that most wakeups occur before the timer expires.
+  timer_wakeup_lateness_ += lateness_usec - timer_wakeup_lateness_ / 8;
+  long slack = timer_wakeup_lateness_ / 4 + 1;
+  timer_spin_slack_usec_ =
+    (slack < timer_spin_usec_) ? slack : timer_spin_usec_;
+}
 #endif // defined(ASIO_HAS_TIMERFD)
 
+void epoll_reactor::spin_until_timer_expiry(mutex::scoped_lock& lock)
+{
+  for (;;)
+  {
+    long usec = timer_queues_.wait_duration_usec(timer_spin_usec_ + 1);
+    if (usec == 0 || usec > timer_spin_usec_)
+      return;
+
+    lock.unlock();
+    std::chrono::steady_clock::time_point end =
+      std::chrono::steady_clock::now() + std::chrono::microseconds(usec);
+    while (std::chrono::steady_clock::now() < end)
+      ;
+    lock.lock();
+  }
+}
+
 struct epoll_reactor::perform_io_cleanup_on_block_exit
 {
   explicit perform_io_cleanup_on_block_exit(epoll_reactor* r)
@@ -793,10 +900,15 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
     if (events & (flag[j] | EPOLLERR | EPOLLHUP))
     {
       try_speculative_[j] = true;
+      speculative_count_[j] = 0;
+      bool corked = false;
       while (reactor_op* op = op_queue_[j].front())
       {
+        op->more_queued_ = reactor_op::more_queued(
+            op, op_queue_access::next(op));
         if (reactor_op::status status = op->perform())
         {
+          corked = op->more_queued_;
           op_queue_[j].pop();
           io_cleanup.ops_.push(op);
           if (status == reactor_op::done_and_exhausted)
@@ -808,6 +920,14 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
         else
           break;
       }
+
+#if defined(ASIO_HAS_MSG_MORE)
+      // A send that held back its data was not followed by one that pushed it.
+      if (corked)
+        socket_ops::uncork(descriptor_);
+#else // defined(ASIO_HAS_MSG_MORE)
+      (void)corked;
+#endif // defined(ASIO_HAS_MSG_MORE)
     }
   }
 
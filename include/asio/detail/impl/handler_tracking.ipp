@@ -28,6 +28,7 @@
 #include "asio/detail/chrono.hpp"
 #include "asio/detail/chrono_time_traits.hpp"
 #include "asio/detail/handler_tracking.hpp"
+#include "asio/trace_context.hpp"
 #include "asio/wait_traits.hpp"
 
 #if defined(ASIO_WINDOWS_RUNTIME)
@@ -136,6 +137,24 @@ void handler_tracking::creation(execution_context&,
         current_location->file_, current_location->line_);
   }
 
+  // Attribute the new handler to the trace context of the code creating it.
+  if (const trace_context* current_trace = trace_context_scope::top())
+  {
+    if (*current_trace)
+    {
+      write_line(
+#if defined(ASIO_WINDOWS)
+          "@asio|%I64u.%06I64u|%I64u^%I64u|trace %016I64x.%016I64x\n",
+#else // defined(ASIO_WINDOWS)
+          "@asio|%llu.%06llu|%llu^%llu|trace %016llx.%016llx\n",
+#endif // defined(ASIO_WINDOWS)
+          timestamp.seconds, timestamp.microseconds,
+          current_id, h.id_,
+          static_cast<uint64_t>(current_trace->trace_id()),
+          static_cast<uint64_t>(current_trace->span_id()));
+    }
+  }
+
   write_line(
 #if defined(ASIO_WINDOWS)
       "@asio|%I64u.%06I64u|%I64u*%I64u|%.20s@%p.%.50s\n",
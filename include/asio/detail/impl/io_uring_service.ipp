@@ -25,6 +25,7 @@
 #include "asio/detail/reactor_op.hpp"
 #include "asio/detail/scheduler.hpp"
 #include "asio/detail/throw_error.hpp"
+#include "asio/detail/usdt_probes.hpp"
 #include "asio/error.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -417,6 +418,21 @@ void io_uring_service::cleanup_io_object(
   }
 }
 
+void io_uring_service::close_descriptor(int descriptor)
+{
+  mutex::scoped_lock lock(mutex_);
+  if (::io_uring_sqe* sqe = get_sqe())
+  {
+    ::io_uring_prep_close(sqe, descriptor);
+    post_submit_sqes_op(lock);
+  }
+  else
+  {
+    lock.unlock();
+    ::close(descriptor);
+  }
+}
+
 void io_uring_service::run(long usec, op_queue<operation>& ops)
 {
   __kernel_timespec ts;
@@ -485,6 +501,7 @@ void io_uring_service::run(long usec, op_queue<operation>& ops)
         else
         {
           io_queue* io_q = static_cast<io_queue*>(ptr);
+          ASIO_USDT_PROBE2(io_uring__complete, io_q, cqe->res);
           io_q->set_result(cqe->res);
           ops.push(io_q);
         }
@@ -718,6 +735,7 @@ void io_uring_service::submit_sqes()
   if (pending_sqes_ != 0)
   {
     int result = ::io_uring_submit(&ring_);
+    ASIO_USDT_PROBE2(io_uring__submit, pending_sqes_, result);
     if (result > 0)
     {
       pending_sqes_ -= result;
@@ -19,6 +19,7 @@
 
 #if defined(ASIO_HAS_IO_URING)
 
+#include "asio/config.hpp"
 #include "asio/detail/io_uring_socket_service_base.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -28,7 +29,8 @@ namespace detail {
 
 io_uring_socket_service_base::io_uring_socket_service_base(
     execution_context& context)
-  : io_uring_service_(asio::use_service<io_uring_service>(context))
+  : io_uring_service_(asio::use_service<io_uring_service>(context)),
+    async_close_(asio::config(context).get("reactor", "async_close", false))
 {
   io_uring_service_.init_task();
 }
@@ -86,8 +88,27 @@ void io_uring_socket_service_base::destroy(
           "socket", &impl, impl.socket_, "close"));
 
     io_uring_service_.deregister_io_object(impl.io_object_data_);
-    asio::error_code ignored_ec;
-    socket_ops::close(impl.socket_, impl.state_, true, ignored_ec);
+    if (async_close_)
+    {
+      // As for socket_ops::close, don't block the closing thread waiting for
+      // unsent data to be transmitted.
+      if (impl.state_ & socket_ops::user_set_linger)
+      {
+        ::linger opt;
+        opt.l_onoff = 0;
+        opt.l_linger = 0;
+        asio::error_code ignored_ec;
+        socket_ops::setsockopt(impl.socket_, impl.state_,
+            SOL_SOCKET, SO_LINGER, &opt, sizeof(opt), ignored_ec);
+      }
+
+      io_uring_service_.close_descriptor(impl.socket_);
+    }
+    else
+    {
+      asio::error_code ignored_ec;
+      socket_ops::close(impl.socket_, impl.state_, true, ignored_ec);
+    }
     io_uring_service_.cleanup_io_object(impl.io_object_data_);
   }
 }
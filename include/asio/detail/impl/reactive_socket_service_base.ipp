@@ -32,6 +32,10 @@ namespace detail {
 reactive_socket_service_base::reactive_socket_service_base(
     execution_context& context)
   : reactor_(use_service<reactor>(context)),
+    scheduler_(use_service<scheduler>(context)),
+    close_service_(
+        asio::config(context).get("reactor", "async_close", false)
+        ? &use_service<socket_close_service>(context) : 0),
     extra_state_(
         asio::config(context).get(
           "reactor", "reset_edge_on_partial_read", 0)
@@ -92,11 +96,21 @@ void reactive_socket_service_base::destroy(
     ASIO_HANDLER_OPERATION((reactor_.context(),
           "socket", &impl, impl.socket_, "close"));
 
-    reactor_.deregister_descriptor(impl.socket_, impl.reactor_data_,
-        (impl.state_ & socket_ops::possible_dup) == 0);
+    if (close_service_)
+    {
+      // The descriptor remains open until the close service gets to it, so
+      // it must be explicitly removed from the reactor's interest set.
+      reactor_.deregister_descriptor(impl.socket_, impl.reactor_data_, false);
+      close_service_->close(impl.socket_, impl.state_);
+    }
+    else
+    {
+      reactor_.deregister_descriptor(impl.socket_, impl.reactor_data_,
+          (impl.state_ & socket_ops::possible_dup) == 0);
 
-    asio::error_code ignored_ec;
-    socket_ops::close(impl.socket_, impl.state_, true, ignored_ec);
+      asio::error_code ignored_ec;
+      socket_ops::close(impl.socket_, impl.state_, true, ignored_ec);
+    }
 
     reactor_.cleanup_descriptor_data(impl.reactor_data_);
   }
@@ -259,7 +273,15 @@ void reactive_socket_service_base::do_start_op(
 {
   if (!noop)
   {
-    if ((impl.state_ & socket_ops::non_blocking)
+    // Only receive operations are started speculatively on the read queue,
+    // so waits and accepts are not subject to the read limit.
+    if (op_type == reactor::read_op && allow_speculative
+        && !scheduler_.admit(admission_control::read_work,
+          is_continuation, op->admission_count_))
+    {
+      op->ec_ = asio::error::no_buffer_space;
+    }
+    else if ((impl.state_ & socket_ops::non_blocking)
         || !needs_non_blocking
         || socket_ops::set_internal_non_blocking(
           impl.socket_, impl.state_, true, op->ec_))
@@ -279,16 +301,25 @@ void reactive_socket_service_base::do_start_accept_op(
     void (*on_immediate)(operation* op, bool, const void*),
     const void* immediate_arg)
 {
-  if (!peer_is_open)
+  if (peer_is_open)
   {
-    do_start_op(impl, reactor::read_op, op, is_continuation,
-        true, false, true, on_immediate, immediate_arg);
+    op->ec_ = asio::error::already_open;
   }
-  else
+  else if (!scheduler_.admit(admission_control::accept_work,
+        is_continuation, op->admission_count_))
   {
-    op->ec_ = asio::error::already_open;
-    on_immediate(op, is_continuation, immediate_arg);
+    op->ec_ = asio::error::no_buffer_space;
+  }
+  else if ((impl.state_ & socket_ops::non_blocking)
+      || socket_ops::set_internal_non_blocking(
+        impl.socket_, impl.state_, true, op->ec_))
+  {
+    reactor_.start_op(reactor::read_op, impl.socket_, impl.reactor_data_,
+        op, is_continuation, true, on_immediate, immediate_arg);
+    return;
   }
+
+  on_immediate(op, is_continuation, immediate_arg);
 }
 
 void reactive_socket_service_base::do_start_connect_op(
@@ -17,12 +17,17 @@
 
 #include "asio/detail/config.hpp"
 
+#include <cstring>
+#include <stdexcept>
 #include "asio/config.hpp"
+#include "asio/error.hpp"
 #include "asio/detail/event.hpp"
 #include "asio/detail/limits.hpp"
 #include "asio/detail/scheduler.hpp"
 #include "asio/detail/scheduler_thread_info.hpp"
 #include "asio/detail/signal_blocker.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/detail/throw_exception.hpp"
 
 #if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
 # include "asio/detail/io_uring_service.hpp"
@@ -114,14 +119,28 @@ scheduler::scheduler(asio::execution_context& ctx,
     one_thread_(config(ctx).get("scheduler", "concurrency_hint", 0) == 1),
     mutex_(config(ctx).get("scheduler", "locking", true),
         config(ctx).get("scheduler", "locking_spin_count", 0)),
+    idle_threads_(0),
+    spinning_threads_(0),
     task_(0),
     get_task_(get_task),
     task_interrupted_(true),
     stopped_(false),
     shutdown_(false),
     outstanding_work_(0),
+    priority_op_count_(0),
+    priority_run_(0),
+    priority_burst_limit_(
+        config(ctx).get("scheduler", "priority_burst_limit", 64)),
     task_usec_(config(ctx).get("scheduler", "task_usec", -1L)),
     wait_usec_(config(ctx).get("scheduler", "wait_usec", -1L)),
+    idle_spin_threads_(config(ctx).get("scheduler", "idle_spin_threads", 0)),
+    idle_spin_count_(config(ctx).get("scheduler", "idle_spin_count", 0)),
+    admission_(config(ctx).get("admission", "handler_limit", 0L),
+        config(ctx).get("admission", "accept_limit", 0L),
+        config(ctx).get("admission", "read_limit", 0L),
+        config(ctx).get("admission", "enforce", true),
+        get_handler_policy(ctx),
+        config(ctx).get("scheduler", "locking", true)),
     thread_()
 {
   ASIO_HANDLER_TRACKING_INIT;
@@ -138,14 +157,22 @@ scheduler::scheduler(scheduler::internal, asio::execution_context& ctx)
   : asio::detail::execution_context_service_base<scheduler>(ctx),
     one_thread_(false),
     mutex_(true, 0),
+    idle_threads_(0),
+    spinning_threads_(0),
     task_(0),
     get_task_(&scheduler::get_default_task),
     task_interrupted_(true),
     stopped_(false),
     shutdown_(false),
     outstanding_work_(0),
+    priority_op_count_(0),
+    priority_run_(0),
+    priority_burst_limit_(64),
     task_usec_(-1L),
-    wait_usec_(-1L)
+    wait_usec_(-1L),
+    idle_spin_threads_(0),
+    idle_spin_count_(0),
+    admission_(0, 0, 0, true, admission_control::block_handlers, true)
 {
   ASIO_HANDLER_TRACKING_INIT;
 }
@@ -181,6 +208,16 @@ void scheduler::shutdown()
     if (o != &task_operation_)
       o->destroy();
   }
+  for (int i = 0; i < priority_lanes - 1; ++i)
+  {
+    while (!priority_op_queues_[i].empty())
+    {
+      operation* o = priority_op_queues_[i].front();
+      priority_op_queues_[i].pop();
+      o->destroy();
+    }
+  }
+  priority_op_count_ = 0;
 
   // Reset to initial state.
   task_ = 0;
@@ -206,8 +243,8 @@ std::size_t scheduler::run(asio::error_code& ec)
     return 0;
   }
 
+  admission_control::runner admission_runner(admission_);
   thread_info this_thread;
-  this_thread.private_outstanding_work = 0;
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
@@ -228,8 +265,8 @@ std::size_t scheduler::run_one(asio::error_code& ec)
     return 0;
   }
 
+  admission_control::runner admission_runner(admission_);
   thread_info this_thread;
-  this_thread.private_outstanding_work = 0;
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
@@ -246,8 +283,8 @@ std::size_t scheduler::wait_one(long usec, asio::error_code& ec)
     return 0;
   }
 
+  admission_control::runner admission_runner(admission_);
   thread_info this_thread;
-  this_thread.private_outstanding_work = 0;
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
@@ -264,8 +301,8 @@ std::size_t scheduler::poll(asio::error_code& ec)
     return 0;
   }
 
+  admission_control::runner admission_runner(admission_);
   thread_info this_thread;
-  this_thread.private_outstanding_work = 0;
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
@@ -295,8 +332,8 @@ std::size_t scheduler::poll_one(asio::error_code& ec)
     return 0;
   }
 
+  admission_control::runner admission_runner(admission_);
   thread_info this_thread;
-  this_thread.private_outstanding_work = 0;
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
@@ -343,6 +380,30 @@ bool scheduler::can_dispatch()
   return thread_call_stack::contains(this) != 0;
 }
 
+bool scheduler::can_dispatch(int priority)
+{
+  if (thread_info_base* this_thread = thread_call_stack::contains(this))
+    return priority <= static_cast<thread_info*>(this_thread)->current_priority;
+  return false;
+}
+
+bool scheduler::admit_limited_handler(
+    bool is_continuation, admission_control*& admission)
+{
+  // Threads that are running the scheduler are never made to wait, as doing
+  // so could prevent the queued function objects from being run.
+  switch (admission_.start_handler(is_continuation, !can_dispatch(), admission))
+  {
+  case admission_control::handler_rejected:
+    asio::detail::throw_error(asio::error::no_buffer_space, "admit_handler");
+    return false;
+  case admission_control::handler_shed:
+    return false;
+  default:
+    return true;
+  }
+}
+
 void scheduler::capture_current_exception()
 {
   if (thread_info_base* this_thread = thread_call_stack::contains(this))
@@ -396,6 +457,25 @@ void scheduler::post_immediate_completions(std::size_t n,
   wake_one_thread_and_unlock(lock);
 }
 
+void scheduler::post_prioritised_completion(
+    scheduler::operation* op, int priority)
+{
+  if (priority <= 0)
+  {
+    post_immediate_completion(op, false);
+    return;
+  }
+
+  if (priority >= priority_lanes)
+    priority = priority_lanes - 1;
+
+  work_started();
+  mutex::scoped_lock lock(mutex_);
+  priority_op_queues_[priority - 1].push(op);
+  ++priority_op_count_;
+  wake_one_thread_and_unlock(lock);
+}
+
 void scheduler::post_deferred_completion(scheduler::operation* op)
 {
 #if defined(ASIO_HAS_THREADS)
@@ -458,20 +538,20 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
 {
   while (!stopped_)
   {
-    if (!op_queue_.empty())
+    if (has_queued_operations())
     {
       // Prepare to execute first handler from queue.
-      operation* o = op_queue_.front();
-      op_queue_.pop();
-      bool more_handlers = (!op_queue_.empty());
+      op_queue<operation>& q = next_op_queue();
+      operation* o = q.front();
+      int priority = pop_op_queue(q);
+      bool more_handlers = has_queued_operations();
 
       if (o == &task_operation_)
       {
         task_interrupted_ = more_handlers || task_usec_ == 0;
 
-        if (more_handlers && !one_thread_ && wait_usec_ != 0)
-          wakeup_event_.unlock_and_signal_one(lock);
-        else
+        if (!more_handlers || one_thread_ || wait_usec_ == 0
+            || !maybe_wake_idle_thread_and_unlock(lock))
           lock.unlock();
 
         task_cleanup on_exit = { this, &lock, &this_thread };
@@ -497,6 +577,7 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
         (void)on_exit;
 
         // Complete the operation. May throw an exception. Deletes the object.
+        this_thread.current_priority = priority;
         o->complete(this, ec, task_result);
         this_thread.rethrow_pending_exception();
 
@@ -512,11 +593,7 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
       }
       else
       {
-        wakeup_event_.clear(lock);
-        if (wait_usec_ > 0)
-          wakeup_event_.wait_for_usec(lock, wait_usec_);
-        else
-          wakeup_event_.wait(lock);
+        wait_as_idle_thread(lock, this_thread, wait_usec_);
       }
     }
   }
@@ -531,27 +608,25 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
   if (stopped_)
     return 0;
 
-  operation* o = op_queue_.front();
-  if (o == 0)
+  if (!has_queued_operations())
   {
-    wakeup_event_.clear(lock);
     usec = (wait_usec_ >= 0 && wait_usec_ < usec) ? wait_usec_ : usec;
-    wakeup_event_.wait_for_usec(lock, usec);
+    wait_as_idle_thread(lock, this_thread, usec);
     usec = 0; // Wait at most once.
-    o = op_queue_.front();
   }
 
+  op_queue<operation>* q = &next_op_queue();
+  operation* o = q->front();
   if (o == &task_operation_)
   {
-    op_queue_.pop();
-    bool more_handlers = (!op_queue_.empty());
+    pop_op_queue(*q);
+    bool more_handlers = has_queued_operations();
 
     usec = (task_usec_ >= 0 && task_usec_ < usec) ? task_usec_ : usec;
     task_interrupted_ = more_handlers || usec == 0;
 
-    if (more_handlers && !one_thread_ && wait_usec_ != 0)
-      wakeup_event_.unlock_and_signal_one(lock);
-    else
+    if (!more_handlers || one_thread_ || wait_usec_ == 0
+        || !maybe_wake_idle_thread_and_unlock(lock))
       lock.unlock();
 
     {
@@ -564,11 +639,12 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
       task_->run(more_handlers ? 0 : usec, this_thread.private_op_queue);
     }
 
-    o = op_queue_.front();
+    q = &next_op_queue();
+    o = q->front();
     if (o == &task_operation_)
     {
       if (!one_thread_)
-        wakeup_event_.maybe_unlock_and_signal_one(lock);
+        maybe_wake_idle_thread_and_unlock(lock);
       return 0;
     }
   }
@@ -576,8 +652,8 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
   if (o == 0)
     return 0;
 
-  op_queue_.pop();
-  bool more_handlers = (!op_queue_.empty());
+  int priority = pop_op_queue(*q);
+  bool more_handlers = has_queued_operations();
 
   std::size_t task_result = o->task_result_;
 
@@ -591,6 +667,7 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
   (void)on_exit;
 
   // Complete the operation. May throw an exception. Deletes the object.
+  this_thread.current_priority = priority;
   o->complete(this, ec, task_result);
   this_thread.rethrow_pending_exception();
 
@@ -604,10 +681,11 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   if (stopped_)
     return 0;
 
-  operation* o = op_queue_.front();
+  op_queue<operation>* q = &next_op_queue();
+  operation* o = q->front();
   if (o == &task_operation_)
   {
-    op_queue_.pop();
+    pop_op_queue(*q);
     lock.unlock();
 
     {
@@ -620,10 +698,11 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
       task_->run(0, this_thread.private_op_queue);
     }
 
-    o = op_queue_.front();
+    q = &next_op_queue();
+    o = q->front();
     if (o == &task_operation_)
     {
-      wakeup_event_.maybe_unlock_and_signal_one(lock);
+      maybe_wake_idle_thread_and_unlock(lock);
       return 0;
     }
   }
@@ -631,8 +710,8 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   if (o == 0)
     return 0;
 
-  op_queue_.pop();
-  bool more_handlers = (!op_queue_.empty());
+  int priority = pop_op_queue(*q);
+  bool more_handlers = has_queued_operations();
 
   std::size_t task_result = o->task_result_;
 
@@ -646,17 +725,58 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   (void)on_exit;
 
   // Complete the operation. May throw an exception. Deletes the object.
+  this_thread.current_priority = priority;
   o->complete(this, ec, task_result);
   this_thread.rethrow_pending_exception();
 
   return 1;
 }
 
+op_queue<scheduler::operation>& scheduler::next_op_queue()
+{
+  if (priority_op_count_ == 0)
+    return op_queue_;
+
+  // Allow normal priority work, including the task, to make progress after a
+  // sustained run of elevated priority handlers.
+  if (priority_burst_limit_ > 0 && priority_run_ >= priority_burst_limit_)
+    if (!op_queue_.empty())
+      return op_queue_;
+
+  for (int i = priority_lanes - 2; i >= 0; --i)
+    if (!priority_op_queues_[i].empty())
+      return priority_op_queues_[i];
+
+  return op_queue_;
+}
+
+int scheduler::pop_op_queue(op_queue<scheduler::operation>& q)
+{
+  q.pop();
+  if (&q == &op_queue_)
+  {
+    priority_run_ = 0;
+    return 0;
+  }
+
+  --priority_op_count_;
+  ++priority_run_;
+  return static_cast<int>(&q - priority_op_queues_) + 1;
+}
+
 void scheduler::stop_all_threads(
     mutex::scoped_lock& lock)
 {
   stopped_ = true;
-  wakeup_event_.signal_all(lock);
+
+  while (thread_info* idle_thread = idle_threads_)
+  {
+    idle_threads_ = idle_thread->next_idle_thread;
+    idle_thread->next_idle_thread = 0;
+    idle_thread->idle = false;
+    ref_count_up_release(idle_thread->wakeup_pending);
+    idle_thread->wakeup_event.signal_all(lock);
+  }
 
   if (!task_interrupted_ && task_)
   {
@@ -668,7 +788,7 @@ void scheduler::stop_all_threads(
 void scheduler::wake_one_thread_and_unlock(
     mutex::scoped_lock& lock)
 {
-  if (wait_usec_ == 0 || !wakeup_event_.maybe_unlock_and_signal_one(lock))
+  if (wait_usec_ == 0 || !maybe_wake_idle_thread_and_unlock(lock))
   {
     if (!task_interrupted_ && task_)
     {
@@ -679,6 +799,85 @@ void scheduler::wake_one_thread_and_unlock(
   }
 }
 
+bool scheduler::maybe_wake_idle_thread_and_unlock(
+    mutex::scoped_lock& lock)
+{
+  if (mutex_.enabled())
+  {
+    if (thread_info* idle_thread = idle_threads_)
+    {
+      idle_threads_ = idle_thread->next_idle_thread;
+      idle_thread->next_idle_thread = 0;
+      idle_thread->idle = false;
+      ref_count_up_release(idle_thread->wakeup_pending);
+      idle_thread->wakeup_event.unlock_and_signal_one(lock);
+      return true;
+    }
+  }
+  return false;
+}
+
+void scheduler::wait_as_idle_thread(mutex::scoped_lock& lock,
+    scheduler::thread_info& this_thread, long usec)
+{
+  this_thread.wakeup_event.clear(lock);
+  this_thread.wakeup_pending = 0;
+  this_thread.next_idle_thread = idle_threads_;
+  this_thread.idle = true;
+  idle_threads_ = &this_thread;
+
+#if defined(ASIO_HAS_THREADS)
+  // Spin for a while before blocking, so that a thread woken shortly after
+  // becoming idle does not need to pay for a system call.
+  if (usec != 0 && spinning_threads_ < idle_spin_threads_)
+  {
+    ++spinning_threads_;
+    lock.unlock();
+    for (int n = idle_spin_count_; n > 0; --n)
+      if (ref_count_read_acquire(this_thread.wakeup_pending))
+        break;
+    lock.lock();
+    --spinning_threads_;
+  }
+#endif // defined(ASIO_HAS_THREADS)
+
+  if (this_thread.idle)
+  {
+    if (usec > 0)
+      this_thread.wakeup_event.wait_for_usec(lock, usec);
+    else if (usec < 0)
+      this_thread.wakeup_event.wait(lock);
+  }
+
+  // If we were not explicitly woken (e.g. due to a timeout), we are still on
+  // the idle thread stack and must remove ourselves.
+  if (this_thread.idle)
+  {
+    thread_info** p = &idle_threads_;
+    while (*p != &this_thread)
+      p = &(*p)->next_idle_thread;
+    *p = this_thread.next_idle_thread;
+    this_thread.next_idle_thread = 0;
+    this_thread.idle = false;
+  }
+}
+
+admission_control::handler_policy scheduler::get_handler_policy(
+    execution_context& ctx)
+{
+  char buf[16];
+  const char* policy = use_service<config_service>(ctx).get_value(
+      "admission", "handler_policy", buf, sizeof(buf));
+  if (policy == 0 || std::strcmp(policy, "block") == 0)
+    return admission_control::block_handlers;
+  else if (std::strcmp(policy, "reject") == 0)
+    return admission_control::reject_handlers;
+  else if (std::strcmp(policy, "shed") == 0)
+    return admission_control::shed_handlers;
+  detail::throw_exception(std::out_of_range("config out of range"));
+  return admission_control::block_handlers;
+}
+
 scheduler_task* scheduler::get_default_task(asio::execution_context& ctx)
 {
 #if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
@@ -0,0 +1,161 @@
+//
+// detail/impl/socket_close_service.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_SOCKET_CLOSE_SERVICE_IPP
+#define ASIO_DETAIL_IMPL_SOCKET_CLOSE_SERVICE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/socket_close_service.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class socket_close_service::close_thread_function
+{
+public:
+  explicit close_thread_function(socket_close_service* service)
+    : service_(service)
+  {
+  }
+
+  void operator()()
+  {
+    service_->run();
+  }
+
+private:
+  socket_close_service* service_;
+};
+
+socket_close_service::socket_close_service(execution_context& context)
+  : execution_context_service_base<socket_close_service>(context),
+    stopped_(false),
+    shutdown_(false)
+{
+  start_thread();
+}
+
+socket_close_service::~socket_close_service()
+{
+  shutdown();
+}
+
+void socket_close_service::shutdown()
+{
+  stop_thread();
+
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  shutdown_ = true;
+}
+
+void socket_close_service::notify_fork(execution_context::fork_event fork_ev)
+{
+  if (fork_ev == execution_context::fork_prepare)
+    stop_thread();
+  else
+    start_thread();
+}
+
+void socket_close_service::close(socket_type s, socket_ops::state_type state)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+
+  if (shutdown_ || !thread_.get())
+  {
+    lock.unlock();
+    asio::error_code ignored_ec;
+    socket_ops::close(s, state, true, ignored_ec);
+    return;
+  }
+
+  pending_close p = { s, state };
+  pending_.push_back(p);
+
+  // Only the first socket queued in a batch needs to wake the thread.
+  if (pending_.size() == 1)
+    event_.unlock_and_signal_one(lock);
+}
+
+void socket_close_service::run()
+{
+  std::vector<pending_close> batch;
+
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  for (;;)
+  {
+    while (pending_.empty() && !stopped_)
+    {
+      event_.clear(lock);
+      event_.wait(lock);
+    }
+
+    if (pending_.empty())
+      return;
+
+    batch.swap(pending_);
+    lock.unlock();
+    close_all(batch);
+    batch.clear();
+    lock.lock();
+  }
+}
+
+void socket_close_service::start_thread()
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  if (!thread_.get() && !shutdown_)
+  {
+    stopped_ = false;
+    thread_.reset(new asio::detail::thread(close_thread_function(this)));
+  }
+}
+
+void socket_close_service::stop_thread()
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  if (thread_.get())
+  {
+    stopped_ = true;
+    event_.signal(lock);
+    lock.unlock();
+    thread_->join();
+    lock.lock();
+    thread_.reset();
+  }
+
+  // Close anything queued after the thread finished.
+  std::vector<pending_close> batch;
+  batch.swap(pending_);
+  lock.unlock();
+  close_all(batch);
+}
+
+void socket_close_service::close_all(std::vector<pending_close>& batch)
+{
+  for (std::size_t i = 0; i < batch.size(); ++i)
+  {
+    asio::error_code ignored_ec;
+    socket_ops::close(batch[i].socket_, batch[i].state_, true, ignored_ec);
+  }
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_IMPL_SOCKET_CLOSE_SERVICE_IPP
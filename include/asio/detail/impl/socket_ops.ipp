@@ -1654,6 +1654,19 @@ bool non_blocking_send1(socket_type s,
   }
 }
 
+#if defined(ASIO_HAS_MSG_MORE)
+
+void uncork(socket_type s)
+{
+  // Clearing TCP_CORK pushes any pending frames, whereas an empty send does
+  // not. Failure is ignored, as the socket need not be a TCP socket.
+  int optval = 0;
+  ::setsockopt(s, IPPROTO_TCP, TCP_CORK,
+      &optval, static_cast<socklen_t>(sizeof(optval)));
+}
+
+#endif // defined(ASIO_HAS_MSG_MORE)
+
 #endif // defined(ASIO_HAS_IOCP)
 
 signed_size_type sendto(socket_type s, const buf* bufs,
@@ -17,6 +17,8 @@
 
 #include "asio/detail/config.hpp"
 #include "asio/detail/strand_executor_service.hpp"
+#include "asio/detail/usdt_probes.hpp"
+#include "asio/config.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -27,7 +29,9 @@ strand_executor_service::strand_executor_service(execution_context& ctx)
   : execution_context_service_base<strand_executor_service>(ctx),
     mutex_(),
     salt_(0),
-    impl_list_(0)
+    impl_list_(0),
+    max_handlers_per_turn_(
+        config(ctx).get("strand", "max_handlers_per_turn", 0U))
 {
 }
 
@@ -108,6 +112,7 @@ bool strand_executor_service::enqueue(const implementation_type& impl,
     // Some other function already holds the strand lock. Enqueue for later.
     impl->waiting_queue_.push(op);
     impl->mutex_->unlock();
+    ASIO_USDT_PROBE3(strand__enqueue, impl.get(), op, 1);
     return false;
   }
   else
@@ -117,6 +122,7 @@ bool strand_executor_service::enqueue(const implementation_type& impl,
     impl->locked_ = true;
     impl->mutex_->unlock();
     impl->ready_queue_.push(op);
+    ASIO_USDT_PROBE3(strand__enqueue, impl.get(), op, 0);
     return true;
   }
 }
@@ -141,11 +147,17 @@ void strand_executor_service::run_ready_handlers(implementation_type& impl)
   // Indicate that this strand is executing on the current thread.
   call_stack<strand_impl>::context ctx(impl.get());
 
-  // Run all ready handlers. No lock is required since the ready queue is
-  // accessed only within the strand.
+  // Run the ready handlers. No lock is required since the ready queue is
+  // accessed only within the strand. Any handlers left over once the per-turn
+  // limit is reached remain at the front of the ready queue, and the strand
+  // is rescheduled behind other pending work by the invoker's exit handler.
   asio::error_code ec;
-  while (scheduler_operation* o = impl->ready_queue_.front())
+  std::size_t limit = impl->service_->max_handlers_per_turn_;
+  for (std::size_t n = 0; limit == 0 || n < limit; ++n)
   {
+    scheduler_operation* o = impl->ready_queue_.front();
+    if (!o)
+      break;
     impl->ready_queue_.pop();
     o->complete(impl.get(), ec, 0);
   }
@@ -27,7 +27,8 @@ namespace detail {
 
 inline strand_service::strand_impl::strand_impl()
   : operation(&strand_service::do_complete),
-    locked_(false)
+    locked_(false),
+    max_handlers_per_turn_(0)
 {
 }
 
@@ -18,6 +18,8 @@
 #include "asio/detail/config.hpp"
 #include "asio/detail/call_stack.hpp"
 #include "asio/detail/strand_service.hpp"
+#include "asio/detail/usdt_probes.hpp"
+#include "asio/config.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -46,7 +48,9 @@ strand_service::strand_service(asio::io_context& io_context)
     io_context_(io_context),
     io_context_impl_(asio::use_service<io_context_impl>(io_context)),
     mutex_(),
-    salt_(0)
+    salt_(0),
+    max_handlers_per_turn_(
+        config(io_context).get("strand", "max_handlers_per_turn", 0U))
 {
 }
 
@@ -84,6 +88,7 @@ void strand_service::construct(strand_service::implementation_type& impl)
   {
     execution_context::allocator<void> alloc(context());
     implementations_[index] = allocate_shared<strand_impl>(alloc);
+    implementations_[index]->max_handlers_per_turn_ = max_handlers_per_turn_;
   }
   impl = implementations_[index].get();
 }
@@ -139,6 +144,7 @@ void strand_service::do_dispatch(implementation_type& impl, operation* op)
     // Some other handler already holds the strand lock. Enqueue for later.
     impl->waiting_queue_.push(op);
     impl->mutex_.unlock();
+    ASIO_USDT_PROBE3(strand__enqueue, impl, op, 1);
   }
   else
   {
@@ -147,6 +153,7 @@ void strand_service::do_dispatch(implementation_type& impl, operation* op)
     impl->locked_ = true;
     impl->mutex_.unlock();
     impl->ready_queue_.push(op);
+    ASIO_USDT_PROBE3(strand__enqueue, impl, op, 0);
     io_context_impl_.post_immediate_completion(impl, false);
   }
 }
@@ -160,6 +167,7 @@ void strand_service::do_post(implementation_type& impl,
     // Some other handler already holds the strand lock. Enqueue for later.
     impl->waiting_queue_.push(op);
     impl->mutex_.unlock();
+    ASIO_USDT_PROBE3(strand__enqueue, impl, op, 1);
   }
   else
   {
@@ -168,6 +176,7 @@ void strand_service::do_post(implementation_type& impl,
     impl->locked_ = true;
     impl->mutex_.unlock();
     impl->ready_queue_.push(op);
+    ASIO_USDT_PROBE3(strand__enqueue, impl, op, 0);
     io_context_impl_.post_immediate_completion(impl, is_continuation);
   }
 }
@@ -187,10 +196,15 @@ void strand_service::do_complete(void* owner, operation* base,
     on_exit.owner_ = static_cast<io_context_impl*>(owner);
     on_exit.impl_ = impl;
 
-    // Run all ready handlers. No lock is required since the ready queue is
-    // accessed only within the strand.
-    while (operation* o = impl->ready_queue_.front())
+    // Run the ready handlers. No lock is required since the ready queue is
+    // accessed only within the strand. Handlers left over once the per-turn
+    // limit is reached are run when the strand is next scheduled.
+    std::size_t limit = impl->max_handlers_per_turn_;
+    for (std::size_t n = 0; limit == 0 || n < limit; ++n)
     {
+      operation* o = impl->ready_queue_.front();
+      if (!o)
+        break;
       impl->ready_queue_.pop();
       o->complete(owner, ec, 0);
     }
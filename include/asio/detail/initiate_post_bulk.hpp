@@ -0,0 +1,220 @@
+//
+// detail/initiate_post_bulk.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_INITIATE_POST_BULK_HPP
+#define ASIO_DETAIL_INITIATE_POST_BULK_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include "asio/associated_allocator.hpp"
+#include "asio/associated_executor.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/thread.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/execution/allocator.hpp"
+#include "asio/execution/blocking.hpp"
+#include "asio/execution/outstanding_work.hpp"
+#include "asio/execution/relationship.hpp"
+#include "asio/prefer.hpp"
+#include "asio/require.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Calculate the number of indices claimed by a worker at a time. The aim is
+// to keep the number of atomic operations low, while still leaving enough
+// chunks for the work to be balanced across the available threads.
+inline std::size_t post_bulk_grain_size(std::size_t n)
+{
+  std::size_t threads = thread::hardware_concurrency();
+  std::size_t chunks = (threads ? threads : 1) * 8;
+  return n > chunks ? n / chunks : 1;
+}
+
+// The state shared by all workers of a single post_bulk operation. This is the
+// only allocation performed for the operation, other than the small function
+// objects submitted to the executor.
+template <typename Executor, typename Function,
+    typename Handler, typename HandlerExecutor>
+class post_bulk_state
+{
+public:
+  template <typename F, typename H>
+  post_bulk_state(const Executor& ex, std::size_t n, F&& f,
+      H&& handler, const HandlerExecutor& handler_ex)
+    : executor_(ex),
+      function_(static_cast<F&&>(f)),
+      count_(n),
+      grain_(post_bulk_grain_size(n)),
+      next_(0),
+      remaining_(n),
+      handler_(static_cast<H&&>(handler)),
+      allocator_((get_associated_allocator)(handler_)),
+      handler_executor_(asio::prefer(handler_ex,
+          execution::outstanding_work.tracked))
+  {
+  }
+
+  // Submit a worker to the target executor. The handler's allocator is copied
+  // on construction, as workers may still be submitting while the handler is
+  // being moved out for completion.
+  static void post_worker(const shared_ptr<post_bulk_state>& self)
+  {
+    asio::prefer(
+        asio::require(self->executor_, execution::blocking.never),
+        execution::relationship.fork,
+        execution::allocator(self->allocator_)
+      ).execute(worker(self));
+  }
+
+private:
+  class worker
+  {
+  public:
+    explicit worker(const shared_ptr<post_bulk_state>& state)
+      : state_(state)
+    {
+    }
+
+    void operator()()
+    {
+      post_bulk_state* s = state_.get();
+
+      // If any indices are still unclaimed, submit one more worker so that
+      // another thread can share in the remaining work. Each worker fans out
+      // at most once, so the number of queued workers stays small.
+      if (s->next_.load(std::memory_order_relaxed) < s->count_)
+        post_worker(state_);
+
+      for (;;)
+      {
+        std::size_t begin = s->next_.fetch_add(
+            s->grain_, std::memory_order_relaxed);
+        if (begin >= s->count_)
+          return;
+
+        std::size_t end = begin + s->grain_;
+        if (end > s->count_)
+          end = s->count_;
+
+        for (std::size_t i = begin; i < end; ++i)
+          s->function_(i);
+
+        if (s->remaining_.fetch_sub(end - begin,
+              std::memory_order_acq_rel) == end - begin)
+        {
+          s->complete();
+          return;
+        }
+      }
+    }
+
+  private:
+    shared_ptr<post_bulk_state> state_;
+  };
+
+  // Submit the completion handler to its associated executor.
+  void complete()
+  {
+    asio::prefer(handler_executor_, execution::allocator(allocator_)).execute(
+        asio::detail::bind_handler(static_cast<Handler&&>(handler_)));
+  }
+
+  typedef decay_t<
+      prefer_result_t<const HandlerExecutor&,
+        execution::outstanding_work_t::tracked_t
+      >
+    > handler_work_executor_type;
+
+  Executor executor_;
+  Function function_;
+  const std::size_t count_;
+  const std::size_t grain_;
+  std::atomic<std::size_t> next_;
+  std::atomic<std::size_t> remaining_;
+  Handler handler_;
+  associated_allocator_t<Handler> allocator_;
+  handler_work_executor_type handler_executor_;
+};
+
+template <typename Executor>
+class initiate_post_bulk_with_executor
+{
+public:
+  typedef Executor executor_type;
+
+  explicit initiate_post_bulk_with_executor(const Executor& ex)
+    : ex_(ex)
+  {
+  }
+
+  executor_type get_executor() const noexcept
+  {
+    return ex_;
+  }
+
+  template <typename CompletionHandler, typename Function>
+  void operator()(CompletionHandler&& handler,
+      std::size_t n, Function&& function) const
+  {
+    typedef decay_t<CompletionHandler> handler_t;
+    typedef decay_t<Function> function_t;
+
+    typedef associated_executor_t<handler_t, Executor> handler_ex_t;
+    handler_ex_t handler_ex((get_associated_executor)(handler, ex_));
+
+    associated_allocator_t<handler_t> alloc(
+        (get_associated_allocator)(handler));
+
+    if (n == 0)
+    {
+      asio::prefer(
+          asio::require(handler_ex, execution::blocking.never),
+          execution::relationship.fork,
+          execution::allocator(alloc)
+        ).execute(
+          asio::detail::bind_handler(
+            static_cast<CompletionHandler&&>(handler)));
+      return;
+    }
+
+    typedef post_bulk_state<Executor,
+        function_t, handler_t, handler_ex_t> state_type;
+
+    typedef typename std::allocator_traits<
+        associated_allocator_t<handler_t>>::template rebind_alloc<state_type>
+      state_allocator_type;
+
+    shared_ptr<state_type> state = allocate_shared<state_type>(
+        state_allocator_type(alloc), ex_, n,
+        static_cast<Function&&>(function),
+        static_cast<CompletionHandler&&>(handler), handler_ex);
+
+    state_type::post_worker(state);
+  }
+
+private:
+  Executor ex_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_INITIATE_POST_BULK_HPP
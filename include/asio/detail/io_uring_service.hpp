@@ -142,6 +142,10 @@ public:
   // object.
   ASIO_DECL void cleanup_io_object(per_io_object_data& io_obj);
 
+  // Close a descriptor asynchronously. The close is submitted along with the
+  // next batch of submission queue entries and its completion is ignored.
+  ASIO_DECL void close_descriptor(int descriptor);
+
   // Add a new timer queue to the reactor.
   template <typename TimeTraits, typename Allocator>
   void add_timer_queue(timer_queue<TimeTraits, Allocator>& timer_queue);
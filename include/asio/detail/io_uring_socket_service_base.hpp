@@ -166,6 +166,20 @@ public:
     return ec;
   }
 
+  // Gets whether queued asynchronous sends are coalesced.
+  bool auto_cork(const base_implementation_type&) const
+  {
+    return false;
+  }
+
+  // Sets whether queued asynchronous sends are coalesced.
+  asio::error_code auto_cork(base_implementation_type&,
+      bool, asio::error_code& ec)
+  {
+    ec = asio::error::operation_not_supported;
+    return ec;
+  }
+
   // Wait for the socket to become ready to read, ready to write, or to have
   // pending error conditions.
   asio::error_code wait(base_implementation_type& impl,
@@ -645,6 +659,9 @@ protected:
   // The io_uring_service that performs event demultiplexing for the service.
   io_uring_service& io_uring_service_;
 
+  // Whether sockets are closed asynchronously on destruction.
+  const bool async_close_;
+
   // Cached success value to avoid accessing category singleton.
   const asio::error_code success_ec_;
 };
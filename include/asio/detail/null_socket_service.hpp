@@ -203,6 +203,20 @@ public:
     return ec;
   }
 
+  // Gets whether queued asynchronous sends are coalesced.
+  bool auto_cork(const implementation_type&) const
+  {
+    return false;
+  }
+
+  // Sets whether queued asynchronous sends are coalesced.
+  asio::error_code auto_cork(implementation_type&,
+      bool, asio::error_code& ec)
+  {
+    ec = asio::error::operation_not_supported;
+    return ec;
+  }
+
   // Disable sends or receives on the socket.
   asio::error_code shutdown(implementation_type&,
       socket_base::shutdown_type, asio::error_code& ec)
@@ -56,12 +56,19 @@ public:
     typedef buffer_sequence_adapter<asio::const_buffer,
         ConstBufferSequence> bufs_type;
 
+    socket_base::message_flags flags = o->flags_;
+#if defined(ASIO_HAS_MSG_MORE)
+    // Hold back a partial segment while another send is queued behind this one.
+    if (o->more_queued_)
+      flags |= MSG_MORE;
+#endif // defined(ASIO_HAS_MSG_MORE)
+
     status result;
     if (bufs_type::is_single_buffer)
     {
       result = socket_ops::non_blocking_send1(o->socket_,
           bufs_type::first(o->buffers_).data(),
-          bufs_type::first(o->buffers_).size(), o->flags_,
+          bufs_type::first(o->buffers_).size(), flags,
           o->ec_, o->bytes_transferred_) ? done : not_done;
 
       if (result == done)
@@ -73,7 +80,7 @@ public:
     {
       bufs_type bufs(o->buffers_);
       result = socket_ops::non_blocking_send(o->socket_,
-            bufs.buffers(), bufs.count(), o->flags_,
+            bufs.buffers(), bufs.count(), flags,
             o->ec_, o->bytes_transferred_) ? done : not_done;
 
       if (result == done)
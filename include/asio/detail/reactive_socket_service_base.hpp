@@ -36,6 +36,8 @@
 #include "asio/detail/reactive_wait_op.hpp"
 #include "asio/detail/reactor.hpp"
 #include "asio/detail/reactor_op.hpp"
+#include "asio/detail/scheduler.hpp"
+#include "asio/detail/socket_close_service.hpp"
 #include "asio/detail/socket_holder.hpp"
 #include "asio/detail/socket_ops.hpp"
 #include "asio/detail/socket_types.hpp"
@@ -169,6 +171,35 @@ public:
     return ec;
   }
 
+  // Gets whether queued asynchronous sends are coalesced.
+  bool auto_cork(const base_implementation_type& impl) const
+  {
+    return (impl.state_ & socket_ops::auto_cork) != 0;
+  }
+
+  // Sets whether queued asynchronous sends are coalesced.
+  asio::error_code auto_cork(base_implementation_type& impl,
+      bool mode, asio::error_code& ec)
+  {
+    if (!is_open(impl))
+    {
+      ec = asio::error::bad_descriptor;
+      return ec;
+    }
+
+#if defined(ASIO_HAS_MSG_MORE)
+    if (mode)
+      impl.state_ |= socket_ops::auto_cork;
+    else
+      impl.state_ &= ~socket_ops::auto_cork;
+    ec = success_ec_;
+#else // defined(ASIO_HAS_MSG_MORE)
+    (void)mode;
+    ec = asio::error::operation_not_supported;
+#endif // defined(ASIO_HAS_MSG_MORE)
+    return ec;
+  }
+
   // Wait for the socket to become ready to read, ready to write, or to have
   // pending error conditions.
   asio::error_code wait(base_implementation_type& impl,
@@ -300,6 +331,7 @@ public:
       op::ptr::allocate(handler), 0 };
     p.p = new (p.v) op(success_ec_, impl.socket_,
         impl.state_, buffers, flags, handler, io_ex);
+    p.p->corkable_ = (impl.state_ & socket_ops::auto_cork) != 0;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
@@ -312,7 +344,10 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_send"));
 
-    start_op(impl, reactor::write_op, p.p, is_continuation, true,
+    // In auto-cork mode the send is always left to the reactor, so that sends
+    // started together are queued together and may be coalesced.
+    start_op(impl, reactor::write_op, p.p, is_continuation,
+        (impl.state_ & socket_ops::auto_cork) == 0,
         ((impl.state_ & socket_ops::stream_oriented)
           && buffer_sequence_adapter<asio::const_buffer,
             ConstBufferSequence>::all_empty(buffers)), true, &io_ex, 0);
@@ -735,6 +770,12 @@ protected:
   // The selector that performs event demultiplexing for the service.
   reactor& reactor_;
 
+  // The scheduler used to apply admission control to new operations.
+  scheduler& scheduler_;
+
+  // The service used to close sockets on destruction, if enabled.
+  socket_close_service* close_service_;
+
   // Cached success value to avoid accessing category singleton.
   const asio::error_code success_ec_;
 
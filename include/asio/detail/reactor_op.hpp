@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/detail/atomic_count.hpp"
 #include "asio/detail/operation.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -36,6 +37,20 @@ public:
   // The number of bytes transferred, to be passed to the completion handler.
   std::size_t bytes_transferred_;
 
+  // The count of in-flight operations that was incremented when the operation
+  // was admitted, if any. The count is decremented when the operation is
+  // destroyed.
+  atomic_count* admission_count_;
+
+  // Whether the operation is a send on an auto-corked socket, which may be
+  // coalesced with the corkable sends queued behind it.
+  bool corkable_;
+
+  // Whether the operation is corkable and is followed in its queue by another
+  // corkable operation. Set by the reactor before the operation is performed
+  // from its queue.
+  bool more_queued_;
+
   // Status returned by perform function. May be used to decide whether it is
   // worth performing more operations on the descriptor immediately.
   enum status { not_done, done, done_and_exhausted };
@@ -46,6 +61,13 @@ public:
     return perform_func_(this);
   }
 
+  // Determine whether the operation may be coalesced with the one that
+  // follows it in its queue.
+  static bool more_queued(reactor_op* op, reactor_op* next)
+  {
+    return op->corkable_ && next && next->corkable_;
+  }
+
 protected:
   typedef status (*perform_func_type)(reactor_op*);
 
@@ -55,10 +77,19 @@ protected:
       ec_(success_ec),
       cancellation_key_(0),
       bytes_transferred_(0),
+      admission_count_(0),
+      corkable_(false),
+      more_queued_(false),
       perform_func_(perform_func)
   {
   }
 
+  ~reactor_op()
+  {
+    if (admission_count_)
+      decrement(*admission_count_, 1);
+  }
+
 private:
   perform_func_type perform_func_;
 };
@@ -20,6 +20,7 @@
 #include "asio/detail/noncopyable.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_ops.hpp"
 #include "asio/error.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -163,18 +164,24 @@ public:
   {
     if (i != operations_.end())
     {
+      bool corked = false;
       while (reactor_op* op = i->second.front())
       {
+        op->more_queued_ = reactor_op::more_queued(
+            op, op_queue_access::next(op));
         if (op->perform())
         {
+          corked = op->more_queued_;
           i->second.pop();
           ops.push(op);
         }
         else
         {
+          uncork(i->first, corked);
           return true;
         }
       }
+      uncork(i->first, corked);
       operations_.erase(i);
     }
     return false;
@@ -200,6 +207,18 @@ public:
   }
 
 private:
+  // Push out the data held back by a send that was not followed by another.
+  static void uncork(Descriptor descriptor, bool corked)
+  {
+#if defined(ASIO_HAS_MSG_MORE)
+    if (corked)
+      socket_ops::uncork(descriptor);
+#else // defined(ASIO_HAS_MSG_MORE)
+    (void)descriptor;
+    (void)corked;
+#endif // defined(ASIO_HAS_MSG_MORE)
+  }
+
   // The operations that are currently executing asynchronously.
   hash_map<key_type, mapped_type> operations_;
 };
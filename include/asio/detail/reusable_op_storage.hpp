@@ -0,0 +1,149 @@
+//
+// detail/reusable_op_storage.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REUSABLE_OP_STORAGE_HPP
+#define ASIO_DETAIL_REUSABLE_OP_STORAGE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <functional>
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Holds on to the memory of a single operation between the iterations of a
+// composed operation, such as async_write, that repeatedly starts operations
+// of the same type. The memory is kept only while the composed operation's
+// handler is in transit and is always returned to the handler's associated
+// allocator before the composed operation completes.
+class reusable_op_storage
+{
+public:
+  // The function used to return the memory to the associated allocator of the
+  // handler that owns the storage.
+  typedef void (*deallocate_function)(void* block, void* owner);
+
+  reusable_op_storage() noexcept
+    : block_(0),
+      size_(0),
+      align_(0),
+      deallocate_(0)
+  {
+  }
+
+  // Copies of a handler start without any memory of their own.
+  reusable_op_storage(const reusable_op_storage&) noexcept
+    : block_(0),
+      size_(0),
+      align_(0),
+      deallocate_(0)
+  {
+  }
+
+  reusable_op_storage(reusable_op_storage&& other) noexcept
+    : block_(other.block_),
+      size_(other.size_),
+      align_(other.align_),
+      deallocate_(other.deallocate_)
+  {
+    other.block_ = 0;
+  }
+
+  // Take the stored memory, if it matches the required size and alignment.
+  void* take(std::size_t size, std::size_t align) noexcept
+  {
+    if (block_ && size_ == size && align_ == align)
+    {
+      void* block = block_;
+      block_ = 0;
+      return block;
+    }
+    return 0;
+  }
+
+  // Store the memory of a completed operation, if there is space for it.
+  bool keep(void* block, std::size_t size,
+      std::size_t align, deallocate_function deallocate) noexcept
+  {
+    if (block_)
+      return false;
+
+    // The memory must not be kept by a handler that lives inside that same
+    // memory. This happens when an operation is destroyed without having been
+    // invoked, at which point the handler has already been destroyed.
+    std::less<const char*> less;
+    const char* begin = static_cast<const char*>(block);
+    const char* self = reinterpret_cast<const char*>(this);
+    if (!less(self, begin) && less(self, begin + size))
+      return false;
+
+    block_ = block;
+    size_ = size;
+    align_ = align;
+    deallocate_ = deallocate;
+    return true;
+  }
+
+  // Return any stored memory to the allocator associated with the owner.
+  void release(void* owner)
+  {
+    if (block_)
+    {
+      void* block = block_;
+      block_ = 0;
+      deallocate_(block, owner);
+    }
+  }
+
+private:
+  reusable_op_storage& operator=(const reusable_op_storage&);
+
+  void* block_;
+  std::size_t size_;
+  std::size_t align_;
+  deallocate_function deallocate_;
+};
+
+// Handlers that own reusable storage provide an overload of this function,
+// found by argument-dependent lookup, that returns a pointer to the storage.
+inline reusable_op_storage* get_reusable_op_storage(const void*)
+{
+  return 0;
+}
+
+template <typename Handler>
+inline void* take_reusable_op_storage(Handler* h,
+    std::size_t size, std::size_t align) noexcept
+{
+  reusable_op_storage* storage = get_reusable_op_storage(h);
+  return storage ? storage->take(size, align) : 0;
+}
+
+template <typename Handler>
+inline bool keep_reusable_op_storage(Handler* h, void* block,
+    std::size_t size, std::size_t align,
+    reusable_op_storage::deallocate_function deallocate) noexcept
+{
+  reusable_op_storage* storage = get_reusable_op_storage(h);
+  return storage ? storage->keep(block, size, align, deallocate) : false;
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_REUSABLE_OP_STORAGE_HPP
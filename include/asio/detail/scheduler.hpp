@@ -19,6 +19,7 @@
 
 #include "asio/error_code.hpp"
 #include "asio/execution_context.hpp"
+#include "asio/detail/admission_control.hpp"
 #include "asio/detail/atomic_count.hpp"
 #include "asio/detail/conditionally_enabled_event.hpp"
 #include "asio/detail/conditionally_enabled_mutex.hpp"
@@ -45,6 +46,10 @@ public:
   // Tag type used for constructing as an internal scheduler.
   struct internal {};
 
+  // The number of priority lanes. Lane 0 holds normal priority work, and the
+  // remaining lanes hold work of successively higher priority.
+  static constexpr int priority_lanes = 4;
+
   // The type of a function used to obtain a task instance.
   typedef scheduler_task* (*get_task_func_type)(
       asio::execution_context&);
@@ -111,9 +116,47 @@ public:
   // Return whether a handler can be dispatched immediately.
   ASIO_DECL bool can_dispatch();
 
+  // Return whether a handler with the given priority can be dispatched
+  // immediately, without bypassing queued work of a higher priority than the
+  // handler that is currently running.
+  ASIO_DECL bool can_dispatch(int priority);
+
   /// Capture the current exception so it can be rethrown from a run function.
   ASIO_DECL void capture_current_exception();
 
+  // Count a new operation of the specified class as in flight, if it may be
+  // admitted. Returns false if the operation is refused. Otherwise, sets count
+  // to the count that the operation must decrement when it finishes, if any.
+  bool admit(admission_control::work_class c,
+      bool is_continuation, atomic_count*& count)
+  {
+    return admission_.start_op(c, is_continuation, count);
+  }
+
+  // Count a new function object against the handler limit, if it may be
+  // admitted. Returns false if the function object is to be shed, and throws
+  // if it is rejected. Otherwise, sets admission to the controller that must
+  // be notified once the function object has left the queue, if any.
+  bool admit_handler(bool is_continuation, admission_control*& admission)
+  {
+    admission = 0;
+    if (admission_.limit(admission_control::handler_work) <= 0)
+      return true;
+    return admit_limited_handler(is_continuation, admission);
+  }
+
+  // Get the admission controller.
+  const admission_control& admission() const
+  {
+    return admission_;
+  }
+
+  // Get the amount of outstanding work.
+  long outstanding_work() const
+  {
+    return outstanding_work_;
+  }
+
   // Request invocation of the given operation and return immediately. Assumes
   // that work_started() has not yet been called for the operation.
   ASIO_DECL void post_immediate_completion(
@@ -124,6 +167,11 @@ public:
   ASIO_DECL void post_immediate_completions(std::size_t n,
       op_queue<operation>& ops, bool is_continuation);
 
+  // Request invocation of the given operation in the specified priority lane
+  // and return immediately. Assumes that work_started() has not yet been
+  // called for the operation.
+  ASIO_DECL void post_prioritised_completion(operation* op, int priority);
+
   // Request invocation of the given operation and return immediately. Assumes
   // that work_started() was previously called for the operation.
   ASIO_DECL void post_deferred_completion(operation* op);
@@ -162,6 +210,18 @@ private:
   ASIO_DECL std::size_t do_poll_one(mutex::scoped_lock& lock,
       thread_info& this_thread, const asio::error_code& ec);
 
+  // Determine whether there are any operations in the queues.
+  bool has_queued_operations() const
+  {
+    return !op_queue_.empty() || priority_op_count_ != 0;
+  }
+
+  // Get the queue from which the next operation should be taken.
+  ASIO_DECL op_queue<operation>& next_op_queue();
+
+  // Pop the front operation from the given queue and return its priority.
+  ASIO_DECL int pop_op_queue(op_queue<operation>& q);
+
   // Stop the task and all idle threads.
   ASIO_DECL void stop_all_threads(mutex::scoped_lock& lock);
 
@@ -169,6 +229,25 @@ private:
   ASIO_DECL void wake_one_thread_and_unlock(
       mutex::scoped_lock& lock);
 
+  // If there is an idle thread, wake the one that most recently became idle
+  // and unlock the mutex. Returns false, with the mutex still locked, if there
+  // are no idle threads.
+  ASIO_DECL bool maybe_wake_idle_thread_and_unlock(
+      mutex::scoped_lock& lock);
+
+  // Push the current thread on to the idle thread stack and wait until it is
+  // woken, the scheduler is stopped, or the timeout (if non-negative) expires.
+  ASIO_DECL void wait_as_idle_thread(mutex::scoped_lock& lock,
+      thread_info& this_thread, long usec);
+
+  // Apply the handler limit to a new function object.
+  ASIO_DECL bool admit_limited_handler(
+      bool is_continuation, admission_control*& admission);
+
+  // Get the policy for function objects that exceed the handler limit.
+  ASIO_DECL static admission_control::handler_policy get_handler_policy(
+      execution_context& ctx);
+
   // Get the default task.
   ASIO_DECL static scheduler_task* get_default_task(
       asio::execution_context& ctx);
@@ -191,8 +270,12 @@ private:
   // Mutex to protect access to internal data.
   mutable mutex mutex_;
 
-  // Event to wake up blocked threads.
-  event wakeup_event_;
+  // The stack of idle threads, with the most recently idled thread on top.
+  // Waking the top thread first favours a thread whose cache is still warm.
+  thread_info* idle_threads_;
+
+  // The number of idle threads that are currently spinning.
+  int spinning_threads_;
 
   // The task to be run by this service.
   scheduler_task* task_;
@@ -221,12 +304,37 @@ private:
   // The queue of handlers that are ready to be delivered.
   op_queue<operation> op_queue_;
 
+  // The queues of elevated priority handlers that are ready to be delivered.
+  // The queue at index i holds handlers with priority i + 1.
+  op_queue<operation> priority_op_queues_[priority_lanes - 1];
+
+  // The total number of handlers in the elevated priority queues.
+  std::size_t priority_op_count_;
+
+  // The number of consecutive elevated priority handlers that have been
+  // delivered since a handler was last taken from the normal queue.
+  int priority_run_;
+
+  // The number of consecutive elevated priority handlers that may be delivered
+  // before normal priority work is allowed to run.
+  const int priority_burst_limit_;
+
   // The time limit on running the scheduler task, in microseconds.
   const long task_usec_;
 
   // The time limit on waiting when the queue is empty, in microseconds.
   const long wait_usec_;
 
+  // The maximum number of idle threads that may spin before blocking.
+  const int idle_spin_threads_;
+
+  // The number of times an idle thread spins before blocking.
+  const int idle_spin_count_;
+
+  // The admission controller, which limits the new work that is queued or in
+  // flight.
+  admission_control admission_;
+
   // The thread that is running the scheduler.
   asio::detail::thread thread_;
 };
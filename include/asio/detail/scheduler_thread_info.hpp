@@ -15,6 +15,8 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/conditionally_enabled_event.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/thread_info_base.hpp"
 
@@ -28,8 +30,33 @@ class scheduler_operation;
 
 struct scheduler_thread_info : public thread_info_base
 {
+  scheduler_thread_info()
+    : private_outstanding_work(0),
+      current_priority(0),
+      next_idle_thread(0),
+      idle(false),
+      wakeup_pending(0)
+  {
+  }
+
   op_queue<scheduler_operation> private_op_queue;
   long private_outstanding_work;
+
+  // The priority lane of the handler currently being run by this thread.
+  int current_priority;
+
+  // Event used to wake this thread when it is idle.
+  conditionally_enabled_event wakeup_event;
+
+  // The next thread in the scheduler's stack of idle threads.
+  scheduler_thread_info* next_idle_thread;
+
+  // Whether the thread is currently linked into the idle thread stack.
+  bool idle;
+
+  // Set when the thread has been woken, so that spinning threads may observe
+  // the wakeup without acquiring the scheduler's lock.
+  atomic_count wakeup_pending;
 };
 
 } // namespace detail
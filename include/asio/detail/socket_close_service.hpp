@@ -0,0 +1,108 @@
+//
+// detail/socket_close_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_SOCKET_CLOSE_SERVICE_HPP
+#define ASIO_DETAIL_SOCKET_CLOSE_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <vector>
+#include "asio/execution_context.hpp"
+#include "asio/detail/event.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/scoped_ptr.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/detail/socket_types.hpp"
+#include "asio/detail/thread.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Closes sockets on a background thread, so that the cost of the close system
+// call is not borne by the thread destroying the socket. Sockets are queued
+// by the destroying thread and closed in batches, and the background thread is
+// only woken when the queue becomes non-empty.
+class socket_close_service :
+  public execution_context_service_base<socket_close_service>
+{
+public:
+  // Constructor.
+  ASIO_DECL socket_close_service(execution_context& context);
+
+  // Destructor.
+  ASIO_DECL ~socket_close_service();
+
+  // Destroy all user-defined handler objects owned by the service.
+  ASIO_DECL void shutdown();
+
+  // Perform any fork-related housekeeping.
+  ASIO_DECL void notify_fork(execution_context::fork_event fork_ev);
+
+  // Queue a socket to be closed. The socket must already have been removed
+  // from the reactor.
+  ASIO_DECL void close(socket_type s, socket_ops::state_type state);
+
+private:
+  // Helper class to run the close loop in a thread.
+  class close_thread_function;
+
+  // A socket that is waiting to be closed.
+  struct pending_close
+  {
+    socket_type socket_;
+    socket_ops::state_type state_;
+  };
+
+  // Run the close loop until stopped.
+  ASIO_DECL void run();
+
+  // Start the background thread.
+  ASIO_DECL void start_thread();
+
+  // Stop the background thread, closing any sockets that are still queued.
+  ASIO_DECL void stop_thread();
+
+  // Close a batch of sockets.
+  ASIO_DECL static void close_all(std::vector<pending_close>& batch);
+
+  // Mutex to protect access to internal data.
+  asio::detail::mutex mutex_;
+
+  // Event used to wake the background thread.
+  asio::detail::event event_;
+
+  // The sockets waiting to be closed.
+  std::vector<pending_close> pending_;
+
+  // Whether the background thread has been asked to stop.
+  bool stopped_;
+
+  // Whether the service has been shut down.
+  bool shutdown_;
+
+  // The background thread.
+  asio::detail::scoped_ptr<asio::detail::thread> thread_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/socket_close_service.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_DETAIL_SOCKET_CLOSE_SERVICE_HPP
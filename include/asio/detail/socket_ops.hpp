@@ -56,10 +56,14 @@ enum
 
   // When using an edge-triggered reactor (epoll) the user wants the edge to be
   // reset following a partial read on a stream-oriented socket.
-  reset_edge_on_partial_read = 128
+  reset_edge_on_partial_read = 128,
+
+  // The user wants asynchronous sends that are queued behind one another to be
+  // coalesced using MSG_MORE.
+  auto_cork = 256
 };
 
-typedef unsigned char state_type;
+typedef unsigned short state_type;
 
 struct noop_deleter { void operator()(void*) {} };
 typedef shared_ptr<void> shared_cancel_token_type;
@@ -253,6 +257,13 @@ ASIO_DECL bool non_blocking_send1(socket_type s,
     const void* data, size_t size, int flags,
     asio::error_code& ec, size_t& bytes_transferred);
 
+#if defined(ASIO_HAS_MSG_MORE)
+
+// Push out data held back by an earlier send that used MSG_MORE.
+ASIO_DECL void uncork(socket_type s);
+
+#endif // defined(ASIO_HAS_MSG_MORE)
+
 #endif // defined(ASIO_HAS_IOCP)
 
 ASIO_DECL signed_size_type sendto(socket_type s,
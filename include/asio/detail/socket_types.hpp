@@ -368,6 +368,9 @@ typedef int signed_size_type;
 # define ASIO_OS_DEF_SO_RCVLOWAT SO_RCVLOWAT
 # define ASIO_OS_DEF_SO_REUSEADDR SO_REUSEADDR
 # define ASIO_OS_DEF_TCP_NODELAY TCP_NODELAY
+# if defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
+#  define ASIO_OS_DEF_TCP_NOTSENT_LOWAT TCP_NOTSENT_LOWAT
+# endif // defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
 # define ASIO_OS_DEF_IP_MULTICAST_IF IP_MULTICAST_IF
 # define ASIO_OS_DEF_IP_MULTICAST_TTL IP_MULTICAST_TTL
 # define ASIO_OS_DEF_IP_MULTICAST_LOOP IP_MULTICAST_LOOP
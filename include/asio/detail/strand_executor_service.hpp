@@ -134,7 +134,7 @@ private:
   // handlers were transferred.
   ASIO_DECL static bool push_waiting_to_ready(implementation_type& impl);
 
-  // Invokes all ready-to-run handlers.
+  // Invokes ready-to-run handlers, up to the configured per-turn limit.
   ASIO_DECL static void run_ready_handlers(implementation_type& impl);
 
   // Helper function to request invocation of the given function.
@@ -157,6 +157,10 @@ private:
 
   // The head of a linked list of all implementations.
   strand_impl* impl_list_;
+
+  // The maximum number of handlers to run each time a strand is scheduled. A
+  // value of 0 means there is no limit.
+  const std::size_t max_handlers_per_turn_;
 };
 
 } // namespace detail
@@ -69,6 +69,9 @@ public:
     // handlers that hold the strand's lock. The ready queue is only modified
     // from within the strand and so may be accessed without locking the mutex.
     op_queue<operation> ready_queue_;
+    // The maximum number of handlers to run each time the strand is scheduled.
+    // A value of 0 means there is no limit.
+    std::size_t max_handlers_per_turn_;
   };
 
   typedef strand_impl* implementation_type;
@@ -128,6 +131,9 @@ private:
   // Extra value used when hashing to prevent recycled memory locations from
   // getting the same strand implementation.
   std::size_t salt_;
+
+  // The maximum number of handlers to run each time a strand is scheduled.
+  const std::size_t max_handlers_per_turn_;
 };
 
 } // namespace detail
@@ -23,6 +23,7 @@
 #include "asio/detail/limits.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/timer_queue_base.hpp"
+#include "asio/detail/usdt_probes.hpp"
 #include "asio/detail/wait_op.hpp"
 #include "asio/error.hpp"
 
@@ -152,6 +153,7 @@ public:
       while (!heap_.empty() && !TimeTraits::less_than(now, heap_[0].time_))
       {
         per_timer_data* timer = heap_[0].timer_;
+        ASIO_USDT_PROBE1(timer__expiry, timer);
         while (wait_op* op = timer->op_queue_.front())
         {
           timer->op_queue_.pop();
@@ -0,0 +1,110 @@
+//
+// detail/usdt_probes.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_USDT_PROBES_HPP
+#define ASIO_DETAIL_USDT_PROBES_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_USDT_PROBES)
+# include <cstddef>
+# include <sys/sdt.h>
+# include "asio/error_code.hpp"
+#endif // defined(ASIO_HAS_USDT_PROBES)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+#if defined(ASIO_HAS_USDT_PROBES)
+
+// Each probe compiles to a single nop, plus an ELF note that describes where
+// its arguments live. The arguments are only read when a tracer is attached.
+// Probe names use a double underscore, which tracers display as a dash.
+# define ASIO_USDT_PROBE0(name) \
+  STAP_PROBE(asio, name)
+# define ASIO_USDT_PROBE1(name, a1) \
+  STAP_PROBE1(asio, name, a1)
+# define ASIO_USDT_PROBE2(name, a1, a2) \
+  STAP_PROBE2(asio, name, a1, a2)
+# define ASIO_USDT_PROBE3(name, a1, a2, a3) \
+  STAP_PROBE3(asio, name, a1, a2, a3)
+# define ASIO_USDT_PROBE4(name, a1, a2, a3, a4) \
+  STAP_PROBE4(asio, name, a1, a2, a3, a4)
+
+// Helpers to extract probe arguments from the handler tracking arguments of a
+// reactor operation, which are the error code and, optionally, the number of
+// bytes transferred.
+inline int usdt_error_value(const asio::error_code& ec)
+{
+  return ec.value();
+}
+
+template <typename T>
+inline int usdt_error_value(const asio::error_code& ec, const T&)
+{
+  return ec.value();
+}
+
+inline std::size_t usdt_bytes_transferred(const asio::error_code&)
+{
+  return 0;
+}
+
+template <typename T>
+inline std::size_t usdt_bytes_transferred(const asio::error_code&, const T& n)
+{
+  return n;
+}
+
+# define ASIO_USDT_HANDLER_CREATION(context, \
+    h, object_type, object, native_handle, op_name) \
+  ASIO_USDT_PROBE4(handler__creation, &(h), object_type, object, op_name)
+
+# define ASIO_USDT_HANDLER_COMPLETION(h) \
+  ASIO_USDT_PROBE1(handler__completion, &(h))
+
+# define ASIO_USDT_HANDLER_OPERATION(context, \
+    object_type, object, native_handle, op_name) \
+  ASIO_USDT_PROBE3(handler__operation, object_type, object, op_name)
+
+# define ASIO_USDT_REACTOR_REGISTRATION(context, native_handle, registration) \
+  ASIO_USDT_PROBE2(reactor__registration, native_handle, registration)
+
+# define ASIO_USDT_REACTOR_DEREGISTRATION(context, \
+    native_handle, registration) \
+  ASIO_USDT_PROBE2(reactor__deregistration, native_handle, registration)
+
+# define ASIO_USDT_REACTOR_OPERATION(h, op_name, ...) \
+  ASIO_USDT_PROBE4(reactor__operation, &(h), op_name, \
+      asio::detail::usdt_error_value(__VA_ARGS__), \
+      asio::detail::usdt_bytes_transferred(__VA_ARGS__))
+
+#else // defined(ASIO_HAS_USDT_PROBES)
+
+# define ASIO_USDT_PROBE0(name) (void)0
+# define ASIO_USDT_PROBE1(name, a1) (void)0
+# define ASIO_USDT_PROBE2(name, a1, a2) (void)0
+# define ASIO_USDT_PROBE3(name, a1, a2, a3) (void)0
+# define ASIO_USDT_PROBE4(name, a1, a2, a3, a4) (void)0
+
+#endif // defined(ASIO_HAS_USDT_PROBES)
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_USDT_PROBES_HPP
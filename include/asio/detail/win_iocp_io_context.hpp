@@ -19,6 +19,7 @@
 
 #if defined(ASIO_HAS_IOCP)
 
+#include "asio/detail/admission_control.hpp"
 #include "asio/detail/limits.hpp"
 #include "asio/detail/mutex.hpp"
 #include "asio/detail/op_queue.hpp"
@@ -116,9 +117,24 @@ public:
   // Return whether a handler can be dispatched immediately.
   ASIO_DECL bool can_dispatch();
 
+  // Return whether a handler with the given priority can be dispatched
+  // immediately. Priority lanes are not supported by this implementation.
+  bool can_dispatch(int)
+  {
+    return can_dispatch();
+  }
+
   /// Capture the current exception so it can be rethrown from a run function.
   ASIO_DECL void capture_current_exception();
 
+  // Count a new function object against the handler limit. Admission control
+  // is not supported by this implementation.
+  bool admit_handler(bool, admission_control*& admission)
+  {
+    admission = 0;
+    return true;
+  }
+
   // Request invocation of the given operation and return immediately. Assumes
   // that work_started() has not yet been called for the operation.
   void post_immediate_completion(win_iocp_operation* op, bool)
@@ -127,6 +143,14 @@ public:
     post_deferred_completion(op);
   }
 
+  // Request invocation of the given operation in the specified priority lane
+  // and return immediately. Priority lanes are not supported by this
+  // implementation, so the operation is posted with normal priority.
+  void post_prioritised_completion(win_iocp_operation* op, int)
+  {
+    post_immediate_completion(op, false);
+  }
+
   // Request invocation of the given operation and return immediately. Assumes
   // that work_started() was previously called for the operation.
   ASIO_DECL void post_deferred_completion(win_iocp_operation* op);
@@ -183,6 +183,20 @@ public:
     return ec;
   }
 
+  // Gets whether queued asynchronous sends are coalesced.
+  bool auto_cork(const base_implementation_type&) const
+  {
+    return false;
+  }
+
+  // Sets whether queued asynchronous sends are coalesced.
+  asio::error_code auto_cork(base_implementation_type&,
+      bool, asio::error_code& ec)
+  {
+    ec = asio::error::operation_not_supported;
+    return ec;
+  }
+
   // Wait for the socket to become ready to read, ready to write, or to have
   // pending error conditions.
   asio::error_code wait(base_implementation_type& impl,
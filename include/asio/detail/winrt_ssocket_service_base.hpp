@@ -168,6 +168,20 @@ public:
     return ec;
   }
 
+  // Gets whether queued asynchronous sends are coalesced.
+  bool auto_cork(const base_implementation_type&) const
+  {
+    return false;
+  }
+
+  // Sets whether queued asynchronous sends are coalesced.
+  asio::error_code auto_cork(base_implementation_type&,
+      bool, asio::error_code& ec)
+  {
+    ec = asio::error::operation_not_supported;
+    return ec;
+  }
+
   // Send the given data to the peer.
   template <typename ConstBufferSequence>
   std::size_t send(base_implementation_type& impl,
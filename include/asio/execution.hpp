@@ -29,6 +29,7 @@
 #include "asio/execution/occupancy.hpp"
 #include "asio/execution/outstanding_work.hpp"
 #include "asio/execution/prefer_only.hpp"
+#include "asio/execution/priority.hpp"
 #include "asio/execution/relationship.hpp"
 
 #endif // ASIO_EXECUTION_HPP
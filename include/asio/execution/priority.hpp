@@ -0,0 +1,135 @@
+//
+// execution/priority.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXECUTION_PRIORITY_HPP
+#define ASIO_EXECUTION_PRIORITY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/is_applicable_property.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+#if defined(GENERATING_DOCUMENTATION)
+
+namespace execution {
+
+/// A property to describe the priority with which an executor should schedule
+/// submitted function objects, relative to other work in its execution
+/// context.
+/**
+ * A priority of @c 0 indicates normal priority. Larger values indicate
+ * successively higher priorities. An execution context may support only a
+ * small, fixed number of priority levels, in which case values outside the
+ * supported range are clamped.
+ */
+struct priority_t
+{
+  /// The priority_t property applies to executors.
+  template <typename T>
+  static constexpr bool is_applicable_property_v = is_executor_v<T>;
+
+  /// The priority_t property can be required.
+  static constexpr bool is_requirable = true;
+
+  /// The priority_t property can be preferred.
+  static constexpr bool is_preferable = true;
+
+  /// The type returned by queries against an @c any_executor.
+  typedef int polymorphic_query_result_type;
+
+  /// Default constructor, representing normal priority.
+  constexpr priority_t();
+
+  /// Create a property object that represents the specified priority.
+  constexpr priority_t operator()(int p) const;
+
+  /// Obtain the priority value.
+  constexpr int value() const;
+};
+
+/// A special value used for accessing the priority_t property.
+constexpr priority_t priority;
+
+} // namespace execution
+
+#else // defined(GENERATING_DOCUMENTATION)
+
+namespace execution {
+namespace detail {
+
+template <int I = 0>
+struct priority_t
+{
+#if defined(ASIO_HAS_VARIABLE_TEMPLATES)
+  template <typename T>
+  static constexpr bool is_applicable_property_v = is_executor<T>::value;
+#endif // defined(ASIO_HAS_VARIABLE_TEMPLATES)
+
+  static constexpr bool is_requirable = true;
+  static constexpr bool is_preferable = true;
+  typedef int polymorphic_query_result_type;
+
+  constexpr priority_t()
+    : value_(0)
+  {
+  }
+
+  constexpr priority_t operator()(int p) const
+  {
+    return priority_t(p);
+  }
+
+  constexpr int value() const
+  {
+    return value_;
+  }
+
+private:
+  explicit constexpr priority_t(int p)
+    : value_(p)
+  {
+  }
+
+  int value_;
+};
+
+} // namespace detail
+
+typedef detail::priority_t<> priority_t;
+
+ASIO_INLINE_VARIABLE constexpr priority_t priority;
+
+} // namespace execution
+
+#if !defined(ASIO_HAS_VARIABLE_TEMPLATES)
+
+template <typename T>
+struct is_applicable_property<T, execution::priority_t>
+  : integral_constant<bool, execution::is_executor<T>::value>
+{
+};
+
+#endif // !defined(ASIO_HAS_VARIABLE_TEMPLATES)
+
+#endif // defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXECUTION_PRIORITY_HPP
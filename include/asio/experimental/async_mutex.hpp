@@ -0,0 +1,272 @@
+//
+// experimental/async_mutex.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_ASYNC_MUTEX_HPP
+#define ASIO_EXPERIMENTAL_ASYNC_MUTEX_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/any_io_executor.hpp"
+#include "asio/async_result.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/error_code.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/experimental/detail/semaphore_service.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+
+/// An asynchronous mutex.
+/**
+ * The basic_async_mutex class template provides mutual exclusion between
+ * asynchronous agents, such as two coroutines that write to the same socket.
+ * The lock is obtained with async_lock() or try_lock(), and released with
+ * unlock().
+ *
+ * When the mutex is not locked, it is locked with a single atomic operation,
+ * and no operation object is allocated and no lock is taken. The completion
+ * handler is then invoked as an immediate completion, using the handler's
+ * associated immediate executor. Otherwise the operation waits, without
+ * further allocation, in an intrusive queue, and ownership is handed to
+ * waiting operations in the order in which they started. Waiting operations
+ * are completed as if by asio::post.
+ *
+ * For example:
+ * @code asio::experimental::async_mutex write_lock(socket.get_executor());
+ *
+ * awaitable<void> send(const std::string& message)
+ * {
+ *   co_await write_lock.async_lock(use_awaitable);
+ *   auto [e, n] = co_await async_write(socket,
+ *       asio::buffer(message), as_tuple(use_awaitable));
+ *   write_lock.unlock();
+ *   ...
+ * } @endcode
+ *
+ * The mutex is not associated with an owner, and may be unlocked by an agent
+ * other than the one that locked it.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ */
+template <typename Executor = any_io_executor>
+class basic_async_mutex
+{
+private:
+  class initiate_async_lock;
+  typedef detail::semaphore_service service_type;
+
+public:
+  /// The type of the executor associated with the mutex.
+  typedef Executor executor_type;
+
+  /// Rebinds the mutex type to another executor.
+  template <typename Executor1>
+  struct rebind_executor
+  {
+    /// The mutex type when rebound to the specified executor.
+    typedef basic_async_mutex<Executor1> other;
+  };
+
+  /// Construct a basic_async_mutex.
+  /**
+   * @param ex The I/O executor that the mutex will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on the mutex.
+   */
+  explicit basic_async_mutex(const executor_type& ex)
+    : service_(&asio::use_service<service_type>(
+            basic_async_mutex::get_context(ex))),
+      impl_(),
+      executor_(ex)
+  {
+    service_->construct(impl_, 1);
+  }
+
+  /// Construct a basic_async_mutex.
+  /**
+   * @param context An execution context which provides the I/O executor that
+   * the mutex will use, by default, to dispatch handlers for any asynchronous
+   * operations performed on the mutex.
+   */
+  template <typename ExecutionContext>
+  explicit basic_async_mutex(ExecutionContext& context,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value,
+        defaulted_constraint
+      > = defaulted_constraint())
+    : service_(&asio::use_service<service_type>(context)),
+      impl_(),
+      executor_(context.get_executor())
+  {
+    service_->construct(impl_, 1);
+  }
+
+  /// Destructor.
+  /**
+   * Waiting operations complete with the error
+   * asio::error::operation_aborted.
+   */
+  ~basic_async_mutex()
+  {
+    service_->destroy(impl_);
+  }
+
+  /// Get the executor associated with the object.
+  const executor_type& get_executor() noexcept
+  {
+    return executor_;
+  }
+
+  /// Determine whether the mutex is locked.
+  bool is_locked() const noexcept
+  {
+    return service_->available(impl_) == 0;
+  }
+
+  /// Try to lock the mutex without blocking.
+  /**
+   * This function neither allocates nor takes a lock.
+   *
+   * @returns @c true if the mutex was locked, otherwise @c false.
+   */
+  bool try_lock() noexcept
+  {
+    return service_->try_acquire(impl_);
+  }
+
+  /// Unlock the mutex.
+  /**
+   * Ownership is handed to the longest waiting operation, if any. Its
+   * completion handler is never invoked from inside this function.
+   */
+  void unlock()
+  {
+    service_->release(impl_, 1);
+  }
+
+  /// Cancel all asynchronous operations waiting on the mutex.
+  /**
+   * Waiting operations complete with the error
+   * asio::error::operation_aborted.
+   *
+   * @returns The number of operations that were cancelled.
+   */
+  std::size_t cancel()
+  {
+    return service_->cancel(impl_);
+  }
+
+  /// Asynchronously lock the mutex.
+  /**
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   *
+   * A cancelled operation does not hold the lock.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        CompletionToken ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  auto async_lock(
+      CompletionToken&& token
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+    -> decltype(
+      async_initiate<CompletionToken, void (asio::error_code)>(
+        declval<initiate_async_lock>(), token))
+  {
+    return async_initiate<CompletionToken, void (asio::error_code)>(
+        initiate_async_lock(this), token);
+  }
+
+private:
+  // Disallow copying and assignment.
+  basic_async_mutex(const basic_async_mutex&) = delete;
+  basic_async_mutex& operator=(const basic_async_mutex&) = delete;
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      enable_if_t<execution::is_executor<T>::value>* = 0)
+  {
+    return asio::query(t, execution::context);
+  }
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      enable_if_t<!execution::is_executor<T>::value>* = 0)
+  {
+    return t.context();
+  }
+
+  class initiate_async_lock
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_lock(basic_async_mutex* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename LockHandler>
+    void operator()(LockHandler&& handler) const
+    {
+      asio::detail::non_const_lvalue<LockHandler> handler2(handler);
+      self_->service_->async_acquire(self_->impl_,
+          handler2.value, self_->get_executor());
+    }
+
+  private:
+    basic_async_mutex* self_;
+  };
+
+  // The service associated with the I/O object.
+  service_type* service_;
+
+  // The underlying implementation of the I/O object.
+  service_type::implementation_type impl_;
+
+  // The associated executor.
+  Executor executor_;
+};
+
+/// Typedef for the typical usage of an asynchronous mutex.
+typedef basic_async_mutex<> async_mutex;
+
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXPERIMENTAL_ASYNC_MUTEX_HPP
@@ -0,0 +1,494 @@
+//
+// experimental/async_rate_limiter.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_ASYNC_RATE_LIMITER_HPP
+#define ASIO_EXPERIMENTAL_ASYNC_RATE_LIMITER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <memory>
+#include "asio/any_io_executor.hpp"
+#include "asio/async_result.hpp"
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/error.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/experimental/detail/semaphore_service.hpp"
+#include "asio/wait_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+
+/// An asynchronous token bucket rate limiter.
+/**
+ * The basic_async_rate_limiter class template limits the rate at which agents
+ * may proceed. Tokens are added to a bucket at a fixed rate, up to a maximum
+ * burst size, and are taken with async_acquire() or try_acquire().
+ *
+ * The bucket is represented by the time at which it will next be full. When
+ * enough tokens are available they are taken with a single compare-and-swap,
+ * and no operation object is allocated and no lock is taken. The completion
+ * handler is then invoked as an immediate completion, using the handler's
+ * associated immediate executor. Otherwise the operation waits, without
+ * further allocation, in an intrusive queue, and a single timer is used to
+ * complete waiting operations in the order in which they started. Waiting
+ * operations are completed as if by asio::post.
+ *
+ * For example, to accept at most 100 new connections per second, with bursts
+ * of up to 10:
+ * @code asio::experimental::async_rate_limiter accept_rate(
+ *     ctx, 100, std::chrono::seconds(1), 10);
+ *
+ * for (;;)
+ * {
+ *   co_await accept_rate.async_acquire(1, use_awaitable);
+ *   tcp::socket socket = co_await acceptor.async_accept(use_awaitable);
+ *   ...
+ * } @endcode
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ */
+template <typename Executor = any_io_executor>
+class basic_async_rate_limiter
+{
+private:
+  class initiate_async_acquire;
+  class op_cancellation;
+  struct state;
+  struct timer_handler;
+  typedef detail::semaphore_service service_type;
+
+public:
+  /// The type of the executor associated with the rate limiter.
+  typedef Executor executor_type;
+
+  /// Rebinds the rate limiter type to another executor.
+  template <typename Executor1>
+  struct rebind_executor
+  {
+    /// The rate limiter type when rebound to the specified executor.
+    typedef basic_async_rate_limiter<Executor1> other;
+  };
+
+  /// The clock used to replenish tokens.
+  typedef chrono::steady_clock clock_type;
+
+  /// Construct a basic_async_rate_limiter.
+  /**
+   * The bucket is initially full.
+   *
+   * @param ex The I/O executor that the rate limiter will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on the rate
+   * limiter.
+   *
+   * @param rate The number of tokens added to the bucket in each @c period.
+   *
+   * @param period The period over which @c rate tokens are added. The interval
+   * between tokens is rounded down to a whole number of clock ticks.
+   *
+   * @param burst The maximum number of tokens that the bucket holds.
+   */
+  basic_async_rate_limiter(const executor_type& ex, std::size_t rate,
+      clock_type::duration period, std::size_t burst)
+    : service_(&asio::use_service<service_type>(
+            basic_async_rate_limiter::get_context(ex))),
+      state_(std::make_shared<state>(ex)),
+      executor_(ex)
+  {
+    service_->construct(*state_, interval(rate, period), burst);
+  }
+
+  /// Construct a basic_async_rate_limiter.
+  /**
+   * The bucket is initially full.
+   *
+   * @param context An execution context which provides the I/O executor that
+   * the rate limiter will use, by default, to dispatch handlers for any
+   * asynchronous operations performed on the rate limiter.
+   *
+   * @param rate The number of tokens added to the bucket in each @c period.
+   *
+   * @param period The period over which @c rate tokens are added. The interval
+   * between tokens is rounded down to a whole number of clock ticks.
+   *
+   * @param burst The maximum number of tokens that the bucket holds.
+   */
+  template <typename ExecutionContext>
+  basic_async_rate_limiter(ExecutionContext& context, std::size_t rate,
+      clock_type::duration period, std::size_t burst,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value,
+        defaulted_constraint
+      > = defaulted_constraint())
+    : service_(&asio::use_service<service_type>(context)),
+      state_(std::make_shared<state>(context.get_executor())),
+      executor_(context.get_executor())
+  {
+    service_->construct(*state_, interval(rate, period), burst);
+  }
+
+  /// Destructor.
+  /**
+   * Waiting operations complete with the error
+   * asio::error::operation_aborted.
+   */
+  ~basic_async_rate_limiter()
+  {
+    service_->destroy(*state_);
+  }
+
+  /// Get the executor associated with the object.
+  const executor_type& get_executor() noexcept
+  {
+    return executor_;
+  }
+
+  /// Get the maximum number of tokens that the bucket holds.
+  std::size_t burst() const noexcept
+  {
+    return state_->burst_;
+  }
+
+  /// Try to take tokens without blocking.
+  /**
+   * This function neither allocates nor takes a lock. It fails if other
+   * operations are already waiting for tokens.
+   *
+   * @returns @c true if the tokens were taken, otherwise @c false.
+   */
+  bool try_acquire(std::size_t n = 1) noexcept
+  {
+    return service_->try_acquire(*state_, n, now());
+  }
+
+  /// Cancel all asynchronous operations waiting on the rate limiter.
+  /**
+   * Waiting operations complete with the error
+   * asio::error::operation_aborted.
+   *
+   * @returns The number of operations that were cancelled.
+   */
+  std::size_t cancel()
+  {
+    std::size_t n = service_->cancel(*state_);
+    cancel_timer_if_idle(*state_);
+    return n;
+  }
+
+  /// Asynchronously take tokens.
+  /**
+   * @param n The number of tokens to take. If greater than the burst size,
+   * the operation completes immediately with the error
+   * asio::error::invalid_argument.
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   *
+   * A cancelled operation does not take any tokens.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        CompletionToken ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  auto async_acquire(std::size_t n,
+      CompletionToken&& token
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+    -> decltype(
+      async_initiate<CompletionToken, void (asio::error_code)>(
+        declval<initiate_async_acquire>(), token, n))
+  {
+    return async_initiate<CompletionToken, void (asio::error_code)>(
+        initiate_async_acquire(this), token, n);
+  }
+
+private:
+  // Disallow copying and assignment.
+  basic_async_rate_limiter(const basic_async_rate_limiter&) = delete;
+  basic_async_rate_limiter& operator=(
+      const basic_async_rate_limiter&) = delete;
+
+  typedef basic_waitable_timer<clock_type,
+    wait_traits<clock_type>, Executor> timer_type;
+
+  // The rate limiter's implementation, together with the timer used to wake
+  // waiting operations. It is shared with an outstanding timer wait so that
+  // the wait may safely complete after the rate limiter is destroyed.
+  struct state : service_type::rate_limiter_implementation_type
+  {
+    explicit state(const Executor& ex)
+      : timer_(ex),
+        timer_armed_(false)
+    {
+    }
+
+    // The timer, which is protected by the implementation's mutex.
+    timer_type timer_;
+
+    // Whether there is an outstanding wait on the timer.
+    bool timer_armed_;
+  };
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      enable_if_t<execution::is_executor<T>::value>* = 0)
+  {
+    return asio::query(t, execution::context);
+  }
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      enable_if_t<!execution::is_executor<T>::value>* = 0)
+  {
+    return t.context();
+  }
+
+  // Get the number of clock ticks between tokens.
+  static asio::int64_t interval(
+      std::size_t rate, clock_type::duration period)
+  {
+    return rate > 0
+      ? static_cast<asio::int64_t>(period.count())
+        / static_cast<asio::int64_t>(rate)
+      : static_cast<asio::int64_t>(period.count());
+  }
+
+  // Get the current time in clock ticks.
+  static asio::int64_t now()
+  {
+    return static_cast<asio::int64_t>(
+        clock_type::now().time_since_epoch().count());
+  }
+
+  // Start a wait for the time at which the first waiting operation may take
+  // its tokens. Must be called with the implementation's mutex held.
+  static void start_timer(const std::shared_ptr<state>& s,
+      asio::int64_t ready_time)
+  {
+    s->timer_.expires_at(clock_type::time_point(
+          clock_type::duration(ready_time)));
+    s->timer_.async_wait(timer_handler(s));
+    s->timer_armed_ = true;
+  }
+
+  // Complete the waiting operations whose tokens are now available.
+  static void grant_waiters(const std::shared_ptr<state>& s)
+  {
+    asio::detail::op_queue<detail::semaphore_operation> ops;
+
+    asio::detail::mutex::scoped_lock lock(s->mutex_);
+    s->timer_armed_ = false;
+    asio::int64_t time_now = now();
+    while (detail::semaphore_operation* op = s->waiters_.front())
+    {
+      asio::int64_t ready_time;
+      if (!service_type::try_consume(*s, op->count_, time_now, ready_time))
+      {
+        start_timer(s, ready_time);
+        break;
+      }
+      s->waiters_.pop();
+      ops.push(op);
+    }
+    if (s->waiters_.empty())
+      s->has_waiters_.store(false, std::memory_order_release);
+    lock.unlock();
+
+    while (detail::semaphore_operation* op = ops.front())
+    {
+      ops.pop();
+      op->post(asio::error_code());
+    }
+  }
+
+  // Cancel the outstanding timer wait, if there are no waiting operations,
+  // so that it does not keep the execution context busy.
+  static void cancel_timer_if_idle(state& s)
+  {
+    asio::detail::mutex::scoped_lock lock(s.mutex_);
+    if (s.timer_armed_ && s.waiters_.empty())
+    {
+      s.timer_.cancel();
+      s.timer_armed_ = false;
+    }
+  }
+
+  // Handler for the timer. Does nothing if the wait was cancelled, or if the
+  // rate limiter has gone away.
+  struct timer_handler
+  {
+    explicit timer_handler(const std::shared_ptr<state>& s)
+      : state_(s)
+    {
+    }
+
+    void operator()(const asio::error_code& ec)
+    {
+      if (ec != asio::error::operation_aborted)
+        if (std::shared_ptr<state> s = state_.lock())
+          grant_waiters(s);
+    }
+
+    std::weak_ptr<state> state_;
+  };
+
+  // Helper class used to implement per-operation cancellation.
+  class op_cancellation
+  {
+  public:
+    op_cancellation(service_type* s, state* st)
+      : service_(s),
+        state_(st)
+    {
+    }
+
+    void operator()(cancellation_type_t type)
+    {
+      if (!!(type &
+            (cancellation_type::terminal
+              | cancellation_type::partial
+              | cancellation_type::total)))
+      {
+        service_->cancel_by_key(*state_, this);
+        cancel_timer_if_idle(*state_);
+      }
+    }
+
+  private:
+    service_type* service_;
+    state* state_;
+  };
+
+  template <typename Handler>
+  void async_acquire_impl(Handler& handler, std::size_t n)
+  {
+    if (n > state_->burst_)
+    {
+      detail::semaphore_complete_immediately(handler,
+          executor_, asio::error::invalid_argument);
+      return;
+    }
+
+    // An uncontended acquire neither allocates nor takes a lock.
+    asio::int64_t time_now = now();
+    if (service_->try_acquire(*state_, n, time_now))
+    {
+      detail::semaphore_complete_immediately(
+          handler, executor_, asio::error_code());
+      return;
+    }
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef detail::semaphore_wait_op<Handler, Executor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(handler, executor_, n);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<op_cancellation>(service_, state_.get());
+    }
+
+    ASIO_HANDLER_CREATION((service_->context(), *p.p,
+          "rate_limiter", state_.get(), 0, "async_acquire"));
+
+    asio::detail::mutex::scoped_lock lock(state_->mutex_);
+
+    // The tokens may have become available since the first attempt.
+    asio::int64_t ready_time = time_now;
+    if (state_->waiters_.empty()
+        && service_type::try_consume(*state_, n, time_now, ready_time))
+    {
+      lock.unlock();
+      p.p->immediate(asio::error_code());
+      p.v = p.p = 0;
+      return;
+    }
+
+    state_->waiters_.push(p.p);
+    state_->has_waiters_.store(true, std::memory_order_release);
+    p.v = p.p = 0;
+
+    if (!state_->timer_armed_)
+      start_timer(state_, ready_time);
+  }
+
+  class initiate_async_acquire
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_acquire(basic_async_rate_limiter* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename AcquireHandler>
+    void operator()(AcquireHandler&& handler, std::size_t n) const
+    {
+      asio::detail::non_const_lvalue<AcquireHandler> handler2(handler);
+      self_->async_acquire_impl(handler2.value, n);
+    }
+
+  private:
+    basic_async_rate_limiter* self_;
+  };
+
+  // The service associated with the I/O object.
+  service_type* service_;
+
+  // The underlying implementation of the I/O object.
+  std::shared_ptr<state> state_;
+
+  // The associated executor.
+  Executor executor_;
+};
+
+/// Typedef for the typical usage of an asynchronous rate limiter.
+typedef basic_async_rate_limiter<> async_rate_limiter;
+
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXPERIMENTAL_ASYNC_RATE_LIMITER_HPP
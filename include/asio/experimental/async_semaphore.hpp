@@ -0,0 +1,275 @@
+//
+// experimental/async_semaphore.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_ASYNC_SEMAPHORE_HPP
+#define ASIO_EXPERIMENTAL_ASYNC_SEMAPHORE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/any_io_executor.hpp"
+#include "asio/async_result.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/error_code.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/experimental/detail/semaphore_service.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+
+/// An asynchronous counting semaphore.
+/**
+ * The basic_async_semaphore class template limits the number of agents that
+ * may concurrently hold a permit. A permit is obtained with async_acquire() or
+ * try_acquire(), and returned with release().
+ *
+ * When a permit is available, it is acquired with a single atomic operation,
+ * and no operation object is allocated and no lock is taken. The completion
+ * handler is then invoked as an immediate completion, using the handler's
+ * associated immediate executor. Otherwise the operation waits, without
+ * further allocation, in an intrusive queue and is granted a permit in the
+ * order in which it started. Waiting operations are completed as if by
+ * asio::post.
+ *
+ * For example, to limit the number of concurrent connection attempts:
+ * @code asio::experimental::async_semaphore connection_limit(ctx, 32);
+ *
+ * awaitable<void> connect(tcp::socket& socket, tcp::endpoint ep)
+ * {
+ *   co_await connection_limit.async_acquire(use_awaitable);
+ *   auto [e] = co_await socket.async_connect(ep, as_tuple(use_awaitable));
+ *   connection_limit.release();
+ *   ...
+ * } @endcode
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ */
+template <typename Executor = any_io_executor>
+class basic_async_semaphore
+{
+private:
+  class initiate_async_acquire;
+  typedef detail::semaphore_service service_type;
+
+public:
+  /// The type of the executor associated with the semaphore.
+  typedef Executor executor_type;
+
+  /// Rebinds the semaphore type to another executor.
+  template <typename Executor1>
+  struct rebind_executor
+  {
+    /// The semaphore type when rebound to the specified executor.
+    typedef basic_async_semaphore<Executor1> other;
+  };
+
+  /// Construct a basic_async_semaphore.
+  /**
+   * @param ex The I/O executor that the semaphore will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on the
+   * semaphore.
+   *
+   * @param initial_count The number of permits that are initially available.
+   */
+  basic_async_semaphore(const executor_type& ex, std::size_t initial_count)
+    : service_(&asio::use_service<service_type>(
+            basic_async_semaphore::get_context(ex))),
+      impl_(),
+      executor_(ex)
+  {
+    service_->construct(impl_, static_cast<std::ptrdiff_t>(initial_count));
+  }
+
+  /// Construct a basic_async_semaphore.
+  /**
+   * @param context An execution context which provides the I/O executor that
+   * the semaphore will use, by default, to dispatch handlers for any
+   * asynchronous operations performed on the semaphore.
+   *
+   * @param initial_count The number of permits that are initially available.
+   */
+  template <typename ExecutionContext>
+  basic_async_semaphore(ExecutionContext& context, std::size_t initial_count,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value,
+        defaulted_constraint
+      > = defaulted_constraint())
+    : service_(&asio::use_service<service_type>(context)),
+      impl_(),
+      executor_(context.get_executor())
+  {
+    service_->construct(impl_, static_cast<std::ptrdiff_t>(initial_count));
+  }
+
+  /// Destructor.
+  /**
+   * Waiting operations complete with the error
+   * asio::error::operation_aborted.
+   */
+  ~basic_async_semaphore()
+  {
+    service_->destroy(impl_);
+  }
+
+  /// Get the executor associated with the object.
+  const executor_type& get_executor() noexcept
+  {
+    return executor_;
+  }
+
+  /// Get the number of permits that are currently available.
+  std::size_t available() const noexcept
+  {
+    return service_->available(impl_);
+  }
+
+  /// Try to acquire a permit without blocking.
+  /**
+   * This function neither allocates nor takes a lock.
+   *
+   * @returns @c true if a permit was acquired, otherwise @c false.
+   */
+  bool try_acquire() noexcept
+  {
+    return service_->try_acquire(impl_);
+  }
+
+  /// Release permits.
+  /**
+   * Each permit is handed to the longest waiting operation, if any, or
+   * otherwise made available. Waiting operations' completion handlers are
+   * never invoked from inside this function.
+   *
+   * @param n The number of permits to release.
+   */
+  void release(std::size_t n = 1)
+  {
+    service_->release(impl_, n);
+  }
+
+  /// Cancel all asynchronous operations waiting on the semaphore.
+  /**
+   * Waiting operations complete with the error
+   * asio::error::operation_aborted.
+   *
+   * @returns The number of operations that were cancelled.
+   */
+  std::size_t cancel()
+  {
+    return service_->cancel(impl_);
+  }
+
+  /// Asynchronously acquire a permit.
+  /**
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   *
+   * A cancelled operation does not hold a permit.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        CompletionToken ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  auto async_acquire(
+      CompletionToken&& token
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+    -> decltype(
+      async_initiate<CompletionToken, void (asio::error_code)>(
+        declval<initiate_async_acquire>(), token))
+  {
+    return async_initiate<CompletionToken, void (asio::error_code)>(
+        initiate_async_acquire(this), token);
+  }
+
+private:
+  // Disallow copying and assignment.
+  basic_async_semaphore(const basic_async_semaphore&) = delete;
+  basic_async_semaphore& operator=(const basic_async_semaphore&) = delete;
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      enable_if_t<execution::is_executor<T>::value>* = 0)
+  {
+    return asio::query(t, execution::context);
+  }
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      enable_if_t<!execution::is_executor<T>::value>* = 0)
+  {
+    return t.context();
+  }
+
+  class initiate_async_acquire
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_acquire(basic_async_semaphore* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename AcquireHandler>
+    void operator()(AcquireHandler&& handler) const
+    {
+      asio::detail::non_const_lvalue<AcquireHandler> handler2(handler);
+      self_->service_->async_acquire(self_->impl_,
+          handler2.value, self_->get_executor());
+    }
+
+  private:
+    basic_async_semaphore* self_;
+  };
+
+  // The service associated with the I/O object.
+  service_type* service_;
+
+  // The underlying implementation of the I/O object.
+  service_type::implementation_type impl_;
+
+  // The associated executor.
+  Executor executor_;
+};
+
+/// Typedef for the typical usage of an asynchronous semaphore.
+typedef basic_async_semaphore<> async_semaphore;
+
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXPERIMENTAL_ASYNC_SEMAPHORE_HPP
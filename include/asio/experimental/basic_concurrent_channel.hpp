@@ -102,6 +102,7 @@ class basic_concurrent_channel
 #endif // !defined(GENERATING_DOCUMENTATION)
 {
 private:
+  friend class detail::channel_select_access;
   class initiate_async_send;
   class initiate_async_receive;
   typedef detail::channel_service<asio::detail::mutex> service_type;
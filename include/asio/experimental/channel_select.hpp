@@ -0,0 +1,232 @@
+//
+// experimental/channel_select.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_CHANNEL_SELECT_HPP
+#define ASIO_EXPERIMENTAL_CHANNEL_SELECT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <tuple>
+#include "asio/associated_allocator.hpp"
+#include "asio/associated_cancellation_slot.hpp"
+#include "asio/async_result.hpp"
+#include "asio/detail/completion_payload.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/experimental/detail/channel_select_op.hpp"
+#include "asio/prepend.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+
+/// A select over the receive ends of several channels.
+/**
+ * See the documentation for asio::experimental::make_channel_select for a
+ * usage example.
+ */
+template <typename... Channels>
+class channel_select
+{
+private:
+  static_assert(sizeof...(Channels) > 0,
+      "a select requires at least one channel");
+
+  typedef typename std::tuple_element<0,
+    std::tuple<Channels...>>::type first_channel_type;
+  typedef typename first_channel_type::executor_type io_executor_type;
+  typedef typename experimental::detail::channel_select_access::template
+    types<first_channel_type>::payload_type payload_type;
+  typedef typename experimental::detail::channel_select_access::template
+    types<first_channel_type>::traits_type traits_type;
+
+  static_assert(
+      conjunction<
+        is_same<payload_type,
+          typename experimental::detail::channel_select_access::template
+            types<Channels>::payload_type>...
+      >::value,
+      "all channels in a select must have the same signatures and traits");
+
+  class initiate_async_receive;
+
+  template <typename... PayloadSignatures, typename CompletionToken>
+  auto do_async_receive(
+      asio::detail::completion_payload<PayloadSignatures...>*,
+      CompletionToken&& token)
+    -> decltype(
+        async_initiate<CompletionToken,
+          typename asio::detail::prepend_signature<
+            PayloadSignatures, std::size_t>::type...>(
+              declval<initiate_async_receive>(), token))
+  {
+    return async_initiate<CompletionToken,
+      typename asio::detail::prepend_signature<
+        PayloadSignatures, std::size_t>::type...>(
+          initiate_async_receive(this), token);
+  }
+
+public:
+  /// Constructor.
+  explicit channel_select(Channels&... channels)
+    : channels_(&channels...)
+  {
+  }
+
+  /// Asynchronously receive a message from whichever channel is ready first.
+  /**
+   * If one of the channels already has a message available, the message is
+   * received from the first such channel, in the order in which the channels
+   * were passed to the constructor, and no memory is allocated. Otherwise, a
+   * single operation is allocated that waits on all of the channels, and the
+   * first message sent to any of them completes the select. At most one
+   * message is received.
+   *
+   * A waiting select does not hold any channel's lock while waiting, and
+   * channels may be shared with ordinary receivers and other selects. When
+   * the select completes, the branches left waiting on the other channels are
+   * discarded the next time those channels are used, and the operation's
+   * memory is released once all branches have been discarded.
+   *
+   * The completion handler is invoked using the executor of the first channel
+   * if there is no associated executor.
+   *
+   * @par Completion Signature
+   * The channels' signatures, each with a leading @c std::size_t argument that
+   * indicates which channel the message was received from. If the operation
+   * is cancelled, the index is equal to the number of channels and the
+   * remaining arguments are those of the channel traits' cancellation
+   * notification.
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename CompletionToken
+      ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(io_executor_type)>
+  auto async_receive(
+      CompletionToken&& token
+        ASIO_DEFAULT_COMPLETION_TOKEN(io_executor_type))
+#if !defined(GENERATING_DOCUMENTATION)
+    -> decltype(
+        this->do_async_receive(static_cast<payload_type*>(0),
+          static_cast<CompletionToken&&>(token)))
+#endif // !defined(GENERATING_DOCUMENTATION)
+  {
+    return this->do_async_receive(static_cast<payload_type*>(0),
+        static_cast<CompletionToken&&>(token));
+  }
+
+private:
+  class initiate_async_receive
+  {
+  public:
+    typedef io_executor_type executor_type;
+
+    explicit initiate_async_receive(channel_select* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return std::get<0>(self_->channels_)->get_executor();
+    }
+
+    template <typename ReceiveHandler>
+    void operator()(ReceiveHandler&& handler) const
+    {
+      asio::detail::non_const_lvalue<ReceiveHandler> handler2(handler);
+      self_->start(handler2.value);
+    }
+
+  private:
+    channel_select* self_;
+  };
+
+  template <typename Handler>
+  void start(Handler& handler)
+  {
+    typedef experimental::detail::channel_select_op<traits_type,
+      payload_type, Handler, io_executor_type, sizeof...(Channels)> op;
+
+    const io_executor_type& io_ex =
+      std::get<0>(channels_)->get_executor();
+
+    // Complete immediately, without allocating, if a channel is ready.
+    if ((experimental::detail::channel_select_try_receive<0>)(
+          handler, io_ex, channels_))
+      return;
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation that waits on all channels.
+    typename op::Alloc allocator((get_associated_allocator)(handler));
+    typename op::ptr p = { asio::detail::addressof(allocator),
+      op::ptr::allocate(allocator), 0 };
+    p.p = new (p.v) op(handler, io_ex, allocator);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+      slot.template emplace<typename op::op_cancellation>(p.p);
+
+    op* o = p.p;
+    p.v = p.p = 0;
+    (experimental::detail::channel_select_start<0>)(o, channels_);
+  }
+
+  std::tuple<Channels*...> channels_;
+};
+
+/// Create a select over the receive ends of several channels.
+/**
+ * The channels may be any combination of asio::experimental::basic_channel
+ * and asio::experimental::basic_concurrent_channel objects, provided they
+ * carry the same signatures and traits. For example:
+ *
+ * @code asio::experimental::channel<void(asio::error_code, int)> a(ctx);
+ * asio::experimental::concurrent_channel<
+ *     void(asio::error_code, int)> b(ctx);
+ * ...
+ * for (;;)
+ * {
+ *   auto [index, ec, value] = co_await
+ *     asio::experimental::make_channel_select(a, b).async_receive(
+ *       asio::as_tuple(asio::use_awaitable));
+ *   ...
+ * } @endcode
+ *
+ * The channels are held by reference, and must outlive the select.
+ */
+template <typename... Channels>
+ASIO_NODISCARD inline channel_select<Channels...>
+make_channel_select(Channels&... channels)
+{
+  return channel_select<Channels...>(channels...);
+}
+
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXPERIMENTAL_CHANNEL_SELECT_HPP
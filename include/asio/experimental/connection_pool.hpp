@@ -0,0 +1,346 @@
+//
+// experimental/connection_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_CONNECTION_POOL_HPP
+#define ASIO_EXPERIMENTAL_CONNECTION_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/associated_immediate_executor.hpp"
+#include "asio/async_result.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/initiate_dispatch.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/error_code.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/experimental/detail/connection_pool_impl.hpp"
+#include "asio/ip/tcp.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+
+/// A pool of established outbound connections, keyed by endpoint.
+/**
+ * The basic_connection_pool class template keeps idle connections to remote
+ * endpoints so that they may be reused, removing the cost of connection
+ * establishment from a program's request paths.
+ *
+ * A connection is obtained using async_acquire(). If the pool holds an idle
+ * connection to the endpoint, the most recently used one is checked and
+ * handed out as an immediate completion, using the handler's associated
+ * immediate executor. The check is a zero-timeout poll of the socket, followed
+ * by a non-blocking peek only if the socket is readable, and discards
+ * connections that the peer has closed or that have received unsolicited
+ * data. If no idle connection is available, a new connection is established
+ * for the caller. When the caller has finished with a connection, and the
+ * connection is in a state where it may be reused, it is returned to the pool
+ * using release().
+ *
+ * The pool may also be asked to maintain a minimum number of idle connections
+ * to an endpoint using preconnect(). Connections are then established in the
+ * background, both immediately and whenever acquiring a connection leaves the
+ * endpoint below its minimum.
+ *
+ * The Stream type may be a socket, such as ip::tcp::socket, or a layered
+ * stream, such as ssl::stream<ip::tcp::socket>. For a layered stream, the
+ * lowest layer is connected and the stream's client handshake is then
+ * performed before the connection is handed out or added to the pool. Streams
+ * that require arguments other than an executor on construction are created
+ * using a factory function object. For example:
+ *
+ * @code asio::ssl::context ssl_ctx(asio::ssl::context::tls_client);
+ * ...
+ * asio::experimental::basic_connection_pool<
+ *     asio::ssl::stream<asio::ip::tcp::socket>> pool(
+ *   ctx.get_executor(),
+ *   [&](const asio::any_io_executor& ex)
+ *   {
+ *     return asio::ssl::stream<asio::ip::tcp::socket>(ex, ssl_ctx);
+ *   });
+ *
+ * pool.preconnect(endpoint, 4);
+ * ...
+ * pool.async_acquire(endpoint,
+ *     [&](asio::error_code ec, asio::ssl::stream<asio::ip::tcp::socket> s)
+ *     {
+ *       ...
+ *     }); @endcode
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ */
+template <typename Stream>
+class basic_connection_pool
+{
+private:
+  class initiate_async_acquire;
+  typedef detail::connection_pool_state<Stream> state_type;
+
+public:
+  /// The type of the pooled connections.
+  typedef Stream stream_type;
+
+  /// The type of the executor associated with the pool.
+  typedef typename Stream::executor_type executor_type;
+
+  /// The protocol type.
+  typedef typename Stream::lowest_layer_type::protocol_type protocol_type;
+
+  /// The endpoint type.
+  typedef typename protocol_type::endpoint endpoint_type;
+
+  /// Construct a connection pool.
+  /**
+   * @param ex The I/O executor that the pool will use, by default, to dispatch
+   * handlers for any asynchronous operations performed on the pool. Pooled
+   * connections are created using this executor.
+   *
+   * @param max_idle The maximum number of idle connections that are kept for
+   * each endpoint.
+   */
+  explicit basic_connection_pool(const executor_type& ex,
+      std::size_t max_idle = 16)
+    : state_(std::make_shared<state_type>(ex,
+          &basic_connection_pool::default_create, max_idle))
+  {
+  }
+
+  /// Construct a connection pool.
+  /**
+   * @param context An execution context which provides the I/O executor that
+   * the pool will use, by default, to dispatch handlers for any asynchronous
+   * operations performed on the pool. Pooled connections are created using
+   * this executor.
+   *
+   * @param max_idle The maximum number of idle connections that are kept for
+   * each endpoint.
+   */
+  template <typename ExecutionContext>
+  explicit basic_connection_pool(ExecutionContext& context,
+      std::size_t max_idle = 16,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value,
+        defaulted_constraint
+      > = defaulted_constraint())
+    : state_(std::make_shared<state_type>(context.get_executor(),
+          &basic_connection_pool::default_create, max_idle))
+  {
+  }
+
+  /// Construct a connection pool that uses a factory to create streams.
+  /**
+   * @param ex The I/O executor that the pool will use, by default, to dispatch
+   * handlers for any asynchronous operations performed on the pool.
+   *
+   * @param factory A function object, with the signature
+   * <tt>Stream(const executor_type&)</tt>, that is called to create each
+   * new, unconnected stream.
+   *
+   * @param max_idle The maximum number of idle connections that are kept for
+   * each endpoint.
+   */
+  template <typename StreamFactory>
+  basic_connection_pool(const executor_type& ex,
+      StreamFactory factory, std::size_t max_idle = 16,
+      constraint_t<
+        !is_convertible<StreamFactory, std::size_t>::value
+      > = 0)
+    : state_(std::make_shared<state_type>(ex,
+          static_cast<StreamFactory&&>(factory), max_idle))
+  {
+  }
+
+  /// Destructor.
+  /**
+   * Closes all idle connections. Connections that are being established in
+   * the background are closed once they complete.
+   */
+  ~basic_connection_pool()
+  {
+    state_->clear(true);
+  }
+
+  /// Get the executor associated with the object.
+  const executor_type& get_executor() noexcept
+  {
+    return state_->get_executor();
+  }
+
+  /// Maintain a minimum number of idle connections to an endpoint.
+  /**
+   * Connections are established in the background until the pool holds @c
+   * min_idle idle connections to the endpoint. Connections are established
+   * again whenever acquiring a connection leaves the endpoint below its
+   * minimum. A connection that cannot be established is not retried until
+   * the next time that a connection to the endpoint is acquired, or its
+   * minimum is set.
+   *
+   * @param endpoint The remote endpoint.
+   *
+   * @param min_idle The number of idle connections to maintain. A value of 0
+   * stops connections being established in the background.
+   */
+  void preconnect(const endpoint_type& endpoint, std::size_t min_idle)
+  {
+    state_->set_min_idle(endpoint, min_idle);
+  }
+
+  /// Get the number of idle connections to an endpoint.
+  std::size_t idle(const endpoint_type& endpoint) const
+  {
+    return state_->idle(endpoint);
+  }
+
+  /// Close all idle connections.
+  void clear()
+  {
+    state_->clear(false);
+  }
+
+  /// Return a connection to the pool.
+  /**
+   * The connection is kept for reuse unless it is closed or the pool already
+   * holds the maximum number of idle connections to the endpoint, in which
+   * case it is closed. A connection must only be returned to the pool if it
+   * has no pending operations and if it is in a state where it may be used
+   * for a new request, such as after a complete response has been read.
+   *
+   * @param endpoint The remote endpoint to which the stream is connected.
+   *
+   * @param stream The connection.
+   */
+  void release(const endpoint_type& endpoint, stream_type&& stream)
+  {
+    state_->add_idle(endpoint, static_cast<stream_type&&>(stream));
+  }
+
+  /// Asynchronously acquire a connection to an endpoint.
+  /**
+   * If the pool holds a reusable idle connection to the endpoint, it is
+   * passed to the completion handler as an immediate completion. Otherwise a
+   * new connection is established.
+   *
+   * @param endpoint The remote endpoint.
+   *
+   * @param token The completion token that will be used to produce a
+   * completion handler, which will be called when the connection is
+   * acquired. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   Stream stream // The connection, if successful.
+   * ); @endcode
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, Stream) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * When a new connection is being established, this asynchronous operation
+   * supports cancellation in the same way as the stream's @c async_connect
+   * and @c async_handshake operations.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code, Stream))
+        CompletionToken ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  auto async_acquire(const endpoint_type& endpoint,
+      CompletionToken&& token
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+    -> decltype(
+      async_initiate<CompletionToken, void (asio::error_code, Stream)>(
+        declval<initiate_async_acquire>(), token, endpoint))
+  {
+    return async_initiate<CompletionToken, void (asio::error_code, Stream)>(
+        initiate_async_acquire(state_), token, endpoint);
+  }
+
+private:
+  // Disallow copying and assignment.
+  basic_connection_pool(const basic_connection_pool&) = delete;
+  basic_connection_pool& operator=(const basic_connection_pool&) = delete;
+
+  // Creates a stream using its executor constructor.
+  static Stream default_create(const executor_type& ex)
+  {
+    return Stream(ex);
+  }
+
+  class initiate_async_acquire
+  {
+  public:
+    typedef typename Stream::executor_type executor_type;
+
+    explicit initiate_async_acquire(
+        const std::shared_ptr<state_type>& state)
+      : state_(state)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return state_->get_executor();
+    }
+
+    template <typename AcquireHandler>
+    void operator()(AcquireHandler&& handler,
+        const endpoint_type& endpoint) const
+    {
+      typedef decay_t<AcquireHandler> handler_type;
+      asio::detail::non_const_lvalue<AcquireHandler> handler2(handler);
+
+      std::unique_ptr<Stream> stream;
+      if (state_->take_idle(endpoint, stream))
+      {
+        typedef associated_immediate_executor_t<handler_type, executor_type>
+          immediate_ex_type;
+
+        immediate_ex_type immediate_ex = (get_associated_immediate_executor)(
+            handler2.value, state_->get_executor());
+
+        (asio::detail::initiate_dispatch_with_executor<immediate_ex_type>(
+            immediate_ex))(
+              asio::detail::move_binder2<handler_type, asio::error_code, Stream>(
+                0, static_cast<handler_type&&>(handler2.value),
+                asio::error_code(), static_cast<Stream&&>(*stream)),
+              asio::detail::empty_work_function());
+        return;
+      }
+
+      asio::async_compose<handler_type, void (asio::error_code, Stream)>(
+          detail::connection_pool_connect_op<Stream>(
+            state_->create(), endpoint),
+          handler2.value, state_->get_executor());
+    }
+
+  private:
+    std::shared_ptr<state_type> state_;
+  };
+
+  // The state shared with background connection operations.
+  std::shared_ptr<state_type> state_;
+};
+
+/// Typedef for a pool of TCP connections.
+typedef basic_connection_pool<ip::tcp::socket> tcp_connection_pool;
+
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXPERIMENTAL_CONNECTION_POOL_HPP
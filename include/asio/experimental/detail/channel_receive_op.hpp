@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <atomic>
 #include "asio/detail/bind_handler.hpp"
 #include "asio/detail/completion_handler.hpp"
 #include "asio/detail/handler_alloc_helpers.hpp"
@@ -47,11 +48,37 @@ public:
     func_(this, dispatch_op, &payload);
   }
 
+  // Attempt to claim the operation so that it may be completed. An operation
+  // that is one branch of a select may be claimed only if no other branch of
+  // the select has been.
+  bool try_claim()
+  {
+    if (!select_winner_)
+      return true;
+    void* winner = 0;
+    return select_winner_->compare_exchange_strong(winner, this,
+        std::memory_order_acq_rel) || winner == this;
+  }
+
+  // Determine whether the operation is a branch of a select that has been
+  // completed by another branch, and so must be discarded.
+  bool is_stale() const
+  {
+    if (!select_winner_)
+      return false;
+    void* winner = select_winner_->load(std::memory_order_acquire);
+    return winner != 0 && winner != this;
+  }
+
 protected:
   channel_receive(func_type func)
-    : channel_operation(func)
+    : channel_operation(func),
+      select_winner_(0)
   {
   }
+
+  // The winning branch, if the operation is one branch of a select.
+  std::atomic<void*>* select_winner_;
 };
 
 template <typename Payload, typename Handler, typename IoExecutor>
@@ -0,0 +1,371 @@
+//
+// experimental/detail/channel_select_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_DETAIL_CHANNEL_SELECT_OP_HPP
+#define ASIO_EXPERIMENTAL_DETAIL_CHANNEL_SELECT_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include <tuple>
+#include "asio/associated_allocator.hpp"
+#include "asio/cancellation_type.hpp"
+#include "asio/detail/completion_message.hpp"
+#include "asio/detail/completion_payload_handler.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/experimental/detail/channel_service.hpp"
+#include "asio/prepend.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+namespace detail {
+
+// Grants a select access to the implementation of the channels it waits on.
+class channel_select_access
+{
+public:
+  template <typename Channel>
+  struct types
+  {
+    typedef typename Channel::service_type service_type;
+    typedef typename Channel::payload_type payload_type;
+    typedef typename decay_t<
+      decltype(declval<Channel&>().impl_)>::traits_type traits_type;
+  };
+
+  template <typename Channel>
+  static typename Channel::service_type& service(Channel& channel)
+  {
+    return *channel.service_;
+  }
+
+  template <typename Channel>
+  static auto implementation(Channel& channel)
+    -> decltype((channel.impl_))
+  {
+    return channel.impl_;
+  }
+};
+
+// The ways in which a select may be completed.
+enum channel_select_completion
+{
+  channel_select_immediate,
+  channel_select_post,
+  channel_select_dispatch
+};
+
+// One branch of a select, waiting to receive from a single channel. The
+// branches are embedded in the select operation that owns them.
+template <typename Payload, typename Owner>
+class channel_select_branch : public channel_receive<Payload>
+{
+public:
+  channel_select_branch()
+    : channel_receive<Payload>(&channel_select_branch::do_action),
+      owner_(0),
+      index_(0)
+  {
+  }
+
+  void init(Owner* owner, std::size_t index, std::atomic<void*>* winner)
+  {
+    owner_ = owner;
+    index_ = index;
+    this->select_winner_ = winner;
+  }
+
+  static void do_action(channel_operation* base,
+      channel_operation::action a, void* v)
+  {
+    channel_select_branch* b(static_cast<channel_select_branch*>(base));
+    Payload* payload = static_cast<Payload*>(v);
+
+    switch (a)
+    {
+    case channel_operation::immediate_op:
+      b->owner_->complete(b->index_, payload, channel_select_immediate);
+      break;
+    case channel_operation::dispatch_op:
+      b->owner_->complete(b->index_, payload, channel_select_dispatch);
+      break;
+    case channel_operation::post_op:
+      b->owner_->complete(b->index_, payload, channel_select_post);
+      break;
+    case channel_operation::destroy_op:
+    default:
+      b->owner_->release();
+      break;
+    }
+  }
+
+private:
+  Owner* owner_;
+  std::size_t index_;
+};
+
+// A select over N channels. A single allocation holds the handler and one
+// branch for each channel. Each branch that is registered with a channel
+// holds a reference to the operation, as does a connected cancellation slot,
+// and the memory is released when the last of these is dropped. Branches that
+// lose the select are discarded by their channels when next used.
+template <typename Traits, typename Payload,
+    typename Handler, typename IoExecutor, std::size_t N>
+class channel_select_op
+{
+public:
+  typedef associated_allocator_t<Handler> Alloc;
+  ASIO_DEFINE_HANDLER_ALLOCATOR_PTR(channel_select_op);
+
+  typedef channel_select_branch<Payload, channel_select_op> branch_type;
+
+  channel_select_op(Handler& handler,
+      const IoExecutor& io_ex, const Alloc& allocator)
+    : handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex),
+      allocator_(allocator),
+      winner_(0),
+      ref_count_(N)
+  {
+    for (std::size_t i = 0; i < N; ++i)
+      branches_[i].init(this, i, &winner_);
+  }
+
+  branch_type* branch(std::size_t i)
+  {
+    return &branches_[i];
+  }
+
+  bool has_winner() const
+  {
+    return winner_.load(std::memory_order_acquire) != 0;
+  }
+
+  void add_ref()
+  {
+    ref_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void release()
+  {
+    if (ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      Alloc allocator(allocator_);
+      ptr p = { asio::detail::addressof(allocator), this, this };
+      p.reset();
+    }
+  }
+
+  // Complete the select on behalf of the winning branch, which drops its
+  // reference to the operation.
+  void complete(std::size_t index, Payload* payload,
+      channel_select_completion how)
+  {
+    // Take ownership of the operation's outstanding work.
+    channel_operation::handler_work<Handler, IoExecutor> w(
+        static_cast<channel_operation::handler_work<Handler, IoExecutor>&&>(
+          work_));
+
+    // Move the handler out of the operation, as the memory may be
+    // deallocated, or still be referenced by a losing branch, when the
+    // handler is invoked.
+    asio::detail::prepend_handler<Handler, std::size_t> index_handler(
+        static_cast<Handler&&>(handler_), std::tuple<std::size_t>(index));
+    asio::detail::completion_payload_handler<Payload,
+      asio::detail::prepend_handler<Handler, std::size_t>> handler(
+        static_cast<Payload&&>(*payload), index_handler);
+
+    release();
+
+    if (how == channel_select_immediate)
+      w.immediate(handler, handler.handler_.handler_, 0);
+    else if (how == channel_select_dispatch)
+      w.dispatch(handler, handler.handler_.handler_);
+    else
+      w.post(handler, handler.handler_.handler_);
+  }
+
+  // Helper class used to implement per-operation cancellation.
+  class op_cancellation
+  {
+  public:
+    explicit op_cancellation(channel_select_op* op)
+      : op_(op)
+    {
+      op_->add_ref();
+    }
+
+    op_cancellation(const op_cancellation&) = delete;
+    op_cancellation& operator=(const op_cancellation&) = delete;
+
+    ~op_cancellation()
+    {
+      op_->release();
+    }
+
+    void operator()(cancellation_type_t type)
+    {
+      if (!!(type &
+            (cancellation_type::terminal
+              | cancellation_type::partial
+              | cancellation_type::total)))
+      {
+        void* winner = 0;
+        if (op_->winner_.compare_exchange_strong(winner,
+              &op_->winner_, std::memory_order_acq_rel))
+        {
+          // Completion drops a reference, but this object still holds one.
+          op_->add_ref();
+          Traits::invoke_receive_cancelled(post_cancelled(op_));
+        }
+      }
+    }
+
+  private:
+    struct post_cancelled
+    {
+      explicit post_cancelled(channel_select_op* op)
+        : op_(op)
+      {
+      }
+
+      template <typename... Args>
+      void operator()(Args&&... args)
+      {
+        Payload payload(
+            asio::detail::completion_message<
+              typename Traits::receive_cancelled_signature>(0,
+                static_cast<Args&&>(args)...));
+        op_->complete(N, &payload, channel_select_post);
+      }
+
+      channel_select_op* op_;
+    };
+
+    channel_select_op* op_;
+  };
+
+private:
+  Handler handler_;
+  channel_operation::handler_work<Handler, IoExecutor> work_;
+  Alloc allocator_;
+  std::atomic<void*> winner_;
+  std::atomic<std::size_t> ref_count_;
+  branch_type branches_[N];
+};
+
+// Function object used to complete a select whose channel was ready.
+template <typename Handler, typename IoExecutor>
+class channel_select_ready
+{
+public:
+  channel_select_ready(Handler& handler,
+      const IoExecutor& io_ex, std::size_t index)
+    : handler_(handler),
+      io_executor_(io_ex),
+      index_(index)
+  {
+  }
+
+  template <typename... Args>
+  void operator()(Args&&... args)
+  {
+    channel_operation::handler_work<Handler, IoExecutor> w(
+        handler_, io_executor_);
+
+    asio::detail::prepend_handler<Handler,
+      std::size_t, decay_t<Args>...> handler(
+        static_cast<Handler&&>(handler_),
+        std::tuple<std::size_t, decay_t<Args>...>(
+          index_, static_cast<Args&&>(args)...));
+
+    w.immediate(handler, handler.handler_, 0);
+  }
+
+private:
+  Handler& handler_;
+  const IoExecutor& io_executor_;
+  std::size_t index_;
+};
+
+// Attempt to complete a select from the first channel that is ready.
+template <std::size_t I, typename Handler,
+    typename IoExecutor, typename... Channels>
+inline bool channel_select_try_receive(Handler&,
+    const IoExecutor&, std::tuple<Channels*...>&,
+    enable_if_t<I == sizeof...(Channels)>* = 0)
+{
+  return false;
+}
+
+template <std::size_t I, typename Handler,
+    typename IoExecutor, typename... Channels>
+inline bool channel_select_try_receive(Handler& handler,
+    const IoExecutor& io_ex, std::tuple<Channels*...>& channels,
+    enable_if_t<I < sizeof...(Channels)>* = 0)
+{
+  typedef typename std::tuple_element<I,
+    std::tuple<Channels...>>::type channel_type;
+
+  channel_type& channel = *std::get<I>(channels);
+  if (channel_select_access::service(channel).try_receive(
+        channel_select_access::implementation(channel),
+        channel_select_ready<Handler, IoExecutor>(handler, io_ex, I)))
+    return true;
+
+  return (channel_select_try_receive<I + 1>)(handler, io_ex, channels);
+}
+
+// Register the branches of a select with their channels, stopping early if the
+// select has already been won.
+template <std::size_t I, typename Op, typename... Channels>
+inline void channel_select_start(Op*, std::tuple<Channels*...>&,
+    enable_if_t<I == sizeof...(Channels)>* = 0)
+{
+}
+
+template <std::size_t I, typename Op, typename... Channels>
+inline void channel_select_start(Op* op, std::tuple<Channels*...>& channels,
+    enable_if_t<I < sizeof...(Channels)>* = 0)
+{
+  if (op->has_winner())
+  {
+    // Drop the references held for the branches that were not registered.
+    // This may deallocate the operation, so it is not touched afterwards.
+    for (std::size_t i = I; i < sizeof...(Channels); ++i)
+      op->branch(i)->destroy();
+    return;
+  }
+
+  typedef typename std::tuple_element<I,
+    std::tuple<Channels...>>::type channel_type;
+
+  channel_type& channel = *std::get<I>(channels);
+  channel_select_access::service(channel).start_select_receive(
+      channel_select_access::implementation(channel), op->branch(I));
+
+  (channel_select_start<I + 1>)(op, channels);
+}
+
+} // namespace detail
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXPERIMENTAL_DETAIL_CHANNEL_SELECT_OP_HPP
@@ -34,6 +34,8 @@ namespace asio {
 namespace experimental {
 namespace detail {
 
+class channel_select_access;
+
 template <typename Mutex>
 class channel_service
   : public asio::detail::execution_context_service_base<
@@ -219,6 +221,15 @@ public:
     p.v = p.p = 0;
   }
 
+  // Start one branch of a select over several channels. If the channel is
+  // not ready, the branch waits alongside the channel's other receivers.
+  // Otherwise, it completes immediately unless another branch has already
+  // won the select.
+  template <typename Traits, typename... Signatures>
+  void start_select_receive(implementation_type<Traits, Signatures...>& impl,
+      channel_receive<typename implementation_type<
+        Traits, Signatures...>::payload_type>* branch);
+
 private:
   // Helper function object to handle a closed notification.
   template <typename Payload, typename Signature>
@@ -255,6 +266,17 @@ private:
       channel_receive<typename implementation_type<
         Traits, Signatures...>::payload_type>* receive_op);
 
+  // Helper function to remove the first waiting receive operation that may be
+  // completed, discarding any select branches that have lost. If there is no
+  // such operation, the send state is reset and null is returned.
+  template <typename Payload>
+  static channel_receive<Payload>* claim_receive_op(
+      base_implementation_type& impl);
+
+  // Helper function to discard waiting select branches that have lost.
+  template <typename Payload>
+  static void discard_stale_receive_ops(base_implementation_type& impl);
+
   // Helper class used to implement per-operation cancellation.
   template <typename Traits, typename... Signatures>
   class op_cancellation
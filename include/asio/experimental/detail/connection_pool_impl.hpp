@@ -0,0 +1,377 @@
+//
+// experimental/detail/connection_pool_impl.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_DETAIL_CONNECTION_POOL_IMPL_HPP
+#define ASIO_EXPERIMENTAL_DETAIL_CONNECTION_POOL_IMPL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <vector>
+#include "asio/compose.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+namespace detail {
+
+// Determines whether a stream performs a client handshake once its lowest
+// layer is connected, as ssl::stream does.
+template <typename Stream, typename = void>
+struct connection_pool_has_handshake : false_type
+{
+};
+
+template <typename Stream>
+struct connection_pool_has_handshake<Stream,
+    void_t<decltype(Stream::client)>> : true_type
+{
+};
+
+// Asynchronously creates a stream and connects it to an endpoint, performing
+// a client handshake if the stream requires one.
+template <typename Stream>
+class connection_pool_connect_op
+{
+public:
+  typedef typename Stream::lowest_layer_type::protocol_type::endpoint
+    endpoint_type;
+
+  connection_pool_connect_op(Stream&& stream, const endpoint_type& endpoint)
+    : stream_(new Stream(static_cast<Stream&&>(stream))),
+      endpoint_(endpoint),
+      state_(starting)
+  {
+  }
+
+  template <typename Self>
+  void operator()(Self& self, asio::error_code ec = asio::error_code())
+  {
+    switch (state_)
+    {
+    case starting:
+      state_ = connecting;
+      stream_->lowest_layer().async_connect(endpoint_,
+          static_cast<Self&&>(self));
+      return;
+    case connecting:
+      if (!ec && connection_pool_has_handshake<Stream>::value)
+      {
+        state_ = handshaking;
+        handshake(static_cast<Self&&>(self),
+            connection_pool_has_handshake<Stream>());
+        return;
+      }
+      // Fall through.
+    default:
+      if (ec)
+      {
+        asio::error_code ignored;
+        stream_->lowest_layer().close(ignored);
+      }
+      self.complete(ec, static_cast<Stream&&>(*stream_));
+    }
+  }
+
+private:
+  template <typename Self>
+  void handshake(Self&& self, true_type)
+  {
+    stream_->async_handshake(Stream::client, static_cast<Self&&>(self));
+  }
+
+  template <typename Self>
+  void handshake(Self&&, false_type)
+  {
+  }
+
+  // The stream is held by pointer so that its address is stable while the
+  // operation object is moved between intermediate operations.
+  std::unique_ptr<Stream> stream_;
+  endpoint_type endpoint_;
+  enum { starting, connecting, handshaking } state_;
+};
+
+// Determines cheaply whether an idle connection may be handed out again.
+template <typename Stream>
+bool connection_pool_is_reusable(Stream& stream)
+{
+  typedef typename Stream::lowest_layer_type lowest_layer_type;
+
+  lowest_layer_type& socket = stream.lowest_layer();
+  if (!socket.is_open())
+    return false;
+
+  // An idle connection that is not readable has neither received data nor
+  // been closed by the peer.
+  asio::error_code ec;
+  int result = asio::detail::socket_ops::poll_read(
+      socket.native_handle(), 0, 0, ec);
+  if (result == 0)
+    return true;
+  if (result < 0)
+    return false;
+
+  // Peek at the pending data, which does not block as the socket is readable,
+  // to distinguish end of file or an error from unsolicited data.
+  char data;
+  asio::detail::signed_size_type bytes = asio::detail::socket_ops::recv1(
+      socket.native_handle(), &data, 1, ASIO_OS_DEF(MSG_PEEK), ec);
+  if (bytes <= 0)
+    return false;
+
+  // Unsolicited data on a plain socket means that the connection is out of
+  // step with the peer. A layered stream, such as ssl::stream, may receive
+  // records that are consumed by the layer itself.
+  return !is_base_of<lowest_layer_type, Stream>::value;
+}
+
+// The state shared between a connection pool and its pending operations.
+template <typename Stream>
+class connection_pool_state
+  : public std::enable_shared_from_this<
+      connection_pool_state<Stream>>
+{
+public:
+  typedef typename Stream::executor_type executor_type;
+  typedef typename Stream::lowest_layer_type::protocol_type::endpoint
+    endpoint_type;
+  typedef std::function<Stream(const executor_type&)> factory_type;
+
+  connection_pool_state(const executor_type& ex,
+      const factory_type& factory, std::size_t max_idle)
+    : executor_(ex),
+      factory_(factory),
+      max_idle_(max_idle),
+      closed_(false)
+  {
+  }
+
+  const executor_type& get_executor() const noexcept
+  {
+    return executor_;
+  }
+
+  Stream create() const
+  {
+    return factory_(executor_);
+  }
+
+  // Takes a reusable idle connection, if any, and starts any connections that
+  // are required to restore the endpoint's minimum.
+  bool take_idle(const endpoint_type& ep,
+      std::unique_ptr<Stream>& stream)
+  {
+    std::vector<Stream> dead;
+    std::size_t connects = 0;
+    {
+      asio::detail::mutex::scoped_lock lock(mutex_);
+      endpoint_state& s = endpoints_[ep];
+      while (!s.idle.empty())
+      {
+        Stream candidate(static_cast<Stream&&>(s.idle.back()));
+        s.idle.pop_back();
+        if (connection_pool_is_reusable(candidate))
+        {
+          stream.reset(new Stream(static_cast<Stream&&>(candidate)));
+          break;
+        }
+        dead.push_back(static_cast<Stream&&>(candidate));
+      }
+      connects = connects_required(s);
+    }
+
+    // Connections are closed, and new ones started, outside the lock.
+    dead.clear();
+    start_connects(ep, connects);
+    return !!stream;
+  }
+
+  // Sets the minimum number of idle connections for an endpoint and starts
+  // any connections required to reach it.
+  void set_min_idle(const endpoint_type& ep, std::size_t min_idle)
+  {
+    std::size_t connects = 0;
+    {
+      asio::detail::mutex::scoped_lock lock(mutex_);
+      endpoint_state& s = endpoints_[ep];
+      s.min_idle = min_idle;
+      connects = connects_required(s);
+    }
+    start_connects(ep, connects);
+  }
+
+  // Returns a connection to the pool.
+  void add_idle(const endpoint_type& ep, Stream&& stream)
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    endpoint_state& s = endpoints_[ep];
+    if (!closed_ && s.idle.size() < max_idle_
+        && stream.lowest_layer().is_open())
+    {
+      s.idle.push_back(static_cast<Stream&&>(stream));
+      return;
+    }
+    lock.unlock();
+    asio::error_code ignored;
+    stream.lowest_layer().close(ignored);
+  }
+
+  // Gets the number of idle connections for an endpoint.
+  std::size_t idle(const endpoint_type& ep) const
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    typename std::map<endpoint_type, endpoint_state>::const_iterator iter =
+      endpoints_.find(ep);
+    return iter == endpoints_.end() ? 0 : iter->second.idle.size();
+  }
+
+  // Closes all idle connections. If the pool is being destroyed, connections
+  // that are subsequently established are closed too.
+  void clear(bool closing)
+  {
+    std::map<endpoint_type, endpoint_state> endpoints;
+    {
+      asio::detail::mutex::scoped_lock lock(mutex_);
+      if (closing)
+      {
+        closed_ = true;
+        endpoints.swap(endpoints_);
+      }
+      else
+      {
+        for (typename std::map<endpoint_type, endpoint_state>::iterator
+            iter = endpoints_.begin(); iter != endpoints_.end(); ++iter)
+          endpoints[iter->first].idle.swap(iter->second.idle);
+      }
+    }
+  }
+
+private:
+  struct endpoint_state
+  {
+    endpoint_state()
+      : min_idle(0),
+        connecting(0)
+    {
+    }
+
+    // Idle connections, with the most recently used at the back.
+    std::vector<Stream> idle;
+
+    // The number of idle connections to maintain.
+    std::size_t min_idle;
+
+    // The number of connections being established to restore the minimum.
+    std::size_t connecting;
+  };
+
+  // Determines how many connections must be started to restore the minimum.
+  // The caller must hold the lock.
+  std::size_t connects_required(endpoint_state& s)
+  {
+    if (closed_ || s.idle.size() + s.connecting >= s.min_idle)
+      return 0;
+    std::size_t n = s.min_idle - s.idle.size() - s.connecting;
+    s.connecting += n;
+    return n;
+  }
+
+  // Starts connections in the background.
+  void start_connects(const endpoint_type& ep, std::size_t n)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      connect_handler handler(this->shared_from_this(), ep);
+      asio::async_compose<connect_handler, void (asio::error_code, Stream)>(
+          connection_pool_connect_op<Stream>(create(), ep),
+          handler, executor_);
+    }
+  }
+
+  // Adds a connection that was established in the background to the pool.
+  void connected(const endpoint_type& ep,
+      const asio::error_code& ec, Stream&& stream)
+  {
+    {
+      asio::detail::mutex::scoped_lock lock(mutex_);
+      if (!closed_)
+      {
+        endpoint_state& s = endpoints_[ep];
+        --s.connecting;
+
+        // A failed connection is not retried until the next time a
+        // connection is acquired from, or the minimum is set for, the
+        // endpoint.
+        if (!ec && s.idle.size() < max_idle_)
+        {
+          s.idle.push_back(static_cast<Stream&&>(stream));
+          return;
+        }
+      }
+    }
+    asio::error_code ignored;
+    stream.lowest_layer().close(ignored);
+  }
+
+  class connect_handler
+  {
+  public:
+    typedef typename connection_pool_state::executor_type executor_type;
+
+    connect_handler(
+        const std::shared_ptr<connection_pool_state>& state,
+        const endpoint_type& ep)
+      : state_(state),
+        endpoint_(ep)
+    {
+    }
+
+    executor_type get_executor() const noexcept
+    {
+      return state_->get_executor();
+    }
+
+    void operator()(const asio::error_code& ec, Stream stream)
+    {
+      state_->connected(endpoint_, ec, static_cast<Stream&&>(stream));
+    }
+
+  private:
+    std::shared_ptr<connection_pool_state> state_;
+    endpoint_type endpoint_;
+  };
+
+  executor_type executor_;
+  factory_type factory_;
+  const std::size_t max_idle_;
+  mutable asio::detail::mutex mutex_;
+  std::map<endpoint_type, endpoint_state> endpoints_;
+  bool closed_;
+};
+
+} // namespace detail
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXPERIMENTAL_DETAIL_CONNECTION_POOL_IMPL_HPP
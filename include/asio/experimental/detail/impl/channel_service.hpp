@@ -204,10 +204,16 @@ void channel_service<Mutex>::close(
     while (channel_operation* op = impl.waiters_.front())
     {
       impl.waiters_.pop();
-      traits_type::invoke_receive_closed(
-          post_receive<payload_type,
-            typename traits_type::receive_closed_signature>(
-              static_cast<channel_receive<payload_type>*>(op)));
+      channel_receive<payload_type>* receive_op =
+        static_cast<channel_receive<payload_type>*>(op);
+      if (receive_op->try_claim())
+      {
+        traits_type::invoke_receive_closed(
+            post_receive<payload_type,
+              typename traits_type::receive_closed_signature>(receive_op));
+      }
+      else
+        receive_op->destroy();
     }
   }
 
@@ -238,10 +244,16 @@ void channel_service<Mutex>::cancel(
     else
     {
       impl.waiters_.pop();
-      traits_type::invoke_receive_cancelled(
-          post_receive<payload_type,
-            typename traits_type::receive_cancelled_signature>(
-              static_cast<channel_receive<payload_type>*>(op)));
+      channel_receive<payload_type>* receive_op =
+        static_cast<channel_receive<payload_type>*>(op);
+      if (receive_op->try_claim())
+      {
+        traits_type::invoke_receive_cancelled(
+            post_receive<payload_type,
+              typename traits_type::receive_cancelled_signature>(receive_op));
+      }
+      else
+        receive_op->destroy();
     }
   }
 
@@ -322,6 +334,10 @@ bool channel_service<Mutex>::try_send(
 
   typename Mutex::scoped_lock lock(impl.mutex_);
 
+  channel_receive<payload_type>* receive_op = 0;
+  if (impl.send_state_ == waiter)
+    receive_op = claim_receive_op<payload_type>(impl);
+
   switch (impl.send_state_)
   {
   case block:
@@ -339,9 +355,6 @@ bool channel_service<Mutex>::try_send(
   case waiter:
     {
       payload_type payload(Message(0, static_cast<Args&&>(args)...));
-      channel_receive<payload_type>* receive_op =
-        static_cast<channel_receive<payload_type>*>(impl.waiters_.front());
-      impl.waiters_.pop();
       if (impl.waiters_.empty())
         impl.send_state_ = impl.max_buffer_size_ ? buffer : block;
       lock.unlock();
@@ -388,8 +401,13 @@ std::size_t channel_service<Mutex>::try_send_n(
 
   payload_type payload(Message(0, static_cast<Args&&>(args)...));
 
-  for (std::size_t i = 0; i < count; ++i)
+  std::size_t i = 0;
+  while (i < count)
   {
+    channel_receive<payload_type>* receive_op = 0;
+    if (impl.send_state_ == waiter)
+      receive_op = claim_receive_op<payload_type>(impl);
+
     switch (impl.send_state_)
     {
     case block:
@@ -407,9 +425,6 @@ std::size_t channel_service<Mutex>::try_send_n(
       }
     case waiter:
       {
-        channel_receive<payload_type>* receive_op =
-          static_cast<channel_receive<payload_type>*>(impl.waiters_.front());
-        impl.waiters_.pop();
         if (impl.waiters_.empty())
           impl.send_state_ = impl.max_buffer_size_ ? buffer : block;
         lock.unlock();
@@ -417,6 +432,7 @@ std::size_t channel_service<Mutex>::try_send_n(
           receive_op->dispatch(payload);
         else
           receive_op->post(payload);
+        ++i;
         break;
       }
     case closed:
@@ -442,6 +458,10 @@ void channel_service<Mutex>::start_send_op(
 
   typename Mutex::scoped_lock lock(impl.mutex_);
 
+  channel_receive<payload_type>* receive_op = 0;
+  if (impl.send_state_ == waiter)
+    receive_op = claim_receive_op<payload_type>(impl);
+
   switch (impl.send_state_)
   {
   case block:
@@ -462,9 +482,6 @@ void channel_service<Mutex>::start_send_op(
     }
   case waiter:
     {
-      channel_receive<payload_type>* receive_op =
-        static_cast<channel_receive<payload_type>*>(impl.waiters_.front());
-      impl.waiters_.pop();
       if (impl.waiters_.empty())
         impl.send_state_ = impl.max_buffer_size_ ? buffer : block;
       receive_op->post(send_op->get_payload());
@@ -614,6 +631,76 @@ void channel_service<Mutex>::start_receive_op(
   }
 }
 
+template <typename Mutex>
+template <typename Traits, typename... Signatures>
+void channel_service<Mutex>::start_select_receive(
+    channel_service<Mutex>::implementation_type<Traits, Signatures...>& impl,
+    channel_receive<typename implementation_type<
+      Traits, Signatures...>::payload_type>* branch)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+
+  {
+    typename Mutex::scoped_lock lock(impl.mutex_);
+
+    if (impl.receive_state_ == block)
+    {
+      // Branches left behind by earlier selects are discarded here, so that
+      // a loop that repeatedly selects does not grow the queue of waiters.
+      discard_stale_receive_ops<payload_type>(impl);
+      impl.waiters_.push(branch);
+      if (impl.send_state_ != closed)
+        impl.send_state_ = waiter;
+      return;
+    }
+  }
+
+  // The lock is not held while claiming the select, as a winning branch may
+  // need to lock another channel. If the channel is drained in the meantime,
+  // the claimed branch simply waits for the next value.
+  if (branch->try_claim())
+    start_receive_op(impl, branch);
+  else
+    branch->destroy();
+}
+
+template <typename Mutex>
+template <typename Payload>
+channel_receive<Payload>* channel_service<Mutex>::claim_receive_op(
+    channel_service<Mutex>::base_implementation_type& impl)
+{
+  while (channel_operation* op = impl.waiters_.front())
+  {
+    impl.waiters_.pop();
+    channel_receive<Payload>* receive_op =
+      static_cast<channel_receive<Payload>*>(op);
+    if (receive_op->try_claim())
+      return receive_op;
+    receive_op->destroy();
+  }
+
+  impl.send_state_ = impl.max_buffer_size_ ? buffer : block;
+  return 0;
+}
+
+template <typename Mutex>
+template <typename Payload>
+void channel_service<Mutex>::discard_stale_receive_ops(
+    channel_service<Mutex>::base_implementation_type& impl)
+{
+  asio::detail::op_queue<channel_operation> other_ops;
+  while (channel_operation* op = impl.waiters_.front())
+  {
+    impl.waiters_.pop();
+    if (static_cast<channel_receive<Payload>*>(op)->is_stale())
+      op->destroy();
+    else
+      other_ops.push(op);
+  }
+  impl.waiters_.push(other_ops);
+}
+
 } // namespace detail
 } // namespace experimental
 } // namespace asio
@@ -0,0 +1,202 @@
+//
+// experimental/detail/impl/mailbox_executor_service.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_DETAIL_IMPL_MAILBOX_EXECUTOR_SERVICE_IPP
+#define ASIO_EXPERIMENTAL_DETAIL_IMPL_MAILBOX_EXECUTOR_SERVICE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/call_stack.hpp"
+#include "asio/experimental/detail/mailbox_executor_service.hpp"
+#include "asio/config.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+namespace detail {
+
+mailbox_executor_service::mailbox_executor_service(execution_context& ctx)
+  : asio::detail::execution_context_service_base<
+      mailbox_executor_service>(ctx),
+    mutex_(),
+    impl_list_(0),
+    max_messages_per_turn_(
+        config(ctx).get("mailbox", "max_messages_per_turn", 64U))
+{
+}
+
+void mailbox_executor_service::shutdown()
+{
+  asio::detail::op_queue<asio::detail::scheduler_operation> ops;
+
+  asio::detail::mutex::scoped_lock lock(mutex_);
+
+  mailbox_impl* impl = impl_list_;
+  while (impl)
+  {
+    impl->shutdown_.store(true, std::memory_order_release);
+    take_incoming(impl);
+    ops.push(impl->ready_queue_);
+    impl = impl->next_;
+  }
+}
+
+mailbox_executor_service::implementation_type
+mailbox_executor_service::create_implementation()
+{
+  execution_context::allocator<void> alloc(context());
+  implementation_type new_impl =
+    asio::detail::allocate_shared<mailbox_impl>(alloc);
+  new_impl->incoming_.store(0, std::memory_order_relaxed);
+  new_impl->shutdown_.store(false, std::memory_order_relaxed);
+
+  asio::detail::mutex::scoped_lock lock(mutex_);
+
+  // Insert implementation into linked list of all implementations.
+  new_impl->next_ = impl_list_;
+  new_impl->prev_ = 0;
+  if (impl_list_)
+    impl_list_->prev_ = new_impl.get();
+  impl_list_ = new_impl.get();
+  new_impl->service_ = this;
+
+  return new_impl;
+}
+
+mailbox_executor_service::mailbox_impl::~mailbox_impl()
+{
+  // Messages that were never run are destroyed along with the ready queue.
+  take_incoming(this);
+
+  asio::detail::mutex::scoped_lock lock(service_->mutex_);
+
+  // Remove implementation from linked list of all implementations.
+  if (service_->impl_list_ == this)
+    service_->impl_list_ = next_;
+  if (prev_)
+    prev_->next_ = next_;
+  if (next_)
+    next_->prev_= prev_;
+}
+
+bool mailbox_executor_service::enqueue(const implementation_type& impl,
+    asio::detail::scheduler_operation* op)
+{
+  if (impl->shutdown_.load(std::memory_order_acquire))
+  {
+    op->destroy();
+    return false;
+  }
+
+  // Push the message on to the incoming stack, taking the lock if it is not
+  // already held.
+  uintptr_t old_value = impl->incoming_.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    asio::detail::op_queue_access::next(op,
+        reinterpret_cast<asio::detail::scheduler_operation*>(
+          old_value & ~static_cast<uintptr_t>(locked_bit)));
+    if (impl->incoming_.compare_exchange_weak(old_value,
+          reinterpret_cast<uintptr_t>(op) | locked_bit,
+          std::memory_order_release, std::memory_order_relaxed))
+      break;
+  }
+
+  // The function that acquires the lock is responsible for scheduling the
+  // mailbox.
+  return (old_value & locked_bit) == 0;
+}
+
+void mailbox_executor_service::take_incoming(mailbox_impl* impl)
+{
+  uintptr_t value = impl->incoming_.exchange(
+      locked_bit, std::memory_order_acquire);
+  asio::detail::scheduler_operation* newest =
+    reinterpret_cast<asio::detail::scheduler_operation*>(
+        value & ~static_cast<uintptr_t>(locked_bit));
+  if (!newest)
+    return;
+
+  // Reverse the list in place so that the messages are oldest first, and then
+  // splice it on to the end of the ready queue.
+  asio::detail::scheduler_operation* oldest = 0;
+  asio::detail::scheduler_operation* op = newest;
+  while (op)
+  {
+    asio::detail::scheduler_operation* next =
+      asio::detail::op_queue_access::next(op);
+    asio::detail::op_queue_access::next(op, oldest);
+    oldest = op;
+    op = next;
+  }
+
+  typedef asio::detail::op_queue_access access;
+  if (access::back(impl->ready_queue_))
+    access::next(access::back(impl->ready_queue_), oldest);
+  else
+    access::front(impl->ready_queue_) = oldest;
+  access::back(impl->ready_queue_) = newest;
+}
+
+bool mailbox_executor_service::running_in_this_thread(
+    const implementation_type& impl)
+{
+  return !!asio::detail::call_stack<mailbox_impl>::contains(impl.get());
+}
+
+bool mailbox_executor_service::more_messages(implementation_type& impl)
+{
+  // Messages left over from this turn keep the lock held.
+  if (!impl->ready_queue_.empty())
+    return true;
+
+  // Release the lock, unless new messages have arrived.
+  uintptr_t expected = locked_bit;
+  return !impl->incoming_.compare_exchange_strong(expected, 0,
+      std::memory_order_release, std::memory_order_relaxed);
+}
+
+void mailbox_executor_service::run_ready_messages(implementation_type& impl)
+{
+  // Indicate that this mailbox is executing on the current thread.
+  asio::detail::call_stack<mailbox_impl>::context ctx(impl.get());
+
+  // Take all of the messages that have arrived since the last turn with a
+  // single atomic operation.
+  take_incoming(impl.get());
+
+  // Run the ready messages. No lock is required since the ready queue is
+  // accessed only by the holder of the mailbox's lock. Any messages left over
+  // once the per-turn limit is reached remain at the front of the ready
+  // queue, and the mailbox is rescheduled behind other pending work by the
+  // invoker's exit handler.
+  asio::error_code ec;
+  std::size_t limit = impl->service_->max_messages_per_turn_;
+  for (std::size_t n = 0; limit == 0 || n < limit; ++n)
+  {
+    asio::detail::scheduler_operation* o = impl->ready_queue_.front();
+    if (!o)
+      break;
+    impl->ready_queue_.pop();
+    o->complete(impl.get(), ec, 0);
+  }
+}
+
+} // namespace detail
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXPERIMENTAL_DETAIL_IMPL_MAILBOX_EXECUTOR_SERVICE_IPP
@@ -0,0 +1,254 @@
+//
+// experimental/detail/impl/semaphore_service.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_DETAIL_IMPL_SEMAPHORE_SERVICE_IPP
+#define ASIO_EXPERIMENTAL_DETAIL_IMPL_SEMAPHORE_SERVICE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/error.hpp"
+#include "asio/experimental/detail/semaphore_service.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+namespace detail {
+
+semaphore_service::semaphore_service(execution_context& ctx)
+  : asio::detail::execution_context_service_base<semaphore_service>(ctx),
+    mutex_(),
+    impl_list_(0)
+{
+}
+
+void semaphore_service::shutdown()
+{
+  // Abandon all pending operations.
+  asio::detail::op_queue<semaphore_operation> ops;
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  base_implementation_type* impl = impl_list_;
+  while (impl)
+  {
+    ops.push(impl->waiters_);
+    impl = impl->next_;
+  }
+}
+
+void semaphore_service::construct(
+    semaphore_service::implementation_type& impl,
+    std::ptrdiff_t initial_count)
+{
+  impl.count_.store(initial_count, std::memory_order_relaxed);
+
+  // Insert implementation into linked list of all implementations.
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  impl.next_ = impl_list_;
+  impl.prev_ = 0;
+  if (impl_list_)
+    impl_list_->prev_ = &impl;
+  impl_list_ = &impl;
+}
+
+void semaphore_service::construct(
+    semaphore_service::rate_limiter_implementation_type& impl,
+    asio::int64_t interval, std::size_t burst)
+{
+  impl.full_time_.store(0, std::memory_order_relaxed);
+  impl.interval_ = interval > 0 ? interval : 1;
+  impl.burst_ = burst > 0 ? burst : 1;
+  impl.has_waiters_.store(false, std::memory_order_relaxed);
+
+  // Insert implementation into linked list of all implementations.
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  impl.next_ = impl_list_;
+  impl.prev_ = 0;
+  if (impl_list_)
+    impl_list_->prev_ = &impl;
+  impl_list_ = &impl;
+}
+
+std::size_t semaphore_service::cancel(
+    semaphore_service::implementation_type& impl)
+{
+  asio::detail::op_queue<semaphore_operation> ops;
+  std::size_t n = 0;
+
+  asio::detail::mutex::scoped_lock lock(impl.mutex_);
+  while (semaphore_operation* op = impl.waiters_.front())
+  {
+    impl.waiters_.pop();
+    ops.push(op);
+    ++n;
+  }
+
+  // The cancelled operations no longer count against the permits. As the
+  // waiters are only handed permits while holding the mutex, none of the
+  // cancelled operations has been granted one.
+  impl.count_.fetch_add(static_cast<std::ptrdiff_t>(n),
+      std::memory_order_acq_rel);
+  lock.unlock();
+
+  while (semaphore_operation* op = ops.front())
+  {
+    ops.pop();
+    op->post(asio::error::operation_aborted);
+  }
+
+  return n;
+}
+
+std::size_t semaphore_service::cancel(
+    semaphore_service::rate_limiter_implementation_type& impl)
+{
+  asio::detail::op_queue<semaphore_operation> ops;
+  std::size_t n = 0;
+
+  asio::detail::mutex::scoped_lock lock(impl.mutex_);
+  while (semaphore_operation* op = impl.waiters_.front())
+  {
+    impl.waiters_.pop();
+    ops.push(op);
+    ++n;
+  }
+  impl.has_waiters_.store(false, std::memory_order_release);
+  lock.unlock();
+
+  while (semaphore_operation* op = ops.front())
+  {
+    ops.pop();
+    op->post(asio::error::operation_aborted);
+  }
+
+  return n;
+}
+
+void semaphore_service::cancel_by_key(
+    semaphore_service::implementation_type& impl,
+    void* cancellation_key)
+{
+  asio::detail::op_queue<semaphore_operation> other_ops;
+  semaphore_operation* cancelled_op = 0;
+
+  asio::detail::mutex::scoped_lock lock(impl.mutex_);
+  while (semaphore_operation* op = impl.waiters_.front())
+  {
+    impl.waiters_.pop();
+    if (!cancelled_op && op->cancellation_key_ == cancellation_key)
+      cancelled_op = op;
+    else
+      other_ops.push(op);
+  }
+  impl.waiters_.push(other_ops);
+
+  if (cancelled_op)
+    impl.count_.fetch_add(1, std::memory_order_acq_rel);
+  lock.unlock();
+
+  if (cancelled_op)
+    cancelled_op->post(asio::error::operation_aborted);
+}
+
+void semaphore_service::cancel_by_key(
+    semaphore_service::rate_limiter_implementation_type& impl,
+    void* cancellation_key)
+{
+  asio::detail::op_queue<semaphore_operation> other_ops;
+  semaphore_operation* cancelled_op = 0;
+
+  asio::detail::mutex::scoped_lock lock(impl.mutex_);
+  while (semaphore_operation* op = impl.waiters_.front())
+  {
+    impl.waiters_.pop();
+    if (!cancelled_op && op->cancellation_key_ == cancellation_key)
+      cancelled_op = op;
+    else
+      other_ops.push(op);
+  }
+  impl.waiters_.push(other_ops);
+
+  if (impl.waiters_.empty())
+    impl.has_waiters_.store(false, std::memory_order_release);
+  lock.unlock();
+
+  if (cancelled_op)
+    cancelled_op->post(asio::error::operation_aborted);
+}
+
+void semaphore_service::base_destroy(
+    semaphore_service::base_implementation_type& impl)
+{
+  // Remove implementation from linked list of all implementations.
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  if (impl_list_ == &impl)
+    impl_list_ = impl.next_;
+  if (impl.prev_)
+    impl.prev_->next_ = impl.next_;
+  if (impl.next_)
+    impl.next_->prev_= impl.prev_;
+  impl.next_ = 0;
+  impl.prev_ = 0;
+}
+
+void semaphore_service::start_wait_op(
+    semaphore_service::implementation_type& impl,
+    semaphore_operation* op)
+{
+  asio::detail::mutex::scoped_lock lock(impl.mutex_);
+
+  // Once counted as a waiter, the operation must be queued before the lock is
+  // released, as a concurrent release() will expect to find it.
+  if (impl.count_.fetch_sub(1, std::memory_order_acq_rel) > 0)
+  {
+    lock.unlock();
+    op->immediate(asio::error_code());
+    return;
+  }
+
+  impl.waiters_.push(op);
+}
+
+void semaphore_service::release_waiters(
+    semaphore_service::implementation_type& impl, std::size_t n)
+{
+  asio::detail::op_queue<semaphore_operation> ops;
+
+  // While the mutex is held, the waiters cannot be cancelled and no new
+  // waiters can be counted, so a negative count is exactly the number of
+  // queued operations. Permits beyond those remain in the count.
+  asio::detail::mutex::scoped_lock lock(impl.mutex_);
+  std::ptrdiff_t prev = impl.count_.fetch_add(
+      static_cast<std::ptrdiff_t>(n), std::memory_order_acq_rel);
+  for (std::ptrdiff_t waiters = -prev; waiters > 0 && n > 0; --waiters, --n)
+  {
+    semaphore_operation* op = impl.waiters_.front();
+    impl.waiters_.pop();
+    ops.push(op);
+  }
+  lock.unlock();
+
+  // Handlers are always posted, so that a chain of releases cannot recurse.
+  while (semaphore_operation* op = ops.front())
+  {
+    ops.pop();
+    op->post(asio::error_code());
+  }
+}
+
+} // namespace detail
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXPERIMENTAL_DETAIL_IMPL_SEMAPHORE_SERVICE_IPP
@@ -0,0 +1,172 @@
+//
+// experimental/detail/mailbox_executor_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_DETAIL_MAILBOX_EXECUTOR_SERVICE_HPP
+#define ASIO_EXPERIMENTAL_DETAIL_MAILBOX_EXECUTOR_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/executor_op.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/detail/scheduler_operation.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/execution.hpp"
+#include "asio/execution_context.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+namespace detail {
+
+// Default service implementation for a mailbox.
+class mailbox_executor_service
+  : public asio::detail::execution_context_service_base<
+      mailbox_executor_service>
+{
+public:
+  // The underlying implementation of a mailbox.
+  class mailbox_impl
+  {
+  public:
+    ASIO_DECL ~mailbox_impl();
+
+  private:
+    friend class mailbox_executor_service;
+
+    // The messages that have been sent to the mailbox but not yet taken by
+    // the mailbox's owner, as a pointer to the most recent message. Messages
+    // are linked through their intrusive next pointers, newest first. The low
+    // bit is set while the mailbox is "locked", i.e. when it has been
+    // scheduled to run, or is running, its messages.
+    std::atomic<uintptr_t> incoming_;
+
+    // Indicates that the mailbox has been shut down and will accept no
+    // further messages.
+    std::atomic<bool> shutdown_;
+
+    // The messages that are ready to be run, oldest first. The ready queue is
+    // only modified by the holder of the mailbox's lock and so may be
+    // accessed without synchronisation.
+    asio::detail::op_queue<asio::detail::scheduler_operation> ready_queue_;
+
+    // Pointers to adjacent handle implementations in linked list.
+    mailbox_impl* next_;
+    mailbox_impl* prev_;
+
+    // The mailbox service in where the implementation is held.
+    mailbox_executor_service* service_;
+  };
+
+  typedef asio::detail::shared_ptr<mailbox_impl> implementation_type;
+
+  // Construct a new mailbox service for the specified context.
+  ASIO_DECL explicit mailbox_executor_service(execution_context& context);
+
+  // Destroy all user-defined handler objects owned by the service.
+  ASIO_DECL void shutdown();
+
+  // Create a new mailbox implementation.
+  ASIO_DECL implementation_type create_implementation();
+
+  // Request invocation of the given function.
+  template <typename Executor, typename Function>
+  static void execute(const implementation_type& impl, Executor& ex,
+      Function&& function,
+      enable_if_t<
+        can_query<Executor, execution::allocator_t<void>>::value
+      >* = 0);
+
+  // Request invocation of the given function.
+  template <typename Executor, typename Function>
+  static void execute(const implementation_type& impl, Executor& ex,
+      Function&& function,
+      enable_if_t<
+        !can_query<Executor, execution::allocator_t<void>>::value
+      >* = 0);
+
+  // Request invocation of the given function.
+  template <typename Executor, typename Function, typename Allocator>
+  static void dispatch(const implementation_type& impl, Executor& ex,
+      Function&& function, const Allocator& a);
+
+  // Request invocation of the given function and return immediately.
+  template <typename Executor, typename Function, typename Allocator>
+  static void post(const implementation_type& impl, Executor& ex,
+      Function&& function, const Allocator& a);
+
+  // Request invocation of the given function and return immediately.
+  template <typename Executor, typename Function, typename Allocator>
+  static void defer(const implementation_type& impl, Executor& ex,
+      Function&& function, const Allocator& a);
+
+  // Determine whether the mailbox is running in the current thread.
+  ASIO_DECL static bool running_in_this_thread(
+      const implementation_type& impl);
+
+private:
+  friend class mailbox_impl;
+  template <typename F, typename Allocator> class allocator_binder;
+  template <typename Executor, typename = void> class invoker;
+
+  // The bit of mailbox_impl::incoming_ that indicates the mailbox is locked.
+  enum { locked_bit = 1 };
+
+  // Adds a message to the mailbox without taking a lock. Returns true if it
+  // acquires the mailbox's lock.
+  ASIO_DECL static bool enqueue(const implementation_type& impl,
+      asio::detail::scheduler_operation* op);
+
+  // Moves all incoming messages to the end of the ready queue.
+  ASIO_DECL static void take_incoming(mailbox_impl* impl);
+
+  // Determines whether there are more messages to run. If there are not, the
+  // mailbox's lock is released.
+  ASIO_DECL static bool more_messages(implementation_type& impl);
+
+  // Runs ready messages, up to the configured per-turn limit.
+  ASIO_DECL static void run_ready_messages(implementation_type& impl);
+
+  // Helper function to request invocation of the given function.
+  template <typename Executor, typename Function, typename Allocator>
+  static void do_execute(const implementation_type& impl, Executor& ex,
+      Function&& function, const Allocator& a);
+
+  // Mutex to protect access to the service-wide state.
+  asio::detail::mutex mutex_;
+
+  // The head of a linked list of all implementations.
+  mailbox_impl* impl_list_;
+
+  // The maximum number of messages to run each time a mailbox is scheduled.
+  // A value of 0 means there is no limit.
+  const std::size_t max_messages_per_turn_;
+};
+
+} // namespace detail
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/experimental/detail/impl/mailbox_executor_service.hpp"
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/experimental/detail/impl/mailbox_executor_service.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_EXPERIMENTAL_DETAIL_MAILBOX_EXECUTOR_SERVICE_HPP
@@ -0,0 +1,332 @@
+//
+// experimental/detail/pipeline_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_DETAIL_PIPELINE_QUEUE_HPP
+#define ASIO_EXPERIMENTAL_DETAIL_PIPELINE_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+namespace detail {
+
+// Indexes that are written by different threads are kept on separate cache
+// lines to avoid false sharing.
+enum { pipeline_queue_padding = 64 };
+
+// Round a requested capacity up to a power of two, with a minimum of two.
+inline std::size_t pipeline_queue_capacity(std::size_t n)
+{
+  std::size_t capacity = 2;
+  while (capacity < n)
+    capacity <<= 1;
+  return capacity;
+}
+
+// Uninitialised storage for a single queue element.
+template <typename T>
+struct pipeline_queue_slot
+{
+  T* get()
+  {
+    return static_cast<T*>(static_cast<void*>(&storage_));
+  }
+
+  alignas(T) unsigned char storage_[sizeof(T)];
+};
+
+// A bounded, lock-free, single-producer single-consumer ring buffer. Each side
+// caches the other side's index so that, in the common case, a push or pop
+// touches only the cache line that it owns.
+template <typename T>
+class spsc_pipeline_queue
+  : private asio::detail::noncopyable
+{
+public:
+  explicit spsc_pipeline_queue(std::size_t capacity)
+    : mask_(pipeline_queue_capacity(capacity) - 1),
+      slots_(new pipeline_queue_slot<T>[mask_ + 1]),
+      head_(0),
+      tail_cache_(0),
+      tail_(0),
+      head_cache_(0)
+  {
+  }
+
+  ~spsc_pipeline_queue()
+  {
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    for (; head != tail; ++head)
+      slots_[head & mask_].get()->~T();
+    delete[] slots_;
+  }
+
+  std::size_t capacity() const
+  {
+    return mask_ + 1;
+  }
+
+  template <typename Arg>
+  bool try_push(Arg&& arg)
+  {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_cache_ > mask_)
+    {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail - head_cache_ > mask_)
+        return false;
+    }
+    new (slots_[tail & mask_].get()) T(static_cast<Arg&&>(arg));
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Remove the oldest element and pass it, as an rvalue, to the function
+  // object f. The slot is released before f is called.
+  template <typename Function>
+  bool try_consume(Function& f)
+  {
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_)
+    {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head == tail_cache_)
+        return false;
+    }
+    T* value = slots_[head & mask_].get();
+    T tmp(static_cast<T&&>(*value));
+    value->~T();
+    head_.store(head + 1, std::memory_order_release);
+    f(static_cast<T&&>(tmp));
+    return true;
+  }
+
+  bool empty() const
+  {
+    return head_.load(std::memory_order_acquire)
+      == tail_.load(std::memory_order_acquire);
+  }
+
+  bool full() const
+  {
+    return tail_.load(std::memory_order_acquire)
+      - head_.load(std::memory_order_acquire) > mask_;
+  }
+
+private:
+  const std::size_t mask_;
+  pipeline_queue_slot<T>* const slots_;
+  char pad0_[pipeline_queue_padding];
+
+  // Consumer side.
+  std::atomic<std::size_t> head_;
+  std::size_t tail_cache_;
+  char pad1_[pipeline_queue_padding];
+
+  // Producer side.
+  std::atomic<std::size_t> tail_;
+  std::size_t head_cache_;
+  char pad2_[pipeline_queue_padding];
+};
+
+// A bounded, lock-free, multi-producer multi-consumer ring buffer. Each slot
+// carries a sequence number that tells producers and consumers whether it is
+// ready for them, so that a push or pop costs a single compare-and-swap on the
+// shared index.
+template <typename T>
+class mpmc_pipeline_queue
+  : private asio::detail::noncopyable
+{
+public:
+  explicit mpmc_pipeline_queue(std::size_t capacity)
+    : mask_(pipeline_queue_capacity(capacity) - 1),
+      cells_(new cell[mask_ + 1]),
+      enqueue_pos_(0),
+      dequeue_pos_(0)
+  {
+    for (std::size_t i = 0; i <= mask_; ++i)
+      cells_[i].sequence_.store(i, std::memory_order_relaxed);
+  }
+
+  ~mpmc_pipeline_queue()
+  {
+    std::size_t head = dequeue_pos_.load(std::memory_order_relaxed);
+    std::size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+    for (; head != tail; ++head)
+      cells_[head & mask_].value_.get()->~T();
+    delete[] cells_;
+  }
+
+  std::size_t capacity() const
+  {
+    return mask_ + 1;
+  }
+
+  template <typename Arg>
+  bool try_push(Arg&& arg)
+  {
+    std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      cell& c = cells_[pos & mask_];
+      std::size_t seq = c.sequence_.load(std::memory_order_acquire);
+      std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - pos);
+      if (diff == 0)
+      {
+        if (enqueue_pos_.compare_exchange_weak(pos,
+              pos + 1, std::memory_order_relaxed))
+        {
+          new (c.value_.get()) T(static_cast<Arg&&>(arg));
+          c.sequence_.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (diff < 0)
+        return false;
+      else
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+
+  // Remove the oldest element and pass it, as an rvalue, to the function
+  // object f. The slot is released before f is called.
+  template <typename Function>
+  bool try_consume(Function& f)
+  {
+    std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      cell& c = cells_[pos & mask_];
+      std::size_t seq = c.sequence_.load(std::memory_order_acquire);
+      std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+      if (diff == 0)
+      {
+        if (dequeue_pos_.compare_exchange_weak(pos,
+              pos + 1, std::memory_order_relaxed))
+        {
+          T* value = c.value_.get();
+          T tmp(static_cast<T&&>(*value));
+          value->~T();
+          c.sequence_.store(pos + mask_ + 1, std::memory_order_release);
+          f(static_cast<T&&>(tmp));
+          return true;
+        }
+      }
+      else if (diff < 0)
+        return false;
+      else
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+
+  bool empty() const
+  {
+    std::size_t pos = dequeue_pos_.load(std::memory_order_acquire);
+    std::size_t seq = cells_[pos & mask_].sequence_.load(
+        std::memory_order_acquire);
+    return static_cast<std::ptrdiff_t>(seq - (pos + 1)) < 0;
+  }
+
+  bool full() const
+  {
+    std::size_t pos = enqueue_pos_.load(std::memory_order_acquire);
+    std::size_t seq = cells_[pos & mask_].sequence_.load(
+        std::memory_order_acquire);
+    return static_cast<std::ptrdiff_t>(seq - pos) < 0;
+  }
+
+private:
+  struct cell
+  {
+    std::atomic<std::size_t> sequence_;
+    pipeline_queue_slot<T> value_;
+  };
+
+  const std::size_t mask_;
+  cell* const cells_;
+  char pad0_[pipeline_queue_padding];
+  std::atomic<std::size_t> enqueue_pos_;
+  char pad1_[pipeline_queue_padding];
+  std::atomic<std::size_t> dequeue_pos_;
+  char pad2_[pipeline_queue_padding];
+};
+
+// The queue in front of a pipeline stage. The single-producer single-consumer
+// ring is used when both the stage and the one feeding it run a single worker.
+template <typename T>
+class pipeline_queue
+  : private asio::detail::noncopyable
+{
+public:
+  pipeline_queue(std::size_t capacity, bool single_producer_consumer)
+    : spsc_(single_producer_consumer
+        ? new spsc_pipeline_queue<T>(capacity) : 0),
+      mpmc_(single_producer_consumer
+        ? 0 : new mpmc_pipeline_queue<T>(capacity))
+  {
+  }
+
+  ~pipeline_queue()
+  {
+    delete spsc_;
+    delete mpmc_;
+  }
+
+  std::size_t capacity() const
+  {
+    return spsc_ ? spsc_->capacity() : mpmc_->capacity();
+  }
+
+  template <typename Arg>
+  bool try_push(Arg&& arg)
+  {
+    return spsc_ ? spsc_->try_push(static_cast<Arg&&>(arg))
+      : mpmc_->try_push(static_cast<Arg&&>(arg));
+  }
+
+  template <typename Function>
+  bool try_consume(Function& f)
+  {
+    return spsc_ ? spsc_->try_consume(f) : mpmc_->try_consume(f);
+  }
+
+  bool empty() const
+  {
+    return spsc_ ? spsc_->empty() : mpmc_->empty();
+  }
+
+  bool full() const
+  {
+    return spsc_ ? spsc_->full() : mpmc_->full();
+  }
+
+private:
+  spsc_pipeline_queue<T>* spsc_;
+  mpmc_pipeline_queue<T>* mpmc_;
+};
+
+} // namespace detail
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXPERIMENTAL_DETAIL_PIPELINE_QUEUE_HPP
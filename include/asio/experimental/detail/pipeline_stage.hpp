@@ -0,0 +1,520 @@
+//
+// experimental/detail/pipeline_stage.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_DETAIL_PIPELINE_STAGE_HPP
+#define ASIO_EXPERIMENTAL_DETAIL_PIPELINE_STAGE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include "asio/detail/memory.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/experimental/detail/pipeline_queue.hpp"
+#include "asio/post.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+
+template <typename T>
+class pipeline_output;
+
+namespace detail {
+
+// The shared state that owns all of a pipeline's stages. Handlers posted for
+// stage workers hold a reference to keep the stages alive.
+class pipeline_owner
+  : public std::enable_shared_from_this<pipeline_owner>,
+    private asio::detail::noncopyable
+{
+public:
+  virtual ~pipeline_owner()
+  {
+  }
+
+  // Called by the first stage when it has removed values from its queue.
+  virtual void consumed(std::size_t n) = 0;
+
+  // Called by the last stage once it has processed every value.
+  virtual void finished() = 0;
+};
+
+// A worker runs one instance of a stage's function at a time. A stage has as
+// many workers as its configured parallelism. A function pointer is used
+// instead of virtual functions to avoid the associated overhead.
+class pipeline_worker
+  : private asio::detail::noncopyable
+{
+public:
+  enum state_type
+  {
+    // Not running and not scheduled.
+    idle,
+
+    // A handler has been posted to run the worker, or it is running.
+    scheduled,
+
+    // Waiting for space in the next stage's queue.
+    blocked
+  };
+
+  // Post a handler to run the worker.
+  void schedule()
+  {
+    schedule_func_(this);
+  }
+
+  std::atomic<int> state_;
+
+protected:
+  typedef void (*schedule_func_type)(pipeline_worker*);
+
+  explicit pipeline_worker(schedule_func_type schedule_func)
+    : state_(idle),
+      next_waiter_(0),
+      waiting_(false),
+      schedule_func_(schedule_func)
+  {
+  }
+
+  // Prevents deletion through this type.
+  ~pipeline_worker()
+  {
+  }
+
+private:
+  friend class pipeline_waiters;
+  pipeline_worker* next_waiter_;
+  bool waiting_;
+  schedule_func_type schedule_func_;
+};
+
+// The workers of an upstream stage that are blocked on a full queue. This is
+// only used when a stage cannot keep up, and so is protected by a mutex.
+class pipeline_waiters
+  : private asio::detail::noncopyable
+{
+public:
+  pipeline_waiters()
+    : has_waiters_(false),
+      head_(0),
+      tail_(0)
+  {
+  }
+
+  void add(pipeline_worker* w)
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    if (!w->waiting_)
+    {
+      w->waiting_ = true;
+      w->next_waiter_ = 0;
+      if (tail_)
+        tail_->next_waiter_ = w;
+      else
+        head_ = w;
+      tail_ = w;
+    }
+    has_waiters_.store(true, std::memory_order_seq_cst);
+  }
+
+  // Called after values have been removed from the queue.
+  void wake_all()
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!has_waiters_.load(std::memory_order_relaxed))
+      return;
+
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    has_waiters_.store(false, std::memory_order_relaxed);
+    while (pipeline_worker* w = head_)
+    {
+      head_ = w->next_waiter_;
+      w->next_waiter_ = 0;
+      w->waiting_ = false;
+      int expected = pipeline_worker::blocked;
+      if (w->state_.compare_exchange_strong(expected,
+            pipeline_worker::scheduled, std::memory_order_acq_rel))
+        w->schedule();
+    }
+    tail_ = 0;
+  }
+
+private:
+  asio::detail::mutex mutex_;
+  std::atomic<bool> has_waiters_;
+  pipeline_worker* head_;
+  pipeline_worker* tail_;
+};
+
+// Type-erased interface used to close a stage and to destroy it.
+class pipeline_stage_base
+  : private asio::detail::noncopyable
+{
+public:
+  virtual ~pipeline_stage_base()
+  {
+  }
+
+  // Called once the previous stage, or the pipeline's producers, will push no
+  // further values.
+  virtual void close() = 0;
+
+  // The number of workers that run the stage's function.
+  virtual std::size_t parallelism() const = 0;
+};
+
+// The receiving end of a stage.
+template <typename T>
+class pipeline_input : public pipeline_stage_base
+{
+public:
+  // Wake idle workers after n values have been pushed to the queue.
+  virtual void notify(std::size_t n) = 0;
+
+  pipeline_queue<T> queue_;
+  pipeline_waiters waiters_;
+
+protected:
+  pipeline_input(std::size_t capacity, bool single_producer_consumer)
+    : queue_(capacity, single_producer_consumer)
+  {
+  }
+};
+
+// The sending end of a stage, used to connect it to the next one.
+template <typename T>
+class pipeline_connector
+{
+public:
+  virtual void connect(pipeline_input<T>* next) = 0;
+
+protected:
+  // Prevents deletion through this type.
+  ~pipeline_connector()
+  {
+  }
+};
+
+// Collects a worker's output values and hands them to the next stage in
+// batches.
+template <typename T>
+class pipeline_sender
+{
+public:
+  pipeline_sender()
+    : next_(0)
+  {
+  }
+
+  template <typename Function, typename Arg>
+  void call(Function& f, Arg&& arg)
+  {
+    f(static_cast<Arg&&>(arg), output_);
+  }
+
+  // Push as many pending values as possible to the next stage. Returns true
+  // if there are no longer any pending values.
+  bool flush()
+  {
+    std::vector<T>& values = output_.values_;
+    std::size_t first = output_.flushed_;
+    std::size_t last = values.size();
+    std::size_t i = first;
+    while (i < last && next_->queue_.try_push(static_cast<T&&>(values[i])))
+      ++i;
+
+    if (i == last)
+    {
+      values.clear();
+      output_.flushed_ = 0;
+    }
+    else
+      output_.flushed_ = i;
+
+    if (i != first)
+      next_->notify(i - first);
+
+    return i == last;
+  }
+
+  // Register a worker to be rescheduled when the next stage's queue has
+  // space. Returns true if space became available while registering.
+  bool wait(pipeline_worker* w)
+  {
+    next_->waiters_.add(w);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return !next_->queue_.full();
+  }
+
+  pipeline_input<T>* next_;
+
+private:
+  pipeline_output<T> output_;
+};
+
+// The last stage of a pipeline produces no values.
+template <>
+class pipeline_sender<void>
+{
+public:
+  template <typename Function, typename Arg>
+  void call(Function& f, Arg&& arg)
+  {
+    f(static_cast<Arg&&>(arg));
+  }
+
+  bool flush()
+  {
+    return true;
+  }
+
+  bool wait(pipeline_worker*)
+  {
+    return true;
+  }
+
+  pipeline_input<void>* next_;
+};
+
+// A stage that applies a function to each value on the executor, with up to
+// parallelism invocations in flight. Each time a worker runs, it processes up
+// to batch_size values before flushing its output to the next stage and, if
+// there is more work, posting itself again so that it does not monopolise a
+// thread.
+template <typename In, typename Out, typename Function, typename Executor>
+class pipeline_stage
+  : public pipeline_input<In>,
+    public pipeline_connector<Out>
+{
+public:
+  template <typename F>
+  pipeline_stage(pipeline_owner* owner, F&& f, const Executor& ex,
+      std::size_t parallelism, std::size_t capacity, std::size_t batch_size,
+      bool single_producer, bool first)
+    : pipeline_input<In>(capacity, single_producer && parallelism == 1),
+      owner_(owner),
+      function_(static_cast<F&&>(f)),
+      executor_(ex),
+      parallelism_(parallelism),
+      batch_size_(batch_size),
+      first_(first),
+      workers_(new worker[parallelism]),
+      next_stage_(0),
+      active_(0),
+      closed_(false),
+      finished_(false)
+  {
+    for (std::size_t i = 0; i < parallelism_; ++i)
+      workers_[i].stage_ = this;
+  }
+
+  ~pipeline_stage()
+  {
+    delete[] workers_;
+  }
+
+  void connect(pipeline_input<Out>* next)
+  {
+    next_stage_ = next;
+    for (std::size_t i = 0; i < parallelism_; ++i)
+      workers_[i].sender_.next_ = next;
+  }
+
+  std::size_t parallelism() const
+  {
+    return parallelism_;
+  }
+
+  void close()
+  {
+    closed_.store(true, std::memory_order_seq_cst);
+    check_finished();
+  }
+
+  void notify(std::size_t n)
+  {
+    // Pairs with the fence in go_idle() so that either the producer sees an
+    // idle worker, or the worker sees the new values.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    std::size_t wanted = (n + batch_size_ - 1) / batch_size_;
+    for (std::size_t i = 0; i < parallelism_ && wanted > 0; ++i)
+    {
+      worker* w = &workers_[i];
+      int expected = pipeline_worker::idle;
+      if (w->state_.load(std::memory_order_relaxed) == expected
+          && w->state_.compare_exchange_strong(expected,
+            pipeline_worker::scheduled, std::memory_order_acq_rel))
+      {
+        active_.fetch_add(1, std::memory_order_seq_cst);
+        post_worker(w);
+        --wanted;
+      }
+    }
+  }
+
+private:
+  class worker : public pipeline_worker
+  {
+  public:
+    worker()
+      : pipeline_worker(&worker::do_schedule),
+        stage_(0)
+    {
+    }
+
+    static void do_schedule(pipeline_worker* base)
+    {
+      worker* w = static_cast<worker*>(base);
+      w->stage_->post_worker(w);
+    }
+
+    pipeline_stage* stage_;
+    pipeline_sender<Out> sender_;
+  };
+
+  struct run_handler
+  {
+    void operator()()
+    {
+      stage_->run(worker_);
+    }
+
+    pipeline_stage* stage_;
+    worker* worker_;
+    std::shared_ptr<pipeline_owner> owner_;
+  };
+
+  struct consume_function
+  {
+    void operator()(In&& value)
+    {
+      worker_->sender_.call(*function_, static_cast<In&&>(value));
+    }
+
+    worker* worker_;
+    Function* function_;
+  };
+
+  void post_worker(worker* w)
+  {
+    run_handler handler = { this, w, owner_->shared_from_this() };
+    asio::post(executor_, static_cast<run_handler&&>(handler));
+  }
+
+  void run(worker* w)
+  {
+    if (!w->sender_.flush())
+      return block(w);
+
+    consume_function f = { w, &function_ };
+    std::size_t n = 0;
+    while (n < batch_size_ && this->queue_.try_consume(f))
+      ++n;
+
+    if (n > 0)
+    {
+      if (first_)
+        owner_->consumed(n);
+      else
+        this->waiters_.wake_all();
+    }
+
+    if (!w->sender_.flush())
+      return block(w);
+
+    if (n == batch_size_)
+      post_worker(w);
+    else
+      go_idle(w);
+  }
+
+  // The next stage's queue is full. The worker remains active, and is
+  // rescheduled by the next stage once it has removed values from its queue.
+  void block(worker* w)
+  {
+    w->state_.store(pipeline_worker::blocked, std::memory_order_seq_cst);
+    if (w->sender_.wait(w))
+    {
+      int expected = pipeline_worker::blocked;
+      if (w->state_.compare_exchange_strong(expected,
+            pipeline_worker::scheduled, std::memory_order_acq_rel))
+        post_worker(w);
+    }
+  }
+
+  void go_idle(worker* w)
+  {
+    w->state_.store(pipeline_worker::idle, std::memory_order_seq_cst);
+    std::size_t remaining =
+      active_.fetch_sub(1, std::memory_order_seq_cst) - 1;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // A producer may have pushed a value after the queue was last checked.
+    if (!this->queue_.empty())
+    {
+      int expected = pipeline_worker::idle;
+      if (w->state_.compare_exchange_strong(expected,
+            pipeline_worker::scheduled, std::memory_order_acq_rel))
+      {
+        active_.fetch_add(1, std::memory_order_seq_cst);
+        post_worker(w);
+      }
+      return;
+    }
+
+    if (remaining == 0)
+      check_finished();
+  }
+
+  // The stage is finished once it has been closed and has no active workers
+  // and no queued values.
+  void check_finished()
+  {
+    if (closed_.load(std::memory_order_seq_cst)
+        && active_.load(std::memory_order_seq_cst) == 0
+        && this->queue_.empty()
+        && !finished_.exchange(true, std::memory_order_acq_rel))
+    {
+      if (next_stage_)
+        next_stage_->close();
+      else
+        owner_->finished();
+    }
+  }
+
+  pipeline_owner* owner_;
+  Function function_;
+  Executor executor_;
+  const std::size_t parallelism_;
+  const std::size_t batch_size_;
+  const bool first_;
+  worker* workers_;
+  pipeline_stage_base* next_stage_;
+  std::atomic<std::size_t> active_;
+  std::atomic<bool> closed_;
+  std::atomic<bool> finished_;
+};
+
+} // namespace detail
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXPERIMENTAL_DETAIL_PIPELINE_STAGE_HPP
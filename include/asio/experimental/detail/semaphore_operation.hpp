@@ -0,0 +1,177 @@
+//
+// experimental/detail/semaphore_operation.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_DETAIL_SEMAPHORE_OPERATION_HPP
+#define ASIO_EXPERIMENTAL_DETAIL_SEMAPHORE_OPERATION_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/associated_immediate_executor.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_tracking.hpp"
+#include "asio/detail/initiate_dispatch.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/error_code.hpp"
+#include "asio/experimental/detail/channel_operation.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+namespace detail {
+
+// Base class for operations waiting on a semaphore, mutex or rate limiter. A
+// function pointer is used instead of virtual functions to avoid the
+// associated overhead.
+class semaphore_operation ASIO_INHERIT_TRACKED_HANDLER
+{
+public:
+  void immediate(const asio::error_code& ec)
+  {
+    func_(this, immediate_op, &ec);
+  }
+
+  void post(const asio::error_code& ec)
+  {
+    func_(this, post_op, &ec);
+  }
+
+  void destroy()
+  {
+    func_(this, destroy_op, 0);
+  }
+
+  // The number of permits or tokens that the operation is waiting for.
+  std::size_t count_;
+
+  // The operation key used for targeted cancellation.
+  void* cancellation_key_;
+
+protected:
+  enum action
+  {
+    destroy_op = 0,
+    immediate_op = 1,
+    post_op = 2
+  };
+
+  typedef void (*func_type)(semaphore_operation*,
+      action, const asio::error_code*);
+
+  semaphore_operation(func_type func, std::size_t count)
+    : count_(count),
+      cancellation_key_(0),
+      next_(0),
+      func_(func)
+  {
+  }
+
+  // Prevents deletion through this type.
+  ~semaphore_operation()
+  {
+  }
+
+  friend class asio::detail::op_queue_access;
+  semaphore_operation* next_;
+  func_type func_;
+};
+
+template <typename Handler, typename IoExecutor>
+class semaphore_wait_op : public semaphore_operation
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(semaphore_wait_op);
+
+  semaphore_wait_op(Handler& handler,
+      const IoExecutor& io_ex, std::size_t count)
+    : semaphore_operation(&semaphore_wait_op::do_action, count),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_action(semaphore_operation* base,
+      semaphore_operation::action a, const asio::error_code* ec)
+  {
+    // Take ownership of the operation object.
+    semaphore_wait_op* o(static_cast<semaphore_wait_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    channel_operation::handler_work<Handler, IoExecutor> w(
+        static_cast<channel_operation::handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the handler is posted. Even if we're not about to post the handler, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    if (a != semaphore_operation::destroy_op)
+    {
+      asio::detail::binder1<Handler, asio::error_code>
+        handler(o->handler_, *ec);
+      p.h = asio::detail::addressof(handler.handler_);
+      p.reset();
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_));
+      if (a == semaphore_operation::immediate_op)
+        w.immediate(handler, handler.handler_, 0);
+      else
+        w.post(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+    else
+    {
+      asio::detail::binder0<Handler> handler(o->handler_);
+      p.h = asio::detail::addressof(handler.handler_);
+      p.reset();
+    }
+  }
+
+private:
+  Handler handler_;
+  channel_operation::handler_work<Handler, IoExecutor> work_;
+};
+
+// Complete a handler immediately, without allocating an operation object. As
+// the handler is not stored, no outstanding work is tracked on the I/O
+// executor.
+template <typename Handler, typename IoExecutor>
+inline void semaphore_complete_immediately(Handler& handler,
+    const IoExecutor& io_ex, const asio::error_code& ec)
+{
+  typedef associated_immediate_executor_t<Handler, IoExecutor>
+    immediate_ex_type;
+
+  immediate_ex_type immediate_ex =
+    (get_associated_immediate_executor)(handler, io_ex);
+
+  (asio::detail::initiate_dispatch_with_executor<immediate_ex_type>(
+      immediate_ex))(asio::detail::bind_handler(
+        static_cast<Handler&&>(handler), ec),
+      asio::detail::empty_work_function());
+}
+
+} // namespace detail
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXPERIMENTAL_DETAIL_SEMAPHORE_OPERATION_HPP
@@ -0,0 +1,307 @@
+//
+// experimental/detail/semaphore_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_DETAIL_SEMAPHORE_SERVICE_HPP
+#define ASIO_EXPERIMENTAL_DETAIL_SEMAPHORE_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include "asio/associated_cancellation_slot.hpp"
+#include "asio/cancellation_type.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/experimental/detail/semaphore_operation.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+namespace detail {
+
+class semaphore_service
+  : public asio::detail::execution_context_service_base<semaphore_service>
+{
+public:
+  // The base implementation type of all semaphores and rate limiters.
+  struct base_implementation_type
+  {
+    // Default constructor.
+    base_implementation_type()
+      : next_(0),
+        prev_(0)
+    {
+    }
+
+    // The operations that are waiting, in the order they were started.
+    asio::detail::op_queue<semaphore_operation> waiters_;
+
+    // The mutex used to protect the waiters. It is not needed to acquire or
+    // release a permit when there are no waiters.
+    asio::detail::mutex mutex_;
+
+    // Pointers to adjacent implementations in linked list.
+    base_implementation_type* next_;
+    base_implementation_type* prev_;
+  };
+
+  // The implementation of a semaphore or mutex.
+  struct implementation_type : base_implementation_type
+  {
+    // Default constructor.
+    implementation_type()
+      : count_(0)
+    {
+    }
+
+    // The number of available permits less the number of waiters. A waiter is
+    // counted from the moment it fails to acquire a permit, and is handed a
+    // permit directly by release() rather than through the count. A count
+    // below zero is only changed while holding the mutex, so that it always
+    // matches the number of operations in the waiters queue.
+    std::atomic<std::ptrdiff_t> count_;
+  };
+
+  // The implementation of a token bucket rate limiter. The bucket is
+  // represented by the time at which it would next be full, so that tokens
+  // can be taken with a single compare-and-swap.
+  struct rate_limiter_implementation_type : base_implementation_type
+  {
+    // Default constructor.
+    rate_limiter_implementation_type()
+      : full_time_(0),
+        interval_(1),
+        burst_(1),
+        has_waiters_(false)
+    {
+    }
+
+    // The clock time, in ticks, at which the bucket is full.
+    std::atomic<asio::int64_t> full_time_;
+
+    // The number of clock ticks needed to replenish one token.
+    asio::int64_t interval_;
+
+    // The capacity of the bucket.
+    std::size_t burst_;
+
+    // Whether there are operations waiting for tokens. While there are, new
+    // acquisitions must join the queue so that waiters are not starved.
+    std::atomic<bool> has_waiters_;
+  };
+
+  // Constructor.
+  ASIO_DECL semaphore_service(execution_context& ctx);
+
+  // Destroy all user-defined handler objects owned by the service.
+  ASIO_DECL void shutdown();
+
+  // Construct a new semaphore implementation.
+  ASIO_DECL void construct(implementation_type& impl,
+      std::ptrdiff_t initial_count);
+
+  // Construct a new rate limiter implementation.
+  ASIO_DECL void construct(rate_limiter_implementation_type& impl,
+      asio::int64_t interval, std::size_t burst);
+
+  // Destroy a semaphore or rate limiter implementation.
+  template <typename Implementation>
+  void destroy(Implementation& impl)
+  {
+    cancel(impl);
+    base_destroy(impl);
+  }
+
+  // Cancel all waiting operations. Returns the number of operations that were
+  // cancelled.
+  ASIO_DECL std::size_t cancel(implementation_type& impl);
+  ASIO_DECL std::size_t cancel(rate_limiter_implementation_type& impl);
+
+  // Cancel the waiting operation that has the given key.
+  ASIO_DECL void cancel_by_key(implementation_type& impl,
+      void* cancellation_key);
+  ASIO_DECL void cancel_by_key(rate_limiter_implementation_type& impl,
+      void* cancellation_key);
+
+  // Get the number of permits that are currently available.
+  std::size_t available(const implementation_type& impl) const noexcept
+  {
+    std::ptrdiff_t count = impl.count_.load(std::memory_order_relaxed);
+    return count > 0 ? static_cast<std::size_t>(count) : 0;
+  }
+
+  // Attempt to acquire a permit without blocking or taking a lock.
+  bool try_acquire(implementation_type& impl) noexcept
+  {
+    std::ptrdiff_t count = impl.count_.load(std::memory_order_relaxed);
+    while (count > 0)
+    {
+      if (impl.count_.compare_exchange_weak(count, count - 1,
+            std::memory_order_acquire, std::memory_order_relaxed))
+        return true;
+    }
+    return false;
+  }
+
+  // Release permits, handing them to waiting operations first.
+  void release(implementation_type& impl, std::size_t n)
+  {
+    // Without waiters, the permits are returned to the count without a lock.
+    std::ptrdiff_t count = impl.count_.load(std::memory_order_relaxed);
+    while (count >= 0)
+    {
+      if (impl.count_.compare_exchange_weak(count,
+            count + static_cast<std::ptrdiff_t>(n),
+            std::memory_order_release, std::memory_order_relaxed))
+        return;
+    }
+
+    release_waiters(impl, n);
+  }
+
+  // Asynchronously acquire a permit.
+  template <typename Handler, typename IoExecutor>
+  void async_acquire(implementation_type& impl,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    // An uncontended acquire neither allocates nor takes a lock.
+    if (try_acquire(impl))
+    {
+      semaphore_complete_immediately(handler, io_ex, asio::error_code());
+      return;
+    }
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef semaphore_wait_op<Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(handler, io_ex, 1);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<op_cancellation<implementation_type>>(
+            this, &impl);
+    }
+
+    ASIO_HANDLER_CREATION((this->context(), *p.p,
+          "semaphore", &impl, 0, "async_acquire"));
+
+    start_wait_op(impl, p.p);
+    p.v = p.p = 0;
+  }
+
+  // Attempt to take tokens from a rate limiter without blocking or taking a
+  // lock. Fails if the tokens are not yet available, or if other operations
+  // are already waiting.
+  bool try_acquire(rate_limiter_implementation_type& impl,
+      std::size_t n, asio::int64_t now) noexcept
+  {
+    if (impl.has_waiters_.load(std::memory_order_acquire))
+      return false;
+    asio::int64_t ready_time;
+    return try_consume(impl, n, now, ready_time);
+  }
+
+  // Take tokens from a rate limiter if they are available at the given time.
+  // Otherwise, sets ready_time to the time at which they will be.
+  static bool try_consume(rate_limiter_implementation_type& impl,
+      std::size_t n, asio::int64_t now,
+      asio::int64_t& ready_time) noexcept
+  {
+    asio::int64_t cost =
+      static_cast<asio::int64_t>(n) * impl.interval_;
+    asio::int64_t capacity =
+      static_cast<asio::int64_t>(impl.burst_) * impl.interval_;
+    asio::int64_t full_time =
+      impl.full_time_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      asio::int64_t new_full_time =
+        (full_time > now ? full_time : now) + cost;
+      if (new_full_time - now > capacity)
+      {
+        ready_time = new_full_time - capacity;
+        return false;
+      }
+      if (impl.full_time_.compare_exchange_weak(full_time, new_full_time,
+            std::memory_order_acq_rel, std::memory_order_relaxed))
+        return true;
+    }
+  }
+
+  // Helper class used to implement per-operation cancellation.
+  template <typename Implementation>
+  class op_cancellation
+  {
+  public:
+    op_cancellation(semaphore_service* s, Implementation* impl)
+      : service_(s),
+        impl_(impl)
+    {
+    }
+
+    void operator()(cancellation_type_t type)
+    {
+      if (!!(type &
+            (cancellation_type::terminal
+              | cancellation_type::partial
+              | cancellation_type::total)))
+      {
+        service_->cancel_by_key(*impl_, this);
+      }
+    }
+
+  private:
+    semaphore_service* service_;
+    Implementation* impl_;
+  };
+
+private:
+  // Remove an implementation from the linked list of all implementations.
+  ASIO_DECL void base_destroy(base_implementation_type& impl);
+
+  // Add a waiting operation, unless a permit became available after the
+  // uncontended attempt to acquire one failed.
+  ASIO_DECL void start_wait_op(implementation_type& impl,
+      semaphore_operation* op);
+
+  // Release permits while holding the mutex, handing them to waiting
+  // operations first.
+  ASIO_DECL void release_waiters(implementation_type& impl, std::size_t n);
+
+  // Mutex to protect access to the linked list of implementations.
+  asio::detail::mutex mutex_;
+
+  // The head of a linked list of all implementations.
+  base_implementation_type* impl_list_;
+};
+
+} // namespace detail
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/experimental/detail/impl/semaphore_service.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_EXPERIMENTAL_DETAIL_SEMAPHORE_SERVICE_HPP
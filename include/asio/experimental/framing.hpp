@@ -0,0 +1,476 @@
+//
+// experimental/framing.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_FRAMING_HPP
+#define ASIO_EXPERIMENTAL_FRAMING_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <iterator>
+#include "asio/async_result.hpp"
+#include "asio/buffer.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+namespace detail {
+
+template <typename> class initiate_async_read_frame;
+template <typename> class initiate_async_write_frames;
+
+} // namespace detail
+
+/// Describes the length prefix that precedes each frame in a byte stream.
+/**
+ * A frame consists of a length prefix followed by that number of bytes of
+ * payload. The prefix is either a fixed-width unsigned integer, in big-endian
+ * (network) or little-endian byte order, or a variable-length integer using
+ * the unsigned LEB128 encoding, where each byte holds seven bits of the
+ * length, least significant group first, and the high bit is set on all bytes
+ * but the last.
+ */
+class frame_prefix
+{
+public:
+  /// The byte order of a fixed-width prefix.
+  enum byte_order
+  {
+    /// Most significant byte first.
+    big_endian,
+
+    /// Least significant byte first.
+    little_endian
+  };
+
+  /// Construct a four byte prefix in network byte order.
+  frame_prefix() noexcept
+    : varint_(false),
+      width_(4),
+      order_(big_endian),
+      max_frame_size_(0xFFFFFFFFu)
+  {
+  }
+
+  /// Create a fixed-width prefix.
+  /**
+   * @param width The number of bytes in the prefix. Must be 1, 2, 4 or 8.
+   *
+   * @param order The byte order of the prefix.
+   *
+   * @throws std::out_of_range Thrown if @c width is not a supported width.
+   */
+  ASIO_DECL static frame_prefix fixed(std::size_t width,
+      byte_order order = big_endian);
+
+  /// Create a variable-length prefix.
+  ASIO_DECL static frame_prefix varint() noexcept;
+
+  /// Get the maximum length of a frame's payload.
+  /**
+   * By default this is the largest length that the prefix can represent.
+   */
+  std::size_t max_frame_size() const noexcept
+  {
+    return max_frame_size_;
+  }
+
+  /// Set the maximum length of a frame's payload.
+  /**
+   * Decoding a prefix with a larger length fails with
+   * asio::error::message_size. The value is limited to the largest length
+   * that the prefix can represent.
+   */
+  ASIO_DECL void max_frame_size(std::size_t n) noexcept;
+
+  /// Get the maximum number of bytes in an encoded prefix.
+  std::size_t max_size() const noexcept
+  {
+    return varint_ ? (sizeof(std::size_t) * 8 + 6) / 7 : width_;
+  }
+
+  /// Get the number of bytes needed to encode the prefix for a length.
+  ASIO_DECL std::size_t encoded_size(std::size_t length) const noexcept;
+
+  /// Encode the prefix for a frame.
+  /**
+   * @param length The length of the frame's payload, which must not exceed
+   * max_frame_size().
+   *
+   * @param data The location at which the prefix is written. There must be
+   * space for at least encoded_size(length) bytes.
+   *
+   * @returns The number of bytes written.
+   */
+  ASIO_DECL std::size_t encode(std::size_t length, void* data) const noexcept;
+
+  /// Decode the prefix at the start of a block of data.
+  /**
+   * @param data The data to be decoded.
+   *
+   * @param size The number of bytes of data.
+   *
+   * @param length Set to the length of the frame's payload if a complete
+   * prefix is decoded.
+   *
+   * @param ec Set to asio::error::message_size if the length exceeds
+   * max_frame_size(), or cannot be represented.
+   *
+   * @returns The number of bytes in the prefix, or 0 if the data does not
+   * contain a complete prefix or an error occurred.
+   */
+  ASIO_DECL std::size_t decode(const void* data, std::size_t size,
+      std::size_t& length, asio::error_code& ec) const noexcept;
+
+private:
+  bool varint_;
+  unsigned char width_;
+  byte_order order_;
+  std::size_t max_frame_size_;
+};
+
+/// A view of the complete frames in a contiguous block of data.
+/**
+ * Iterating over a frame_sequence yields a @c const_buffer for the payload of
+ * each frame, referring directly to the underlying data. Iteration stops at
+ * the first frame that is incomplete or has an invalid prefix.
+ *
+ * @par Example
+ * @code std::string data;
+ * ...
+ * std::size_t n = co_await asio::experimental::async_read_frame(
+ *     socket, asio::dynamic_buffer(data), prefix, asio::use_awaitable);
+ * for (asio::const_buffer frame :
+ *     asio::experimental::frame_sequence(
+ *       asio::buffer(data, n), prefix))
+ * {
+ *   ...
+ * }
+ * data.erase(0, n); @endcode
+ */
+class frame_sequence
+{
+public:
+  class const_iterator;
+
+  /// Construct a view of the frames in the specified data.
+  frame_sequence(const const_buffer& data,
+      const frame_prefix& prefix) noexcept
+    : data_(data),
+      prefix_(prefix)
+  {
+  }
+
+  /// Get an iterator to the first frame.
+  const_iterator begin() const noexcept;
+
+  /// Get an iterator past the last complete frame.
+  const_iterator end() const noexcept;
+
+private:
+  const_buffer data_;
+  frame_prefix prefix_;
+};
+
+/// An iterator over the payloads of the frames in a frame_sequence.
+class frame_sequence::const_iterator
+{
+public:
+  /// The type of the value pointed to by the iterator.
+  typedef const_buffer value_type;
+
+  /// The type of the result of applying operator->() to the iterator.
+  typedef const const_buffer* pointer;
+
+  /// The type of the result of applying operator*() to the iterator.
+  typedef const const_buffer& reference;
+
+  /// The type used for the distance between two iterators.
+  typedef std::ptrdiff_t difference_type;
+
+  /// The iterator category.
+  typedef std::forward_iterator_tag iterator_category;
+
+  /// Default constructor creates an end iterator.
+  const_iterator() noexcept
+    : position_(0),
+      next_(0),
+      end_(0)
+  {
+  }
+
+  /// Dereference an iterator.
+  const const_buffer& operator*() const noexcept
+  {
+    return frame_;
+  }
+
+  /// Dereference an iterator.
+  const const_buffer* operator->() const noexcept
+  {
+    return &frame_;
+  }
+
+  /// Increment operator (prefix).
+  const_iterator& operator++() noexcept
+  {
+    position_ = next_;
+    decode();
+    return *this;
+  }
+
+  /// Increment operator (postfix).
+  const_iterator operator++(int) noexcept
+  {
+    const_iterator tmp(*this);
+    ++*this;
+    return tmp;
+  }
+
+  /// Test two iterators for equality.
+  friend bool operator==(const const_iterator& a,
+      const const_iterator& b) noexcept
+  {
+    return a.position_ == b.position_;
+  }
+
+  /// Test two iterators for inequality.
+  friend bool operator!=(const const_iterator& a,
+      const const_iterator& b) noexcept
+  {
+    return a.position_ != b.position_;
+  }
+
+private:
+  friend class frame_sequence;
+
+  const_iterator(const unsigned char* position, const unsigned char* end,
+      const frame_prefix& prefix) noexcept
+    : position_(position),
+      next_(position),
+      end_(end),
+      prefix_(prefix)
+  {
+    decode();
+  }
+
+  // Decodes the frame at the current position, moving to the end if there
+  // is no complete frame.
+  void decode() noexcept
+  {
+    std::size_t size = end_ - position_;
+    std::size_t length = 0;
+    asio::error_code ec;
+    std::size_t n = prefix_.decode(position_, size, length, ec);
+    if (n == 0 || length > size - n)
+    {
+      position_ = next_ = end_;
+      frame_ = const_buffer();
+      return;
+    }
+    frame_ = const_buffer(position_ + n, length);
+    next_ = position_ + n + length;
+  }
+
+  const unsigned char* position_;
+  const unsigned char* next_;
+  const unsigned char* end_;
+  frame_prefix prefix_;
+  const_buffer frame_;
+};
+
+inline frame_sequence::const_iterator frame_sequence::begin() const noexcept
+{
+  const unsigned char* data = static_cast<const unsigned char*>(data_.data());
+  return const_iterator(data, data + data_.size(), prefix_);
+}
+
+inline frame_sequence::const_iterator frame_sequence::end() const noexcept
+{
+  const unsigned char* data = static_cast<const unsigned char*>(data_.data());
+  return const_iterator(data + data_.size(), data + data_.size(), prefix_);
+}
+
+/// Start an asynchronous operation to read complete frames into a dynamic
+/// buffer.
+/**
+ * This function is used to asynchronously read data into the specified
+ * dynamic buffer until it contains at least one complete frame. It is an
+ * initiating function for an @ref asynchronous_operation, and always returns
+ * immediately.
+ *
+ * Each read requests as much data as the buffer's capacity allows, up to the
+ * remainder of an incomplete frame or a minimum of 512 bytes, so that many
+ * small frames are typically obtained with a single read. If the dynamic
+ * buffer's sequence already contains a complete frame, the operation
+ * completes without reading.
+ *
+ * On successful completion, the first @c n bytes of the buffer's sequence
+ * contain all of the complete frames that were received. These may be
+ * accessed, without copying, using a frame_sequence. The caller should
+ * consume these @c n bytes from the buffer once the frames have been
+ * processed, leaving any data that follows for a subsequent read.
+ *
+ * @param s The stream from which the data is to be read. The type must
+ * support the AsyncReadStream concept.
+ *
+ * @param buffers The dynamic buffer sequence into which the data will be
+ * read. The buffer's data must be contiguous, as is the case for the buffers
+ * returned by asio::dynamic_buffer(). Although the buffers object may be
+ * copied as necessary, ownership of the underlying memory blocks is retained
+ * by the caller, which must guarantee that they remain valid until the
+ * completion handler is called.
+ *
+ * @param prefix The length prefix that precedes each frame.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the read completes. The
+ * function signature of the completion handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const asio::error_code& error,
+ *
+ *   // The number of bytes in the dynamic buffer sequence's
+ *   // get area that hold complete frames. 0 if an error
+ *   // occurred.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ *
+ * @par Completion Signature
+ * @code void(asio::error_code, std::size_t) @endcode
+ *
+ * The operation fails with asio::error::message_size if a frame's length
+ * exceeds the prefix's maximum frame size, or if the frame would not fit in
+ * the dynamic buffer.
+ *
+ * @par Per-Operation Cancellation
+ * This asynchronous operation supports cancellation for the following
+ * asio::cancellation_type values:
+ *
+ * @li @c cancellation_type::terminal
+ *
+ * @li @c cancellation_type::partial
+ *
+ * if they are also supported by the @c AsyncReadStream type's
+ * @c async_read_some operation.
+ */
+template <typename AsyncReadStream, typename DynamicBuffer_v2,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) ReadToken = default_completion_token_t<
+        typename AsyncReadStream::executor_type>>
+inline auto async_read_frame(AsyncReadStream& s,
+    DynamicBuffer_v2 buffers, const frame_prefix& prefix,
+    ReadToken&& token = default_completion_token_t<
+      typename AsyncReadStream::executor_type>(),
+    constraint_t<
+      is_dynamic_buffer_v2<DynamicBuffer_v2>::value
+    > = 0)
+  -> decltype(
+    async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        declval<detail::initiate_async_read_frame<AsyncReadStream>>(),
+        token, static_cast<DynamicBuffer_v2&&>(buffers), prefix))
+{
+  return async_initiate<ReadToken,
+    void (asio::error_code, std::size_t)>(
+      detail::initiate_async_read_frame<AsyncReadStream>(s),
+      token, static_cast<DynamicBuffer_v2&&>(buffers), prefix);
+}
+
+/// Start an asynchronous operation to write a sequence of frames.
+/**
+ * This function is used to asynchronously write a batch of frames to a
+ * stream, where each buffer in the supplied sequence is the payload of one
+ * frame. It is an initiating function for an @ref asynchronous_operation, and
+ * always returns immediately.
+ *
+ * The prefixes are encoded into a single block of memory, and the frames are
+ * written using gather writes. The payloads of small frames are copied
+ * alongside their prefixes, so that a run of small frames occupies a single
+ * buffer. Larger payloads are written directly from the caller's memory.
+ *
+ * @param s The stream to which the data is to be written. The type must
+ * support the AsyncWriteStream concept.
+ *
+ * @param frames One or more buffers, each containing the payload of a frame.
+ * Although the buffers object may be copied as necessary, ownership of the
+ * underlying memory blocks is retained by the caller, which must guarantee
+ * that they remain valid until the completion handler is called.
+ *
+ * @param prefix The length prefix that precedes each frame.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the write completes. The
+ * function signature of the completion handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes written from the buffers, including
+ *   // the prefixes. If an error occurred, this will be less
+ *   // than the total size of the frames.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ *
+ * @par Completion Signature
+ * @code void(asio::error_code, std::size_t) @endcode
+ *
+ * The operation fails with asio::error::message_size, without writing any
+ * data, if a payload exceeds the prefix's maximum frame size.
+ *
+ * @par Per-Operation Cancellation
+ * This asynchronous operation supports cancellation for the following
+ * asio::cancellation_type values:
+ *
+ * @li @c cancellation_type::terminal
+ *
+ * if they are also supported by the @c AsyncWriteStream type's
+ * @c async_write_some operation.
+ */
+template <typename AsyncWriteStream, typename ConstBufferSequence,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) WriteToken = default_completion_token_t<
+        typename AsyncWriteStream::executor_type>>
+inline auto async_write_frames(AsyncWriteStream& s,
+    const ConstBufferSequence& frames, const frame_prefix& prefix,
+    WriteToken&& token = default_completion_token_t<
+      typename AsyncWriteStream::executor_type>(),
+    constraint_t<
+      is_const_buffer_sequence<ConstBufferSequence>::value
+    > = 0)
+  -> decltype(
+    async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        declval<detail::initiate_async_write_frames<AsyncWriteStream>>(),
+        token, frames, prefix))
+{
+  return async_initiate<WriteToken,
+    void (asio::error_code, std::size_t)>(
+      detail::initiate_async_write_frames<AsyncWriteStream>(s),
+      token, frames, prefix);
+}
+
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/experimental/impl/framing.hpp"
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/experimental/impl/framing.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_EXPERIMENTAL_FRAMING_HPP
@@ -0,0 +1,374 @@
+//
+// experimental/impl/framing.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_IMPL_FRAMING_HPP
+#define ASIO_EXPERIMENTAL_IMPL_FRAMING_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "asio/compose.hpp"
+#include "asio/detail/handler_type_requirements.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/immediate.hpp"
+#include "asio/write.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+namespace detail {
+
+// Payloads up to this size are copied alongside their prefixes when writing,
+// so that a run of small frames is written from a single buffer.
+enum { frame_copy_threshold = 128 };
+
+template <typename AsyncReadStream, typename DynamicBuffer_v2>
+class read_frame_op
+{
+public:
+  read_frame_op(AsyncReadStream& stream, DynamicBuffer_v2&& buffers,
+      const frame_prefix& prefix)
+    : stream_(stream),
+      buffers_(static_cast<DynamicBuffer_v2&&>(buffers)),
+      prefix_(prefix),
+      state_(starting),
+      bytes_to_read_(0),
+      result_(0)
+  {
+  }
+
+  template <typename Self>
+  void operator()(Self& self, asio::error_code ec = asio::error_code(),
+      std::size_t bytes_transferred = 0)
+  {
+    switch (state_)
+    {
+    case starting:
+      result_ = parse(result_ec_);
+      if (result_ != 0 || result_ec_)
+      {
+        // The buffer already holds a complete frame. Complete via the
+        // handler's immediate executor so that the handler is not invoked
+        // from within the initiating function.
+        state_ = completing;
+        asio::async_immediate(self.get_io_executor(),
+            static_cast<Self&&>(self));
+        return;
+      }
+      state_ = reading;
+      read(self);
+      return;
+    case reading:
+      buffers_.shrink(bytes_to_read_ - bytes_transferred);
+      if (ec)
+      {
+        self.complete(ec, 0);
+        return;
+      }
+      result_ = parse(result_ec_);
+      if (result_ == 0 && !result_ec_)
+      {
+        read(self);
+        return;
+      }
+      // Fall through.
+    default:
+      self.complete(result_ec_, result_);
+    }
+  }
+
+private:
+  template <typename Self>
+  void read(Self& self)
+  {
+    std::size_t pos = buffers_.size();
+    buffers_.grow(bytes_to_read_);
+    stream_.async_read_some(buffers_.data(pos, bytes_to_read_),
+        static_cast<Self&&>(self));
+  }
+
+  // Returns the number of bytes occupied by complete frames at the start of
+  // the buffer. If there are none, determines how much more to read.
+  std::size_t parse(asio::error_code& ec)
+  {
+    std::size_t size = buffers_.size();
+    const_buffer data = const_cast<const DynamicBuffer_v2&>(
+        buffers_).data(0, size);
+    const unsigned char* p = static_cast<const unsigned char*>(data.data());
+
+    std::size_t complete = 0;
+    std::size_t shortfall = 1;
+    for (;;)
+    {
+      std::size_t remaining = size - complete;
+      std::size_t length = 0;
+      std::size_t n = prefix_.decode(p + complete, remaining, length, ec);
+      if (ec)
+      {
+        // Deliver the complete frames first. The error is reported by the
+        // next read.
+        if (complete != 0)
+          ec = asio::error_code();
+        return complete;
+      }
+      if (n == 0)
+        break;
+      if (length > buffers_.max_size() - n)
+      {
+        if (complete == 0)
+          ec = asio::error::message_size;
+        return complete;
+      }
+      if (length > remaining - n)
+      {
+        shortfall = n + length - remaining;
+        break;
+      }
+      complete += n + length;
+    }
+
+    if (complete != 0)
+      return complete;
+
+    if (size == buffers_.max_size())
+    {
+      ec = asio::error::message_size;
+      return 0;
+    }
+
+    bytes_to_read_ = (std::max)(shortfall,
+        (std::min)(
+          (std::max<std::size_t>)(512, buffers_.capacity() - size),
+          static_cast<std::size_t>(65536)));
+    bytes_to_read_ = (std::min)(bytes_to_read_, buffers_.max_size() - size);
+    return 0;
+  }
+
+  AsyncReadStream& stream_;
+  DynamicBuffer_v2 buffers_;
+  frame_prefix prefix_;
+  enum { starting, reading, completing } state_;
+  std::size_t bytes_to_read_;
+  std::size_t result_;
+  asio::error_code result_ec_;
+};
+
+template <typename AsyncReadStream>
+class initiate_async_read_frame
+{
+public:
+  typedef typename AsyncReadStream::executor_type executor_type;
+
+  explicit initiate_async_read_frame(AsyncReadStream& stream)
+    : stream_(stream)
+  {
+  }
+
+  executor_type get_executor() const noexcept
+  {
+    return stream_.get_executor();
+  }
+
+  template <typename ReadHandler, typename DynamicBuffer_v2>
+  void operator()(ReadHandler&& handler, DynamicBuffer_v2&& buffers,
+      const frame_prefix& prefix) const
+  {
+    // If you get an error on the following line it means that your handler
+    // does not meet the documented type requirements for a ReadHandler.
+    ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+    // The frames are presented as contiguous views into the buffer.
+    static_assert(is_convertible<
+        typename decay_t<DynamicBuffer_v2>::const_buffers_type,
+        const_buffer>::value,
+      "DynamicBuffer_v2 data must be contiguous");
+
+    asio::detail::non_const_lvalue<ReadHandler> handler2(handler);
+    asio::async_compose<decay_t<ReadHandler>,
+      void (asio::error_code, std::size_t)>(
+        read_frame_op<AsyncReadStream, decay_t<DynamicBuffer_v2>>(
+          stream_, static_cast<DynamicBuffer_v2&&>(buffers), prefix),
+        handler2.value, stream_);
+  }
+
+private:
+  AsyncReadStream& stream_;
+};
+
+// A buffer sequence that refers to buffers owned by a write_frames_op, so
+// that they are not copied by the underlying write operation.
+class frame_buffers
+{
+public:
+  typedef const_buffer value_type;
+  typedef const const_buffer* const_iterator;
+
+  frame_buffers(const const_buffer* begin, const const_buffer* end) noexcept
+    : begin_(begin),
+      end_(end)
+  {
+  }
+
+  const const_buffer* begin() const noexcept
+  {
+    return begin_;
+  }
+
+  const const_buffer* end() const noexcept
+  {
+    return end_;
+  }
+
+private:
+  const const_buffer* begin_;
+  const const_buffer* end_;
+};
+
+template <typename AsyncWriteStream>
+class write_frames_op
+{
+public:
+  template <typename ConstBufferSequence>
+  write_frames_op(AsyncWriteStream& stream,
+      const ConstBufferSequence& frames, const frame_prefix& prefix)
+    : stream_(stream),
+      started_(false)
+  {
+    // Determine the space needed for the prefixes and the small payloads.
+    std::size_t count = 0;
+    std::size_t staging_size = 0;
+    for (auto i = asio::buffer_sequence_begin(frames),
+        end = asio::buffer_sequence_end(frames); i != end; ++i)
+    {
+      const_buffer frame(*i);
+      if (frame.size() > prefix.max_frame_size())
+      {
+        ec_ = asio::error::message_size;
+        return;
+      }
+      staging_size += prefix.encoded_size(frame.size());
+      if (frame.size() <= frame_copy_threshold)
+        staging_size += frame.size();
+      ++count;
+    }
+
+    // Encode the frames, starting a new buffer wherever a payload is written
+    // directly from the caller's memory.
+    staging_.resize(staging_size);
+    buffers_.reserve(count * 2 + 1);
+    unsigned char* run = staging_.data();
+    unsigned char* p = run;
+    for (auto i = asio::buffer_sequence_begin(frames),
+        end = asio::buffer_sequence_end(frames); i != end; ++i)
+    {
+      const_buffer frame(*i);
+      p += prefix.encode(frame.size(), p);
+      if (frame.size() <= frame_copy_threshold)
+      {
+        if (frame.size() != 0)
+          std::memcpy(p, frame.data(), frame.size());
+        p += frame.size();
+      }
+      else
+      {
+        buffers_.push_back(const_buffer(run, p - run));
+        buffers_.push_back(frame);
+        run = p;
+      }
+    }
+    if (p != run)
+      buffers_.push_back(const_buffer(run, p - run));
+  }
+
+  template <typename Self>
+  void operator()(Self& self, asio::error_code ec = asio::error_code(),
+      std::size_t bytes_transferred = 0)
+  {
+    if (!started_)
+    {
+      started_ = true;
+      if (ec_)
+      {
+        // Complete via the handler's immediate executor so that the handler
+        // is not invoked from within the initiating function.
+        asio::async_immediate(self.get_io_executor(),
+            static_cast<Self&&>(self));
+        return;
+      }
+
+      const const_buffer* begin = buffers_.data();
+      asio::async_write(stream_,
+          frame_buffers(begin, begin + buffers_.size()),
+          static_cast<Self&&>(self));
+      return;
+    }
+
+    if (ec_)
+      self.complete(ec_, 0);
+    else
+      self.complete(ec, bytes_transferred);
+  }
+
+private:
+  AsyncWriteStream& stream_;
+  bool started_;
+  asio::error_code ec_;
+  std::vector<unsigned char> staging_;
+  std::vector<const_buffer> buffers_;
+};
+
+template <typename AsyncWriteStream>
+class initiate_async_write_frames
+{
+public:
+  typedef typename AsyncWriteStream::executor_type executor_type;
+
+  explicit initiate_async_write_frames(AsyncWriteStream& stream)
+    : stream_(stream)
+  {
+  }
+
+  executor_type get_executor() const noexcept
+  {
+    return stream_.get_executor();
+  }
+
+  template <typename WriteHandler, typename ConstBufferSequence>
+  void operator()(WriteHandler&& handler, const ConstBufferSequence& frames,
+      const frame_prefix& prefix) const
+  {
+    // If you get an error on the following line it means that your handler
+    // does not meet the documented type requirements for a WriteHandler.
+    ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+    asio::detail::non_const_lvalue<WriteHandler> handler2(handler);
+    asio::async_compose<decay_t<WriteHandler>,
+      void (asio::error_code, std::size_t)>(
+        write_frames_op<AsyncWriteStream>(stream_, frames, prefix),
+        handler2.value, stream_);
+  }
+
+private:
+  AsyncWriteStream& stream_;
+};
+
+} // namespace detail
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXPERIMENTAL_IMPL_FRAMING_HPP
@@ -0,0 +1,169 @@
+//
+// experimental/impl/framing.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_IMPL_FRAMING_IPP
+#define ASIO_EXPERIMENTAL_IMPL_FRAMING_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <limits>
+#include <stdexcept>
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/throw_exception.hpp"
+#include "asio/error.hpp"
+#include "asio/experimental/framing.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+
+frame_prefix frame_prefix::fixed(std::size_t width, byte_order order)
+{
+  if (width != 1 && width != 2 && width != 4 && width != 8)
+  {
+    std::out_of_range ex("frame_prefix width");
+    asio::detail::throw_exception(ex);
+  }
+
+  frame_prefix prefix;
+  prefix.width_ = static_cast<unsigned char>(width);
+  prefix.order_ = order;
+  prefix.max_frame_size((std::numeric_limits<std::size_t>::max)());
+  return prefix;
+}
+
+frame_prefix frame_prefix::varint() noexcept
+{
+  frame_prefix prefix;
+  prefix.varint_ = true;
+  prefix.max_frame_size_ = (std::numeric_limits<std::size_t>::max)();
+  return prefix;
+}
+
+void frame_prefix::max_frame_size(std::size_t n) noexcept
+{
+  if (!varint_ && width_ < sizeof(std::size_t))
+  {
+    std::size_t limit = (static_cast<std::size_t>(1) << (width_ * 8)) - 1;
+    if (n > limit)
+      n = limit;
+  }
+  max_frame_size_ = n;
+}
+
+std::size_t frame_prefix::encoded_size(std::size_t length) const noexcept
+{
+  if (!varint_)
+    return width_;
+
+  std::size_t n = 1;
+  while (length >>= 7)
+    ++n;
+  return n;
+}
+
+std::size_t frame_prefix::encode(std::size_t length,
+    void* data) const noexcept
+{
+  unsigned char* p = static_cast<unsigned char*>(data);
+
+  if (varint_)
+  {
+    std::size_t n = 0;
+    do
+    {
+      unsigned char byte = static_cast<unsigned char>(length & 0x7F);
+      length >>= 7;
+      p[n++] = static_cast<unsigned char>(length ? byte | 0x80 : byte);
+    } while (length);
+    return n;
+  }
+
+  asio::uint64_t value = length;
+  for (std::size_t i = 0; i < width_; ++i)
+  {
+    std::size_t index = order_ == big_endian ? width_ - 1 - i : i;
+    p[index] = static_cast<unsigned char>((value >> (i * 8)) & 0xFF);
+  }
+  return width_;
+}
+
+std::size_t frame_prefix::decode(const void* data, std::size_t size,
+    std::size_t& length, asio::error_code& ec) const noexcept
+{
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  ec = asio::error_code();
+
+  if (varint_)
+  {
+    asio::uint64_t value = 0;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      asio::uint64_t group = p[i] & 0x7F;
+      std::size_t shift = i * 7;
+
+      // Reject lengths that overflow or exceed the limit as soon as they are
+      // seen, rather than waiting for the prefix to be completed.
+      if (group != 0 && (shift >= 64 || ((group << shift) >> shift) != group))
+      {
+        ec = asio::error::message_size;
+        return 0;
+      }
+      if (group != 0)
+        value |= group << shift;
+      if (value > max_frame_size_)
+      {
+        ec = asio::error::message_size;
+        return 0;
+      }
+
+      if ((p[i] & 0x80) == 0)
+      {
+        length = static_cast<std::size_t>(value);
+        return i + 1;
+      }
+
+      if (i + 1 == max_size())
+      {
+        ec = asio::error::message_size;
+        return 0;
+      }
+    }
+    return 0;
+  }
+
+  if (size < width_)
+    return 0;
+
+  asio::uint64_t value = 0;
+  for (std::size_t i = 0; i < width_; ++i)
+  {
+    std::size_t index = order_ == big_endian ? i : width_ - 1 - i;
+    value = (value << 8) | p[index];
+  }
+  if (value > max_frame_size_)
+  {
+    ec = asio::error::message_size;
+    return 0;
+  }
+  length = static_cast<std::size_t>(value);
+  return width_;
+}
+
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXPERIMENTAL_IMPL_FRAMING_IPP
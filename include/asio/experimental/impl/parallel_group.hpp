@@ -22,6 +22,7 @@
 #include <new>
 #include <tuple>
 #include "asio/associated_cancellation_slot.hpp"
+#include "asio/associated_trace_context.hpp"
 #include "asio/detail/recycling_allocator.hpp"
 #include "asio/detail/type_traits.hpp"
 #include "asio/dispatch.hpp"
@@ -147,7 +148,9 @@ template <typename Condition, typename Handler, typename... Ops>
 struct parallel_group_state
 {
   parallel_group_state(Condition&& c, Handler&& h)
-    : cancellation_condition_(std::move(c)),
+    : trace_context_((get_associated_trace_context)(
+          h, asio::trace_context::current())),
+      cancellation_condition_(std::move(c)),
       handler_(std::move(h))
   {
   }
@@ -174,6 +177,10 @@ struct parallel_group_state
   // The cancellation signals for each operation in the group.
   asio::cancellation_signal cancellation_signals_[sizeof...(Ops)];
 
+  // The trace context of the group's completion handler, which is propagated
+  // to each operation in the group.
+  asio::trace_context trace_context_;
+
   // The cancellation condition is used to determine whether the results from an
   // individual operation warrant a cancellation request for the whole group.
   Condition cancellation_condition_;
@@ -187,6 +194,7 @@ template <std::size_t I, typename Condition, typename Handler, typename... Ops>
 struct parallel_group_op_handler
 {
   typedef asio::cancellation_slot cancellation_slot_type;
+  typedef asio::trace_context trace_context_type;
 
   parallel_group_op_handler(
     std::shared_ptr<parallel_group_state<Condition, Handler, Ops...>> state)
@@ -199,6 +207,11 @@ struct parallel_group_op_handler
     return state_->cancellation_signals_[I].slot();
   }
 
+  trace_context_type get_trace_context() const noexcept
+  {
+    return state_->trace_context_;
+  }
+
   template <typename... Args>
   void operator()(Args... args)
   {
@@ -497,6 +510,8 @@ struct ranged_parallel_group_state
       cancellation_signals_(
           ASIO_REBIND_ALLOC(Allocator,
             asio::cancellation_signal)(allocator)),
+      trace_context_((get_associated_trace_context)(
+          h, asio::trace_context::current())),
       cancellation_condition_(std::move(c)),
       handler_(std::move(h), size, allocator)
   {
@@ -528,6 +543,10 @@ struct ranged_parallel_group_state
     ASIO_REBIND_ALLOC(Allocator, asio::cancellation_signal)>
       cancellation_signals_;
 
+  // The trace context of the group's completion handler, which is propagated
+  // to each operation in the group.
+  asio::trace_context trace_context_;
+
   // The cancellation condition is used to determine whether the results from an
   // individual operation warrant a cancellation request for the whole group.
   Condition cancellation_condition_;
@@ -541,6 +560,7 @@ template <typename Condition, typename Handler, typename Op, typename Allocator>
 struct ranged_parallel_group_op_handler
 {
   typedef asio::cancellation_slot cancellation_slot_type;
+  typedef asio::trace_context trace_context_type;
 
   ranged_parallel_group_op_handler(
       std::shared_ptr<ranged_parallel_group_state<
@@ -556,6 +576,11 @@ struct ranged_parallel_group_op_handler
     return state_->cancellation_signals_[idx_].slot();
   }
 
+  trace_context_type get_trace_context() const noexcept
+  {
+    return state_->trace_context_;
+  }
+
   template <typename... Args>
   void operator()(Args... args)
   {
@@ -0,0 +1,566 @@
+//
+// experimental/mailbox.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_MAILBOX_HPP
+#define ASIO_EXPERIMENTAL_MAILBOX_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/execution/blocking.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/experimental/detail/mailbox_executor_service.hpp"
+#include "asio/is_executor.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+
+/// Provides ordered, batched function invocation for lightweight actors.
+/**
+ * A mailbox guarantees the same ordered, non-concurrent invocation of
+ * submitted function objects as a @ref asio::strand. Submitting a function
+ * object to a mailbox does not acquire a lock: the message is pushed on to an
+ * intrusive multi-producer, single-consumer queue with a single atomic
+ * operation, and only the submission that finds the mailbox idle schedules
+ * it on the underlying executor.
+ *
+ * When the mailbox runs, it takes all pending messages at once and invokes up
+ * to @c max_messages_per_turn of them before yielding the underlying executor
+ * to other work. The limit is obtained from the execution context's
+ * configuration as @c mailbox.max_messages_per_turn, and defaults to 64. A
+ * value of 0 means that all pending messages are run on each turn.
+ */
+template <typename Executor>
+class mailbox
+{
+public:
+  /// The type of the underlying executor.
+  typedef Executor inner_executor_type;
+
+  /// Default constructor.
+  /**
+   * This constructor is only valid if the underlying executor type is default
+   * constructible.
+   */
+  mailbox()
+    : executor_(),
+      impl_(mailbox::create_implementation(executor_))
+  {
+  }
+
+  /// Construct a mailbox for the specified executor.
+  template <typename Executor1>
+  explicit mailbox(const Executor1& e,
+      constraint_t<
+        conditional_t<
+          !is_same<Executor1, mailbox>::value,
+          is_convertible<Executor1, Executor>,
+          false_type
+        >::value
+      > = 0)
+    : executor_(e),
+      impl_(mailbox::create_implementation(executor_))
+  {
+  }
+
+  /// Copy constructor.
+  mailbox(const mailbox& other) noexcept
+    : executor_(other.executor_),
+      impl_(other.impl_)
+  {
+  }
+
+  /// Converting constructor.
+  /**
+   * This constructor is only valid if the @c OtherExecutor type is convertible
+   * to @c Executor.
+   */
+  template <class OtherExecutor>
+  mailbox(
+      const mailbox<OtherExecutor>& other) noexcept
+    : executor_(other.executor_),
+      impl_(other.impl_)
+  {
+  }
+
+  /// Assignment operator.
+  mailbox& operator=(const mailbox& other) noexcept
+  {
+    executor_ = other.executor_;
+    impl_ = other.impl_;
+    return *this;
+  }
+
+  /// Converting assignment operator.
+  /**
+   * This assignment operator is only valid if the @c OtherExecutor type is
+   * convertible to @c Executor.
+   */
+  template <class OtherExecutor>
+  mailbox& operator=(
+      const mailbox<OtherExecutor>& other) noexcept
+  {
+    executor_ = other.executor_;
+    impl_ = other.impl_;
+    return *this;
+  }
+
+  /// Move constructor.
+  mailbox(mailbox&& other) noexcept
+    : executor_(static_cast<Executor&&>(other.executor_)),
+      impl_(static_cast<implementation_type&&>(other.impl_))
+  {
+  }
+
+  /// Converting move constructor.
+  /**
+   * This constructor is only valid if the @c OtherExecutor type is convertible
+   * to @c Executor.
+   */
+  template <class OtherExecutor>
+  mailbox(mailbox<OtherExecutor>&& other) noexcept
+    : executor_(static_cast<OtherExecutor&&>(other.executor_)),
+      impl_(static_cast<implementation_type&&>(other.impl_))
+  {
+  }
+
+  /// Move assignment operator.
+  mailbox& operator=(mailbox&& other) noexcept
+  {
+    executor_ = static_cast<Executor&&>(other.executor_);
+    impl_ = static_cast<implementation_type&&>(other.impl_);
+    return *this;
+  }
+
+  /// Converting move assignment operator.
+  /**
+   * This assignment operator is only valid if the @c OtherExecutor type is
+   * convertible to @c Executor.
+   */
+  template <class OtherExecutor>
+  mailbox& operator=(mailbox<OtherExecutor>&& other) noexcept
+  {
+    executor_ = static_cast<OtherExecutor&&>(other.executor_);
+    impl_ = static_cast<implementation_type&&>(other.impl_);
+    return *this;
+  }
+
+  /// Destructor.
+  ~mailbox() noexcept
+  {
+  }
+
+  /// Obtain the underlying executor.
+  inner_executor_type get_inner_executor() const noexcept
+  {
+    return executor_;
+  }
+
+  /// Forward a query to the underlying executor.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * asio::query customisation point.
+   *
+   * For example:
+   * @code asio::mailbox<my_executor_type> ex = ...;
+   * if (asio::query(ex, asio::execution::blocking)
+   *       == asio::execution::blocking.never)
+   *   ... @endcode
+   */
+  template <typename Property>
+  constraint_t<
+    can_query<const Executor&, Property>::value,
+    conditional_t<
+      is_convertible<Property, execution::blocking_t>::value,
+      execution::blocking_t,
+      query_result_t<const Executor&, Property>
+    >
+  > query(const Property& p) const
+    noexcept(is_nothrow_query<const Executor&, Property>::value)
+  {
+    return this->query_helper(
+        is_convertible<Property, execution::blocking_t>(), p);
+  }
+
+  /// Forward a requirement to the underlying executor.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * asio::require customisation point.
+   *
+   * For example:
+   * @code asio::mailbox<my_executor_type> ex1 = ...;
+   * auto ex2 = asio::require(ex1,
+   *     asio::execution::blocking.never); @endcode
+   */
+  template <typename Property>
+  constraint_t<
+    can_require<const Executor&, Property>::value
+      && !is_convertible<Property, execution::blocking_t::always_t>::value,
+    mailbox<decay_t<require_result_t<const Executor&, Property>>>
+  > require(const Property& p) const
+    noexcept(is_nothrow_require<const Executor&, Property>::value)
+  {
+    return mailbox<decay_t<require_result_t<const Executor&, Property>>>(
+        asio::require(executor_, p), impl_);
+  }
+
+  /// Forward a preference to the underlying executor.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * asio::prefer customisation point.
+   *
+   * For example:
+   * @code asio::mailbox<my_executor_type> ex1 = ...;
+   * auto ex2 = asio::prefer(ex1,
+   *     asio::execution::blocking.never); @endcode
+   */
+  template <typename Property>
+  constraint_t<
+    can_prefer<const Executor&, Property>::value
+      && !is_convertible<Property, execution::blocking_t::always_t>::value,
+    mailbox<decay_t<prefer_result_t<const Executor&, Property>>>
+  > prefer(const Property& p) const
+    noexcept(is_nothrow_prefer<const Executor&, Property>::value)
+  {
+    return mailbox<decay_t<prefer_result_t<const Executor&, Property>>>(
+        asio::prefer(executor_, p), impl_);
+  }
+
+#if !defined(ASIO_NO_TS_EXECUTORS)
+  /// Obtain the underlying execution context.
+  execution_context& context() const noexcept
+  {
+    return executor_.context();
+  }
+
+  /// Inform the mailbox that it has some outstanding work to do.
+  /**
+   * The mailbox delegates this call to its underlying executor.
+   */
+  void on_work_started() const noexcept
+  {
+    executor_.on_work_started();
+  }
+
+  /// Inform the mailbox that some work is no longer outstanding.
+  /**
+   * The mailbox delegates this call to its underlying executor.
+   */
+  void on_work_finished() const noexcept
+  {
+    executor_.on_work_finished();
+  }
+#endif // !defined(ASIO_NO_TS_EXECUTORS)
+
+  /// Request the mailbox to invoke the given function object.
+  /**
+   * This function is used to ask the mailbox to execute the given function
+   * object on its underlying executor. The function object will be executed
+   * according to the properties of the underlying executor.
+   *
+   * @param f The function object to be called. The executor will make
+   * a copy of the handler object as required. The function signature of the
+   * function object must be: @code void function(); @endcode
+   */
+  template <typename Function>
+  constraint_t<
+    traits::execute_member<const Executor&, Function>::is_valid,
+    void
+  > execute(Function&& f) const
+  {
+    detail::mailbox_executor_service::execute(impl_,
+        executor_, static_cast<Function&&>(f));
+  }
+
+#if !defined(ASIO_NO_TS_EXECUTORS)
+  /// Request the mailbox to invoke the given function object.
+  /**
+   * This function is used to ask the mailbox to execute the given function
+   * object on its underlying executor. The function object will be executed
+   * inside this function if the mailbox is not otherwise busy and if the
+   * underlying executor's @c dispatch() function is also able to execute the
+   * function before returning.
+   *
+   * @param f The function object to be called. The executor will make
+   * a copy of the handler object as required. The function signature of the
+   * function object must be: @code void function(); @endcode
+   *
+   * @param a An allocator that may be used by the executor to allocate the
+   * internal storage needed for function invocation.
+   */
+  template <typename Function, typename Allocator>
+  void dispatch(Function&& f, const Allocator& a) const
+  {
+    detail::mailbox_executor_service::dispatch(impl_,
+        executor_, static_cast<Function&&>(f), a);
+  }
+
+  /// Request the mailbox to invoke the given function object.
+  /**
+   * This function is used to ask the executor to execute the given function
+   * object. The function object will never be executed inside this function.
+   * Instead, it will be scheduled by the underlying executor's post function.
+   *
+   * @param f The function object to be called. The executor will make
+   * a copy of the handler object as required. The function signature of the
+   * function object must be: @code void function(); @endcode
+   *
+   * @param a An allocator that may be used by the executor to allocate the
+   * internal storage needed for function invocation.
+   */
+  template <typename Function, typename Allocator>
+  void post(Function&& f, const Allocator& a) const
+  {
+    detail::mailbox_executor_service::post(impl_,
+        executor_, static_cast<Function&&>(f), a);
+  }
+
+  /// Request the mailbox to invoke the given function object.
+  /**
+   * This function is used to ask the executor to execute the given function
+   * object. The function object will never be executed inside this function.
+   * Instead, it will be scheduled by the underlying executor's defer function.
+   *
+   * @param f The function object to be called. The executor will make
+   * a copy of the handler object as required. The function signature of the
+   * function object must be: @code void function(); @endcode
+   *
+   * @param a An allocator that may be used by the executor to allocate the
+   * internal storage needed for function invocation.
+   */
+  template <typename Function, typename Allocator>
+  void defer(Function&& f, const Allocator& a) const
+  {
+    detail::mailbox_executor_service::defer(impl_,
+        executor_, static_cast<Function&&>(f), a);
+  }
+#endif // !defined(ASIO_NO_TS_EXECUTORS)
+
+  /// Determine whether the mailbox is running in the current thread.
+  /**
+   * @return @c true if the current thread is executing a function that was
+   * submitted to the mailbox using post(), dispatch() or defer(). Otherwise
+   * returns @c false.
+   */
+  bool running_in_this_thread() const noexcept
+  {
+    return detail::mailbox_executor_service::running_in_this_thread(impl_);
+  }
+
+  /// Compare two mailboxes for equality.
+  /**
+   * Two mailboxes are equal if they refer to the same ordered, non-concurrent
+   * state.
+   */
+  friend bool operator==(const mailbox& a, const mailbox& b) noexcept
+  {
+    return a.impl_ == b.impl_;
+  }
+
+  /// Compare two mailboxes for inequality.
+  /**
+   * Two mailboxes are equal if they refer to the same ordered, non-concurrent
+   * state.
+   */
+  friend bool operator!=(const mailbox& a, const mailbox& b) noexcept
+  {
+    return a.impl_ != b.impl_;
+  }
+
+#if defined(GENERATING_DOCUMENTATION)
+private:
+#endif // defined(GENERATING_DOCUMENTATION)
+  typedef detail::mailbox_executor_service::implementation_type
+    implementation_type;
+
+  template <typename InnerExecutor>
+  static implementation_type create_implementation(const InnerExecutor& ex,
+      constraint_t<
+        can_query<InnerExecutor, execution::context_t>::value
+      > = 0)
+  {
+    return use_service<detail::mailbox_executor_service>(
+        asio::query(ex, execution::context)).create_implementation();
+  }
+
+  template <typename InnerExecutor>
+  static implementation_type create_implementation(const InnerExecutor& ex,
+      constraint_t<
+        !can_query<InnerExecutor, execution::context_t>::value
+      > = 0)
+  {
+    return use_service<detail::mailbox_executor_service>(
+        ex.context()).create_implementation();
+  }
+
+  mailbox(const Executor& ex, const implementation_type& impl)
+    : executor_(ex),
+      impl_(impl)
+  {
+  }
+
+  template <typename Property>
+  query_result_t<const Executor&, Property> query_helper(
+      false_type, const Property& property) const
+  {
+    return asio::query(executor_, property);
+  }
+
+  template <typename Property>
+  execution::blocking_t query_helper(true_type, const Property& property) const
+  {
+    execution::blocking_t result = asio::query(executor_, property);
+    return result == execution::blocking.always
+      ? execution::blocking.possibly : result;
+  }
+
+  Executor executor_;
+  implementation_type impl_;
+};
+
+/** @defgroup make_mailbox asio::make_mailbox
+ *
+ * @brief The asio::make_mailbox function creates a @ref mailbox object for
+ * an executor or execution context.
+ */
+/*@{*/
+
+/// Create a @ref mailbox object for an executor.
+/**
+ * @param ex An executor.
+ *
+ * @returns A mailbox constructed with the specified executor.
+ */
+template <typename Executor>
+inline mailbox<Executor> make_mailbox(const Executor& ex,
+    constraint_t<
+      is_executor<Executor>::value || execution::is_executor<Executor>::value
+    > = 0)
+{
+  return mailbox<Executor>(ex);
+}
+
+/// Create a @ref mailbox object for an execution context.
+/**
+ * @param ctx An execution context, from which an executor will be obtained.
+ *
+ * @returns A mailbox constructed with the execution context's executor, obtained
+ * by performing <tt>ctx.get_executor()</tt>.
+ */
+template <typename ExecutionContext>
+inline mailbox<typename ExecutionContext::executor_type>
+make_mailbox(ExecutionContext& ctx,
+    constraint_t<
+      is_convertible<ExecutionContext&, execution_context&>::value
+    > = 0)
+{
+  return mailbox<typename ExecutionContext::executor_type>(ctx.get_executor());
+}
+
+/*@}*/
+
+} // namespace experimental
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+namespace traits {
+
+#if !defined(ASIO_HAS_DEDUCED_EQUALITY_COMPARABLE_TRAIT)
+
+template <typename Executor>
+struct equality_comparable<experimental::mailbox<Executor>>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = true;
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_EQUALITY_COMPARABLE_TRAIT)
+
+#if !defined(ASIO_HAS_DEDUCED_EXECUTE_MEMBER_TRAIT)
+
+template <typename Executor, typename Function>
+struct execute_member<experimental::mailbox<Executor>, Function,
+    enable_if_t<
+      traits::execute_member<const Executor&, Function>::is_valid
+    >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = false;
+  typedef void result_type;
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_EXECUTE_MEMBER_TRAIT)
+
+#if !defined(ASIO_HAS_DEDUCED_QUERY_MEMBER_TRAIT)
+
+template <typename Executor, typename Property>
+struct query_member<experimental::mailbox<Executor>, Property,
+    enable_if_t<
+      can_query<const Executor&, Property>::value
+    >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept =
+    is_nothrow_query<Executor, Property>::value;
+  typedef conditional_t<
+    is_convertible<Property, execution::blocking_t>::value,
+      execution::blocking_t, query_result_t<Executor, Property>> result_type;
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_QUERY_MEMBER_TRAIT)
+
+#if !defined(ASIO_HAS_DEDUCED_REQUIRE_MEMBER_TRAIT)
+
+template <typename Executor, typename Property>
+struct require_member<experimental::mailbox<Executor>, Property,
+    enable_if_t<
+      can_require<const Executor&, Property>::value
+        && !is_convertible<Property, execution::blocking_t::always_t>::value
+    >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept =
+    is_nothrow_require<Executor, Property>::value;
+  typedef experimental::mailbox<decay_t<require_result_t<Executor, Property>>> result_type;
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_REQUIRE_MEMBER_TRAIT)
+
+#if !defined(ASIO_HAS_DEDUCED_PREFER_MEMBER_TRAIT)
+
+template <typename Executor, typename Property>
+struct prefer_member<experimental::mailbox<Executor>, Property,
+    enable_if_t<
+      can_prefer<const Executor&, Property>::value
+        && !is_convertible<Property, execution::blocking_t::always_t>::value
+    >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept =
+    is_nothrow_prefer<Executor, Property>::value;
+  typedef experimental::mailbox<decay_t<prefer_result_t<Executor, Property>>> result_type;
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_PREFER_MEMBER_TRAIT)
+
+} // namespace traits
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXPERIMENTAL_MAILBOX_HPP
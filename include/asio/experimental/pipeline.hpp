@@ -0,0 +1,696 @@
+//
+// experimental/pipeline.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_PIPELINE_HPP
+#define ASIO_EXPERIMENTAL_PIPELINE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "asio/any_io_executor.hpp"
+#include "asio/async_result.hpp"
+#include "asio/compose.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/throw_exception.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/error.hpp"
+#include "asio/error_code.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/experimental/async_semaphore.hpp"
+#include "asio/experimental/detail/pipeline_stage.hpp"
+#include "asio/is_executor.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+
+/// Collects the values produced by a pipeline stage.
+/**
+ * A reference to a pipeline_output object is passed to each invocation of a
+ * stage's function. Values pushed to the output are held by the stage's worker
+ * and handed to the next stage as a batch once the worker has finished its
+ * current run.
+ */
+template <typename T>
+class pipeline_output
+{
+public:
+  /// Push a value to the next stage.
+  void push(const T& value)
+  {
+    values_.push_back(value);
+  }
+
+  /// Push a value to the next stage.
+  void push(T&& value)
+  {
+    values_.push_back(static_cast<T&&>(value));
+  }
+
+  /// Construct a value in place and push it to the next stage.
+  template <typename... Args>
+  void emplace(Args&&... args)
+  {
+    values_.emplace_back(static_cast<Args&&>(args)...);
+  }
+
+private:
+  template <typename> friend class detail::pipeline_sender;
+
+  pipeline_output()
+    : flushed_(0)
+  {
+  }
+
+  pipeline_output(const pipeline_output&) = delete;
+  pipeline_output& operator=(const pipeline_output&) = delete;
+
+  std::vector<T> values_;
+  std::size_t flushed_;
+};
+
+namespace detail {
+
+template <typename T, typename Executor>
+class pipeline_state : public pipeline_owner
+{
+public:
+  explicit pipeline_state(const Executor& ex)
+    : credits_(ex, 0),
+      done_(ex, 0),
+      head_(0),
+      users_(0)
+  {
+  }
+
+  ~pipeline_state()
+  {
+    for (std::size_t i = 0; i < stages_.size(); ++i)
+      delete stages_[i];
+  }
+
+  void add(pipeline_stage_base* stage)
+  {
+    stages_.push_back(stage);
+  }
+
+  void start(pipeline_input<T>* head)
+  {
+    head_ = head;
+    credits_.release(head->queue_.capacity());
+  }
+
+  void consumed(std::size_t n)
+  {
+    credits_.release(n);
+  }
+
+  void finished()
+  {
+    done_.release();
+  }
+
+  // Push a value to the first stage. The caller must hold a credit, which
+  // guarantees that there is space in the first stage's queue.
+  template <typename Arg>
+  bool push(Arg&& arg)
+  {
+    if (users_.fetch_add(2, std::memory_order_acq_rel) & 1)
+    {
+      leave();
+      credits_.release();
+      return false;
+    }
+
+    // With concurrent consumers, a credit may be returned for one slot before
+    // another consumer has finished moving a value out of the slot that the
+    // push is targeting. That consumer is not running user code, so the slot
+    // is released shortly.
+    while (!head_->queue_.try_push(static_cast<Arg&&>(arg)))
+      std::this_thread::yield();
+    head_->notify(1);
+    leave();
+    return true;
+  }
+
+  void close()
+  {
+    credits_.cancel();
+    std::size_t users = users_.fetch_or(1, std::memory_order_acq_rel);
+    if (users == 0)
+      head_->close();
+  }
+
+  // The last producer to leave after the pipeline is closed closes the first
+  // stage.
+  void leave()
+  {
+    if (users_.fetch_sub(2, std::memory_order_acq_rel) == 3)
+      head_->close();
+  }
+
+  basic_async_semaphore<Executor> credits_;
+  basic_async_semaphore<Executor> done_;
+
+private:
+  std::vector<pipeline_stage_base*> stages_;
+  pipeline_input<T>* head_;
+
+  // Twice the number of producers currently pushing a value, plus one if the
+  // pipeline has been closed.
+  std::atomic<std::size_t> users_;
+};
+
+} // namespace detail
+
+template <typename T, typename Executor>
+class basic_pipeline;
+
+template <typename T, typename Current, typename Executor>
+class basic_pipeline_builder;
+
+/// Create a builder for a pipeline that accepts values of type @c T.
+/**
+ * @param ex The default executor. It is used to run stages that are added
+ * without an executor, and to dispatch handlers for the pipeline's
+ * asynchronous operations.
+ */
+template <typename T, typename Executor>
+basic_pipeline_builder<T, T, Executor> make_pipeline(const Executor& ex,
+    constraint_t<
+      execution::is_executor<Executor>::value || is_executor<Executor>::value
+    > = 0);
+
+/// Create a builder for a pipeline that accepts values of type @c T.
+/**
+ * @param ctx An execution context which provides the default executor. It is
+ * used to run stages that are added without an executor, and to dispatch
+ * handlers for the pipeline's asynchronous operations.
+ */
+template <typename T, typename ExecutionContext>
+basic_pipeline_builder<T, T, typename ExecutionContext::executor_type>
+make_pipeline(ExecutionContext& ctx,
+    constraint_t<
+      is_convertible<ExecutionContext&, execution_context&>::value
+    > = 0);
+
+/// Builds a pipeline one stage at a time.
+/**
+ * A pipeline is a chain of stages. Each stage has a bounded, lock-free queue
+ * of input values and runs its function on an executor. When a stage and the
+ * stage before it both have a parallelism of one, the queue between them is a
+ * single-producer single-consumer ring buffer. Otherwise it is a
+ * multi-producer multi-consumer ring buffer. A stage's workers each process a
+ * batch of values per run, and pass their output values to the next stage's
+ * queue at the end of the run.
+ *
+ * When a queue is full, the workers feeding it stop and are rescheduled once
+ * the stage that owns the queue has made progress, so that a slow stage
+ * applies backpressure to the stages before it and, ultimately, to the
+ * pipeline's producers.
+ *
+ * @tparam T The type of the values pushed into the pipeline.
+ *
+ * @tparam Current The type of the values produced by the last stage added.
+ *
+ * @tparam Executor The pipeline's default executor type.
+ *
+ * For example, to filter, transform and write lines of text:
+ * @code auto p = asio::experimental::make_pipeline<std::string>(ctx)
+ *   .stage<std::string>(
+ *       [](std::string line, pipeline_output<std::string>& out)
+ *       {
+ *         if (!line.empty())
+ *           out.push(std::move(line));
+ *       })
+ *   .stage<std::string>(pool.get_executor(),
+ *       [](std::string line, pipeline_output<std::string>& out)
+ *       {
+ *         out.push(to_upper(line));
+ *       }, 4)
+ *   .sink([](std::string line){ std::cout << line << "\n"; }); @endcode
+ *
+ * A builder should be used to add at most one further stage or sink.
+ */
+template <typename T, typename Current, typename Executor>
+class basic_pipeline_builder
+{
+private:
+  typedef detail::pipeline_state<T, Executor> state_type;
+
+public:
+  /// The type of the default executor.
+  typedef Executor executor_type;
+
+  /// Construct a builder for a new pipeline.
+  /**
+   * @param ex The default executor. It is used to run stages that are added
+   * without an executor, and to dispatch handlers for the pipeline's
+   * asynchronous operations.
+   */
+  explicit basic_pipeline_builder(const executor_type& ex)
+    : state_(std::make_shared<state_type>(ex)),
+      tail_(0),
+      tail_parallelism_(0),
+      capacity_(1024),
+      batch_size_(64),
+      executor_(ex)
+  {
+    static_assert(is_same<T, Current>::value,
+        "a new pipeline's current type must be its input type");
+  }
+
+  /// Get the default executor.
+  const executor_type& get_executor() const noexcept
+  {
+    return executor_;
+  }
+
+  /// Set the queue capacity for stages that are subsequently added.
+  /**
+   * The capacity is rounded up to a power of two. The default is 1024.
+   *
+   * @throws std::invalid_argument Thrown if @c n is zero.
+   */
+  basic_pipeline_builder& queue_capacity(std::size_t n)
+  {
+    check_non_zero(n, "queue capacity must be non-zero");
+    capacity_ = n;
+    return *this;
+  }
+
+  /// Set the batch size for stages that are subsequently added.
+  /**
+   * The batch size is the maximum number of values that a stage's worker
+   * processes before passing its output to the next stage and yielding its
+   * thread. The default is 64.
+   *
+   * @throws std::invalid_argument Thrown if @c n is zero.
+   */
+  basic_pipeline_builder& batch_size(std::size_t n)
+  {
+    check_non_zero(n, "batch size must be non-zero");
+    batch_size_ = n;
+    return *this;
+  }
+
+  /// Add a stage that runs on the default executor.
+  /**
+   * @tparam Out The type of the values that the stage produces.
+   *
+   * @param f The stage's function, which is called as
+   * @code f(std::move(value), output) @endcode
+   * where @c output is an lvalue of type @c pipeline_output<Out>. The function
+   * may push any number of values to the output. It must not throw.
+   *
+   * @param parallelism The maximum number of concurrent invocations of @c f.
+   * If greater than one, @c f must be safe to call concurrently.
+   *
+   * @throws std::invalid_argument Thrown if @c parallelism is zero.
+   */
+  template <typename Out, typename Function>
+  basic_pipeline_builder<T, Out, Executor> stage(
+      Function&& f, std::size_t parallelism = 1)
+  {
+    return this->stage<Out>(executor_,
+        static_cast<Function&&>(f), parallelism);
+  }
+
+  /// Add a stage that runs on the specified executor.
+  /**
+   * @tparam Out The type of the values that the stage produces.
+   *
+   * @param ex The executor on which the stage's function is run.
+   *
+   * @param f The stage's function, which is called as
+   * @code f(std::move(value), output) @endcode
+   * where @c output is an lvalue of type @c pipeline_output<Out>. The function
+   * may push any number of values to the output. It must not throw.
+   *
+   * @param parallelism The maximum number of concurrent invocations of @c f.
+   * If greater than one, @c f must be safe to call concurrently.
+   *
+   * @throws std::invalid_argument Thrown if @c parallelism is zero.
+   */
+  template <typename Out, typename StageExecutor, typename Function>
+  basic_pipeline_builder<T, Out, Executor> stage(const StageExecutor& ex,
+      Function&& f, std::size_t parallelism = 1,
+      constraint_t<
+        execution::is_executor<StageExecutor>::value
+          || is_executor<StageExecutor>::value
+      > = 0)
+  {
+    detail::pipeline_connector<Out>* s = this->add_stage<Out>(
+        ex, static_cast<Function&&>(f), parallelism);
+    return basic_pipeline_builder<T, Out, Executor>(state_, s,
+        parallelism, capacity_, batch_size_, executor_);
+  }
+
+  /// Add the final stage, which runs on the default executor, and create the
+  /// pipeline.
+  /**
+   * @param f The stage's function, which is called as
+   * @code f(std::move(value)) @endcode
+   * It must not throw.
+   *
+   * @param parallelism The maximum number of concurrent invocations of @c f.
+   * If greater than one, @c f must be safe to call concurrently.
+   *
+   * @throws std::invalid_argument Thrown if @c parallelism is zero.
+   */
+  template <typename Function>
+  basic_pipeline<T, Executor> sink(Function&& f, std::size_t parallelism = 1)
+  {
+    return this->sink(executor_, static_cast<Function&&>(f), parallelism);
+  }
+
+  /// Add the final stage, which runs on the specified executor, and create
+  /// the pipeline.
+  /**
+   * @param ex The executor on which the stage's function is run.
+   *
+   * @param f The stage's function, which is called as
+   * @code f(std::move(value)) @endcode
+   * It must not throw.
+   *
+   * @param parallelism The maximum number of concurrent invocations of @c f.
+   * If greater than one, @c f must be safe to call concurrently.
+   *
+   * @throws std::invalid_argument Thrown if @c parallelism is zero.
+   */
+  template <typename StageExecutor, typename Function>
+  basic_pipeline<T, Executor> sink(const StageExecutor& ex,
+      Function&& f, std::size_t parallelism = 1,
+      constraint_t<
+        execution::is_executor<StageExecutor>::value
+          || is_executor<StageExecutor>::value
+      > = 0)
+  {
+    this->add_stage<void>(ex, static_cast<Function&&>(f), parallelism);
+    return basic_pipeline<T, Executor>(state_);
+  }
+
+private:
+  template <typename, typename, typename>
+    friend class basic_pipeline_builder;
+
+  basic_pipeline_builder(const std::shared_ptr<state_type>& state,
+      detail::pipeline_connector<Current>* tail,
+      std::size_t tail_parallelism, std::size_t capacity,
+      std::size_t batch_size, const executor_type& ex)
+    : state_(state),
+      tail_(tail),
+      tail_parallelism_(tail_parallelism),
+      capacity_(capacity),
+      batch_size_(batch_size),
+      executor_(ex)
+  {
+  }
+
+  static void check_non_zero(std::size_t n, const char* what)
+  {
+    if (n == 0)
+    {
+      std::invalid_argument ex(what);
+      asio::detail::throw_exception(ex);
+    }
+  }
+
+  template <typename Out, typename StageExecutor, typename Function>
+  detail::pipeline_stage<Current, Out, decay_t<Function>, StageExecutor>*
+  add_stage(const StageExecutor& ex, Function&& f, std::size_t parallelism)
+  {
+    typedef detail::pipeline_stage<Current, Out,
+      decay_t<Function>, StageExecutor> stage_type;
+
+    check_non_zero(parallelism, "parallelism must be non-zero");
+
+    std::unique_ptr<stage_type> s(new stage_type(state_.get(),
+          static_cast<Function&&>(f), ex, parallelism, capacity_, batch_size_,
+          tail_ != 0 && tail_parallelism_ == 1, tail_ == 0));
+    state_->add(s.get());
+
+    this->attach(s.get(), is_same<T, Current>());
+    return s.release();
+  }
+
+  void attach(detail::pipeline_input<T>* s, true_type)
+  {
+    if (tail_)
+      tail_->connect(s);
+    else
+      state_->start(s);
+  }
+
+  void attach(detail::pipeline_input<Current>* s, false_type)
+  {
+    tail_->connect(s);
+  }
+
+  std::shared_ptr<state_type> state_;
+  detail::pipeline_connector<Current>* tail_;
+  std::size_t tail_parallelism_;
+  std::size_t capacity_;
+  std::size_t batch_size_;
+  executor_type executor_;
+};
+
+/// A chain of stages that process values concurrently.
+/**
+ * Pipelines are created using make_pipeline() and basic_pipeline_builder.
+ * Producers push values with try_push() or async_push(), which respect the
+ * capacity of the first stage's queue. Once all values have been pushed, the
+ * pipeline is closed and async_wait() completes when every stage has
+ * processed all of its values.
+ *
+ * Destroying the pipeline closes it. Values that have already been pushed
+ * are still processed.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ */
+template <typename T, typename Executor = any_io_executor>
+class basic_pipeline
+{
+private:
+  typedef detail::pipeline_state<T, Executor> state_type;
+  struct push_op;
+  struct wait_op;
+
+public:
+  /// The type of the values pushed into the pipeline.
+  typedef T value_type;
+
+  /// The type of the executor associated with the pipeline.
+  typedef Executor executor_type;
+
+  /// Move-construct a pipeline from another.
+  basic_pipeline(basic_pipeline&& other) noexcept
+    : state_(static_cast<std::shared_ptr<state_type>&&>(other.state_))
+  {
+  }
+
+  /// Destructor.
+  ~basic_pipeline()
+  {
+    if (state_)
+      state_->close();
+  }
+
+  /// Get the executor associated with the object.
+  const executor_type& get_executor() noexcept
+  {
+    return state_->done_.get_executor();
+  }
+
+  /// Try to push a value into the pipeline without waiting.
+  /**
+   * @returns @c true if the value was pushed. Returns @c false, and does not
+   * modify the value, if the first stage's queue is full or the pipeline has
+   * been closed.
+   */
+  bool try_push(const T& value)
+  {
+    return state_->credits_.try_acquire() && state_->push(value);
+  }
+
+  /// Try to push a value into the pipeline without waiting.
+  /**
+   * @returns @c true if the value was pushed. Returns @c false, and does not
+   * modify the value, if the first stage's queue is full or the pipeline has
+   * been closed.
+   */
+  bool try_push(T&& value)
+  {
+    return state_->credits_.try_acquire()
+      && state_->push(static_cast<T&&>(value));
+  }
+
+  /// Asynchronously push a value into the pipeline.
+  /**
+   * The operation waits until there is space in the first stage's queue.
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   *
+   * The operation completes with asio::error::operation_aborted if the
+   * pipeline is closed before the value could be pushed.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        CompletionToken ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  auto async_push(T value,
+      CompletionToken&& token
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+    -> decltype(
+      async_compose<CompletionToken, void (asio::error_code)>(
+        declval<push_op>(), token, declval<const executor_type&>()))
+  {
+    return async_compose<CompletionToken, void (asio::error_code)>(
+        push_op(state_, static_cast<T&&>(value)), token, get_executor());
+  }
+
+  /// Close the pipeline.
+  /**
+   * No further values may be pushed. Waiting async_push() operations
+   * complete with asio::error::operation_aborted.
+   */
+  void close()
+  {
+    state_->close();
+  }
+
+  /// Asynchronously wait for the pipeline to finish.
+  /**
+   * The operation completes once the pipeline has been closed and every stage
+   * has processed all of its values.
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        CompletionToken ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  auto async_wait(
+      CompletionToken&& token
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+    -> decltype(
+      async_compose<CompletionToken, void (asio::error_code)>(
+        declval<wait_op>(), token, declval<const executor_type&>()))
+  {
+    return async_compose<CompletionToken, void (asio::error_code)>(
+        wait_op(state_), token, get_executor());
+  }
+
+private:
+  template <typename, typename, typename>
+    friend class basic_pipeline_builder;
+
+  explicit basic_pipeline(const std::shared_ptr<state_type>& state)
+    : state_(state)
+  {
+  }
+
+  // Disallow copying and assignment.
+  basic_pipeline(const basic_pipeline&) = delete;
+  basic_pipeline& operator=(const basic_pipeline&) = delete;
+
+  struct push_op
+  {
+    push_op(const std::shared_ptr<state_type>& state, T&& value)
+      : state_(state),
+        value_(static_cast<T&&>(value))
+    {
+    }
+
+    template <typename Self>
+    void operator()(Self& self)
+    {
+      std::shared_ptr<state_type> state = state_;
+      state->credits_.async_acquire(static_cast<Self&&>(self));
+    }
+
+    template <typename Self>
+    void operator()(Self& self, asio::error_code ec)
+    {
+      if (!ec && !state_->push(static_cast<T&&>(value_)))
+        ec = asio::error::operation_aborted;
+      self.complete(ec);
+    }
+
+    std::shared_ptr<state_type> state_;
+    T value_;
+  };
+
+  struct wait_op
+  {
+    explicit wait_op(const std::shared_ptr<state_type>& state)
+      : state_(state)
+    {
+    }
+
+    template <typename Self>
+    void operator()(Self& self)
+    {
+      std::shared_ptr<state_type> state = state_;
+      state->done_.async_acquire(static_cast<Self&&>(self));
+    }
+
+    // The permit is returned so that any other waiters also complete.
+    template <typename Self>
+    void operator()(Self& self, asio::error_code ec)
+    {
+      if (!ec)
+        state_->done_.release();
+      self.complete(ec);
+    }
+
+    std::shared_ptr<state_type> state_;
+  };
+
+  std::shared_ptr<state_type> state_;
+};
+
+template <typename T, typename Executor>
+inline basic_pipeline_builder<T, T, Executor> make_pipeline(
+    const Executor& ex,
+    constraint_t<
+      execution::is_executor<Executor>::value || is_executor<Executor>::value
+    >)
+{
+  return basic_pipeline_builder<T, T, Executor>(ex);
+}
+
+template <typename T, typename ExecutionContext>
+inline basic_pipeline_builder<T, T, typename ExecutionContext::executor_type>
+make_pipeline(ExecutionContext& ctx,
+    constraint_t<
+      is_convertible<ExecutionContext&, execution_context&>::value
+    >)
+{
+  return (make_pipeline<T>)(ctx.get_executor());
+}
+
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXPERIMENTAL_PIPELINE_HPP
@@ -0,0 +1,57 @@
+//
+// impl/admission_statistics.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_ADMISSION_STATISTICS_IPP
+#define ASIO_IMPL_ADMISSION_STATISTICS_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/admission_statistics.hpp"
+#include "asio/detail/scheduler.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+admission_statistics get_admission_statistics(execution_context& ctx)
+{
+  admission_statistics stats = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+  if (has_service<detail::scheduler>(ctx))
+  {
+    detail::scheduler& sched = use_service<detail::scheduler>(ctx);
+    const detail::admission_control& admission = sched.admission();
+    stats.outstanding_work = sched.outstanding_work();
+    stats.handlers_queued = admission.in_flight(
+        detail::admission_control::handler_work);
+    stats.handlers_over_limit = admission.over_limit(
+        detail::admission_control::handler_work);
+    stats.handlers_blocked = admission.handlers_blocked();
+    stats.handlers_rejected = admission.handlers_rejected();
+    stats.handlers_shed = admission.handlers_shed();
+    stats.accepts_over_limit = admission.over_limit(
+        detail::admission_control::accept_work);
+    stats.reads_over_limit = admission.over_limit(
+        detail::admission_control::read_work);
+    stats.accepts_in_flight = admission.in_flight(
+        detail::admission_control::accept_work);
+    stats.reads_in_flight = admission.in_flight(
+        detail::admission_control::read_work);
+  }
+  return stats;
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_ADMISSION_STATISTICS_IPP
@@ -31,6 +31,7 @@
 #include "asio/post.hpp"
 #include "asio/system_error.hpp"
 #include "asio/this_coro.hpp"
+#include "asio/trace_context.hpp"
 
 #if defined(ASIO_ENABLE_HANDLER_TRACKING)
 # if defined(ASIO_HAS_SOURCE_LOCATION)
@@ -655,6 +656,7 @@ private:
   awaitable_frame_base<Executor>* top_of_stack_;
   asio::cancellation_slot parent_cancellation_slot_;
   asio::cancellation_state cancellation_state_;
+  asio::trace_context trace_context_;
   bool has_executor_;
   bool throw_if_cancelled_;
 };
@@ -665,11 +667,12 @@ class awaitable_thread
 public:
   typedef Executor executor_type;
   typedef cancellation_slot cancellation_slot_type;
+  typedef asio::trace_context trace_context_type;
 
   // Construct from the entry point of a new thread of execution.
   awaitable_thread(awaitable<awaitable_thread_entry_point, Executor> p,
       const Executor& ex, cancellation_slot parent_cancel_slot,
-      cancellation_state cancel_state)
+      cancellation_state cancel_state, const trace_context_type& trace_ctx)
     : bottom_of_stack_(std::move(p))
   {
     bottom_of_stack_.frame_->top_of_stack_ = bottom_of_stack_.frame_;
@@ -677,6 +680,7 @@ public:
     bottom_of_stack_.frame_->has_executor_ = true;
     bottom_of_stack_.frame_->parent_cancellation_slot_ = parent_cancel_slot;
     bottom_of_stack_.frame_->cancellation_state_ = cancel_state;
+    bottom_of_stack_.frame_->trace_context_ = trace_ctx;
   }
 
   // Transfer ownership from another awaitable_thread.
@@ -756,6 +760,11 @@ public:
     return bottom_of_stack_.frame_->cancellation_state_.slot();
   }
 
+  trace_context_type get_trace_context() const noexcept
+  {
+    return bottom_of_stack_.frame_->trace_context_;
+  }
+
   // Launch a new thread of execution.
   void launch()
   {
@@ -770,6 +779,8 @@ protected:
   // has been transferred to another resumable_thread object.
   void pump()
   {
+    trace_context_scope trace_scope(bottom_of_stack_.frame_->trace_context_);
+
     do
       bottom_of_stack_.frame_->top_of_stack_->resume();
     while (bottom_of_stack_.frame_ && bottom_of_stack_.frame_->top_of_stack_);
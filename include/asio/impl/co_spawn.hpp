@@ -17,6 +17,7 @@
 
 #include "asio/detail/config.hpp"
 #include "asio/associated_cancellation_slot.hpp"
+#include "asio/associated_trace_context.hpp"
 #include "asio/awaitable.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/recycling_allocator.hpp"
@@ -335,11 +336,16 @@ public:
 
     cancellation_state cancel_state(proxy_slot);
 
+    // The new thread inherits the trace context of the completion handler or,
+    // failing that, of the code that spawned it.
+    asio::trace_context trace_ctx = (get_associated_trace_context)(
+        handler, asio::trace_context::current());
+
     auto a = (co_spawn_entry_point)(static_cast<awaitable_type*>(nullptr),
         co_spawn_state<handler_type, Executor, function_type>(
           std::forward<Handler>(handler), ex_, std::forward<F>(f)));
     awaitable_handler<executor_type, void>(std::move(a),
-        ex_, proxy_slot, cancel_state).launch();
+        ex_, proxy_slot, cancel_state, trace_ctx).launch();
   }
 
 private:
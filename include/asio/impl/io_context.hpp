@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/config.hpp"
+#include "asio/detail/admission_control.hpp"
 #include "asio/detail/completion_handler.hpp"
 #include "asio/detail/executor_op.hpp"
 #include "asio/detail/fenced_block.hpp"
@@ -154,6 +155,8 @@ io_context::basic_executor_type<Allocator, Bits>::operator=(
   if (this != &other)
   {
     static_cast<Allocator&>(*this) = static_cast<const Allocator&>(other);
+    static_cast<priority_type&>(*this) =
+      static_cast<const priority_type&>(other);
     io_context* old_io_context = context_ptr();
     target_ = other.target_;
     if (Bits & outstanding_work_tracked)
@@ -175,6 +178,8 @@ io_context::basic_executor_type<Allocator, Bits>::operator=(
   if (this != &other)
   {
     static_cast<Allocator&>(*this) = static_cast<Allocator&&>(other);
+    static_cast<priority_type&>(*this) =
+      static_cast<const priority_type&>(other);
     io_context* old_io_context = context_ptr();
     target_ = other.target_;
     if (Bits & outstanding_work_tracked)
@@ -202,8 +207,12 @@ void io_context::basic_executor_type<Allocator, Bits>::execute(
   typedef decay_t<Function> function_type;
 
   // Invoke immediately if the blocking.possibly property is enabled and we are
-  // already inside the thread pool.
-  if ((bits() & blocking_never) == 0 && context_ptr()->impl_.can_dispatch())
+  // already inside the thread pool. A prioritised function is only invoked
+  // immediately if doing so would not bypass higher priority work.
+  if ((bits() & blocking_never) == 0
+      && ((Bits & prioritised)
+        ? context_ptr()->impl_.can_dispatch(this->priority_value())
+        : context_ptr()->impl_.can_dispatch()))
   {
     // Make a local, non-const copy of the function.
     function_type tmp(static_cast<Function&&>(f));
@@ -225,19 +234,35 @@ void io_context::basic_executor_type<Allocator, Bits>::execute(
 #endif // !defined(ASIO_NO_EXCEPTIONS)
   }
 
-  // Allocate and construct an operation to wrap the function.
-  typedef detail::executor_op<function_type, Allocator, detail::operation> op;
+  // Allocate an operation to wrap the function.
+  typedef detail::admitted_function<function_type> admitted_type;
+  typedef detail::executor_op<admitted_type, Allocator, detail::operation> op;
   typename op::ptr p = {
       detail::addressof(static_cast<const Allocator&>(*this)),
       op::ptr::allocate(static_cast<const Allocator&>(*this)), 0 };
-  p.p = new (p.v) op(static_cast<Function&&>(f),
+
+  // Apply backpressure to new work, dropping the function if it is shed.
+  detail::admission_control* admission = 0;
+  if (!context_ptr()->impl_.admit_handler(
+        (bits() & relationship_continuation) != 0, admission))
+    return;
+
+  p.p = new (p.v) op(admitted_type(static_cast<Function&&>(f), admission),
       static_cast<const Allocator&>(*this));
 
   ASIO_HANDLER_CREATION((*context_ptr(), *p.p,
         "io_context", context_ptr(), 0, "execute"));
 
-  context_ptr()->impl_.post_immediate_completion(p.p,
-      (bits() & relationship_continuation) != 0);
+  if (Bits & prioritised)
+  {
+    context_ptr()->impl_.post_prioritised_completion(
+        p.p, this->priority_value());
+  }
+  else
+  {
+    context_ptr()->impl_.post_immediate_completion(p.p,
+        (bits() & relationship_continuation) != 0);
+  }
   p.v = p.p = 0;
 }
 
@@ -271,7 +296,9 @@ void io_context::basic_executor_type<Allocator, Bits>::dispatch(
   typedef decay_t<Function> function_type;
 
   // Invoke immediately if we are already inside the thread pool.
-  if (context_ptr()->impl_.can_dispatch())
+  if ((Bits & prioritised)
+      ? context_ptr()->impl_.can_dispatch(this->priority_value())
+      : context_ptr()->impl_.can_dispatch())
   {
     // Make a local, non-const copy of the function.
     function_type tmp(static_cast<Function&&>(f));
@@ -281,16 +308,29 @@ void io_context::basic_executor_type<Allocator, Bits>::dispatch(
     return;
   }
 
-  // Allocate and construct an operation to wrap the function.
-  typedef detail::executor_op<function_type,
+  // Allocate an operation to wrap the function.
+  typedef detail::admitted_function<function_type> admitted_type;
+  typedef detail::executor_op<admitted_type,
       OtherAllocator, detail::operation> op;
   typename op::ptr p = { detail::addressof(a), op::ptr::allocate(a), 0 };
-  p.p = new (p.v) op(static_cast<Function&&>(f), a);
+
+  // Apply backpressure to new work, dropping the function if it is shed.
+  detail::admission_control* admission = 0;
+  if (!context_ptr()->impl_.admit_handler(false, admission))
+    return;
+
+  p.p = new (p.v) op(admitted_type(static_cast<Function&&>(f), admission), a);
 
   ASIO_HANDLER_CREATION((*context_ptr(), *p.p,
         "io_context", context_ptr(), 0, "dispatch"));
 
-  context_ptr()->impl_.post_immediate_completion(p.p, false);
+  if (Bits & prioritised)
+  {
+    context_ptr()->impl_.post_prioritised_completion(
+        p.p, this->priority_value());
+  }
+  else
+    context_ptr()->impl_.post_immediate_completion(p.p, false);
   p.v = p.p = 0;
 }
 
@@ -299,16 +339,29 @@ template <typename Function, typename OtherAllocator>
 void io_context::basic_executor_type<Allocator, Bits>::post(
     Function&& f, const OtherAllocator& a) const
 {
-  // Allocate and construct an operation to wrap the function.
-  typedef detail::executor_op<decay_t<Function>,
+  // Allocate an operation to wrap the function.
+  typedef detail::admitted_function<decay_t<Function>> admitted_type;
+  typedef detail::executor_op<admitted_type,
       OtherAllocator, detail::operation> op;
   typename op::ptr p = { detail::addressof(a), op::ptr::allocate(a), 0 };
-  p.p = new (p.v) op(static_cast<Function&&>(f), a);
+
+  // Apply backpressure to new work, dropping the function if it is shed.
+  detail::admission_control* admission = 0;
+  if (!context_ptr()->impl_.admit_handler(false, admission))
+    return;
+
+  p.p = new (p.v) op(admitted_type(static_cast<Function&&>(f), admission), a);
 
   ASIO_HANDLER_CREATION((*context_ptr(), *p.p,
         "io_context", context_ptr(), 0, "post"));
 
-  context_ptr()->impl_.post_immediate_completion(p.p, false);
+  if (Bits & prioritised)
+  {
+    context_ptr()->impl_.post_prioritised_completion(
+        p.p, this->priority_value());
+  }
+  else
+    context_ptr()->impl_.post_immediate_completion(p.p, false);
   p.v = p.p = 0;
 }
 
@@ -317,16 +370,29 @@ template <typename Function, typename OtherAllocator>
 void io_context::basic_executor_type<Allocator, Bits>::defer(
     Function&& f, const OtherAllocator& a) const
 {
-  // Allocate and construct an operation to wrap the function.
-  typedef detail::executor_op<decay_t<Function>,
+  // Allocate an operation to wrap the function.
+  typedef detail::admitted_function<decay_t<Function>> admitted_type;
+  typedef detail::executor_op<admitted_type,
       OtherAllocator, detail::operation> op;
   typename op::ptr p = { detail::addressof(a), op::ptr::allocate(a), 0 };
-  p.p = new (p.v) op(static_cast<Function&&>(f), a);
+
+  // Apply backpressure to new work, dropping the function if it is shed.
+  detail::admission_control* admission = 0;
+  if (!context_ptr()->impl_.admit_handler(true, admission))
+    return;
+
+  p.p = new (p.v) op(admitted_type(static_cast<Function&&>(f), admission), a);
 
   ASIO_HANDLER_CREATION((*context_ptr(), *p.p,
         "io_context", context_ptr(), 0, "defer"));
 
-  context_ptr()->impl_.post_immediate_completion(p.p, true);
+  if (Bits & prioritised)
+  {
+    context_ptr()->impl_.post_prioritised_completion(
+        p.p, this->priority_value());
+  }
+  else
+    context_ptr()->impl_.post_immediate_completion(p.p, true);
   p.v = p.p = 0;
 }
 #endif // !defined(ASIO_NO_TS_EXECUTORS)
@@ -28,6 +28,7 @@
 #include "asio/detail/handler_tracking.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/reusable_op_storage.hpp"
 #include "asio/detail/throw_error.hpp"
 #include "asio/error.hpp"
 
@@ -378,8 +379,14 @@ namespace detail
         stream_(other.stream_),
         buffers_(static_cast<buffers_type&&>(other.buffers_)),
         start_(other.start_),
-        handler_(static_cast<ReadHandler&&>(other.handler_))
+        handler_(static_cast<ReadHandler&&>(other.handler_)),
+        storage_(static_cast<reusable_op_storage&&>(other.storage_))
+    {
+    }
+
+    ~read_op()
     {
+      storage_.release(this);
     }
 
     void operator()(asio::error_code ec,
@@ -411,6 +418,7 @@ namespace detail
           }
         }
 
+        storage_.release(this);
         static_cast<ReadHandler&&>(handler_)(
             static_cast<const asio::error_code&>(ec),
             static_cast<const std::size_t&>(buffers_.total_consumed()));
@@ -425,8 +433,22 @@ namespace detail
     buffers_type buffers_;
     int start_;
     ReadHandler handler_;
+
+    // The memory of the most recently completed async_read_some operation,
+    // kept for reuse by the next iteration.
+    reusable_op_storage storage_;
   };
 
+  template <typename AsyncReadStream, typename MutableBufferSequence,
+      typename MutableBufferIterator, typename CompletionCondition,
+      typename ReadHandler>
+  inline reusable_op_storage* get_reusable_op_storage(
+      read_op<AsyncReadStream, MutableBufferSequence, MutableBufferIterator,
+        CompletionCondition, ReadHandler>* this_handler)
+  {
+    return &this_handler->storage_;
+  }
+
   template <typename AsyncReadStream, typename MutableBufferSequence,
       typename MutableBufferIterator, typename CompletionCondition,
       typename ReadHandler>
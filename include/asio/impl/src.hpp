@@ -19,6 +19,7 @@
 # error Do not compile Asio library source with ASIO_HEADER_ONLY defined
 #endif
 
+#include "asio/impl/admission_statistics.ipp"
 #include "asio/impl/any_completion_executor.ipp"
 #include "asio/impl/any_io_executor.ipp"
 #include "asio/impl/awaitable.ipp"
@@ -60,6 +61,7 @@
 #include "asio/detail/impl/select_reactor.ipp"
 #include "asio/detail/impl/service_registry.ipp"
 #include "asio/detail/impl/signal_set_service.ipp"
+#include "asio/detail/impl/socket_close_service.ipp"
 #include "asio/detail/impl/socket_ops.ipp"
 #include "asio/detail/impl/socket_select_interrupter.ipp"
 #include "asio/detail/impl/strand_executor_service.ipp"
@@ -82,7 +84,10 @@
 #include "asio/detail/impl/winrt_timer_scheduler.ipp"
 #include "asio/detail/impl/winsock_init.ipp"
 #include "asio/execution/impl/bad_executor.ipp"
+#include "asio/experimental/detail/impl/mailbox_executor_service.ipp"
+#include "asio/experimental/detail/impl/semaphore_service.ipp"
 #include "asio/experimental/impl/channel_error.ipp"
+#include "asio/experimental/impl/framing.ipp"
 #include "asio/generic/detail/impl/endpoint.ipp"
 #include "asio/ip/impl/address.ipp"
 #include "asio/ip/impl/address_v4.ipp"
@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/config.hpp"
+#include "asio/detail/admission_control.hpp"
 #include "asio/detail/blocking_executor_op.hpp"
 #include "asio/detail/executor_op.hpp"
 #include "asio/detail/fenced_block.hpp"
@@ -161,11 +162,20 @@ void thread_pool::basic_executor_type<Allocator,
 #endif // !defined(ASIO_NO_EXCEPTIONS)
   }
 
-  // Allocate and construct an operation to wrap the function.
-  typedef detail::executor_op<function_type, Allocator> op;
+  // Allocate an operation to wrap the function.
+  typedef detail::admitted_function<function_type> admitted_type;
+  typedef detail::executor_op<admitted_type, Allocator> op;
   typename op::ptr p = { detail::addressof(allocator_),
       op::ptr::allocate(allocator_), 0 };
-  p.p = new (p.v) op(static_cast<Function&&>(f), allocator_);
+
+  // Apply backpressure to new work, dropping the function if it is shed.
+  detail::admission_control* admission = 0;
+  if (!pool_->scheduler_.admit_handler(
+        (bits_ & relationship_continuation) != 0, admission))
+    return;
+
+  p.p = new (p.v) op(admitted_type(
+        static_cast<Function&&>(f), admission), allocator_);
 
   if ((bits_ & relationship_continuation) != 0)
   {
@@ -261,10 +271,17 @@ void thread_pool::basic_executor_type<Allocator, Bits>::dispatch(
     return;
   }
 
-  // Allocate and construct an operation to wrap the function.
-  typedef detail::executor_op<function_type, OtherAllocator> op;
+  // Allocate an operation to wrap the function.
+  typedef detail::admitted_function<function_type> admitted_type;
+  typedef detail::executor_op<admitted_type, OtherAllocator> op;
   typename op::ptr p = { detail::addressof(a), op::ptr::allocate(a), 0 };
-  p.p = new (p.v) op(static_cast<Function&&>(f), a);
+
+  // Apply backpressure to new work, dropping the function if it is shed.
+  detail::admission_control* admission = 0;
+  if (!pool_->scheduler_.admit_handler(false, admission))
+    return;
+
+  p.p = new (p.v) op(admitted_type(static_cast<Function&&>(f), admission), a);
 
   ASIO_HANDLER_CREATION((*pool_, *p.p,
         "thread_pool", pool_, 0, "dispatch"));
@@ -280,10 +297,17 @@ void thread_pool::basic_executor_type<Allocator, Bits>::post(
 {
   typedef decay_t<Function> function_type;
 
-  // Allocate and construct an operation to wrap the function.
-  typedef detail::executor_op<function_type, OtherAllocator> op;
+  // Allocate an operation to wrap the function.
+  typedef detail::admitted_function<function_type> admitted_type;
+  typedef detail::executor_op<admitted_type, OtherAllocator> op;
   typename op::ptr p = { detail::addressof(a), op::ptr::allocate(a), 0 };
-  p.p = new (p.v) op(static_cast<Function&&>(f), a);
+
+  // Apply backpressure to new work, dropping the function if it is shed.
+  detail::admission_control* admission = 0;
+  if (!pool_->scheduler_.admit_handler(false, admission))
+    return;
+
+  p.p = new (p.v) op(admitted_type(static_cast<Function&&>(f), admission), a);
 
   ASIO_HANDLER_CREATION((*pool_, *p.p,
         "thread_pool", pool_, 0, "post"));
@@ -299,10 +323,17 @@ void thread_pool::basic_executor_type<Allocator, Bits>::defer(
 {
   typedef decay_t<Function> function_type;
 
-  // Allocate and construct an operation to wrap the function.
-  typedef detail::executor_op<function_type, OtherAllocator> op;
+  // Allocate an operation to wrap the function.
+  typedef detail::admitted_function<function_type> admitted_type;
+  typedef detail::executor_op<admitted_type, OtherAllocator> op;
   typename op::ptr p = { detail::addressof(a), op::ptr::allocate(a), 0 };
-  p.p = new (p.v) op(static_cast<Function&&>(f), a);
+
+  // Apply backpressure to new work, dropping the function if it is shed.
+  detail::admission_control* admission = 0;
+  if (!pool_->scheduler_.admit_handler(true, admission))
+    return;
+
+  p.p = new (p.v) op(admitted_type(static_cast<Function&&>(f), admission), a);
 
   ASIO_HANDLER_CREATION((*pool_, *p.p,
         "thread_pool", pool_, 0, "defer"));
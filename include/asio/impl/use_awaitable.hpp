@@ -35,8 +35,9 @@ public:
 
   // Construct from the entry point of a new thread of execution.
   awaitable_handler_base(awaitable<awaitable_thread_entry_point, Executor> a,
-      const Executor& ex, cancellation_slot pcs, cancellation_state cs)
-    : awaitable_thread<Executor>(std::move(a), ex, pcs, cs)
+      const Executor& ex, cancellation_slot pcs, cancellation_state cs,
+      const asio::trace_context& tc)
+    : awaitable_thread<Executor>(std::move(a), ex, pcs, cs, tc)
   {
   }
 
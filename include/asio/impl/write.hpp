@@ -27,6 +27,7 @@
 #include "asio/detail/handler_tracking.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/reusable_op_storage.hpp"
 #include "asio/detail/throw_error.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -343,8 +344,14 @@ namespace detail
         stream_(other.stream_),
         buffers_(static_cast<buffers_type&&>(other.buffers_)),
         start_(other.start_),
-        handler_(static_cast<WriteHandler&&>(other.handler_))
+        handler_(static_cast<WriteHandler&&>(other.handler_)),
+        storage_(static_cast<reusable_op_storage&&>(other.storage_))
+    {
+    }
+
+    ~write_op()
     {
+      storage_.release(this);
     }
 
     void operator()(asio::error_code ec,
@@ -376,6 +383,7 @@ namespace detail
           }
         }
 
+        storage_.release(this);
         static_cast<WriteHandler&&>(handler_)(
             static_cast<const asio::error_code&>(ec),
             static_cast<const std::size_t&>(buffers_.total_consumed()));
@@ -390,8 +398,22 @@ namespace detail
     buffers_type buffers_;
     int start_;
     WriteHandler handler_;
+
+    // The memory of the most recently completed async_write_some operation,
+    // kept for reuse by the next iteration.
+    reusable_op_storage storage_;
   };
 
+  template <typename AsyncWriteStream, typename ConstBufferSequence,
+      typename ConstBufferIterator, typename CompletionCondition,
+      typename WriteHandler>
+  inline reusable_op_storage* get_reusable_op_storage(
+      write_op<AsyncWriteStream, ConstBufferSequence, ConstBufferIterator,
+        CompletionCondition, WriteHandler>* this_handler)
+  {
+    return &this_handler->storage_;
+  }
+
   template <typename AsyncWriteStream, typename ConstBufferSequence,
       typename ConstBufferIterator, typename CompletionCondition,
       typename WriteHandler>
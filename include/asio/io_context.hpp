@@ -58,8 +58,40 @@ namespace detail {
     static constexpr uintptr_t blocking_never = 1;
     static constexpr uintptr_t relationship_continuation = 2;
     static constexpr uintptr_t outstanding_work_tracked = 4;
+    static constexpr uintptr_t prioritised = 8;
     static constexpr uintptr_t runtime_bits = 3;
   };
+
+  // Storage for an executor's priority. Only executors that have had the
+  // priority property applied carry a priority value.
+  template <bool Prioritised>
+  struct io_context_priority
+  {
+    explicit constexpr io_context_priority(int) noexcept
+    {
+    }
+
+    static constexpr int priority_value() noexcept
+    {
+      return 0;
+    }
+  };
+
+  template <>
+  struct io_context_priority<true>
+  {
+    explicit constexpr io_context_priority(int p) noexcept
+      : priority_value_(p)
+    {
+    }
+
+    constexpr int priority_value() const noexcept
+    {
+      return priority_value_;
+    }
+
+    int priority_value_;
+  };
 } // namespace detail
 
 /// Provides core I/O functionality.
@@ -530,12 +562,16 @@ private:
 /// Executor implementation type used to submit functions to an io_context.
 template <typename Allocator, uintptr_t Bits>
 class io_context::basic_executor_type :
-  detail::io_context_bits, Allocator
+  detail::io_context_bits,
+  detail::io_context_priority<
+    (Bits & detail::io_context_bits::prioritised) != 0>,
+  Allocator
 {
 public:
   /// Copy constructor.
   basic_executor_type(const basic_executor_type& other) noexcept
-    : Allocator(static_cast<const Allocator&>(other)),
+    : priority_type(other),
+      Allocator(static_cast<const Allocator&>(other)),
       target_(other.target_)
   {
     if (Bits & outstanding_work_tracked)
@@ -545,7 +581,8 @@ public:
 
   /// Move constructor.
   basic_executor_type(basic_executor_type&& other) noexcept
-    : Allocator(static_cast<Allocator&&>(other)),
+    : priority_type(other),
+      Allocator(static_cast<Allocator&&>(other)),
       target_(other.target_)
   {
     if (Bits & outstanding_work_tracked)
@@ -585,7 +622,7 @@ private:
   constexpr basic_executor_type require(execution::blocking_t::possibly_t) const
   {
     return basic_executor_type(context_ptr(),
-        *this, bits() & ~blocking_never);
+        *this, bits() & ~blocking_never, this->priority_value());
   }
 
   /// Obtain an executor with the @c blocking.never property.
@@ -601,7 +638,7 @@ private:
   constexpr basic_executor_type require(execution::blocking_t::never_t) const
   {
     return basic_executor_type(context_ptr(),
-        *this, bits() | blocking_never);
+        *this, bits() | blocking_never, this->priority_value());
   }
 
   /// Obtain an executor with the @c relationship.fork property.
@@ -617,7 +654,7 @@ private:
   constexpr basic_executor_type require(execution::relationship_t::fork_t) const
   {
     return basic_executor_type(context_ptr(),
-        *this, bits() & ~relationship_continuation);
+        *this, bits() & ~relationship_continuation, this->priority_value());
   }
 
   /// Obtain an executor with the @c relationship.continuation property.
@@ -634,7 +671,7 @@ private:
       execution::relationship_t::continuation_t) const
   {
     return basic_executor_type(context_ptr(),
-        *this, bits() | relationship_continuation);
+        *this, bits() | relationship_continuation, this->priority_value());
   }
 
   /// Obtain an executor with the @c outstanding_work.tracked property.
@@ -652,7 +689,7 @@ private:
   require(execution::outstanding_work_t::tracked_t) const
   {
     return basic_executor_type<Allocator, Bits | outstanding_work_tracked>(
-        context_ptr(), *this, bits());
+        context_ptr(), *this, bits(), this->priority_value());
   }
 
   /// Obtain an executor with the @c outstanding_work.untracked property.
@@ -670,7 +707,7 @@ private:
   require(execution::outstanding_work_t::untracked_t) const
   {
     return basic_executor_type<Allocator, Bits & ~outstanding_work_tracked>(
-        context_ptr(), *this, bits());
+        context_ptr(), *this, bits(), this->priority_value());
   }
 
   /// Obtain an executor with the specified @c allocator property.
@@ -688,7 +725,7 @@ private:
   require(execution::allocator_t<OtherAllocator> a) const
   {
     return basic_executor_type<OtherAllocator, Bits>(
-        context_ptr(), a.value(), bits());
+        context_ptr(), a.value(), bits(), this->priority_value());
   }
 
   /// Obtain an executor with the default @c allocator property.
@@ -704,8 +741,31 @@ private:
   constexpr basic_executor_type<std::allocator<void>, Bits>
   require(execution::allocator_t<void>) const
   {
-    return basic_executor_type<std::allocator<void>, Bits>(
-        context_ptr(), std::allocator<void>(), bits());
+    return basic_executor_type<std::allocator<void>, Bits>(context_ptr(),
+        std::allocator<void>(), bits(), this->priority_value());
+  }
+
+  /// Obtain an executor with the specified @c priority property.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * asio::require customisation point.
+   *
+   * Function objects submitted through the resulting executor are queued in
+   * the io_context's priority lane for the specified priority, and are run
+   * ahead of queued work of a lower priority. A priority of @c 0 is normal
+   * priority.
+   *
+   * For example:
+   * @code auto ex1 = my_io_context.get_executor();
+   * auto ex2 = asio::require(ex1,
+   *     asio::execution::priority(1)); @endcode
+   */
+  constexpr basic_executor_type<Allocator,
+      ASIO_UNSPECIFIED(Bits | prioritised)>
+  require(execution::priority_t p) const
+  {
+    return basic_executor_type<Allocator, Bits | prioritised>(
+        context_ptr(), *this, bits(), p.value());
   }
 
 #if !defined(GENERATING_DOCUMENTATION)
@@ -821,6 +881,20 @@ private:
       : execution::outstanding_work_t(execution::outstanding_work.untracked);
   }
 
+  /// Query the current value of the @c priority property.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * asio::query customisation point.
+   *
+   * For example:
+   * @code auto ex = my_io_context.get_executor();
+   * int p = asio::query(ex, asio::execution::priority); @endcode
+   */
+  constexpr int query(execution::priority_t) const noexcept
+  {
+    return this->priority_value();
+  }
+
   /// Query the current value of the @c allocator property.
   /**
    * Do not call this function directly. It is intended for use with the
@@ -869,6 +943,7 @@ public:
       const basic_executor_type& b) noexcept
   {
     return a.target_ == b.target_
+      && a.priority_value() == b.priority_value()
       && static_cast<const Allocator&>(a) == static_cast<const Allocator&>(b);
   }
 
@@ -880,6 +955,7 @@ public:
       const basic_executor_type& b) noexcept
   {
     return a.target_ != b.target_
+      || a.priority_value() != b.priority_value()
       || static_cast<const Allocator&>(a) != static_cast<const Allocator&>(b);
   }
 
@@ -966,9 +1042,13 @@ private:
   friend class io_context;
   template <typename, uintptr_t> friend class basic_executor_type;
 
+  // The base class used to store the executor's priority.
+  typedef detail::io_context_priority<(Bits & prioritised) != 0> priority_type;
+
   // Constructor used by io_context::get_executor().
   explicit basic_executor_type(io_context& i) noexcept
-    : Allocator(),
+    : priority_type(0),
+      Allocator(),
       target_(reinterpret_cast<uintptr_t>(&i))
   {
     if (Bits & outstanding_work_tracked)
@@ -976,9 +1056,10 @@ private:
   }
 
   // Constructor used by require().
-  basic_executor_type(io_context* i,
-      const Allocator& a, uintptr_t bits) noexcept
-    : Allocator(a),
+  basic_executor_type(io_context* i, const Allocator& a,
+      uintptr_t bits, int priority) noexcept
+    : priority_type(priority),
+      Allocator(a),
       target_(reinterpret_cast<uintptr_t>(i) | bits)
   {
     if (Bits & outstanding_work_tracked)
@@ -1185,6 +1266,18 @@ struct require_member<
       OtherAllocator, Bits> result_type;
 };
 
+template <typename Allocator, uintptr_t Bits>
+struct require_member<
+    asio::io_context::basic_executor_type<Allocator, Bits>,
+    asio::execution::priority_t
+  > : asio::detail::io_context_bits
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = false;
+  typedef asio::io_context::basic_executor_type<
+      Allocator, Bits | prioritised> result_type;
+};
+
 #endif // !defined(ASIO_HAS_DEDUCED_REQUIRE_MEMBER_TRAIT)
 
 #if !defined(ASIO_HAS_DEDUCED_QUERY_STATIC_CONSTEXPR_MEMBER_TRAIT)
@@ -1307,6 +1400,17 @@ struct query_member<
   typedef asio::io_context& result_type;
 };
 
+template <typename Allocator, uintptr_t Bits>
+struct query_member<
+    asio::io_context::basic_executor_type<Allocator, Bits>,
+    asio::execution::priority_t
+  >
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = true;
+  typedef int result_type;
+};
+
 template <typename Allocator, uintptr_t Bits>
 struct query_member<
     asio::io_context::basic_executor_type<Allocator, Bits>,
@@ -125,6 +125,49 @@ public:
     ASIO_OS_DEF(IPPROTO_TCP), ASIO_OS_DEF(TCP_NODELAY)> no_delay;
 #endif
 
+#if defined(ASIO_HAS_TCP_NOTSENT_LOWAT) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Socket option for the limit on unsent data in the send buffer.
+  /**
+   * Implements the IPPROTO_TCP/TCP_NOTSENT_LOWAT socket option.
+   *
+   * Once the amount of data that has not yet been sent to the peer reaches
+   * the limit, the socket stops being ready to send. Asynchronous send
+   * operations then wait, rather than filling the send buffer, which keeps
+   * the latency of newly written data low without reducing throughput.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::ip::tcp::not_sent_low_watermark option(16384);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::ip::tcp::not_sent_low_watermark option;
+   * socket.get_option(option);
+   * int size = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+# if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined not_sent_low_watermark;
+# else
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(IPPROTO_TCP), ASIO_OS_DEF(TCP_NOTSENT_LOWAT)>
+      not_sent_low_watermark;
+# endif
+#endif // defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Compare two protocols for equality.
   friend bool operator==(const tcp& p1, const tcp& p2)
   {
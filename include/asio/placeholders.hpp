@@ -56,20 +56,25 @@ unspecified endpoint;
 /// functions such as asio::signal_set::async_wait.
 unspecified signal_number;
 
+#elif defined(ASIO_HAS_INLINE_VARIABLES)
+
+// With inline variables the placeholders have external linkage, which allows
+// them to be used from within a named module.
+ASIO_INLINE_VARIABLE constexpr auto& error = std::placeholders::_1;
+ASIO_INLINE_VARIABLE constexpr auto& bytes_transferred = std::placeholders::_2;
+ASIO_INLINE_VARIABLE constexpr auto& iterator = std::placeholders::_2;
+ASIO_INLINE_VARIABLE constexpr auto& results = std::placeholders::_2;
+ASIO_INLINE_VARIABLE constexpr auto& endpoint = std::placeholders::_2;
+ASIO_INLINE_VARIABLE constexpr auto& signal_number = std::placeholders::_2;
+
 #else
 
-static ASIO_INLINE_VARIABLE constexpr auto& error
-  = std::placeholders::_1;
-static ASIO_INLINE_VARIABLE constexpr auto& bytes_transferred
-  = std::placeholders::_2;
-static ASIO_INLINE_VARIABLE constexpr auto& iterator
-  = std::placeholders::_2;
-static ASIO_INLINE_VARIABLE constexpr auto& results
-  = std::placeholders::_2;
-static ASIO_INLINE_VARIABLE constexpr auto& endpoint
-  = std::placeholders::_2;
-static ASIO_INLINE_VARIABLE constexpr auto& signal_number
-  = std::placeholders::_2;
+static constexpr auto& error = std::placeholders::_1;
+static constexpr auto& bytes_transferred = std::placeholders::_2;
+static constexpr auto& iterator = std::placeholders::_2;
+static constexpr auto& results = std::placeholders::_2;
+static constexpr auto& endpoint = std::placeholders::_2;
+static constexpr auto& signal_number = std::placeholders::_2;
 
 #endif
 
@@ -0,0 +1,134 @@
+//
+// post_bulk.hpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_POST_BULK_HPP
+#define ASIO_POST_BULK_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/async_result.hpp"
+#include "asio/detail/initiate_post_bulk.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/execution/blocking.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/require.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Submits a function to be invoked for each index in a range, and after all
+/// invocations have finished submits the completion handler.
+/**
+ * This function submits a bulk task for execution using the specified
+ * executor. The function object @c f is invoked once for each index in the
+ * range <tt>[0, n)</tt>, on one or more of the threads that are running the
+ * executor's execution context. None of the invocations occur in the current
+ * thread prior to returning from <tt>post_bulk()</tt>.
+ *
+ * Unlike making @c n separate calls to @ref post(), the range is described by
+ * a single shared task object, and only a small number of function objects
+ * are queued with the executor. The threads that run these function objects
+ * claim contiguous sub-ranges of indices until the range is exhausted.
+ *
+ * @param ex The target executor.
+ *
+ * @param n The number of indices.
+ *
+ * @param f The function object to be invoked. It is called as
+ * <tt>f(i)</tt>, where @c i is of type @c std::size_t, and may be called
+ * concurrently from multiple threads. If an invocation of @c f exits via an
+ * exception, the exception propagates to the thread's run function and the
+ * completion handler is not called.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler. The function signature of the completion handler must be:
+ * @code void handler(); @endcode
+ *
+ * @par Completion Signature
+ * @code void() @endcode
+ *
+ * @par Example
+ * @code asio::thread_pool pool(4);
+ * std::vector<double> v(10000);
+ * asio::post_bulk(pool.get_executor(), v.size(),
+ *     [&](std::size_t i){ v[i] = std::sqrt(i); },
+ *     []{ std::cout << "done\n"; }); @endcode
+ */
+template <typename Executor, typename Function,
+    ASIO_COMPLETION_TOKEN_FOR(void()) NullaryToken
+      = default_completion_token_t<Executor>>
+inline auto post_bulk(const Executor& ex, std::size_t n, Function&& f,
+    NullaryToken&& token = default_completion_token_t<Executor>(),
+    constraint_t<
+      execution::is_executor<Executor>::value
+        && can_require<Executor, execution::blocking_t::never_t>::value
+    > = 0)
+  -> decltype(
+    async_initiate<NullaryToken, void()>(
+      declval<detail::initiate_post_bulk_with_executor<Executor>>(),
+      token, n, static_cast<Function&&>(f)))
+{
+  return async_initiate<NullaryToken, void()>(
+      detail::initiate_post_bulk_with_executor<Executor>(ex),
+      token, n, static_cast<Function&&>(f));
+}
+
+/// Submits a function to be invoked for each index in a range, and after all
+/// invocations have finished submits the completion handler.
+/**
+ * @param ctx An execution context, from which the target executor is obtained.
+ *
+ * @param n The number of indices.
+ *
+ * @param f The function object to be invoked as <tt>f(i)</tt> for each index
+ * @c i in the range <tt>[0, n)</tt>.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler. The function signature of the completion handler must be:
+ * @code void handler(); @endcode
+ *
+ * @returns <tt>post_bulk(ctx.get_executor(), n, forward<Function>(f),
+ * forward<NullaryToken>(token))</tt>.
+ *
+ * @par Completion Signature
+ * @code void() @endcode
+ */
+template <typename ExecutionContext, typename Function,
+    ASIO_COMPLETION_TOKEN_FOR(void()) NullaryToken
+      = default_completion_token_t<typename ExecutionContext::executor_type>>
+inline auto post_bulk(ExecutionContext& ctx, std::size_t n, Function&& f,
+    NullaryToken&& token = default_completion_token_t<
+      typename ExecutionContext::executor_type>(),
+    constraint_t<
+      is_convertible<ExecutionContext&, execution_context&>::value
+    > = 0)
+  -> decltype(
+    async_initiate<NullaryToken, void()>(
+      declval<detail::initiate_post_bulk_with_executor<
+        typename ExecutionContext::executor_type>>(),
+      token, n, static_cast<Function&&>(f)))
+{
+  return async_initiate<NullaryToken, void()>(
+      detail::initiate_post_bulk_with_executor<
+        typename ExecutionContext::executor_type>(ctx.get_executor()),
+      token, n, static_cast<Function&&>(f));
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_POST_BULK_HPP
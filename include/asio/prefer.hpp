@@ -517,6 +517,15 @@ const T static_instance<T>::instance = {};
 
 } // namespace asio_prefer_fn
 namespace asio {
+#if defined(ASIO_HAS_INLINE_VARIABLES)
+
+// With inline variables the customisation point object has external linkage,
+// which allows it to be used from within a named module.
+ASIO_INLINE_VARIABLE constexpr const asio_prefer_fn::impl&
+  prefer = asio_prefer_fn::static_instance<>::instance;
+
+#else // defined(ASIO_HAS_INLINE_VARIABLES)
+
 namespace {
 
 static constexpr const asio_prefer_fn::impl&
@@ -524,6 +533,8 @@ static constexpr const asio_prefer_fn::impl&
 
 } // namespace
 
+#endif // defined(ASIO_HAS_INLINE_VARIABLES)
+
 typedef asio_prefer_fn::impl prefer_t;
 
 template <typename T, typename... Properties>
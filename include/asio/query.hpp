@@ -254,6 +254,15 @@ const T static_instance<T>::instance = {};
 
 } // namespace asio_query_fn
 namespace asio {
+#if defined(ASIO_HAS_INLINE_VARIABLES)
+
+// With inline variables the customisation point object has external linkage,
+// which allows it to be used from within a named module.
+ASIO_INLINE_VARIABLE constexpr const asio_query_fn::impl&
+  query = asio_query_fn::static_instance<>::instance;
+
+#else // defined(ASIO_HAS_INLINE_VARIABLES)
+
 namespace {
 
 static constexpr const asio_query_fn::impl&
@@ -261,6 +270,8 @@ static constexpr const asio_query_fn::impl&
 
 } // namespace
 
+#endif // defined(ASIO_HAS_INLINE_VARIABLES)
+
 typedef asio_query_fn::impl query_t;
 
 template <typename T, typename Property>
@@ -282,6 +282,15 @@ const T static_instance<T>::instance = {};
 
 } // namespace asio_require_concept_fn
 namespace asio {
+#if defined(ASIO_HAS_INLINE_VARIABLES)
+
+// With inline variables the customisation point object has external linkage,
+// which allows it to be used from within a named module.
+ASIO_INLINE_VARIABLE constexpr const asio_require_concept_fn::impl&
+  require_concept = asio_require_concept_fn::static_instance<>::instance;
+
+#else // defined(ASIO_HAS_INLINE_VARIABLES)
+
 namespace {
 
 static constexpr const asio_require_concept_fn::impl&
@@ -289,6 +298,8 @@ static constexpr const asio_require_concept_fn::impl&
 
 } // namespace
 
+#endif // defined(ASIO_HAS_INLINE_VARIABLES)
+
 typedef asio_require_concept_fn::impl require_concept_t;
 
 template <typename T, typename Property>
@@ -15,12 +15,15 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include "asio/ssl/certificate_store.hpp"
 #include "asio/ssl/context.hpp"
 #include "asio/ssl/context_base.hpp"
 #include "asio/ssl/error.hpp"
 #include "asio/ssl/host_name_verification.hpp"
+#include "asio/ssl/server_name_context_cache.hpp"
 #include "asio/ssl/stream.hpp"
 #include "asio/ssl/stream_base.hpp"
+#include "asio/ssl/verification_cache.hpp"
 #include "asio/ssl/verify_context.hpp"
 #include "asio/ssl/verify_mode.hpp"
 
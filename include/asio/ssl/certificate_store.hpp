@@ -0,0 +1,224 @@
+//
+// ssl/certificate_store.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_CERTIFICATE_STORE_HPP
+#define ASIO_SSL_CERTIFICATE_STORE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include <string>
+#include "asio/buffer.hpp"
+#include "asio/error_code.hpp"
+#include "asio/ssl/detail/openssl_init.hpp"
+#include "asio/ssl/detail/openssl_types.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+
+/// A reference-counted store of trusted certification authorities.
+/**
+ * The certificate_store class holds the certification authority certificates
+ * used to verify peers. A store is populated once and may then be shared by
+ * any number of SSL contexts, using context::set_certificate_store(), so that
+ * a certification authority bundle is parsed and held in memory only once.
+ *
+ * Copies of a certificate_store object refer to the same underlying store.
+ *
+ * A store becomes immutable once it has been attached to a context. Any later
+ * attempt to add certification authorities to it, whether through the store
+ * or through a context that uses it, fails with asio::error::no_permission.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code
+ * asio::ssl::certificate_store store;
+ * store.load_verify_file("ca-bundle.pem");
+ *
+ * asio::ssl::context ctx1(asio::ssl::context::tls_client);
+ * ctx1.set_certificate_store(store);
+ *
+ * asio::ssl::context ctx2(asio::ssl::context::tls_client);
+ * ctx2.set_certificate_store(store);
+ * @endcode
+ */
+class certificate_store
+{
+public:
+  /// The native handle type of the certificate store.
+  typedef X509_STORE* native_handle_type;
+
+  /// Construct an empty certificate store.
+  ASIO_DECL certificate_store();
+
+  /// Construct to take ownership of a native handle.
+  ASIO_DECL explicit certificate_store(native_handle_type native_handle);
+
+  /// Copy constructor. The copy refers to the same underlying store.
+  ASIO_DECL certificate_store(const certificate_store& other);
+
+  /// Move constructor.
+  /**
+   * @note Following the move, the moved-from object may only be destroyed or
+   * assigned to.
+   */
+  ASIO_DECL certificate_store(certificate_store&& other) noexcept;
+
+  /// Copy assignment. The object then refers to the same underlying store.
+  ASIO_DECL certificate_store& operator=(const certificate_store& other);
+
+  /// Move assignment.
+  ASIO_DECL certificate_store& operator=(certificate_store&& other) noexcept;
+
+  /// Destructor.
+  ASIO_DECL ~certificate_store();
+
+  /// Get the underlying implementation in the native type.
+  /**
+   * This function may be used to obtain the underlying implementation of the
+   * store. This is intended to allow access to store functionality that is not
+   * otherwise provided.
+   */
+  native_handle_type native_handle() const noexcept
+  {
+    return handle_;
+  }
+
+  /// Load a certification authority file into the store.
+  /**
+   * This function is used to load one or more trusted certification authorities
+   * from a file.
+   *
+   * @param filename The name of a file containing certification authority
+   * certificates in PEM format.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c X509_STORE_load_locations or @c X509_STORE_load_file.
+   */
+  ASIO_DECL void load_verify_file(const std::string& filename);
+
+  /// Load a certification authority file into the store.
+  /**
+   * This function is used to load one or more trusted certification authorities
+   * from a file.
+   *
+   * @param filename The name of a file containing certification authority
+   * certificates in PEM format.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note Calls @c X509_STORE_load_locations or @c X509_STORE_load_file.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID load_verify_file(
+      const std::string& filename, asio::error_code& ec);
+
+  /// Add certification authorities to the store.
+  /**
+   * This function is used to add one or more trusted certification authorities
+   * from a memory buffer.
+   *
+   * @param ca The buffer containing the certification authority certificates.
+   * The certificates must use the PEM format.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c X509_STORE_add_cert.
+   */
+  ASIO_DECL void add_certificate_authority(const const_buffer& ca);
+
+  /// Add certification authorities to the store.
+  /**
+   * This function is used to add one or more trusted certification authorities
+   * from a memory buffer.
+   *
+   * @param ca The buffer containing the certification authority certificates.
+   * The certificates must use the PEM format.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note Calls @c X509_STORE_add_cert.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID add_certificate_authority(
+      const const_buffer& ca, asio::error_code& ec);
+
+  /// Configures the store to use the default directories for finding
+  /// certification authority certificates.
+  /**
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c X509_STORE_set_default_paths.
+   */
+  ASIO_DECL void set_default_verify_paths();
+
+  /// Configures the store to use the default directories for finding
+  /// certification authority certificates.
+  /**
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note Calls @c X509_STORE_set_default_paths.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID set_default_verify_paths(
+      asio::error_code& ec);
+
+  /// Get the number of objects, such as certificates, held in the store.
+  ASIO_DECL std::size_t size() const;
+
+  /// Determine whether the store has been attached to a context, after which
+  /// it may no longer be modified.
+  bool frozen() const
+  {
+    return is_frozen(handle_);
+  }
+
+private:
+  friend class context;
+
+  struct bio_cleanup;
+  struct x509_cleanup;
+
+  // Translate an SSL error into an error code.
+  ASIO_DECL static asio::error_code translate_error(long error);
+
+  // Mark a native store as attached to a context, so that it is no longer
+  // modified.
+  ASIO_DECL static void freeze(native_handle_type handle);
+
+  // Determine whether a native store has been attached to a context.
+  ASIO_DECL static bool is_frozen(native_handle_type handle);
+
+  // Get the index of the extra data slot used to mark a store as frozen.
+  ASIO_DECL static int frozen_index();
+
+  // The underlying native implementation.
+  native_handle_type handle_;
+
+  // Ensure openssl is initialised.
+  asio::ssl::detail::openssl_init<> init_;
+};
+
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/ssl/impl/certificate_store.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_SSL_CERTIFICATE_STORE_HPP
@@ -20,6 +20,7 @@
 #include <string>
 #include "asio/buffer.hpp"
 #include "asio/io_context.hpp"
+#include "asio/ssl/certificate_store.hpp"
 #include "asio/ssl/context_base.hpp"
 #include "asio/ssl/detail/openssl_types.hpp"
 #include "asio/ssl/detail/openssl_init.hpp"
@@ -360,6 +361,39 @@ public:
   ASIO_DECL ASIO_SYNC_OP_VOID add_verify_path(
       const std::string& path, asio::error_code& ec);
 
+  /// Use a shared certificate store for performing verification.
+  /**
+   * This function replaces the context's certification authority store with
+   * the specified shared store. The store's certificates are not copied, so a
+   * single store may be used by many contexts without parsing or holding the
+   * certification authorities more than once.
+   *
+   * @param store The certificate store. The context retains a reference to the
+   * underlying store, which becomes immutable as a result of this call.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c SSL_CTX_set1_cert_store.
+   */
+  ASIO_DECL void set_certificate_store(const certificate_store& store);
+
+  /// Use a shared certificate store for performing verification.
+  /**
+   * This function replaces the context's certification authority store with
+   * the specified shared store. The store's certificates are not copied, so a
+   * single store may be used by many contexts without parsing or holding the
+   * certification authorities more than once.
+   *
+   * @param store The certificate store. The context retains a reference to the
+   * underlying store, which becomes immutable as a result of this call.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note Calls @c SSL_CTX_set1_cert_store.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID set_certificate_store(
+      const certificate_store& store, asio::error_code& ec);
+
   /// Use a certificate from a memory buffer.
   /**
    * This function is used to load a certificate into the context from a buffer.
@@ -724,6 +758,11 @@ private:
   ASIO_DECL static int verify_callback_function(
       int preverified, X509_STORE_CTX* ctx);
 
+  // Callback used when the SSL implementation wants to verify a certificate
+  // chain. Skips verification of chains that are already known to be valid.
+  ASIO_DECL static int cert_verify_callback_function(
+      X509_STORE_CTX* ctx, void* arg);
+
   // Helper function used to set a password callback.
   ASIO_DECL ASIO_SYNC_OP_VOID do_set_password_callback(
       detail::password_callback_base* callback, asio::error_code& ec);
@@ -0,0 +1,66 @@
+//
+// ssl/detail/context_factory.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_DETAIL_CONTEXT_FACTORY_HPP
+#define ASIO_SSL_DETAIL_CONTEXT_FACTORY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include <memory>
+#include <string>
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+
+class context;
+
+namespace detail {
+
+class context_factory_base
+{
+public:
+  virtual ~context_factory_base()
+  {
+  }
+
+  virtual std::shared_ptr<context> call(const std::string& server_name) = 0;
+};
+
+template <typename ContextFactory>
+class context_factory : public context_factory_base
+{
+public:
+  explicit context_factory(ContextFactory factory)
+    : factory_(factory)
+  {
+  }
+
+  virtual std::shared_ptr<context> call(const std::string& server_name)
+  {
+    return factory_(server_name);
+  }
+
+private:
+  ContextFactory factory_;
+};
+
+} // namespace detail
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_SSL_DETAIL_CONTEXT_FACTORY_HPP
@@ -115,6 +115,9 @@ public:
   ASIO_DECL const asio::error_code& map_error_code(
       asio::error_code& ec) const;
 
+  // Get the verify callback that an engine has set on an SSL object, if any.
+  ASIO_DECL static verify_callback_base* get_verify_callback(SSL* ssl);
+
 private:
   // Disallow copying and assignment.
   engine(const engine&);
@@ -58,6 +58,32 @@ private:
   stream_base::handshake_type type_;
 };
 
+// A handshake operation that runs the engine's handshake steps on a separate
+// executor, so that the CPU-intensive cryptographic work does not run on the
+// thread performing the stream's I/O.
+template <typename Executor>
+class offloaded_handshake_op
+  : public handshake_op
+{
+public:
+  typedef Executor engine_executor_type;
+
+  offloaded_handshake_op(stream_base::handshake_type type,
+      const Executor& engine_ex)
+    : handshake_op(type),
+      engine_executor_(engine_ex)
+  {
+  }
+
+  const engine_executor_type& engine_executor() const noexcept
+  {
+    return engine_executor_;
+  }
+
+private:
+  Executor engine_executor_;
+};
+
 } // namespace detail
 } // namespace ssl
 } // namespace asio
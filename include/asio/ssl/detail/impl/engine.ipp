@@ -158,6 +158,13 @@ asio::error_code engine::set_verify_callback(
   return ec;
 }
 
+verify_callback_base* engine::get_verify_callback(SSL* ssl)
+{
+  if (::SSL_get_verify_callback(ssl) == &engine::verify_callback_function)
+    return static_cast<verify_callback_base*>(SSL_get_app_data(ssl));
+  return 0;
+}
+
 int engine::verify_callback_function(int preverified, X509_STORE_CTX* ctx)
 {
   if (ctx)
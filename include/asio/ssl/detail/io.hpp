@@ -17,8 +17,17 @@
 
 #include "asio/detail/config.hpp"
 
+#include "asio/associated_allocator.hpp"
 #include "asio/detail/base_from_cancellation_state.hpp"
+#include "asio/detail/bind_handler.hpp"
 #include "asio/detail/handler_tracking.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/execution/allocator.hpp"
+#include "asio/execution/blocking.hpp"
+#include "asio/execution/outstanding_work.hpp"
+#include "asio/execution/relationship.hpp"
+#include "asio/post.hpp"
+#include "asio/prefer.hpp"
 #include "asio/ssl/detail/engine.hpp"
 #include "asio/ssl/detail/stream_core.hpp"
 #include "asio/write.hpp"
@@ -93,6 +102,47 @@ std::size_t io(Stream& next_layer, stream_core& core,
   return 0;
 }
 
+// Operations that run their engine steps on a separate executor define the
+// nested type engine_executor_type.
+template <typename Operation, typename = void>
+struct has_engine_executor : false_type
+{
+};
+
+template <typename Operation>
+struct has_engine_executor<Operation,
+    void_t<typename Operation::engine_executor_type>> : true_type
+{
+};
+
+// Runs a single engine step of an io_op on the operation's engine executor,
+// and then resumes the io_op on the I/O executor. Outstanding work is tracked
+// on the I/O executor while the step is running.
+template <typename IoOp, typename IoExecutor>
+class io_op_engine_step
+{
+public:
+  io_op_engine_step(IoOp&& op, const IoExecutor& io_ex)
+    : op_(static_cast<IoOp&&>(op)),
+      io_ex_(asio::prefer(io_ex, execution::outstanding_work.tracked))
+  {
+  }
+
+  void operator()()
+  {
+    op_.want_ = op_.op_(op_.core_.engine_, op_.ec_, op_.bytes_transferred_);
+
+    asio::post(io_ex_,
+        asio::detail::bind_handler(static_cast<IoOp&&>(op_),
+          asio::error_code(), std::size_t(0), 2));
+  }
+
+private:
+  IoOp op_;
+  decay_t<prefer_result_t<IoExecutor,
+      execution::outstanding_work_t::tracked_t>> io_ex_;
+};
+
 template <typename Stream, typename Operation, typename Handler>
 class io_op
   : public asio::detail::base_from_cancellation_state<Handler>
@@ -147,7 +197,15 @@ public:
     case 1: // Called after at least one async operation.
       do
       {
-        switch (want_ = op_(core_.engine_, ec_, bytes_transferred_))
+        // If the operation has an engine executor, run the engine step there.
+        // Control resumes at the "case 2:" label below.
+        if (start_engine_step(has_engine_executor<Operation>()))
+          return;
+
+        want_ = op_(core_.engine_, ec_, bytes_transferred_);
+
+        case 2: // Called after an engine step on the engine executor.
+        switch (want_)
         {
         case engine::want_input_and_retry:
 
@@ -229,7 +287,7 @@ public:
           // the async operation's initiating function. In this case we're not
           // allowed to call the handler directly. Instead, issue a zero-sized
           // read so the handler runs "as-if" posted using io_context::post().
-          if (start)
+          if (start == 1)
           {
             ASIO_HANDLER_LOCATION((
                   __FILE__, __LINE__, Operation::tracking_name()));
@@ -316,6 +374,39 @@ public:
     }
   }
 
+  bool start_engine_step(false_type)
+  {
+    return false;
+  }
+
+  bool start_engine_step(true_type)
+  {
+    typedef typename Operation::engine_executor_type engine_executor_type;
+    typedef typename Stream::executor_type io_executor_type;
+
+    ASIO_HANDLER_LOCATION((
+          __FILE__, __LINE__, Operation::tracking_name()));
+
+    associated_allocator_t<Handler> alloc(
+        (get_associated_allocator)(handler_));
+    io_executor_type io_ex(next_layer_.get_executor());
+
+    decay_t<prefer_result_t<const engine_executor_type&,
+        execution::blocking_t::never_t,
+        execution::relationship_t::fork_t,
+        execution::allocator_t<associated_allocator_t<Handler>>
+      >> engine_ex = asio::prefer(op_.engine_executor(),
+          execution::blocking.never,
+          execution::relationship.fork,
+          execution::allocator(alloc));
+
+    engine_ex.execute(
+        io_op_engine_step<io_op, io_executor_type>(
+          static_cast<io_op&&>(*this), io_ex));
+
+    return true;
+  }
+
 //private:
   Stream& next_layer_;
   stream_core& core_;
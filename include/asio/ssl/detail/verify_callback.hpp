@@ -17,6 +17,7 @@
 
 #include "asio/detail/config.hpp"
 
+#include "asio/detail/type_traits.hpp"
 #include "asio/ssl/verify_context.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -33,6 +34,32 @@ public:
   }
 
   virtual bool call(bool preverified, verify_context& ctx) = 0;
+
+  // Determine whether the peer's certificate chain is already known to be
+  // valid, so that verification of the chain may be skipped.
+  virtual bool is_verified(verify_context&)
+  {
+    return false;
+  }
+
+  // Record that the peer's certificate chain has been verified.
+  virtual void set_verified(verify_context&)
+  {
+  }
+};
+
+// Determines whether a verification callback keeps a record of the
+// certificate chains that it has verified.
+template <typename VerifyCallback, typename = void>
+struct has_verified_chain_cache : false_type
+{
+};
+
+template <typename VerifyCallback>
+struct has_verified_chain_cache<VerifyCallback,
+    void_t<decltype(declval<const VerifyCallback&>().is_verified(
+      declval<verify_context&>()))>> : true_type
+{
 };
 
 template <typename VerifyCallback>
@@ -49,7 +76,36 @@ public:
     return callback_(preverified, ctx);
   }
 
+  virtual bool is_verified(verify_context& ctx)
+  {
+    return is_verified(ctx, has_verified_chain_cache<VerifyCallback>());
+  }
+
+  virtual void set_verified(verify_context& ctx)
+  {
+    set_verified(ctx, has_verified_chain_cache<VerifyCallback>());
+  }
+
 private:
+  bool is_verified(verify_context& ctx, true_type)
+  {
+    return callback_.is_verified(ctx);
+  }
+
+  bool is_verified(verify_context&, false_type)
+  {
+    return false;
+  }
+
+  void set_verified(verify_context& ctx, true_type)
+  {
+    callback_.set_verified(ctx);
+  }
+
+  void set_verified(verify_context&, false_type)
+  {
+  }
+
   VerifyCallback callback_;
 };
 
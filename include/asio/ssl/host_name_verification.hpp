@@ -19,6 +19,7 @@
 
 #include <string>
 #include "asio/ssl/detail/openssl_types.hpp"
+#include "asio/ssl/verification_cache.hpp"
 #include "asio/ssl/verify_context.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -56,6 +57,10 @@ namespace ssl {
  *
  * // ... read and write as normal ...
  * @endcode
+ *
+ * When a verification_cache is supplied, a peer certificate that has already
+ * been verified for the host name is accepted without verifying the
+ * certificate chain again.
  */
 class host_name_verification
 {
@@ -65,17 +70,44 @@ public:
 
   /// Constructor.
   explicit host_name_verification(const std::string& host)
-    : host_(host)
+    : host_(host),
+      cache_(0)
+  {
+  }
+
+  /// Constructor that uses a cache of verified certificates.
+  /**
+   * @param host The host name to be checked.
+   *
+   * @param cache The cache of verified certificates. It must outlive all
+   * copies of the host_name_verification object.
+   */
+  host_name_verification(const std::string& host, verification_cache& cache)
+    : host_(host),
+      cache_(&cache)
   {
   }
 
   /// Perform certificate verification.
   ASIO_DECL bool operator()(bool preverified, verify_context& ctx) const;
 
+  /// Determine whether the peer certificate has already been verified for the
+  /// host name.
+  ASIO_DECL bool is_verified(verify_context& ctx) const;
+
+  /// Record that the peer certificate has been verified for the host name.
+  ASIO_DECL void set_verified(verify_context& ctx) const;
+
 private:
+  // Get the peer certificate being verified.
+  ASIO_DECL static X509* peer_certificate(verify_context& ctx);
+
   // Helper function to check a host name against an IPv4 address
   // The host name to be checked.
   std::string host_;
+
+  // The cache of verified certificates, if any.
+  verification_cache* cache_;
 };
 
 } // namespace ssl
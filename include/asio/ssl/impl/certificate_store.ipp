@@ -0,0 +1,286 @@
+//
+// ssl/impl/certificate_store.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_IMPL_CERTIFICATE_STORE_IPP
+#define ASIO_SSL_IMPL_CERTIFICATE_STORE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include "asio/detail/throw_error.hpp"
+#include "asio/error.hpp"
+#include "asio/ssl/certificate_store.hpp"
+#include "asio/ssl/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+
+struct certificate_store::bio_cleanup
+{
+  BIO* p;
+  ~bio_cleanup() { if (p) ::BIO_free(p); }
+};
+
+struct certificate_store::x509_cleanup
+{
+  X509* p;
+  ~x509_cleanup() { if (p) ::X509_free(p); }
+};
+
+certificate_store::certificate_store()
+  : handle_(0)
+{
+  ::ERR_clear_error();
+
+  handle_ = ::X509_STORE_new();
+
+  if (handle_ == 0)
+  {
+    asio::error_code ec = translate_error(::ERR_get_error());
+    asio::detail::throw_error(ec, "certificate_store");
+  }
+}
+
+certificate_store::certificate_store(
+    certificate_store::native_handle_type native_handle)
+  : handle_(native_handle)
+{
+  if (!handle_)
+  {
+    asio::detail::throw_error(
+        asio::error::invalid_argument, "certificate_store");
+  }
+}
+
+certificate_store::certificate_store(const certificate_store& other)
+  : handle_(other.handle_)
+{
+  if (handle_)
+  {
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L) \
+  && (!defined(LIBRESSL_VERSION_NUMBER) \
+    || LIBRESSL_VERSION_NUMBER >= 0x2070000fL)
+    ::X509_STORE_up_ref(handle_);
+#else // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+    ::CRYPTO_add(&handle_->references, 1, CRYPTO_LOCK_X509_STORE);
+#endif // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+  }
+}
+
+certificate_store::certificate_store(certificate_store&& other) noexcept
+  : handle_(other.handle_)
+{
+  other.handle_ = 0;
+}
+
+certificate_store& certificate_store::operator=(
+    const certificate_store& other)
+{
+  certificate_store tmp(other);
+  native_handle_type handle = handle_;
+  handle_ = tmp.handle_;
+  tmp.handle_ = handle;
+  return *this;
+}
+
+certificate_store& certificate_store::operator=(
+    certificate_store&& other) noexcept
+{
+  native_handle_type handle = handle_;
+  handle_ = other.handle_;
+  other.handle_ = handle;
+  return *this;
+}
+
+certificate_store::~certificate_store()
+{
+  if (handle_)
+    ::X509_STORE_free(handle_);
+}
+
+void certificate_store::load_verify_file(const std::string& filename)
+{
+  asio::error_code ec;
+  load_verify_file(filename, ec);
+  asio::detail::throw_error(ec, "load_verify_file");
+}
+
+ASIO_SYNC_OP_VOID certificate_store::load_verify_file(
+    const std::string& filename, asio::error_code& ec)
+{
+  if (is_frozen(handle_))
+  {
+    ec = asio::error::no_permission;
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  ::ERR_clear_error();
+
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  if (::X509_STORE_load_file(handle_, filename.c_str()) != 1)
+#else // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  if (::X509_STORE_load_locations(handle_, filename.c_str(), 0) != 1)
+#endif // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  {
+    ec = translate_error(::ERR_get_error());
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  ec = asio::error_code();
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+void certificate_store::add_certificate_authority(const const_buffer& ca)
+{
+  asio::error_code ec;
+  add_certificate_authority(ca, ec);
+  asio::detail::throw_error(ec, "add_certificate_authority");
+}
+
+ASIO_SYNC_OP_VOID certificate_store::add_certificate_authority(
+    const const_buffer& ca, asio::error_code& ec)
+{
+  if (is_frozen(handle_))
+  {
+    ec = asio::error::no_permission;
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  ::ERR_clear_error();
+
+  bio_cleanup bio = { ::BIO_new_mem_buf(
+      const_cast<void*>(ca.data()), static_cast<int>(ca.size())) };
+  if (bio.p)
+  {
+    for (bool added = false;; added = true)
+    {
+      x509_cleanup cert = { ::PEM_read_bio_X509(bio.p, 0, 0, 0) };
+      if (!cert.p)
+      {
+        unsigned long err = ::ERR_get_error();
+        if (added && ERR_GET_LIB(err) == ERR_LIB_PEM
+            && ERR_GET_REASON(err) == PEM_R_NO_START_LINE)
+          break;
+
+        ec = translate_error(err);
+        ASIO_SYNC_OP_VOID_RETURN(ec);
+      }
+
+      if (::X509_STORE_add_cert(handle_, cert.p) != 1)
+      {
+        ec = translate_error(::ERR_get_error());
+        ASIO_SYNC_OP_VOID_RETURN(ec);
+      }
+    }
+  }
+
+  ec = asio::error_code();
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+void certificate_store::set_default_verify_paths()
+{
+  asio::error_code ec;
+  set_default_verify_paths(ec);
+  asio::detail::throw_error(ec, "set_default_verify_paths");
+}
+
+ASIO_SYNC_OP_VOID certificate_store::set_default_verify_paths(
+    asio::error_code& ec)
+{
+  if (is_frozen(handle_))
+  {
+    ec = asio::error::no_permission;
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  ::ERR_clear_error();
+
+  if (::X509_STORE_set_default_paths(handle_) != 1)
+  {
+    ec = translate_error(::ERR_get_error());
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  ec = asio::error_code();
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+std::size_t certificate_store::size() const
+{
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L) \
+  && (!defined(LIBRESSL_VERSION_NUMBER) \
+    || LIBRESSL_VERSION_NUMBER >= 0x2070000fL)
+  return static_cast<std::size_t>(
+      sk_X509_OBJECT_num(::X509_STORE_get0_objects(handle_)));
+#else // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+  return static_cast<std::size_t>(sk_X509_OBJECT_num(handle_->objs));
+#endif // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+}
+
+void certificate_store::freeze(native_handle_type handle)
+{
+  static char frozen_marker;
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L) \
+  && (!defined(LIBRESSL_VERSION_NUMBER) \
+    || LIBRESSL_VERSION_NUMBER >= 0x2070000fL)
+  ::X509_STORE_set_ex_data(handle, frozen_index(), &frozen_marker);
+#else // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+  ::CRYPTO_set_ex_data(&handle->ex_data, frozen_index(), &frozen_marker);
+#endif // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+}
+
+bool certificate_store::is_frozen(native_handle_type handle)
+{
+  if (!handle)
+    return false;
+
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L) \
+  && (!defined(LIBRESSL_VERSION_NUMBER) \
+    || LIBRESSL_VERSION_NUMBER >= 0x2070000fL)
+  return ::X509_STORE_get_ex_data(handle, frozen_index()) != 0;
+#else // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+  return ::CRYPTO_get_ex_data(&handle->ex_data, frozen_index()) != 0;
+#endif // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+}
+
+int certificate_store::frozen_index()
+{
+  static const int index = ::CRYPTO_get_ex_new_index(
+      CRYPTO_EX_INDEX_X509_STORE, 0, 0, 0, 0, 0);
+  return index;
+}
+
+asio::error_code certificate_store::translate_error(long error)
+{
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  if (ERR_SYSTEM_ERROR(error))
+  {
+    return asio::error_code(
+        static_cast<int>(ERR_GET_REASON(error)),
+        asio::error::get_system_category());
+  }
+#endif // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+
+  return asio::error_code(static_cast<int>(error),
+      asio::error::get_ssl_category());
+}
+
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_SSL_IMPL_CERTIFICATE_STORE_IPP
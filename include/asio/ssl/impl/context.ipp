@@ -22,6 +22,7 @@
 #include "asio/detail/throw_error.hpp"
 #include "asio/error.hpp"
 #include "asio/ssl/context.hpp"
+#include "asio/ssl/detail/engine.hpp"
 #include "asio/ssl/error.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -367,6 +368,11 @@ context::context(context::method m)
   }
 
   set_options(no_compression);
+
+#if !defined(ASIO_USE_WOLFSSL)
+  ::SSL_CTX_set_cert_verify_callback(handle_,
+      &context::cert_verify_callback_function, 0);
+#endif // !defined(ASIO_USE_WOLFSSL)
 }
 
 context::context(context::native_handle_type native_handle)
@@ -542,6 +548,12 @@ void context::load_verify_file(const std::string& filename)
 ASIO_SYNC_OP_VOID context::load_verify_file(
     const std::string& filename, asio::error_code& ec)
 {
+  if (certificate_store::is_frozen(::SSL_CTX_get_cert_store(handle_)))
+  {
+    ec = asio::error::no_permission;
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
   ::ERR_clear_error();
 
   if (::SSL_CTX_load_verify_locations(handle_, filename.c_str(), 0) != 1)
@@ -564,6 +576,12 @@ void context::add_certificate_authority(const const_buffer& ca)
 ASIO_SYNC_OP_VOID context::add_certificate_authority(
     const const_buffer& ca, asio::error_code& ec)
 {
+  if (certificate_store::is_frozen(::SSL_CTX_get_cert_store(handle_)))
+  {
+    ec = asio::error::no_permission;
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
   ::ERR_clear_error();
 
   bio_cleanup bio = { make_buffer_bio(ca) };
@@ -608,6 +626,12 @@ void context::set_default_verify_paths()
 ASIO_SYNC_OP_VOID context::set_default_verify_paths(
     asio::error_code& ec)
 {
+  if (certificate_store::is_frozen(::SSL_CTX_get_cert_store(handle_)))
+  {
+    ec = asio::error::no_permission;
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
   ::ERR_clear_error();
 
   if (::SSL_CTX_set_default_verify_paths(handle_) != 1)
@@ -630,6 +654,12 @@ void context::add_verify_path(const std::string& path)
 ASIO_SYNC_OP_VOID context::add_verify_path(
     const std::string& path, asio::error_code& ec)
 {
+  if (certificate_store::is_frozen(::SSL_CTX_get_cert_store(handle_)))
+  {
+    ec = asio::error::no_permission;
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
   ::ERR_clear_error();
 
   if (::SSL_CTX_load_verify_locations(handle_, 0, path.c_str()) != 1)
@@ -642,6 +672,41 @@ ASIO_SYNC_OP_VOID context::add_verify_path(
   ASIO_SYNC_OP_VOID_RETURN(ec);
 }
 
+void context::set_certificate_store(const certificate_store& store)
+{
+  asio::error_code ec;
+  set_certificate_store(store, ec);
+  asio::detail::throw_error(ec, "set_certificate_store");
+}
+
+ASIO_SYNC_OP_VOID context::set_certificate_store(
+    const certificate_store& store, asio::error_code& ec)
+{
+  if (!store.native_handle())
+  {
+    ec = asio::error::invalid_argument;
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  // The store is now shared, so it must no longer be modified.
+  certificate_store::freeze(store.native_handle());
+
+#if (OPENSSL_VERSION_NUMBER >= 0x10101000L) && !defined(LIBRESSL_VERSION_NUMBER)
+  ::SSL_CTX_set1_cert_store(handle_, store.native_handle());
+#elif (OPENSSL_VERSION_NUMBER >= 0x10100000L) \
+  && (!defined(LIBRESSL_VERSION_NUMBER) \
+    || LIBRESSL_VERSION_NUMBER >= 0x2070000fL)
+  ::X509_STORE_up_ref(store.native_handle());
+  ::SSL_CTX_set_cert_store(handle_, store.native_handle());
+#else // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+  ::CRYPTO_add(&store.native_handle()->references, 1, CRYPTO_LOCK_X509_STORE);
+  ::SSL_CTX_set_cert_store(handle_, store.native_handle());
+#endif // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+
+  ec = asio::error_code();
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
 void context::use_certificate(
     const const_buffer& certificate, file_format format)
 {
@@ -1241,6 +1306,50 @@ int context::verify_callback_function(int preverified, X509_STORE_CTX* ctx)
   return 0;
 }
 
+int context::cert_verify_callback_function(X509_STORE_CTX* ctx, void*)
+{
+  typedef int (*verify_callback_type)(int, X509_STORE_CTX*);
+
+  detail::verify_callback_base* callback = 0;
+  if (SSL* ssl = static_cast<SSL*>(
+        ::X509_STORE_CTX_get_ex_data(
+          ctx, ::SSL_get_ex_data_X509_STORE_CTX_idx())))
+  {
+    // Use whichever callback will be called to verify each certificate.
+    verify_callback_type verify = ::SSL_get_verify_callback(ssl);
+    if (verify == &context::verify_callback_function)
+    {
+      if (SSL_CTX* handle = ::SSL_get_SSL_CTX(ssl))
+        callback = static_cast<detail::verify_callback_base*>(
+            SSL_CTX_get_app_data(handle));
+    }
+    else
+    {
+      callback = detail::engine::get_verify_callback(ssl);
+    }
+  }
+
+  if (callback)
+  {
+    verify_context verify_ctx(ctx);
+    if (callback->is_verified(verify_ctx))
+    {
+      ::X509_STORE_CTX_set_error(ctx, X509_V_OK);
+      return 1;
+    }
+  }
+
+  int result = ::X509_verify_cert(ctx);
+
+  if (callback && result == 1)
+  {
+    verify_context verify_ctx(ctx);
+    callback->set_verified(verify_ctx);
+  }
+
+  return result;
+}
+
 ASIO_SYNC_OP_VOID context::do_set_password_callback(
     detail::password_callback_base* callback, asio::error_code& ec)
 {
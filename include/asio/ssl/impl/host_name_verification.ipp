@@ -65,6 +65,26 @@ bool host_name_verification::operator()(
   }
 }
 
+bool host_name_verification::is_verified(verify_context& ctx) const
+{
+  return cache_ && cache_->contains(peer_certificate(ctx), host_);
+}
+
+void host_name_verification::set_verified(verify_context& ctx) const
+{
+  if (cache_)
+    cache_->insert(peer_certificate(ctx), host_);
+}
+
+X509* host_name_verification::peer_certificate(verify_context& ctx)
+{
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L) && !defined(LIBRESSL_VERSION_NUMBER)
+  return ::X509_STORE_CTX_get0_cert(ctx.native_handle());
+#else // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+  return ctx.native_handle()->cert;
+#endif // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+}
+
 } // namespace ssl
 } // namespace asio
 
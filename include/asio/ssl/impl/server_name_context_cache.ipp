@@ -0,0 +1,91 @@
+//
+// ssl/impl/server_name_context_cache.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_IMPL_SERVER_NAME_CONTEXT_CACHE_IPP
+#define ASIO_SSL_IMPL_SERVER_NAME_CONTEXT_CACHE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include "asio/ssl/server_name_context_cache.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+
+server_name_context_cache::~server_name_context_cache()
+{
+  ::SSL_CTX_set_tlsext_servername_callback(default_context_, 0);
+  ::SSL_CTX_set_tlsext_servername_arg(default_context_, 0);
+}
+
+std::shared_ptr<context> server_name_context_cache::get(
+    const std::string& server_name)
+{
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    std::map<std::string, std::shared_ptr<context>>::iterator iter =
+      contexts_.find(server_name);
+    if (iter != contexts_.end())
+      return iter->second;
+  }
+
+  // Create the context without holding the lock, as loading certificates and
+  // keys may take some time. If another thread creates a context for the same
+  // host name in the meantime, the first one to be cached is used.
+  std::shared_ptr<context> ctx = factory_->call(server_name);
+  if (!ctx)
+    return ctx;
+
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  return contexts_.insert(std::make_pair(server_name, ctx)).first->second;
+}
+
+std::size_t server_name_context_cache::size() const
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  return contexts_.size();
+}
+
+void server_name_context_cache::attach()
+{
+  ::SSL_CTX_set_tlsext_servername_callback(default_context_,
+      &server_name_context_cache::server_name_callback_function);
+  ::SSL_CTX_set_tlsext_servername_arg(default_context_, this);
+}
+
+int server_name_context_cache::server_name_callback_function(
+    SSL* ssl, int* /*alert*/, void* arg)
+{
+  const char* server_name =
+    ::SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+  if (!server_name || !arg)
+    return SSL_TLSEXT_ERR_OK;
+
+  server_name_context_cache* self =
+    static_cast<server_name_context_cache*>(arg);
+
+  std::shared_ptr<context> ctx = self->get(server_name);
+  if (ctx)
+    ::SSL_set_SSL_CTX(ssl, ctx->native_handle());
+
+  return SSL_TLSEXT_ERR_OK;
+}
+
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_SSL_IMPL_SERVER_NAME_CONTEXT_CACHE_IPP
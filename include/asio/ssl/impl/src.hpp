@@ -19,10 +19,13 @@
 # error Do not compile Asio library source with ASIO_HEADER_ONLY defined
 #endif
 
+#include "asio/ssl/impl/certificate_store.ipp"
 #include "asio/ssl/impl/context.ipp"
 #include "asio/ssl/impl/error.ipp"
 #include "asio/ssl/detail/impl/engine.ipp"
 #include "asio/ssl/detail/impl/openssl_init.ipp"
 #include "asio/ssl/impl/host_name_verification.ipp"
+#include "asio/ssl/impl/server_name_context_cache.ipp"
+#include "asio/ssl/impl/verification_cache.ipp"
 
 #endif // ASIO_SSL_IMPL_SRC_HPP
@@ -0,0 +1,132 @@
+//
+// ssl/impl/verification_cache.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_IMPL_VERIFICATION_CACHE_IPP
+#define ASIO_SSL_IMPL_VERIFICATION_CACHE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include "asio/ssl/verification_cache.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+
+verification_cache::verification_cache(
+    std::size_t max_entries, std::chrono::seconds max_age)
+  : max_entries_(max_entries),
+    max_age_(max_age)
+{
+}
+
+bool verification_cache::contains(X509* cert, const std::string& host)
+{
+  std::string key = make_key(cert, host);
+  if (key.empty())
+    return false;
+
+  asio::detail::mutex::scoped_lock lock(mutex_);
+
+  std::map<std::string, std::list<entry>::iterator>::iterator iter =
+    index_.find(key);
+  if (iter == index_.end())
+    return false;
+
+  if (iter->second->expiry <= clock_type::now())
+  {
+    entries_.erase(iter->second);
+    index_.erase(iter);
+    return false;
+  }
+
+  entries_.splice(entries_.begin(), entries_, iter->second);
+  return true;
+}
+
+void verification_cache::insert(X509* cert, const std::string& host)
+{
+  if (max_entries_ == 0)
+    return;
+
+  std::string key = make_key(cert, host);
+  if (key.empty())
+    return;
+
+  // The entry must not outlive the certificate.
+  clock_type::time_point now = clock_type::now();
+  clock_type::time_point expiry = now + max_age_;
+  int days = 0, seconds = 0;
+  if (::ASN1_TIME_diff(&days, &seconds, 0, X509_get_notAfter(cert)) != 1)
+    return;
+  clock_type::time_point not_after = now
+    + std::chrono::hours(24) * days + std::chrono::seconds(seconds);
+  if (not_after <= now)
+    return;
+  if (not_after < expiry)
+    expiry = not_after;
+
+  asio::detail::mutex::scoped_lock lock(mutex_);
+
+  std::map<std::string, std::list<entry>::iterator>::iterator iter =
+    index_.find(key);
+  if (iter != index_.end())
+  {
+    iter->second->expiry = expiry;
+    entries_.splice(entries_.begin(), entries_, iter->second);
+    return;
+  }
+
+  if (entries_.size() >= max_entries_)
+  {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+
+  entry e = { key, expiry };
+  entries_.push_front(e);
+  index_.insert(std::make_pair(key, entries_.begin()));
+}
+
+void verification_cache::clear()
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  index_.clear();
+  entries_.clear();
+}
+
+std::size_t verification_cache::size() const
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+std::string verification_cache::make_key(X509* cert, const std::string& host)
+{
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int length = 0;
+  if (!cert || ::X509_digest(cert, ::EVP_sha256(), digest, &length) != 1)
+    return std::string();
+
+  std::string key(reinterpret_cast<const char*>(digest), length);
+  key += host;
+  return key;
+}
+
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_SSL_IMPL_VERIFICATION_CACHE_IPP
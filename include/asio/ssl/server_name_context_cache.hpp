@@ -0,0 +1,153 @@
+//
+// ssl/server_name_context_cache.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_SERVER_NAME_CONTEXT_CACHE_HPP
+#define ASIO_SSL_SERVER_NAME_CONTEXT_CACHE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/scoped_ptr.hpp"
+#include "asio/ssl/context.hpp"
+#include "asio/ssl/detail/context_factory.hpp"
+#include "asio/ssl/detail/openssl_types.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+
+/// Selects a server's SSL context according to the host name requested by the
+/// client, creating the contexts on demand.
+/**
+ * The server_name_context_cache class is attached to the context that is used
+ * to construct a server's SSL streams. When a client's handshake includes the
+ * server name indication (SNI) extension, the handshake is switched to the
+ * context for that host name. The context for each host name is created by a
+ * user-supplied factory the first time that the name is requested, and is
+ * then cached for subsequent handshakes. Contexts for rarely used host names
+ * therefore cost nothing at startup.
+ *
+ * The factory is called with the requested host name, and must return a
+ * @c std::shared_ptr<asio::ssl::context>. It may return a null pointer to
+ * continue the handshake with the default context, in which case nothing is
+ * cached. This allows unrecognised host names to be rejected without growing
+ * the cache. The factory may be called from any thread that performs a
+ * handshake, and must not exit via an exception.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ *
+ * @par Example
+ * @code
+ * asio::ssl::certificate_store store;
+ * store.load_verify_file("ca-bundle.pem");
+ *
+ * asio::ssl::context default_ctx(asio::ssl::context::tls_server);
+ * default_ctx.use_certificate_chain_file("default.pem");
+ * default_ctx.use_private_key_file("default.key", asio::ssl::context::pem);
+ *
+ * asio::ssl::server_name_context_cache cache(default_ctx,
+ *     [&store](const std::string& host)
+ *     {
+ *       std::shared_ptr<asio::ssl::context> ctx;
+ *       if (is_hosted(host))
+ *       {
+ *         ctx = std::make_shared<asio::ssl::context>(
+ *             asio::ssl::context::tls_server);
+ *         ctx->set_certificate_store(store);
+ *         ctx->use_certificate_chain_file(host + ".pem");
+ *         ctx->use_private_key_file(host + ".key",
+ *             asio::ssl::context::pem);
+ *       }
+ *       return ctx;
+ *     });
+ * @endcode
+ */
+class server_name_context_cache
+  : private noncopyable
+{
+public:
+  /// Construct a cache and attach it to the default context.
+  /**
+   * @param default_context The context used to construct the server's
+   * streams. It must outlive the cache. Any previously installed server name
+   * callback on the context is replaced.
+   *
+   * @param factory The function object used to create the context for a host
+   * name. It is called as:
+   * @code std::shared_ptr<asio::ssl::context> factory(
+   *   const std::string& server_name // The requested host name.
+   * ); @endcode
+   *
+   * @note Calls @c SSL_CTX_set_tlsext_servername_callback.
+   */
+  template <typename ContextFactory>
+  server_name_context_cache(context& default_context, ContextFactory factory)
+    : default_context_(default_context.native_handle()),
+      factory_(new detail::context_factory<ContextFactory>(factory))
+  {
+    attach();
+  }
+
+  /// Destructor. Detaches the cache from the default context.
+  ASIO_DECL ~server_name_context_cache();
+
+  /// Get the context for a host name, creating it if required.
+  /**
+   * @returns The cached or newly created context for the host name, or a null
+   * pointer if the factory declined to create one.
+   */
+  ASIO_DECL std::shared_ptr<context> get(const std::string& server_name);
+
+  /// Get the number of cached contexts.
+  ASIO_DECL std::size_t size() const;
+
+private:
+  // Install the server name callback on the default context.
+  ASIO_DECL void attach();
+
+  // Callback used when a client's handshake includes a server name.
+  ASIO_DECL static int server_name_callback_function(
+      SSL* ssl, int* alert, void* arg);
+
+  // The context used to construct the server's streams.
+  SSL_CTX* default_context_;
+
+  // The function object used to create contexts.
+  asio::detail::scoped_ptr<detail::context_factory_base> factory_;
+
+  // Mutex to protect access to the cached contexts.
+  mutable asio::detail::mutex mutex_;
+
+  // The cached contexts, keyed by host name.
+  std::map<std::string, std::shared_ptr<context>> contexts_;
+};
+
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/ssl/impl/server_name_context_cache.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_SSL_SERVER_NAME_CONTEXT_CACHE_HPP
@@ -24,6 +24,7 @@
 #include "asio/detail/non_const_lvalue.hpp"
 #include "asio/detail/noncopyable.hpp"
 #include "asio/detail/type_traits.hpp"
+#include "asio/execution/executor.hpp"
 #include "asio/ssl/context.hpp"
 #include "asio/ssl/detail/buffered_handshake_op.hpp"
 #include "asio/ssl/detail/handshake_op.hpp"
@@ -68,6 +69,7 @@ class stream :
 {
 private:
   class initiate_async_handshake;
+  class initiate_async_offloaded_handshake;
   class initiate_async_buffered_handshake;
   class initiate_async_shutdown;
   class initiate_async_write_some;
@@ -512,6 +514,78 @@ public:
         initiate_async_handshake(this), token, type);
   }
 
+  /// Start an asynchronous SSL handshake, running the handshake computation
+  /// on a separate executor.
+  /**
+   * This function is used to asynchronously perform an SSL handshake on the
+   * stream. It is an initiating function for an @ref asynchronous_operation,
+   * and always returns immediately.
+   *
+   * Each step of the SSL engine's handshake, which includes the CPU-intensive
+   * public key operations, is run on the specified engine executor. All I/O on
+   * the next layer, and the invocation of the completion handler, are
+   * performed as for the other overloads of @c async_handshake. Outstanding
+   * work is maintained on the stream's executor while an engine step runs.
+   *
+   * @param type The type of handshaking to be performed, i.e. as a client or as
+   * a server.
+   *
+   * @param engine_ex The executor used to run the engine's handshake steps,
+   * such as the executor of a @ref thread_pool. No other operation may be
+   * performed on the stream until the handshake completes.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the handshake completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   *
+   * @par Example
+   * @code asio::thread_pool crypto_pool(2);
+   * ...
+   * stream.async_handshake(asio::ssl::stream_base::server,
+   *     crypto_pool.get_executor(), handler); @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * if they are also supported by the @c Stream type's @c async_read_some and
+   * @c async_write_some operations.
+   */
+  template <typename Executor,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        HandshakeToken = default_completion_token_t<executor_type>>
+  auto async_handshake(handshake_type type, const Executor& engine_ex,
+      HandshakeToken&& token = default_completion_token_t<executor_type>(),
+      constraint_t<
+        execution::is_executor<Executor>::value
+      > = 0)
+    -> decltype(
+      async_initiate<HandshakeToken,
+        void (asio::error_code)>(
+          declval<initiate_async_offloaded_handshake>(),
+          token, type, engine_ex))
+  {
+    return async_initiate<HandshakeToken,
+      void (asio::error_code)>(
+        initiate_async_offloaded_handshake(this), token, type, engine_ex);
+  }
+
   /// Start an asynchronous SSL handshake.
   /**
    * This function is used to asynchronously perform an SSL handshake on the
@@ -899,6 +973,39 @@ private:
     stream* self_;
   };
 
+  class initiate_async_offloaded_handshake
+  {
+  public:
+    typedef typename stream::executor_type executor_type;
+
+    explicit initiate_async_offloaded_handshake(stream* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename HandshakeHandler, typename Executor>
+    void operator()(HandshakeHandler&& handler,
+        handshake_type type, const Executor& engine_ex) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a HandshakeHandler.
+      ASIO_HANDSHAKE_HANDLER_CHECK(HandshakeHandler, handler) type_check;
+
+      asio::detail::non_const_lvalue<HandshakeHandler> handler2(handler);
+      detail::async_io(self_->next_layer_, self_->core_,
+          detail::offloaded_handshake_op<Executor>(type, engine_ex),
+          handler2.value);
+    }
+
+  private:
+    stream* self_;
+  };
+
   class initiate_async_buffered_handshake
   {
   public:
@@ -0,0 +1,135 @@
+//
+// ssl/verification_cache.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_VERIFICATION_CACHE_HPP
+#define ASIO_SSL_VERIFICATION_CACHE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <map>
+#include <string>
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/ssl/detail/openssl_types.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+
+/// A bounded cache of peer certificates that have been verified for a host
+/// name.
+/**
+ * The verification_cache class records the peer certificates that have passed
+ * full verification, including the building and verification of the
+ * certificate chain, for a given host name. It is used with the
+ * host_name_verification class so that repeated connections to the same host
+ * can skip the verification of the chain.
+ *
+ * Entries are keyed by the SHA-256 fingerprint of the peer's certificate and
+ * the host name. An entry expires when the certificate expires, or after the
+ * maximum age given to the constructor, whichever comes first. The maximum age
+ * bounds the time for which changes to the trusted certificates, such as a
+ * revocation, go unnoticed for a cached certificate. When the cache is full,
+ * the least recently used entry is discarded.
+ *
+ * Verification is skipped only for handshakes that use an asio::ssl::context
+ * constructed from a method, as the context is responsible for consulting the
+ * cache.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ *
+ * @par Example
+ * @code
+ * asio::ssl::verification_cache cache(256);
+ * ...
+ * sock.set_verify_mode(ssl::verify_peer);
+ * sock.set_verify_callback(
+ *     ssl::host_name_verification("host.name", cache));
+ * sock.handshake(ssl_socket::client);
+ * @endcode
+ */
+class verification_cache
+  : private noncopyable
+{
+public:
+  /// Construct a cache.
+  /**
+   * @param max_entries The maximum number of entries held by the cache.
+   *
+   * @param max_age The maximum time for which an entry is used.
+   */
+  ASIO_DECL explicit verification_cache(std::size_t max_entries = 1024,
+      std::chrono::seconds max_age = std::chrono::hours(1));
+
+  /// Determine whether a certificate has been verified for a host name.
+  /**
+   * @returns @c true if the certificate is in the cache for the host name and
+   * the entry has not expired.
+   */
+  ASIO_DECL bool contains(X509* cert, const std::string& host);
+
+  /// Record that a certificate has been verified for a host name.
+  ASIO_DECL void insert(X509* cert, const std::string& host);
+
+  /// Remove all entries from the cache.
+  ASIO_DECL void clear();
+
+  /// Get the number of entries in the cache.
+  ASIO_DECL std::size_t size() const;
+
+private:
+  typedef std::chrono::system_clock clock_type;
+
+  // Make the key for a certificate and host name. Returns an empty string if
+  // the certificate's fingerprint cannot be calculated.
+  ASIO_DECL static std::string make_key(X509* cert, const std::string& host);
+
+  struct entry
+  {
+    std::string key;
+    clock_type::time_point expiry;
+  };
+
+  // The maximum number of entries.
+  std::size_t max_entries_;
+
+  // The maximum time for which an entry is used.
+  std::chrono::seconds max_age_;
+
+  // Mutex to protect access to the entries.
+  mutable asio::detail::mutex mutex_;
+
+  // The entries, with the most recently used at the front.
+  std::list<entry> entries_;
+
+  // The entries, indexed by key.
+  std::map<std::string, std::list<entry>::iterator> index_;
+};
+
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/ssl/impl/verification_cache.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_SSL_VERIFICATION_CACHE_HPP
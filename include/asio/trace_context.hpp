@@ -0,0 +1,138 @@
+//
+// trace_context.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_TRACE_CONTEXT_HPP
+#define ASIO_TRACE_CONTEXT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstdint>
+#include "asio/detail/call_stack.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// An opaque identifier used to attribute asynchronous work to a request.
+/**
+ * A trace context is a small value, such as a request identifier or a
+ * distributed tracing span, that is associated with a completion handler using
+ * asio::bind_trace_context. Composed operations, parallel groups and
+ * coroutines propagate the trace context of their completion handler to the
+ * intermediate operations they start, and the context is made available to
+ * the code they run via trace_context::current().
+ *
+ * The library does not interpret the identifiers, other than to treat a trace
+ * context with a zero trace identifier as unset.
+ */
+class trace_context
+{
+public:
+  /// Construct an unset trace context.
+  constexpr trace_context() noexcept
+    : trace_id_(0),
+      span_id_(0)
+  {
+  }
+
+  /// Construct a trace context with the specified identifiers.
+  constexpr explicit trace_context(std::uint64_t trace_id,
+      std::uint64_t span_id = 0) noexcept
+    : trace_id_(trace_id),
+      span_id_(span_id)
+  {
+  }
+
+  /// Get the trace identifier.
+  constexpr std::uint64_t trace_id() const noexcept
+  {
+    return trace_id_;
+  }
+
+  /// Get the span identifier.
+  constexpr std::uint64_t span_id() const noexcept
+  {
+    return span_id_;
+  }
+
+  /// Determine whether the trace context is set.
+  constexpr explicit operator bool() const noexcept
+  {
+    return trace_id_ != 0;
+  }
+
+  /// Compare two trace contexts for equality.
+  friend constexpr bool operator==(const trace_context& a,
+      const trace_context& b) noexcept
+  {
+    return a.trace_id_ == b.trace_id_ && a.span_id_ == b.span_id_;
+  }
+
+  /// Compare two trace contexts for inequality.
+  friend constexpr bool operator!=(const trace_context& a,
+      const trace_context& b) noexcept
+  {
+    return a.trace_id_ != b.trace_id_ || a.span_id_ != b.span_id_;
+  }
+
+  /// Obtain the trace context of the code running on the current thread.
+  /**
+   * @returns The trace context of the innermost completion handler, composed
+   * operation step or coroutine that is running on the current thread and
+   * has an associated trace context, or an unset trace context if there is
+   * none.
+   */
+  static trace_context current() noexcept;
+
+private:
+  std::uint64_t trace_id_;
+  std::uint64_t span_id_;
+};
+
+namespace detail {
+
+// Makes a trace context current for the lifetime of the scope object.
+class trace_context_scope
+  : private noncopyable
+{
+public:
+  explicit trace_context_scope(const trace_context& c) noexcept
+    : context_(c),
+      entry_(this, context_)
+  {
+  }
+
+  static const trace_context* top() noexcept
+  {
+    return call_stack<trace_context_scope, trace_context>::top();
+  }
+
+private:
+  trace_context context_;
+  call_stack<trace_context_scope, trace_context>::context entry_;
+};
+
+} // namespace detail
+
+inline trace_context trace_context::current() noexcept
+{
+  const trace_context* c = detail::trace_context_scope::top();
+  return c ? *c : trace_context();
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_TRACE_CONTEXT_HPP
@@ -0,0 +1,568 @@
+//
+// asio.cppm
+// ~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Interface unit for the asio named module. The library headers are included
+// in the global module fragment, so the entities keep their usual linkage and
+// the module may be used alongside asio.cpp (ASIO_SEPARATE_COMPILATION) or
+// header-only. The public API is then exported using using-declarations.
+//
+// The module must be compiled with the same configuration macros as the code
+// that imports it. Macros, such as ASIO_VERSION, are not exported.
+
+module;
+
+#include "asio.hpp"
+
+export module asio;
+
+export namespace asio {
+
+// Execution contexts and executors.
+using asio::any_completion_executor;
+using asio::any_io_executor;
+using asio::basic_inline_executor;
+using asio::basic_system_executor;
+using asio::execution_context;
+using asio::executor_work_guard;
+using asio::has_service;
+using asio::inline_executor;
+using asio::invalid_service_owner;
+using asio::io_context;
+using asio::is_executor;
+using asio::make_service;
+using asio::make_strand;
+using asio::make_work_guard;
+using asio::service_already_exists;
+using asio::static_thread_pool;
+using asio::strand;
+using asio::system_context;
+using asio::system_executor;
+using asio::thread;
+using asio::thread_pool;
+using asio::use_service;
+#if !defined(ASIO_NO_TS_EXECUTORS)
+using asio::bad_executor;
+using asio::executor;
+using asio::inline_or;
+using asio::inline_or_executor;
+#endif // !defined(ASIO_NO_TS_EXECUTORS)
+
+// Runtime configuration and statistics.
+using asio::admission_statistics;
+using asio::config;
+using asio::config_from_concurrency_hint;
+using asio::config_from_env;
+using asio::config_from_string;
+using asio::config_service;
+using asio::get_admission_statistics;
+
+// Properties.
+using asio::can_prefer;
+using asio::can_prefer_v;
+using asio::can_query;
+using asio::can_query_v;
+using asio::can_require;
+using asio::can_require_concept;
+using asio::can_require_concept_v;
+using asio::can_require_v;
+using asio::is_applicable_property;
+using asio::is_applicable_property_v;
+using asio::is_nothrow_prefer;
+using asio::is_nothrow_prefer_v;
+using asio::is_nothrow_query;
+using asio::is_nothrow_query_v;
+using asio::is_nothrow_require;
+using asio::is_nothrow_require_concept;
+using asio::is_nothrow_require_concept_v;
+using asio::is_nothrow_require_v;
+using asio::prefer;
+using asio::prefer_result;
+using asio::prefer_result_t;
+using asio::prefer_t;
+using asio::query;
+using asio::query_result;
+using asio::query_result_t;
+using asio::query_t;
+using asio::require;
+using asio::require_concept;
+using asio::require_concept_result;
+using asio::require_concept_result_t;
+using asio::require_concept_t;
+using asio::require_result;
+using asio::require_result_t;
+using asio::require_t;
+
+// Asynchronous operations and completion tokens.
+using asio::append;
+using asio::append_t;
+using asio::as_tuple;
+using asio::as_tuple_t;
+using asio::async_completion;
+using asio::async_compose;
+using asio::async_immediate;
+using asio::async_initiate;
+using asio::async_operation;
+using asio::async_result;
+using asio::cancel_after;
+using asio::cancel_after_t;
+using asio::cancel_after_timer;
+using asio::cancel_at;
+using asio::cancel_at_t;
+using asio::cancel_at_timer;
+using asio::completion_handler_for;
+using asio::completion_signature;
+using asio::completion_signature_of;
+using asio::completion_signature_of_t;
+using asio::completion_token_for;
+using asio::composed;
+using asio::consign;
+using asio::consign_t;
+using asio::default_completion_token;
+using asio::default_completion_token_t;
+using asio::defer;
+using asio::deferred;
+using asio::deferred_async_operation;
+using asio::deferred_conditional;
+using asio::deferred_function;
+using asio::deferred_init_tag;
+using asio::deferred_noop;
+using asio::deferred_signatures;
+using asio::deferred_t;
+using asio::deferred_values;
+using asio::detached;
+using asio::detached_t;
+using asio::dispatch;
+using asio::is_async_operation;
+using asio::is_deferred;
+using asio::partial_as_tuple;
+using asio::partial_cancel_after;
+using asio::partial_cancel_after_timer;
+using asio::partial_cancel_at;
+using asio::partial_cancel_at_timer;
+using asio::partial_redirect_disposition;
+using asio::partial_redirect_error;
+using asio::post;
+using asio::post_bulk;
+using asio::prepend;
+using asio::prepend_t;
+using asio::redirect_disposition;
+using asio::redirect_disposition_t;
+using asio::redirect_error;
+using asio::redirect_error_t;
+#if defined(ASIO_HAS_STD_FUTURE_CLASS)
+using asio::use_future;
+using asio::use_future_t;
+#endif // defined(ASIO_HAS_STD_FUTURE_CLASS)
+
+// Associated characteristics and binders.
+using asio::allocator_binder;
+using asio::associated_allocator;
+using asio::associated_allocator_t;
+using asio::associated_cancellation_slot;
+using asio::associated_cancellation_slot_t;
+using asio::associated_executor;
+using asio::associated_executor_t;
+using asio::associated_immediate_executor;
+using asio::associated_immediate_executor_t;
+using asio::associated_trace_context;
+using asio::associated_trace_context_t;
+using asio::associator;
+using asio::bind_allocator;
+using asio::bind_cancellation_slot;
+using asio::bind_executor;
+using asio::bind_immediate_executor;
+using asio::bind_trace_context;
+using asio::cancellation_slot_binder;
+using asio::executor_arg;
+using asio::executor_arg_t;
+using asio::executor_binder;
+using asio::get_associated_allocator;
+using asio::get_associated_cancellation_slot;
+using asio::get_associated_executor;
+using asio::get_associated_immediate_executor;
+using asio::get_associated_trace_context;
+using asio::immediate_executor_binder;
+using asio::partial_allocator_binder;
+using asio::partial_cancellation_slot_binder;
+using asio::partial_executor_binder;
+using asio::partial_immediate_executor_binder;
+using asio::partial_trace_context_binder;
+using asio::recycling_allocator;
+using asio::trace_context;
+using asio::trace_context_binder;
+using asio::uses_executor;
+
+// Cancellation.
+using asio::cancellation_filter;
+using asio::cancellation_signal;
+using asio::cancellation_slot;
+using asio::cancellation_state;
+using asio::cancellation_type;
+using asio::cancellation_type_t;
+using asio::disable_cancellation;
+using asio::enable_partial_cancellation;
+using asio::enable_terminal_cancellation;
+using asio::enable_total_cancellation;
+using asio::operator!;
+using asio::operator&;
+using asio::operator|;
+using asio::operator^;
+using asio::operator~;
+
+// Type-erased completion handlers.
+using asio::any_completion_handler;
+using asio::any_completion_handler_allocator;
+
+// Coroutines.
+using asio::coroutine;
+#if defined(ASIO_HAS_CO_AWAIT)
+using asio::awaitable;
+using asio::co_composed;
+using asio::co_spawn;
+using asio::use_awaitable;
+using asio::use_awaitable_t;
+#endif // defined(ASIO_HAS_CO_AWAIT)
+
+// Errors and dispositions.
+using asio::disposition;
+using asio::disposition_traits;
+using asio::error_category;
+using asio::error_code;
+using asio::is_disposition;
+using asio::is_disposition_v;
+using asio::multiple_exceptions;
+using asio::no_error;
+using asio::no_error_t;
+using asio::system_error;
+using asio::to_exception_ptr;
+
+// Buffers.
+using asio::buffer;
+using asio::buffer_copy;
+using asio::buffer_registration;
+using asio::buffer_sequence_begin;
+using asio::buffer_sequence_end;
+using asio::buffer_size;
+using asio::buffers_begin;
+using asio::buffers_end;
+using asio::buffers_iterator;
+using asio::const_buffer;
+using asio::const_registered_buffer;
+using asio::dynamic_buffer;
+using asio::dynamic_string_buffer;
+using asio::dynamic_vector_buffer;
+using asio::is_const_buffer_sequence;
+using asio::is_contiguous_iterator;
+using asio::is_dynamic_buffer;
+using asio::is_dynamic_buffer_v1;
+using asio::is_dynamic_buffer_v2;
+using asio::is_mutable_buffer_sequence;
+using asio::mutable_buffer;
+using asio::mutable_registered_buffer;
+using asio::null_buffers;
+using asio::operator+;
+using asio::register_buffers;
+using asio::registered_buffer_id;
+#if !defined(ASIO_NO_IOSTREAM)
+using asio::basic_streambuf;
+using asio::basic_streambuf_ref;
+using asio::streambuf;
+#endif // !defined(ASIO_NO_IOSTREAM)
+
+// Synchronous and asynchronous I/O operations.
+using asio::async_connect;
+using asio::async_read;
+using asio::async_read_at;
+using asio::async_read_until;
+using asio::async_write;
+using asio::async_write_at;
+using asio::connect;
+using asio::is_completion_condition;
+using asio::is_connect_condition;
+using asio::is_endpoint_sequence;
+using asio::is_match_condition;
+using asio::is_read_buffered;
+using asio::is_write_buffered;
+using asio::read;
+using asio::read_at;
+using asio::read_until;
+using asio::transfer_all;
+using asio::transfer_at_least;
+using asio::transfer_exactly;
+using asio::write;
+using asio::write_at;
+
+// I/O objects.
+using asio::basic_datagram_socket;
+using asio::basic_raw_socket;
+using asio::basic_seq_packet_socket;
+using asio::basic_signal_set;
+using asio::basic_socket;
+using asio::basic_socket_acceptor;
+using asio::basic_stream_socket;
+using asio::basic_waitable_timer;
+using asio::buffered_read_stream;
+using asio::buffered_stream;
+using asio::buffered_write_stream;
+using asio::high_resolution_timer;
+using asio::signal_set;
+using asio::signal_set_base;
+using asio::socket_base;
+using asio::steady_timer;
+using asio::system_timer;
+using asio::wait_traits;
+#if !defined(ASIO_NO_IOSTREAM)
+using asio::basic_socket_iostream;
+using asio::basic_socket_streambuf;
+#endif // !defined(ASIO_NO_IOSTREAM)
+#if defined(ASIO_HAS_FILE)
+using asio::basic_file;
+using asio::basic_random_access_file;
+using asio::basic_stream_file;
+using asio::file_base;
+using asio::random_access_file;
+using asio::stream_file;
+#endif // defined(ASIO_HAS_FILE)
+#if defined(ASIO_HAS_PIPE)
+using asio::basic_readable_pipe;
+using asio::basic_writable_pipe;
+using asio::connect_pipe;
+using asio::readable_pipe;
+using asio::writable_pipe;
+#endif // defined(ASIO_HAS_PIPE)
+#if defined(ASIO_HAS_SERIAL_PORT)
+using asio::basic_serial_port;
+using asio::serial_port;
+using asio::serial_port_base;
+#endif // defined(ASIO_HAS_SERIAL_PORT)
+
+namespace error {
+
+using asio::error::get_addrinfo_category;
+using asio::error::get_misc_category;
+using asio::error::get_netdb_category;
+using asio::error::get_system_category;
+using asio::error::make_error_code;
+using enum asio::error::addrinfo_errors;
+using enum asio::error::basic_errors;
+using enum asio::error::misc_errors;
+using enum asio::error::netdb_errors;
+using asio::error::addrinfo_errors;
+using asio::error::basic_errors;
+using asio::error::misc_errors;
+using asio::error::netdb_errors;
+
+} // namespace error
+
+namespace execution {
+
+using asio::execution::allocator;
+using asio::execution::allocator_t;
+using asio::execution::any_executor;
+using asio::execution::bad_executor;
+using asio::execution::blocking;
+using asio::execution::blocking_adaptation;
+using asio::execution::blocking_adaptation_t;
+using asio::execution::blocking_t;
+using asio::execution::context;
+using asio::execution::context_as;
+using asio::execution::context_as_t;
+using asio::execution::context_t;
+using asio::execution::executor;
+using asio::execution::inline_exception_handling;
+using asio::execution::inline_exception_handling_t;
+using asio::execution::invocable_archetype;
+using asio::execution::is_executor;
+using asio::execution::is_executor_v;
+using asio::execution::mapping;
+using asio::execution::mapping_t;
+using asio::execution::occupancy;
+using asio::execution::occupancy_t;
+using asio::execution::outstanding_work;
+using asio::execution::outstanding_work_t;
+using asio::execution::prefer_only;
+using asio::execution::priority;
+using asio::execution::priority_t;
+using asio::execution::relationship;
+using asio::execution::relationship_t;
+
+} // namespace execution
+
+namespace generic {
+
+using asio::generic::basic_endpoint;
+using asio::generic::datagram_protocol;
+using asio::generic::raw_protocol;
+using asio::generic::seq_packet_protocol;
+using asio::generic::stream_protocol;
+
+} // namespace generic
+
+namespace ip {
+
+using asio::ip::address;
+using asio::ip::address_v4;
+using asio::ip::address_v4_iterator;
+using asio::ip::address_v4_range;
+using asio::ip::address_v6;
+using asio::ip::address_v6_iterator;
+using asio::ip::address_v6_range;
+using asio::ip::bad_address_cast;
+using asio::ip::basic_address_iterator;
+using asio::ip::basic_address_range;
+using asio::ip::basic_endpoint;
+using asio::ip::basic_resolver;
+using asio::ip::basic_resolver_entry;
+using asio::ip::basic_resolver_iterator;
+using asio::ip::basic_resolver_query;
+using asio::ip::basic_resolver_results;
+using asio::ip::host_name;
+using asio::ip::icmp;
+using asio::ip::make_address;
+using asio::ip::make_address_v4;
+using asio::ip::make_address_v6;
+using asio::ip::make_network_v4;
+using asio::ip::make_network_v6;
+using asio::ip::network_v4;
+using asio::ip::network_v6;
+using asio::ip::port_type;
+using asio::ip::resolver_base;
+using asio::ip::resolver_query_base;
+using asio::ip::scope_id_type;
+using asio::ip::tcp;
+using asio::ip::udp;
+using asio::ip::v4_mapped;
+using asio::ip::v4_mapped_t;
+using asio::ip::v6_only;
+#if !defined(ASIO_NO_IOSTREAM)
+using asio::ip::operator<<;
+#endif // !defined(ASIO_NO_IOSTREAM)
+
+namespace multicast {
+
+using asio::ip::multicast::enable_loopback;
+using asio::ip::multicast::hops;
+using asio::ip::multicast::join_group;
+using asio::ip::multicast::leave_group;
+using asio::ip::multicast::outbound_interface;
+
+} // namespace multicast
+
+namespace unicast {
+
+using asio::ip::unicast::hops;
+
+} // namespace unicast
+
+} // namespace ip
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+namespace local {
+
+using asio::local::basic_endpoint;
+using asio::local::connect_pair;
+using asio::local::datagram_protocol;
+using asio::local::seq_packet_protocol;
+using asio::local::stream_protocol;
+
+} // namespace local
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+namespace placeholders {
+
+using asio::placeholders::bytes_transferred;
+using asio::placeholders::endpoint;
+using asio::placeholders::error;
+using asio::placeholders::iterator;
+using asio::placeholders::results;
+using asio::placeholders::signal_number;
+
+} // namespace placeholders
+
+#if defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+namespace posix {
+
+using asio::posix::basic_descriptor;
+using asio::posix::basic_stream_descriptor;
+using asio::posix::descriptor;
+using asio::posix::descriptor_base;
+using asio::posix::stream_descriptor;
+
+} // namespace posix
+#endif // defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+
+namespace this_coro {
+
+using asio::this_coro::cancellation_state;
+using asio::this_coro::cancellation_state_t;
+using asio::this_coro::executor;
+using asio::this_coro::executor_t;
+using asio::this_coro::reset_cancellation_state;
+using asio::this_coro::throw_if_cancelled;
+
+} // namespace this_coro
+
+namespace traits {
+
+using asio::traits::equality_comparable;
+using asio::traits::execute_member;
+using asio::traits::prefer_free;
+using asio::traits::prefer_member;
+using asio::traits::query_free;
+using asio::traits::query_member;
+using asio::traits::query_static_constexpr_member;
+using asio::traits::require_concept_free;
+using asio::traits::require_concept_member;
+using asio::traits::require_free;
+using asio::traits::require_member;
+using asio::traits::static_query;
+using asio::traits::static_require;
+using asio::traits::static_require_concept;
+
+} // namespace traits
+
+#if defined(ASIO_HAS_WINDOWS_OBJECT_HANDLE)
+namespace windows {
+
+using asio::windows::basic_object_handle;
+using asio::windows::object_handle;
+
+} // namespace windows
+#endif // defined(ASIO_HAS_WINDOWS_OBJECT_HANDLE)
+
+#if defined(ASIO_HAS_WINDOWS_OVERLAPPED_PTR)
+namespace windows {
+
+using asio::windows::overlapped_ptr;
+
+} // namespace windows
+#endif // defined(ASIO_HAS_WINDOWS_OVERLAPPED_PTR)
+
+#if defined(ASIO_HAS_WINDOWS_RANDOM_ACCESS_HANDLE)
+namespace windows {
+
+using asio::windows::basic_overlapped_handle;
+using asio::windows::basic_random_access_handle;
+using asio::windows::overlapped_handle;
+using asio::windows::random_access_handle;
+
+} // namespace windows
+#endif // defined(ASIO_HAS_WINDOWS_RANDOM_ACCESS_HANDLE)
+
+#if defined(ASIO_HAS_WINDOWS_STREAM_HANDLE)
+namespace windows {
+
+using asio::windows::basic_stream_handle;
+using asio::windows::stream_handle;
+
+} // namespace windows
+#endif // defined(ASIO_HAS_WINDOWS_STREAM_HANDLE)
+
+} // namespace asio
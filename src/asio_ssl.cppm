@@ -0,0 +1,61 @@
+//
+// asio_ssl.cppm
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Interface unit for the asio.ssl named module. It exports only the SSL
+// facilities, so programs use it together with the asio module:
+//
+//   import asio;
+//   import asio.ssl;
+//
+// With ASIO_SEPARATE_COMPILATION, the program must also be linked with the
+// object built from asio_ssl.cpp.
+
+module;
+
+#include "asio/ssl.hpp"
+
+export module asio.ssl;
+
+export namespace asio {
+namespace error {
+
+using asio::error::get_ssl_category;
+using asio::error::make_error_code;
+using asio::error::ssl_errors;
+
+} // namespace error
+
+namespace ssl {
+
+using asio::ssl::certificate_store;
+using asio::ssl::context;
+using asio::ssl::context_base;
+using asio::ssl::host_name_verification;
+using asio::ssl::server_name_context_cache;
+using asio::ssl::stream;
+using asio::ssl::stream_base;
+using asio::ssl::verification_cache;
+using asio::ssl::verify_client_once;
+using asio::ssl::verify_context;
+using asio::ssl::verify_fail_if_no_peer_cert;
+using asio::ssl::verify_mode;
+using asio::ssl::verify_none;
+using asio::ssl::verify_peer;
+
+namespace error {
+
+using asio::ssl::error::get_stream_category;
+using asio::ssl::error::make_error_code;
+using enum asio::ssl::error::stream_errors;
+using asio::ssl::error::stream_errors;
+
+} // namespace error
+} // namespace ssl
+} // namespace asio
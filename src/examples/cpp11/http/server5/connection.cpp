@@ -0,0 +1,298 @@
+//
+// connection.cpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "connection.hpp"
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+#if defined(HTTP_SERVER5_HAS_SENDFILE)
+# include <cerrno>
+# include <sys/sendfile.h>
+# include <unistd.h>
+#endif // defined(HTTP_SERVER5_HAS_SENDFILE)
+
+namespace http {
+namespace server5 {
+
+namespace {
+
+/// The maximum number of pipelined requests handled before the replies are
+/// written.
+const std::size_t max_pipelined_requests = 64;
+
+/// The amount of output after which no more requests are handled until the
+/// replies have been written.
+const std::size_t max_pending_output = 65536;
+
+/// How long a connection may remain idle before it is closed.
+const std::chrono::seconds idle_timeout(30);
+
+} // namespace
+
+connection::connection(asio::ip::tcp::socket socket,
+    const request_handler& handler)
+  : socket_(std::move(socket)),
+    timer_(socket_.get_executor()),
+    request_handler_(handler),
+    buffer_begin_(0),
+    buffer_end_(0),
+    output_written_(0),
+#if defined(HTTP_SERVER5_HAS_SENDFILE)
+    next_file_(0),
+#endif // defined(HTTP_SERVER5_HAS_SENDFILE)
+    closing_(false)
+{
+  reply_.clear();
+}
+
+connection::~connection()
+{
+#if defined(HTTP_SERVER5_HAS_SENDFILE)
+  for (std::size_t i = next_file_; i < files_.size(); ++i)
+    ::close(files_[i].file);
+#endif // defined(HTTP_SERVER5_HAS_SENDFILE)
+}
+
+void connection::start()
+{
+  std::error_code ignored_ec;
+  socket_.set_option(asio::ip::tcp::no_delay(true), ignored_ec);
+
+#if defined(HTTP_SERVER5_HAS_SENDFILE)
+  // The socket is written directly by sendfile, which must not block.
+  socket_.native_non_blocking(true, ignored_ec);
+#endif // defined(HTTP_SERVER5_HAS_SENDFILE)
+
+  deadline_ = asio::steady_timer::clock_type::now() + idle_timeout;
+  await_deadline();
+  do_read();
+}
+
+void connection::do_read()
+{
+  // Move the start of any partial request to the front of the buffer.
+  if (buffer_begin_ > 0)
+  {
+    std::memmove(buffer_.data(), buffer_.data() + buffer_begin_,
+        buffer_end_ - buffer_begin_);
+    buffer_end_ -= buffer_begin_;
+    buffer_begin_ = 0;
+  }
+
+  deadline_ = asio::steady_timer::clock_type::now() + idle_timeout;
+
+  auto self(shared_from_this());
+  socket_.async_read_some(
+      asio::buffer(buffer_.data() + buffer_end_,
+        buffer_.size() - buffer_end_),
+      [this, self](std::error_code ec, std::size_t bytes_transferred)
+      {
+        if (!ec)
+        {
+          buffer_end_ += bytes_transferred;
+          handle_requests();
+        }
+        else
+        {
+          stop();
+        }
+      });
+}
+
+void connection::handle_requests()
+{
+  for (std::size_t n = 0; n < max_pipelined_requests
+      && output_.size() < max_pending_output && !closing_; ++n)
+  {
+    request_parser::result_type result;
+    const char* request_end;
+    std::tie(result, request_end) = request_parser_.parse(request_,
+        buffer_.data() + buffer_begin_, buffer_.data() + buffer_end_);
+
+    if (result == request_parser::indeterminate)
+    {
+      // A request that does not fit in the buffer is rejected.
+      if (buffer_begin_ > 0 || buffer_end_ < buffer_.size())
+        break;
+      result = request_parser::bad;
+    }
+
+    reply_.clear();
+    if (result == request_parser::good)
+    {
+      request_handler_.handle_request(request_, reply_);
+      buffer_begin_ = request_end - buffer_.data();
+    }
+    else
+    {
+      reply::stock_reply(reply::bad_request, reply_);
+    }
+    request_parser_.reset();
+
+    reply_.append_headers(output_);
+    if (!reply_.omit_content)
+    {
+#if defined(HTTP_SERVER5_HAS_SENDFILE)
+      if (reply_.file != -1)
+      {
+        file_part part = { output_.size(), reply_.file, 0,
+          reply_.content_length };
+        files_.push_back(part);
+        reply_.file = -1;
+      }
+      else
+#endif // defined(HTTP_SERVER5_HAS_SENDFILE)
+      {
+        output_ += reply_.content;
+      }
+    }
+
+    if (!reply_.keep_alive)
+      closing_ = true;
+  }
+
+  if (!output_.empty())
+    do_write();
+  else
+    do_read();
+}
+
+void connection::do_write()
+{
+  deadline_ = asio::steady_timer::clock_type::now() + idle_timeout;
+
+  // Write the output that precedes the next file to be sent.
+  std::size_t output_end = output_.size();
+#if defined(HTTP_SERVER5_HAS_SENDFILE)
+  if (next_file_ < files_.size())
+    output_end = files_[next_file_].position;
+#endif // defined(HTTP_SERVER5_HAS_SENDFILE)
+
+  if (output_written_ < output_end)
+  {
+    auto self(shared_from_this());
+    asio::async_write(socket_,
+        asio::buffer(output_.data() + output_written_,
+          output_end - output_written_),
+        [this, self](std::error_code ec, std::size_t bytes_transferred)
+        {
+          if (!ec)
+          {
+            output_written_ += bytes_transferred;
+            do_write();
+          }
+          else
+          {
+            stop();
+          }
+        });
+    return;
+  }
+
+#if defined(HTTP_SERVER5_HAS_SENDFILE)
+  if (next_file_ < files_.size())
+  {
+    do_sendfile();
+    return;
+  }
+
+  files_.clear();
+  next_file_ = 0;
+#endif // defined(HTTP_SERVER5_HAS_SENDFILE)
+
+  output_.clear();
+  output_written_ = 0;
+
+  if (closing_)
+  {
+    // Initiate graceful connection closure.
+    std::error_code ignored_ec;
+    socket_.shutdown(asio::ip::tcp::socket::shutdown_both, ignored_ec);
+    stop();
+  }
+  else
+  {
+    // Handle any requests that arrived while the replies were written.
+    handle_requests();
+  }
+}
+
+#if defined(HTTP_SERVER5_HAS_SENDFILE)
+void connection::do_sendfile()
+{
+  file_part& part = files_[next_file_];
+  while (part.remaining > 0)
+  {
+    ssize_t n = ::sendfile(socket_.native_handle(),
+        part.file, &part.offset, part.remaining);
+    if (n > 0)
+    {
+      part.remaining -= static_cast<std::size_t>(n);
+    }
+    else if (n == -1 && errno == EINTR)
+    {
+      continue;
+    }
+    else if (n == -1 && (errno == EAGAIN || errno == EWOULDBLOCK))
+    {
+      // Wait until the socket can accept more data.
+      auto self(shared_from_this());
+      socket_.async_wait(asio::ip::tcp::socket::wait_write,
+          [this, self](std::error_code ec)
+          {
+            if (!ec)
+              do_sendfile();
+            else
+              stop();
+          });
+      return;
+    }
+    else
+    {
+      // The file could not be read, or was truncated after its length was
+      // sent, so the reply cannot be completed.
+      stop();
+      return;
+    }
+  }
+
+  ::close(part.file);
+  ++next_file_;
+  do_write();
+}
+#endif // defined(HTTP_SERVER5_HAS_SENDFILE)
+
+void connection::await_deadline()
+{
+  auto self(shared_from_this());
+  timer_.expires_at(deadline_);
+  timer_.async_wait(
+      [this, self](std::error_code /*ec*/)
+      {
+        if (!socket_.is_open())
+          return;
+
+        if (deadline_ <= asio::steady_timer::clock_type::now())
+          stop();
+        else
+          await_deadline();
+      });
+}
+
+void connection::stop()
+{
+  std::error_code ignored_ec;
+  socket_.close(ignored_ec);
+  timer_.cancel();
+}
+
+} // namespace server5
+} // namespace http
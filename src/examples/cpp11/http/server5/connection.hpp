@@ -0,0 +1,135 @@
+//
+// connection.hpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef HTTP_SERVER5_CONNECTION_HPP
+#define HTTP_SERVER5_CONNECTION_HPP
+
+#include <asio.hpp>
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+#include "reply.hpp"
+#include "request.hpp"
+#include "request_handler.hpp"
+#include "request_parser.hpp"
+
+namespace http {
+namespace server5 {
+
+/// Represents a single persistent connection from a client.
+/**
+ * Every request that has been received in full is handled before any replies
+ * are written, and the replies are then sent together, so that a client that
+ * pipelines its requests is served with one read and one write for each
+ * batch. A connection is only used from the thread that runs its io_context,
+ * so no synchronisation is needed.
+ */
+class connection
+  : public std::enable_shared_from_this<connection>
+{
+public:
+  connection(const connection&) = delete;
+  connection& operator=(const connection&) = delete;
+
+  /// Construct a connection with the given socket.
+  explicit connection(asio::ip::tcp::socket socket,
+      const request_handler& handler);
+
+  /// Destructor closes any files that have not been sent.
+  ~connection();
+
+  /// Start the first asynchronous operation for the connection.
+  void start();
+
+private:
+  /// Perform an asynchronous read operation.
+  void do_read();
+
+  /// Handle the complete requests in the buffer, then write the replies.
+  void handle_requests();
+
+  /// Write the replies that are waiting to be sent.
+  void do_write();
+
+#if defined(HTTP_SERVER5_HAS_SENDFILE)
+  /// Send the contents of a file directly from the page cache.
+  void do_sendfile();
+#endif // defined(HTTP_SERVER5_HAS_SENDFILE)
+
+  /// Close the connection if it is idle for too long.
+  void await_deadline();
+
+  /// Close the connection.
+  void stop();
+
+  /// Socket for the connection.
+  asio::ip::tcp::socket socket_;
+
+  /// Timer used to close idle connections.
+  asio::steady_timer timer_;
+
+  /// The time at which the connection is closed if no progress is made.
+  asio::steady_timer::time_point deadline_;
+
+  /// The handler used to process the incoming requests.
+  const request_handler& request_handler_;
+
+  /// Buffer for incoming data.
+  std::array<char, 16384> buffer_;
+
+  /// The start of the data in the buffer that has not been handled.
+  std::size_t buffer_begin_;
+
+  /// The end of the data in the buffer.
+  std::size_t buffer_end_;
+
+  /// The incoming request.
+  request request_;
+
+  /// The parser for the incoming request.
+  request_parser request_parser_;
+
+  /// The reply that is being produced.
+  reply reply_;
+
+  /// The headers and in-memory content of the replies to be sent.
+  std::string output_;
+
+  /// The number of bytes of output that have been written.
+  std::size_t output_written_;
+
+#if defined(HTTP_SERVER5_HAS_SENDFILE)
+  /// A file to be sent once the output preceding it has been written.
+  struct file_part
+  {
+    std::size_t position;
+    int file;
+    off_t offset;
+    std::size_t remaining;
+  };
+
+  /// The files to be sent, in order.
+  std::vector<file_part> files_;
+
+  /// The next file to be sent.
+  std::size_t next_file_;
+#endif // defined(HTTP_SERVER5_HAS_SENDFILE)
+
+  /// Whether the connection is closed once the output has been written.
+  bool closing_;
+};
+
+typedef std::shared_ptr<connection> connection_ptr;
+
+} // namespace server5
+} // namespace http
+
+#endif // HTTP_SERVER5_CONNECTION_HPP
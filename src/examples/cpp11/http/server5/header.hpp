@@ -0,0 +1,57 @@
+//
+// header.hpp
+// ~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef HTTP_SERVER5_HEADER_HPP
+#define HTTP_SERVER5_HEADER_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace http {
+namespace server5 {
+
+/// A reference to characters held in a connection's read buffer. It is only
+/// valid until the connection reads more data.
+struct string_ref
+{
+  const char* data;
+  std::size_t size;
+
+  /// Convert to a string.
+  std::string to_string() const
+  {
+    return std::string(data, size);
+  }
+
+  /// Compare with a lower case string, ignoring the case of this string.
+  bool iequals(const char* lower) const
+  {
+    for (std::size_t i = 0; i < size; ++i, ++lower)
+    {
+      char c = data[i];
+      if (c >= 'A' && c <= 'Z')
+        c = static_cast<char>(c - 'A' + 'a');
+      if (*lower == 0 || c != *lower)
+        return false;
+    }
+    return *lower == 0;
+  }
+};
+
+struct header
+{
+  string_ref name;
+  string_ref value;
+};
+
+} // namespace server5
+} // namespace http
+
+#endif // HTTP_SERVER5_HEADER_HPP
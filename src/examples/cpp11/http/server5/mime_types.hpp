@@ -0,0 +1,27 @@
+//
+// mime_types.hpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef HTTP_SERVER5_MIME_TYPES_HPP
+#define HTTP_SERVER5_MIME_TYPES_HPP
+
+#include <string>
+
+namespace http {
+namespace server5 {
+namespace mime_types {
+
+/// Convert a file extension into a MIME type.
+const char* extension_to_type(const std::string& extension);
+
+} // namespace mime_types
+} // namespace server5
+} // namespace http
+
+#endif // HTTP_SERVER5_MIME_TYPES_HPP
@@ -0,0 +1,158 @@
+//
+// reply.cpp
+// ~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "reply.hpp"
+#include <cstring>
+
+namespace http {
+namespace server5 {
+
+namespace status_strings {
+
+const char ok[] =
+  "HTTP/1.1 200 OK\r\n";
+const char bad_request[] =
+  "HTTP/1.1 400 Bad Request\r\n";
+const char forbidden[] =
+  "HTTP/1.1 403 Forbidden\r\n";
+const char not_found[] =
+  "HTTP/1.1 404 Not Found\r\n";
+const char internal_server_error[] =
+  "HTTP/1.1 500 Internal Server Error\r\n";
+const char not_implemented[] =
+  "HTTP/1.1 501 Not Implemented\r\n";
+
+const char* to_string(reply::status_type status)
+{
+  switch (status)
+  {
+  case reply::ok:
+    return ok;
+  case reply::bad_request:
+    return bad_request;
+  case reply::forbidden:
+    return forbidden;
+  case reply::not_found:
+    return not_found;
+  case reply::internal_server_error:
+    return internal_server_error;
+  case reply::not_implemented:
+    return not_implemented;
+  default:
+    return internal_server_error;
+  }
+}
+
+} // namespace status_strings
+
+namespace misc_strings {
+
+const char content_type[] = "Content-Type: ";
+const char content_length[] = "\r\nContent-Length: ";
+const char keep_alive[] = "\r\nConnection: keep-alive\r\n\r\n";
+const char close[] = "\r\nConnection: close\r\n\r\n";
+
+} // namespace misc_strings
+
+void reply::clear()
+{
+  status = ok;
+  content_type = "text/plain";
+  content.clear();
+  content_length = 0;
+#if defined(HTTP_SERVER5_HAS_SENDFILE)
+  file = -1;
+#endif // defined(HTTP_SERVER5_HAS_SENDFILE)
+  keep_alive = false;
+  omit_content = false;
+}
+
+void reply::append_headers(std::string& out) const
+{
+  // Format the content length without allocating.
+  char length[24];
+  char* length_end = length + sizeof(length);
+  char* p = length_end;
+  std::size_t n = content_length;
+  do
+  {
+    *--p = static_cast<char>('0' + n % 10);
+    n /= 10;
+  } while (n != 0);
+
+  out.append(status_strings::to_string(status));
+  out.append(misc_strings::content_type);
+  out.append(content_type);
+  out.append(misc_strings::content_length);
+  out.append(p, length_end);
+  out.append(keep_alive ? misc_strings::keep_alive : misc_strings::close);
+}
+
+namespace stock_replies {
+
+const char bad_request[] =
+  "<html>"
+  "<head><title>Bad Request</title></head>"
+  "<body><h1>400 Bad Request</h1></body>"
+  "</html>";
+const char forbidden[] =
+  "<html>"
+  "<head><title>Forbidden</title></head>"
+  "<body><h1>403 Forbidden</h1></body>"
+  "</html>";
+const char not_found[] =
+  "<html>"
+  "<head><title>Not Found</title></head>"
+  "<body><h1>404 Not Found</h1></body>"
+  "</html>";
+const char internal_server_error[] =
+  "<html>"
+  "<head><title>Internal Server Error</title></head>"
+  "<body><h1>500 Internal Server Error</h1></body>"
+  "</html>";
+const char not_implemented[] =
+  "<html>"
+  "<head><title>Not Implemented</title></head>"
+  "<body><h1>501 Not Implemented</h1></body>"
+  "</html>";
+
+const char* to_string(reply::status_type status)
+{
+  switch (status)
+  {
+  case reply::ok:
+    return "";
+  case reply::bad_request:
+    return bad_request;
+  case reply::forbidden:
+    return forbidden;
+  case reply::not_found:
+    return not_found;
+  case reply::internal_server_error:
+    return internal_server_error;
+  case reply::not_implemented:
+    return not_implemented;
+  default:
+    return internal_server_error;
+  }
+}
+
+} // namespace stock_replies
+
+void reply::stock_reply(reply::status_type status, reply& rep)
+{
+  rep.status = status;
+  rep.content_type = "text/html";
+  rep.content.assign(stock_replies::to_string(status));
+  rep.content_length = rep.content.size();
+}
+
+} // namespace server5
+} // namespace http
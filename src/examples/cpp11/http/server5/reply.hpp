@@ -0,0 +1,71 @@
+//
+// reply.hpp
+// ~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef HTTP_SERVER5_REPLY_HPP
+#define HTTP_SERVER5_REPLY_HPP
+
+#include <cstddef>
+#include <string>
+
+#if defined(__linux__)
+# define HTTP_SERVER5_HAS_SENDFILE 1
+#endif // defined(__linux__)
+
+namespace http {
+namespace server5 {
+
+/// A reply to be sent to a client.
+struct reply
+{
+  /// The status of the reply.
+  enum status_type
+  {
+    ok = 200,
+    bad_request = 400,
+    forbidden = 403,
+    not_found = 404,
+    internal_server_error = 500,
+    not_implemented = 501
+  } status;
+
+  /// The MIME type of the content.
+  const char* content_type;
+
+  /// The content to be sent in the reply, unless it is sent from a file.
+  std::string content;
+
+  /// The length of the content.
+  std::size_t content_length;
+
+#if defined(HTTP_SERVER5_HAS_SENDFILE)
+  /// An open file whose contents are sent in the reply using sendfile, or -1.
+  int file;
+#endif // defined(HTTP_SERVER5_HAS_SENDFILE)
+
+  /// Whether the connection remains open after the reply has been sent.
+  bool keep_alive;
+
+  /// Whether the content is left out of the reply, as for a HEAD request.
+  bool omit_content;
+
+  /// Reset the reply, keeping the memory allocated for the content.
+  void clear();
+
+  /// Append the status line and headers to a buffer.
+  void append_headers(std::string& out) const;
+
+  /// Fill in a stock reply.
+  static void stock_reply(status_type status, reply& rep);
+};
+
+} // namespace server5
+} // namespace http
+
+#endif // HTTP_SERVER5_REPLY_HPP
@@ -0,0 +1,44 @@
+//
+// request.hpp
+// ~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef HTTP_SERVER5_REQUEST_HPP
+#define HTTP_SERVER5_REQUEST_HPP
+
+#include <cstddef>
+#include "header.hpp"
+
+namespace http {
+namespace server5 {
+
+/// A request received from a client. The method, URI and headers refer
+/// directly to the connection's read buffer.
+struct request
+{
+  /// The maximum number of headers in a request.
+  enum { max_headers = 32 };
+
+  string_ref method;
+  string_ref uri;
+  int http_version_major;
+  int http_version_minor;
+  header headers[max_headers];
+  std::size_t num_headers;
+
+  /// Whether the client wants the connection to remain open.
+  bool keep_alive;
+
+  /// Whether the request is followed by a body.
+  bool has_body;
+};
+
+} // namespace server5
+} // namespace http
+
+#endif // HTTP_SERVER5_REQUEST_HPP
@@ -0,0 +1,175 @@
+//
+// request_handler.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "request_handler.hpp"
+#include <cstring>
+#include <string>
+#include "mime_types.hpp"
+#include "reply.hpp"
+#include "request.hpp"
+
+#if defined(HTTP_SERVER5_HAS_SENDFILE)
+# include <fcntl.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#else // defined(HTTP_SERVER5_HAS_SENDFILE)
+# include <fstream>
+#endif // defined(HTTP_SERVER5_HAS_SENDFILE)
+
+namespace http {
+namespace server5 {
+
+request_handler::request_handler(const std::string& doc_root)
+  : doc_root_(doc_root)
+{
+}
+
+void request_handler::handle_request(const request& req, reply& rep) const
+{
+  // The connection is only kept open if the request has no body, as bodies
+  // are not read.
+  rep.keep_alive = req.keep_alive && !req.has_body;
+
+  bool head = req.method.size == 4
+    && std::memcmp(req.method.data, "HEAD", 4) == 0;
+  bool get = req.method.size == 3
+    && std::memcmp(req.method.data, "GET", 3) == 0;
+  rep.omit_content = head;
+  if (!get && !head)
+  {
+    reply::stock_reply(reply::not_implemented, rep);
+    return;
+  }
+
+  // Decode url to path, ignoring any query.
+  string_ref path = req.uri;
+  if (const void* query = std::memchr(path.data, '?', path.size))
+    path.size = static_cast<const char*>(query) - path.data;
+  std::string request_path;
+  if (!url_decode(path, request_path))
+  {
+    reply::stock_reply(reply::bad_request, rep);
+    return;
+  }
+
+  // Request path must be absolute and not contain "..".
+  if (request_path.empty() || request_path[0] != '/'
+      || request_path.find("..") != std::string::npos)
+  {
+    reply::stock_reply(reply::bad_request, rep);
+    return;
+  }
+
+  // If path ends in slash (i.e. is a directory) then add "index.html".
+  if (request_path[request_path.size() - 1] == '/')
+  {
+    request_path += "index.html";
+  }
+
+  // Determine the file extension.
+  std::size_t last_slash_pos = request_path.find_last_of("/");
+  std::size_t last_dot_pos = request_path.find_last_of(".");
+  std::string extension;
+  if (last_dot_pos != std::string::npos && last_dot_pos > last_slash_pos)
+  {
+    extension = request_path.substr(last_dot_pos + 1);
+  }
+
+  std::string full_path = doc_root_ + request_path;
+
+#if defined(HTTP_SERVER5_HAS_SENDFILE)
+  // Open the file, which the connection sends using sendfile.
+  int fd = ::open(full_path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1)
+  {
+    reply::stock_reply(reply::not_found, rep);
+    return;
+  }
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+  {
+    ::close(fd);
+    reply::stock_reply(reply::not_found, rep);
+    return;
+  }
+
+  rep.content_length = static_cast<std::size_t>(st.st_size);
+  if (head)
+    ::close(fd);
+  else
+    rep.file = fd;
+#else // defined(HTTP_SERVER5_HAS_SENDFILE)
+  // Read the file to send back.
+  std::ifstream is(full_path.c_str(), std::ios::in | std::ios::binary);
+  if (!is)
+  {
+    reply::stock_reply(reply::not_found, rep);
+    return;
+  }
+
+  char buf[4096];
+  while (is.read(buf, sizeof(buf)).gcount() > 0)
+    rep.content.append(buf, is.gcount());
+  rep.content_length = rep.content.size();
+#endif // defined(HTTP_SERVER5_HAS_SENDFILE)
+
+  rep.status = reply::ok;
+  rep.content_type = mime_types::extension_to_type(extension);
+}
+
+bool request_handler::url_decode(const string_ref& in, std::string& out)
+{
+  out.clear();
+  out.reserve(in.size);
+  for (std::size_t i = 0; i < in.size; ++i)
+  {
+    if (in.data[i] == '%')
+    {
+      if (i + 3 > in.size)
+      {
+        return false;
+      }
+
+      int value = 0;
+      for (std::size_t j = i + 1; j < i + 3; ++j)
+      {
+        char c = in.data[j];
+        value *= 16;
+        if (c >= '0' && c <= '9')
+          value += c - '0';
+        else if (c >= 'a' && c <= 'f')
+          value += c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F')
+          value += c - 'A' + 10;
+        else
+          return false;
+      }
+      if (value == 0)
+      {
+        return false;
+      }
+      out += static_cast<char>(value);
+      i += 2;
+    }
+    else if (in.data[i] == '+')
+    {
+      out += ' ';
+    }
+    else
+    {
+      out += in.data[i];
+    }
+  }
+  return true;
+}
+
+} // namespace server5
+} // namespace http
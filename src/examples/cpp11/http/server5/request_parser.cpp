@@ -0,0 +1,308 @@
+//
+// request_parser.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "request_parser.hpp"
+#include <cstring>
+#include "request.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) \
+  || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+# include <emmintrin.h>
+# define HTTP_SERVER5_USE_SSE2 1
+# if defined(_MSC_VER)
+#  include <intrin.h>
+# endif // defined(_MSC_VER)
+#endif
+
+namespace http {
+namespace server5 {
+
+namespace {
+
+/// Check if a byte is a control character that may not appear in a request's
+/// headers. Horizontal tab, CR and LF are permitted.
+bool is_invalid(unsigned char c)
+{
+  return (c < 0x20 && c != '\t' && c != '\r' && c != '\n') || c == 0x7F;
+}
+
+/// Check if a byte may appear in a token, such as a method or header name.
+bool is_token_char(unsigned char c)
+{
+  if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+      || (c >= '0' && c <= '9'))
+    return true;
+  return c != 0 && std::strchr("!#$%&'*+-.^_`|~", c) != 0;
+}
+
+/// Check if a byte is a digit.
+bool is_digit(unsigned char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+/// Check for the blank line that ends the headers.
+bool is_headers_end(const char* p)
+{
+  return p[0] == '\r' && p[1] == '\n' && p[2] == '\r' && p[3] == '\n';
+}
+
+#if defined(HTTP_SERVER5_USE_SSE2)
+/// Get the index of the lowest set bit in a non-zero mask.
+int lowest_bit(unsigned int mask)
+{
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return static_cast<int>(index);
+#elif defined(__GNUC__)
+  return __builtin_ctz(mask);
+#else
+  int index = 0;
+  while ((mask & 1) == 0)
+  {
+    mask >>= 1;
+    ++index;
+  }
+  return index;
+#endif
+}
+#endif // defined(HTTP_SERVER5_USE_SSE2)
+
+/// Skip spaces and tabs.
+const char* skip_whitespace(const char* p, const char* end)
+{
+  while (p != end && (*p == ' ' || *p == '\t'))
+    ++p;
+  return p;
+}
+
+} // namespace
+
+request_parser::request_parser()
+  : scanned_(0)
+{
+}
+
+void request_parser::reset()
+{
+  scanned_ = 0;
+}
+
+std::tuple<request_parser::result_type, const char*> request_parser::parse(
+    request& req, const char* begin, const char* end)
+{
+  const char* headers_end = end;
+  result_type result = find_headers_end(begin, end, headers_end);
+  if (result == good && !parse_request(req, begin, headers_end))
+    result = bad;
+  return std::make_tuple(result, headers_end);
+}
+
+request_parser::result_type request_parser::find_headers_end(
+    const char* begin, const char* end, const char*& headers_end)
+{
+  const char* p = begin + scanned_;
+
+#if defined(HTTP_SERVER5_USE_SSE2)
+  const __m128i cr = _mm_set1_epi8('\r');
+  const __m128i lf = _mm_set1_epi8('\n');
+  const __m128i tab = _mm_set1_epi8('\t');
+  const __m128i del = _mm_set1_epi8(0x7F);
+  const __m128i max_ctl = _mm_set1_epi8(0x1F);
+
+  while (end - p >= 16)
+  {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i is_cr = _mm_cmpeq_epi8(v, cr);
+
+    // Find the control characters, other than HT, CR and LF.
+    __m128i is_ctl = _mm_or_si128(
+        _mm_cmpeq_epi8(_mm_min_epu8(v, max_ctl), v),
+        _mm_cmpeq_epi8(v, del));
+    __m128i is_allowed = _mm_or_si128(is_cr,
+        _mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, tab)));
+    unsigned int invalid = static_cast<unsigned int>(
+        _mm_movemask_epi8(_mm_andnot_si128(is_allowed, is_ctl)));
+    unsigned int crs = static_cast<unsigned int>(_mm_movemask_epi8(is_cr));
+
+    // Only a CR that precedes the first invalid byte can end the headers.
+    if (invalid)
+      crs &= (invalid & (0u - invalid)) - 1;
+
+    while (crs)
+    {
+      const char* q = p + lowest_bit(crs);
+      if (end - q < 4)
+      {
+        scanned_ = q - begin;
+        return indeterminate;
+      }
+      if (is_headers_end(q))
+      {
+        headers_end = q + 4;
+        return good;
+      }
+      crs &= crs - 1;
+    }
+
+    if (invalid)
+      return bad;
+
+    p += 16;
+  }
+#endif // defined(HTTP_SERVER5_USE_SSE2)
+
+  for (; p != end; ++p)
+  {
+    if (*p == '\r')
+    {
+      if (end - p < 4)
+      {
+        scanned_ = p - begin;
+        return indeterminate;
+      }
+      if (is_headers_end(p))
+      {
+        headers_end = p + 4;
+        return good;
+      }
+    }
+    else if (is_invalid(static_cast<unsigned char>(*p)))
+    {
+      return bad;
+    }
+  }
+
+  scanned_ = p - begin;
+  return indeterminate;
+}
+
+bool request_parser::parse_request(request& req,
+    const char* begin, const char* end)
+{
+  // The headers end with a blank line, so every line ends with a CR.
+  const char* line_end = static_cast<const char*>(
+      std::memchr(begin, '\r', end - begin));
+  if (line_end[1] != '\n' || std::memchr(begin, '\n', line_end - begin))
+    return false;
+
+  // Request method.
+  const char* p = begin;
+  while (p != line_end && is_token_char(static_cast<unsigned char>(*p)))
+    ++p;
+  if (p == begin || p == line_end || *p != ' ')
+    return false;
+  req.method.data = begin;
+  req.method.size = p - begin;
+
+  // Request URI.
+  const char* uri = p + 1;
+  p = static_cast<const char*>(std::memchr(uri, ' ', line_end - uri));
+  if (p == 0 || p == uri)
+    return false;
+  req.uri.data = uri;
+  req.uri.size = p - uri;
+
+  // HTTP version.
+  ++p;
+  if (line_end - p != 8 || std::memcmp(p, "HTTP/", 5) != 0
+      || !is_digit(static_cast<unsigned char>(p[5])) || p[6] != '.'
+      || !is_digit(static_cast<unsigned char>(p[7])))
+    return false;
+  req.http_version_major = p[5] - '0';
+  req.http_version_minor = p[7] - '0';
+
+  // Headers.
+  req.num_headers = 0;
+  for (p = line_end + 2; p != end - 2; p = line_end + 2)
+  {
+    line_end = static_cast<const char*>(std::memchr(p, '\r', end - p));
+    if (line_end[1] != '\n' || std::memchr(p, '\n', line_end - p))
+      return false;
+
+    const char* name = p;
+    while (p != line_end && is_token_char(static_cast<unsigned char>(*p)))
+      ++p;
+    if (p == name || p == line_end || *p != ':')
+      return false;
+
+    const char* value = skip_whitespace(p + 1, line_end);
+    const char* value_end = line_end;
+    while (value_end != value
+        && (value_end[-1] == ' ' || value_end[-1] == '\t'))
+      --value_end;
+
+    if (req.num_headers == request::max_headers)
+      return false;
+    header& h = req.headers[req.num_headers++];
+    h.name.data = name;
+    h.name.size = p - name;
+    h.value.data = value;
+    h.value.size = value_end - value;
+  }
+
+  return parse_connection_headers(req);
+}
+
+bool request_parser::parse_connection_headers(request& req)
+{
+  req.keep_alive = req.http_version_major > 1
+    || (req.http_version_major == 1 && req.http_version_minor >= 1);
+  req.has_body = false;
+
+  for (std::size_t i = 0; i < req.num_headers; ++i)
+  {
+    const header& h = req.headers[i];
+    if (h.name.iequals("connection"))
+    {
+      // The value is a comma separated list of options.
+      const char* p = h.value.data;
+      const char* end = p + h.value.size;
+      while (p != end)
+      {
+        p = skip_whitespace(p, end);
+        const char* option_end = p;
+        while (option_end != end && *option_end != ',')
+          ++option_end;
+        string_ref option = { p, static_cast<std::size_t>(option_end - p) };
+        while (option.size > 0 && (option.data[option.size - 1] == ' '
+              || option.data[option.size - 1] == '\t'))
+          --option.size;
+        if (option.iequals("close"))
+          req.keep_alive = false;
+        else if (option.iequals("keep-alive"))
+          req.keep_alive = true;
+        p = option_end == end ? end : option_end + 1;
+      }
+    }
+    else if (h.name.iequals("content-length"))
+    {
+      if (h.value.size == 0)
+        return false;
+      for (std::size_t j = 0; j < h.value.size; ++j)
+      {
+        if (!is_digit(static_cast<unsigned char>(h.value.data[j])))
+          return false;
+        if (h.value.data[j] != '0')
+          req.has_body = true;
+      }
+    }
+    else if (h.name.iequals("transfer-encoding"))
+    {
+      req.has_body = true;
+    }
+  }
+
+  return true;
+}
+
+} // namespace server5
+} // namespace http
@@ -0,0 +1,72 @@
+//
+// request_parser.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef HTTP_SERVER5_REQUEST_PARSER_HPP
+#define HTTP_SERVER5_REQUEST_PARSER_HPP
+
+#include <cstddef>
+#include <tuple>
+
+namespace http {
+namespace server5 {
+
+struct request;
+
+/// Incremental parser for incoming requests.
+/**
+ * Rather than consuming a byte at a time, the parser scans for the blank line
+ * that ends a request's headers, using SSE2 where available to examine 16
+ * bytes per step and to reject control characters in the same pass. The
+ * position reached is remembered, so that the bytes of a partial request are
+ * examined only once however many reads it takes to arrive. Once the headers
+ * are complete, the request is split into fields that refer to the input.
+ */
+class request_parser
+{
+public:
+  /// Construct ready to parse a request.
+  request_parser();
+
+  /// Reset to initial parser state.
+  void reset();
+
+  /// Result of parse.
+  enum result_type { good, bad, indeterminate };
+
+  /// Parse the request at the start of the data. The enum return value is
+  /// good when a complete request has been parsed, bad if the data is
+  /// invalid, indeterminate when more data is required. The pointer return
+  /// value indicates the end of the request when the result is good. Until
+  /// reset() is called, each call must pass the data of the same request,
+  /// which may have been moved, extended with newly received data.
+  std::tuple<result_type, const char*> parse(request& req,
+      const char* begin, const char* end);
+
+private:
+  /// Find the end of the request's headers.
+  result_type find_headers_end(const char* begin, const char* end,
+      const char*& headers_end);
+
+  /// Split a complete request into its fields.
+  static bool parse_request(request& req,
+      const char* begin, const char* end);
+
+  /// Interpret the headers that affect the connection.
+  static bool parse_connection_headers(request& req);
+
+  /// The number of bytes that have been scanned without finding the end of
+  /// the headers.
+  std::size_t scanned_;
+};
+
+} // namespace server5
+} // namespace http
+
+#endif // HTTP_SERVER5_REQUEST_PARSER_HPP
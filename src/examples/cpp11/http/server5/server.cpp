@@ -0,0 +1,215 @@
+//
+// server.cpp
+// ~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "server.hpp"
+#include <signal.h>
+#include <thread>
+#include <utility>
+#include "connection.hpp"
+
+namespace http {
+namespace server5 {
+
+namespace {
+
+#if defined(SO_REUSEPORT)
+/// Socket option allowing several sockets to listen on the same port.
+class reuse_port
+{
+public:
+  explicit reuse_port(bool value) : value_(value ? 1 : 0) {}
+
+  template <typename Protocol>
+  int level(const Protocol&) const { return SOL_SOCKET; }
+
+  template <typename Protocol>
+  int name(const Protocol&) const { return SO_REUSEPORT; }
+
+  template <typename Protocol>
+  const int* data(const Protocol&) const { return &value_; }
+
+  template <typename Protocol>
+  std::size_t size(const Protocol&) const { return sizeof(value_); }
+
+private:
+  int value_;
+};
+#endif // defined(SO_REUSEPORT)
+
+} // namespace
+
+server::worker::worker()
+  : io_context(1),
+    acceptor(io_context),
+    work(asio::make_work_guard(io_context))
+{
+}
+
+server::server(const std::string& address, const std::string& port,
+    const std::string& doc_root, std::size_t num_threads)
+  : workers_(make_workers(num_threads)),
+    signals_(workers_[0]->io_context),
+    next_worker_(0),
+    request_handler_(doc_root)
+{
+  // Register to handle the signals that indicate when the server should exit.
+  // It is safe to register for the same signal multiple times in a program,
+  // provided all registration for the specified signal is made through Asio.
+  signals_.add(SIGINT);
+  signals_.add(SIGTERM);
+#if defined(SIGQUIT)
+  signals_.add(SIGQUIT);
+#endif // defined(SIGQUIT)
+
+  do_await_stop();
+
+#if defined(HTTP_SERVER5_HAS_SENDFILE)
+  // Unlike the socket's own send operations, sendfile cannot be told not to
+  // raise SIGPIPE when the peer has closed the connection.
+  ::signal(SIGPIPE, SIG_IGN);
+#endif // defined(HTTP_SERVER5_HAS_SENDFILE)
+
+  // Open the first acceptor with the option to reuse the address (i.e.
+  // SO_REUSEADDR) and, where possible, the port.
+  asio::ip::tcp::acceptor& first = workers_[0]->acceptor;
+  asio::ip::tcp::resolver resolver(first.get_executor());
+  asio::ip::tcp::endpoint endpoint =
+    *resolver.resolve(address, port).begin();
+  first.open(endpoint.protocol());
+  first.set_option(asio::ip::tcp::acceptor::reuse_address(true));
+  bool use_reuse_port = false;
+#if defined(SO_REUSEPORT)
+  std::error_code ec;
+  first.set_option(reuse_port(true), ec);
+  use_reuse_port = !ec && workers_.size() > 1;
+#endif // defined(SO_REUSEPORT)
+  first.bind(endpoint);
+  first.listen();
+
+  if (use_reuse_port)
+  {
+#if defined(SO_REUSEPORT)
+    // Bind the other acceptors to the port actually chosen for the first.
+    endpoint = first.local_endpoint();
+    for (std::size_t i = 1; i < workers_.size(); ++i)
+    {
+      asio::ip::tcp::acceptor& acceptor = workers_[i]->acceptor;
+      acceptor.open(endpoint.protocol());
+      acceptor.set_option(asio::ip::tcp::acceptor::reuse_address(true));
+      acceptor.set_option(reuse_port(true));
+      acceptor.bind(endpoint);
+      acceptor.listen();
+    }
+#endif // defined(SO_REUSEPORT)
+
+    for (std::size_t i = 0; i < workers_.size(); ++i)
+      do_accept(*workers_[i]);
+  }
+  else
+  {
+    do_accept_round_robin();
+  }
+}
+
+void server::run()
+{
+  // Create threads to run the io_contexts of all but the first worker, which
+  // is run by the calling thread.
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < workers_.size(); ++i)
+  {
+    asio::io_context& io_context = workers_[i]->io_context;
+    threads.emplace_back([&io_context]{ io_context.run(); });
+  }
+
+  workers_[0]->io_context.run();
+
+  // Wait for all threads in the pool to exit.
+  for (std::size_t i = 0; i < threads.size(); ++i)
+    threads[i].join();
+}
+
+std::vector<std::unique_ptr<server::worker>> server::make_workers(
+    std::size_t num_threads)
+{
+  if (num_threads == 0)
+    num_threads = 1;
+
+  std::vector<std::unique_ptr<worker>> workers;
+  for (std::size_t i = 0; i < num_threads; ++i)
+    workers.emplace_back(new worker);
+  return workers;
+}
+
+void server::do_accept(worker& w)
+{
+  w.acceptor.async_accept(
+      [this, &w](std::error_code ec, asio::ip::tcp::socket socket)
+      {
+        // Check whether the server was stopped by a signal before this
+        // completion handler had a chance to run.
+        if (!w.acceptor.is_open())
+        {
+          return;
+        }
+
+        if (!ec)
+        {
+          std::make_shared<connection>(
+              std::move(socket), request_handler_)->start();
+        }
+
+        do_accept(w);
+      });
+}
+
+void server::do_accept_round_robin()
+{
+  worker& target = *workers_[next_worker_];
+  if (++next_worker_ == workers_.size())
+    next_worker_ = 0;
+
+  asio::ip::tcp::acceptor& acceptor = workers_[0]->acceptor;
+  acceptor.async_accept(target.io_context,
+      [this, &acceptor, &target](std::error_code ec,
+        asio::ip::tcp::socket socket)
+      {
+        // Check whether the server was stopped by a signal before this
+        // completion handler had a chance to run.
+        if (!acceptor.is_open())
+        {
+          return;
+        }
+
+        if (!ec)
+        {
+          // Start the connection on the thread that owns its socket.
+          std::shared_ptr<connection> new_connection =
+            std::make_shared<connection>(std::move(socket), request_handler_);
+          asio::post(target.io_context,
+              [new_connection]{ new_connection->start(); });
+        }
+
+        do_accept_round_robin();
+      });
+}
+
+void server::do_await_stop()
+{
+  signals_.async_wait(
+      [this](std::error_code /*ec*/, int /*signo*/)
+      {
+        for (std::size_t i = 0; i < workers_.size(); ++i)
+          workers_[i]->io_context.stop();
+      });
+}
+
+} // namespace server5
+} // namespace http
@@ -0,0 +1,91 @@
+//
+// server.hpp
+// ~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef HTTP_SERVER5_SERVER_HPP
+#define HTTP_SERVER5_SERVER_HPP
+
+#include <asio.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include "request_handler.hpp"
+
+namespace http {
+namespace server5 {
+
+/// The top-level class of the HTTP server.
+/**
+ * Each thread runs its own io_context, created with a concurrency hint of 1
+ * so that it does no locking, and every connection is kept on the thread that
+ * accepted it. Where the platform supports SO_REUSEPORT, each thread also has
+ * its own listening socket and the kernel spreads incoming connections across
+ * them. Otherwise a single acceptor hands connections to the threads in turn.
+ */
+class server
+{
+public:
+  server(const server&) = delete;
+  server& operator=(const server&) = delete;
+
+  /// Construct the server to listen on the specified TCP address and port, and
+  /// serve up files from the given directory.
+  explicit server(const std::string& address, const std::string& port,
+      const std::string& doc_root, std::size_t num_threads);
+
+  /// Run the server's io_context loops, one per thread.
+  void run();
+
+private:
+  /// The state owned by a single thread.
+  struct worker
+  {
+    worker();
+
+    /// The io_context run by the thread.
+    asio::io_context io_context;
+
+    /// The thread's own acceptor, when SO_REUSEPORT is used.
+    asio::ip::tcp::acceptor acceptor;
+
+    /// Keeps the io_context running while there is no work.
+    asio::executor_work_guard<asio::io_context::executor_type> work;
+  };
+
+  /// Create the per-thread state.
+  static std::vector<std::unique_ptr<worker>> make_workers(
+      std::size_t num_threads);
+
+  /// Perform an asynchronous accept operation on a thread's own acceptor.
+  void do_accept(worker& w);
+
+  /// Perform an asynchronous accept operation on the shared acceptor,
+  /// handing the connection to the next thread.
+  void do_accept_round_robin();
+
+  /// Wait for a request to stop the server.
+  void do_await_stop();
+
+  /// The per-thread state. The first worker is run by the calling thread.
+  std::vector<std::unique_ptr<worker>> workers_;
+
+  /// The signal_set is used to register for process termination notifications.
+  asio::signal_set signals_;
+
+  /// The thread to be given the next connection by the shared acceptor.
+  std::size_t next_worker_;
+
+  /// The handler for all incoming requests.
+  request_handler request_handler_;
+};
+
+} // namespace server5
+} // namespace http
+
+#endif // HTTP_SERVER5_SERVER_HPP
@@ -0,0 +1,97 @@
+//
+// probe.cpp
+// ~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <asio.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "probe_engine.hpp"
+
+using asio::ip::icmp;
+namespace chrono = std::chrono;
+
+int main(int argc, char* argv[])
+{
+  try
+  {
+    if (argc < 4)
+    {
+      std::cerr << "Usage: probe <probes_per_second> <timeout_ms> <host>...\n";
+      std::cerr << "  A host of - reads IPv4 addresses from standard input.\n";
+      std::cerr << "  A rate of 0 sends as quickly as replies allow.\n";
+#if !defined(ASIO_WINDOWS)
+      std::cerr << "(You may need to run this program as root, or add your\n"
+        " group to the net.ipv4.ping_group_range sysctl.)\n";
+#endif
+      return 1;
+    }
+
+    asio::io_context io_context;
+
+    probe_engine::options opts;
+    opts.probes_per_second = std::atoi(argv[1]);
+    opts.timeout = chrono::milliseconds(std::atoi(argv[2]));
+
+    // Resolve the targets before any are sent.
+    std::vector<asio::ip::address_v4> targets;
+    icmp::resolver resolver(io_context);
+    for (int i = 3; i < argc; ++i)
+    {
+      if (std::string(argv[i]) == "-")
+      {
+        std::string line;
+        while (std::getline(std::cin, line))
+          if (!line.empty())
+            targets.push_back(asio::ip::make_address_v4(line));
+      }
+      else
+      {
+        icmp::endpoint endpoint =
+          *resolver.resolve(icmp::v4(), argv[i], "").begin();
+        targets.push_back(endpoint.address().to_v4());
+      }
+    }
+
+    std::size_t remaining = targets.size();
+    probe_engine engine(io_context, opts,
+        [&](const asio::ip::address_v4& target,
+          const std::error_code& ec, chrono::steady_clock::duration rtt)
+        {
+          std::cout << target << ": ";
+          if (ec)
+            std::cout << ec.message() << "\n";
+          else
+            std::cout << "time="
+              << chrono::duration_cast<chrono::microseconds>(rtt).count()
+              << "us\n";
+
+          if (--remaining == 0)
+            io_context.stop();
+        });
+
+    std::cout << "Probing " << targets.size() << " hosts using a "
+      << (engine.uses_datagram_socket() ? "datagram" : "raw")
+      << " socket\n";
+
+    for (std::size_t i = 0; i < targets.size(); ++i)
+      engine.probe(targets[i]);
+
+    if (!targets.empty())
+      io_context.run();
+
+    std::cout << engine.histogram();
+  }
+  catch (std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+  }
+}
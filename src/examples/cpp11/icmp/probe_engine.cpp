@@ -0,0 +1,494 @@
+//
+// probe_engine.cpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "probe_engine.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+
+#include "icmp_header.hpp"
+
+#if defined(__linux__)
+# include <netinet/in.h>
+# include <sys/socket.h>
+# include <unistd.h>
+#endif // defined(__linux__)
+
+using asio::ip::icmp;
+namespace chrono = std::chrono;
+
+//----------------------------------------------------------------------
+
+rtt_histogram::rtt_histogram()
+  : count_(0),
+    timeouts_(0),
+    min_(0),
+    max_(0),
+    sum_(0)
+{
+  buckets_.fill(0);
+}
+
+void rtt_histogram::record(duration rtt)
+{
+  std::uint64_t us = static_cast<std::uint64_t>(std::max<std::int64_t>(0,
+        chrono::duration_cast<chrono::microseconds>(rtt).count()));
+
+  // Bucket b holds times in [2^b, 2^(b+1)) microseconds.
+  std::size_t b = 0;
+  for (std::uint64_t v = us >> 1; v != 0 && b + 1 < num_buckets; v >>= 1)
+    ++b;
+
+  ++buckets_[b];
+  min_ = count_ ? std::min(min_, us) : us;
+  max_ = std::max(max_, us);
+  sum_ += us;
+  ++count_;
+}
+
+std::uint64_t rtt_histogram::percentile(double p) const
+{
+  std::size_t target = static_cast<std::size_t>(p / 100.0 * count_ + 0.5);
+  target = std::max<std::size_t>(target, 1);
+  std::size_t seen = 0;
+  for (std::size_t b = 0; b < num_buckets; ++b)
+  {
+    seen += buckets_[b];
+    if (seen >= target)
+      return std::min<std::uint64_t>((std::uint64_t(2) << b) - 1, max_);
+  }
+  return max_;
+}
+
+std::ostream& operator<<(std::ostream& os, const rtt_histogram& h)
+{
+  for (std::size_t b = 0; b < rtt_histogram::num_buckets; ++b)
+  {
+    if (h.buckets_[b] != 0)
+    {
+      os << std::setw(10) << (b == 0 ? 0 : std::uint64_t(1) << b)
+        << " - " << std::setw(10) << (std::uint64_t(2) << b) - 1
+        << " us: " << h.buckets_[b] << "\n";
+    }
+  }
+
+  os << "replies: " << h.count() << ", timeouts: " << h.timeouts() << "\n";
+  if (h.count() != 0)
+  {
+    os << "min/mean/max: " << h.min_rtt() << "/" << h.mean_rtt()
+      << "/" << h.max_rtt() << " us, p50/p90/p99 <= "
+      << h.percentile(50) << "/" << h.percentile(90)
+      << "/" << h.percentile(99) << " us\n";
+  }
+  return os;
+}
+
+//----------------------------------------------------------------------
+
+namespace {
+
+// The body sent with each echo request.
+const char request_body[] = "asio probe engine";
+
+std::size_t round_up_to_power_of_two(std::uint64_t n)
+{
+  std::size_t size = 1;
+  while (size < n)
+    size <<= 1;
+  return size;
+}
+
+} // namespace
+
+probe_engine::options::options()
+  : max_in_flight(4096),
+    probes_per_second(0),
+    timeout(chrono::seconds(1)),
+    tick(chrono::milliseconds(10)),
+    prefer_datagram(true)
+{
+}
+
+probe_engine::probe_engine(asio::io_context& io_context,
+    const options& opts, handler_type handler)
+  : io_context_(io_context),
+    options_(opts),
+    handler_(std::move(handler)),
+    socket_(io_context),
+    datagram_(false),
+    identifier_(0),
+    next_sequence_(0),
+    table_mask_(0),
+    wheel_mask_(0),
+    timeout_ticks_(0),
+    current_tick_(0),
+    start_(clock_type::now()),
+    timer_(io_context),
+    timer_pending_(false),
+    credit_(1.0),
+    credit_time_(start_),
+    send_pending_(false)
+{
+  // Half of the sequence numbers are left free, so that a new request need
+  // not search far for a sequence number that is not in use.
+  options_.max_in_flight = std::min<std::size_t>(
+      std::max<std::size_t>(options_.max_in_flight, 1), 32768);
+  if (options_.tick <= clock_type::duration::zero())
+    options_.tick = chrono::milliseconds(10);
+
+  requests_.resize(options_.max_in_flight);
+  for (std::size_t i = requests_.size(); i > 0; --i)
+  {
+    requests_[i - 1].generation = 0;
+    free_.push_back(static_cast<std::uint32_t>(i - 1));
+  }
+
+  // Keep the hash table no more than half full.
+  table_entry empty = { 0, no_request };
+  table_.resize(round_up_to_power_of_two(2 * options_.max_in_flight), empty);
+  table_mask_ = table_.size() - 1;
+
+  // A request sent during tick k times out at the end of tick k plus the
+  // timeout, so the wheel must be larger than the timeout in ticks.
+  timeout_ticks_ = static_cast<std::uint64_t>(
+      (options_.timeout + options_.tick - clock_type::duration(1))
+        / options_.tick) + 1;
+  wheel_.resize(round_up_to_power_of_two(timeout_ticks_ + 1));
+  wheel_mask_ = wheel_.size() - 1;
+
+  open_socket();
+  start_receive();
+}
+
+void probe_engine::probe(const asio::ip::address_v4& target)
+{
+  queue_.push_back(target);
+
+  // Send from a fresh call stack, so that this may be called from within the
+  // handler, and so that targets queued together are sent together.
+  if (!send_pending_)
+  {
+    send_pending_ = true;
+    asio::post(io_context_,
+        [this]
+        {
+          send_pending_ = false;
+          send_queued();
+        });
+  }
+}
+
+void probe_engine::open_socket()
+{
+#if defined(__linux__)
+  // A datagram ICMP socket needs no privileges when the user's group is in
+  // net.ipv4.ping_group_range. The kernel chooses the identifier, and passes
+  // up only the replies that carry it.
+  if (options_.prefer_datagram)
+  {
+    int fd = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_ICMP);
+    if (fd != -1)
+    {
+      std::error_code ec;
+      socket_.assign(icmp::v4(), fd, ec);
+      if (!ec)
+        socket_.bind(icmp::endpoint(icmp::v4(), 0), ec);
+      if (!ec)
+      {
+        identifier_ = socket_.local_endpoint().port();
+        datagram_ = true;
+      }
+      else if (socket_.is_open())
+        socket_.close(ec);
+      else
+        ::close(fd);
+    }
+  }
+#endif // defined(__linux__)
+
+  if (!datagram_)
+  {
+    socket_.open(icmp::v4());
+#if defined(ASIO_WINDOWS)
+    identifier_ = static_cast<std::uint16_t>(::GetCurrentProcessId());
+#else
+    identifier_ = static_cast<std::uint16_t>(::getpid());
+#endif
+  }
+
+  // Make room for the replies to a full window of requests to arrive at once.
+  // The system may limit the size, in which case some replies are dropped.
+  std::error_code ec;
+  socket_.set_option(asio::socket_base::receive_buffer_size(
+        static_cast<int>(std::min<std::size_t>(
+            options_.max_in_flight * 512, 16 * 1024 * 1024))), ec);
+
+  // Replies that have already arrived are drained without waiting.
+  socket_.non_blocking(true);
+}
+
+void probe_engine::send_queued()
+{
+  clock_type::time_point now = clock_type::now();
+  advance(now);
+
+  if (options_.probes_per_second != 0)
+  {
+    double rate = static_cast<double>(options_.probes_per_second);
+    double burst = std::max(1.0,
+        rate * chrono::duration<double>(options_.tick).count());
+    credit_ = std::min(burst, credit_ + rate
+        * chrono::duration<double>(now - credit_time_).count());
+    credit_time_ = now;
+  }
+
+  while (!queue_.empty() && !free_.empty()
+      && (options_.probes_per_second == 0 || credit_ >= 1.0))
+  {
+    asio::ip::address_v4 target = queue_.front();
+    if (!send_request(target, now))
+      break;
+    queue_.pop_front();
+    credit_ -= 1.0;
+  }
+
+  schedule_tick();
+}
+
+bool probe_engine::send_request(
+    const asio::ip::address_v4& target, clock_type::time_point now)
+{
+  // Choose a sequence number that is not in use.
+  std::uint32_t key;
+  do
+  {
+    ++next_sequence_;
+    key = (static_cast<std::uint32_t>(identifier_) << 16) | next_sequence_;
+  } while (find(key) != table_.size());
+
+  // Encode the echo request.
+  unsigned char* p = send_buffer_.data();
+  std::size_t length = 8 + sizeof(request_body);
+  std::memset(p, 0, 8);
+  p[0] = icmp_header::echo_request;
+  p[4] = static_cast<unsigned char>(identifier_ >> 8);
+  p[5] = static_cast<unsigned char>(identifier_ & 0xFF);
+  p[6] = static_cast<unsigned char>(next_sequence_ >> 8);
+  p[7] = static_cast<unsigned char>(next_sequence_ & 0xFF);
+  std::memcpy(p + 8, request_body, sizeof(request_body));
+  std::uint32_t sum = 0;
+  for (std::size_t i = 0; i < length; i += 2)
+    sum += (p[i] << 8) + (i + 1 < length ? p[i + 1] : 0);
+  sum = (sum >> 16) + (sum & 0xFFFF);
+  sum += (sum >> 16);
+  p[2] = static_cast<unsigned char>((~sum >> 8) & 0xFF);
+  p[3] = static_cast<unsigned char>(~sum & 0xFF);
+
+  std::error_code ec;
+  socket_.send_to(asio::buffer(p, length), icmp::endpoint(target, 0), 0, ec);
+  if (ec == asio::error::would_block)
+    return false;
+
+  if (ec)
+  {
+    handler_(target, ec, clock_type::duration::zero());
+    return true;
+  }
+
+  std::uint32_t index = free_.back();
+  free_.pop_back();
+  request& r = requests_[index];
+  r.target = target;
+  r.sent = now;
+  r.key = key;
+  insert(key, index);
+
+  wheel_entry entry = { index, r.generation };
+  wheel_[(current_tick_ + timeout_ticks_) & wheel_mask_].push_back(entry);
+  return true;
+}
+
+void probe_engine::start_receive()
+{
+  socket_.async_receive_from(asio::buffer(receive_buffer_), sender_,
+      [this](std::error_code ec, std::size_t length)
+      {
+        if (ec == asio::error::operation_aborted)
+          return;
+
+        if (!ec)
+          handle_reply(length);
+
+        // Handle the other replies that have already arrived, up to a limit
+        // so that the timer is not starved.
+        for (int i = 0; i < 256; ++i)
+        {
+          length = socket_.receive_from(
+              asio::buffer(receive_buffer_), sender_, 0, ec);
+          if (ec)
+            break;
+          handle_reply(length);
+        }
+
+        // Send more requests now that some are no longer in flight.
+        send_queued();
+
+        start_receive();
+      });
+}
+
+void probe_engine::handle_reply(std::size_t length)
+{
+  const unsigned char* p = receive_buffer_.data();
+
+  // A raw socket receives the IPv4 header in front of the ICMP message.
+  if (!datagram_)
+  {
+    if (length < 20)
+      return;
+    std::size_t header_length = (p[0] & 0xF) * 4;
+    if (header_length < 20 || length < header_length)
+      return;
+    p += header_length;
+    length -= header_length;
+  }
+
+  // A raw socket receives every ICMP message for the host, so keep only the
+  // echo replies that match a request in flight.
+  if (length < 8 || p[0] != icmp_header::echo_reply)
+    return;
+  std::uint32_t key = (static_cast<std::uint32_t>(p[4]) << 24)
+    | (static_cast<std::uint32_t>(p[5]) << 16)
+    | (static_cast<std::uint32_t>(p[6]) << 8) | p[7];
+  std::size_t slot = find(key);
+  if (slot == table_.size())
+    return;
+
+  std::uint32_t index = table_[slot].request;
+  if (requests_[index].target != sender_.address().to_v4())
+    return;
+
+  erase(slot);
+  complete(index, std::error_code(),
+      clock_type::now() - requests_[index].sent);
+}
+
+void probe_engine::complete(std::uint32_t index,
+    const std::error_code& ec, clock_type::duration rtt)
+{
+  request& r = requests_[index];
+  asio::ip::address_v4 target = r.target;
+
+  // Entries for the request that remain in the wheel are now stale.
+  ++r.generation;
+  free_.push_back(index);
+
+  if (ec)
+    histogram_.record_timeout();
+  else
+    histogram_.record(rtt);
+
+  handler_(target, ec, rtt);
+}
+
+void probe_engine::advance(clock_type::time_point now)
+{
+  std::uint64_t now_tick = tick_of(now);
+  if (in_flight() == 0)
+  {
+    // Any entries left in the wheel are stale.
+    current_tick_ = std::max(current_tick_, now_tick);
+    return;
+  }
+
+  while (current_tick_ < now_tick)
+  {
+    std::vector<wheel_entry>& entries = wheel_[++current_tick_ & wheel_mask_];
+    for (std::size_t i = 0; i < entries.size(); ++i)
+    {
+      request& r = requests_[entries[i].request];
+      if (r.generation == entries[i].generation)
+      {
+        erase(find(r.key));
+        complete(entries[i].request, asio::error::timed_out,
+            now - r.sent);
+      }
+    }
+    entries.clear();
+  }
+}
+
+void probe_engine::schedule_tick()
+{
+  if (timer_pending_ || pending() == 0)
+    return;
+
+  timer_pending_ = true;
+  timer_.expires_at(start_ + options_.tick
+      * static_cast<clock_type::rep>(current_tick_ + 1));
+  timer_.async_wait(
+      [this](std::error_code ec)
+      {
+        timer_pending_ = false;
+        if (!ec)
+          send_queued();
+      });
+}
+
+std::uint64_t probe_engine::tick_of(clock_type::time_point t) const
+{
+  return static_cast<std::uint64_t>((t - start_) / options_.tick);
+}
+
+std::size_t probe_engine::find(std::uint32_t key) const
+{
+  for (std::size_t i = home(key);; i = (i + 1) & table_mask_)
+  {
+    if (table_[i].request == no_request)
+      return table_.size();
+    if (table_[i].key == key)
+      return i;
+  }
+}
+
+void probe_engine::insert(std::uint32_t key, std::uint32_t index)
+{
+  std::size_t i = home(key);
+  while (table_[i].request != no_request)
+    i = (i + 1) & table_mask_;
+  table_[i].key = key;
+  table_[i].request = index;
+}
+
+void probe_engine::erase(std::size_t slot)
+{
+  // Move back any later entries in the same run that would otherwise no
+  // longer be found, so that no tombstones are needed.
+  std::size_t i = slot;
+  for (std::size_t j = (i + 1) & table_mask_;
+      table_[j].request != no_request; j = (j + 1) & table_mask_)
+  {
+    std::size_t k = home(table_[j].key);
+    if (((j - k) & table_mask_) >= ((j - i) & table_mask_))
+    {
+      table_[i] = table_[j];
+      i = j;
+    }
+  }
+  table_[i].request = no_request;
+}
+
+std::size_t probe_engine::home(std::uint32_t key) const
+{
+  key ^= key >> 16;
+  key *= 0x45d9f3b;
+  key ^= key >> 16;
+  return key & table_mask_;
+}
@@ -0,0 +1,200 @@
+//
+// probe_engine.hpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef PROBE_ENGINE_HPP
+#define PROBE_ENGINE_HPP
+
+#include <asio.hpp>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <ostream>
+#include <vector>
+
+// Histogram of round trip times, with one bucket for each power of two
+// microseconds.
+class rtt_histogram
+{
+public:
+  typedef std::chrono::steady_clock::duration duration;
+
+  enum { num_buckets = 24 };
+
+  rtt_histogram();
+
+  // Record the round trip time of a reply.
+  void record(duration rtt);
+
+  // Record a request that received no reply.
+  void record_timeout() { ++timeouts_; }
+
+  // The number of replies recorded.
+  std::size_t count() const { return count_; }
+
+  // The number of requests that received no reply.
+  std::size_t timeouts() const { return timeouts_; }
+
+  // The shortest, longest and mean round trip times, in microseconds.
+  std::uint64_t min_rtt() const { return count_ ? min_ : 0; }
+  std::uint64_t max_rtt() const { return max_; }
+  std::uint64_t mean_rtt() const { return count_ ? sum_ / count_ : 0; }
+
+  // An upper bound on the given percentile of the round trip times, in
+  // microseconds.
+  std::uint64_t percentile(double p) const;
+
+  // Write the non-empty buckets and the summary statistics.
+  friend std::ostream& operator<<(std::ostream& os, const rtt_histogram& h);
+
+private:
+  std::array<std::size_t, num_buckets> buckets_;
+  std::size_t count_;
+  std::size_t timeouts_;
+  std::uint64_t min_;
+  std::uint64_t max_;
+  std::uint64_t sum_;
+};
+
+// Sends ICMP echo requests to many IPv4 hosts at once over a single socket.
+//
+// Where the platform allows it, the socket is an unprivileged datagram ICMP
+// socket, and otherwise a raw socket. Each request in flight is found from
+// the identifier and sequence number of its reply using an open addressing
+// hash table, and the timeouts of all requests are driven by a single timer
+// that advances a timer wheel. Requests are queued, and sent at no more than
+// the configured rate and number in flight.
+class probe_engine
+{
+public:
+  typedef std::chrono::steady_clock clock_type;
+
+  struct options
+  {
+    options();
+
+    // The maximum number of requests awaiting a reply. At most 32768.
+    std::size_t max_in_flight;
+
+    // The maximum number of requests sent each second, or 0 for no limit.
+    std::size_t probes_per_second;
+
+    // How long to wait for a reply.
+    clock_type::duration timeout;
+
+    // The resolution of the timeouts and of the rate limit.
+    clock_type::duration tick;
+
+    // Whether to try an unprivileged datagram socket before a raw socket.
+    bool prefer_datagram;
+  };
+
+  // Called with the round trip time for each reply, or with
+  // asio::error::timed_out if there was no reply.
+  typedef std::function<void(const asio::ip::address_v4& target,
+      const std::error_code& ec, clock_type::duration rtt)> handler_type;
+
+  probe_engine(asio::io_context& io_context,
+      const options& opts, handler_type handler);
+
+  // Queue an echo request to the target.
+  void probe(const asio::ip::address_v4& target);
+
+  // The number of requests that are queued or awaiting a reply.
+  std::size_t pending() const { return queue_.size() + in_flight(); }
+
+  // Whether an unprivileged datagram socket is used.
+  bool uses_datagram_socket() const { return datagram_; }
+
+  // The round trip times of all replies received.
+  const rtt_histogram& histogram() const { return histogram_; }
+
+private:
+  struct request
+  {
+    asio::ip::address_v4 target;
+    clock_type::time_point sent;
+    std::uint32_t key;
+    std::uint32_t generation;
+  };
+
+  struct table_entry
+  {
+    std::uint32_t key;
+    std::uint32_t request;
+  };
+
+  struct wheel_entry
+  {
+    std::uint32_t request;
+    std::uint32_t generation;
+  };
+
+  static const std::uint32_t no_request = 0xFFFFFFFF;
+
+  void open_socket();
+  std::size_t in_flight() const { return requests_.size() - free_.size(); }
+
+  void send_queued();
+  bool send_request(const asio::ip::address_v4& target,
+      clock_type::time_point now);
+  void start_receive();
+  void handle_reply(std::size_t length);
+  void complete(std::uint32_t index, const std::error_code& ec,
+      clock_type::duration rtt);
+
+  void advance(clock_type::time_point now);
+  void schedule_tick();
+  std::uint64_t tick_of(clock_type::time_point t) const;
+
+  std::size_t find(std::uint32_t key) const;
+  void insert(std::uint32_t key, std::uint32_t index);
+  void erase(std::size_t slot);
+  std::size_t home(std::uint32_t key) const;
+
+  asio::io_context& io_context_;
+  options options_;
+  handler_type handler_;
+  asio::ip::icmp::socket socket_;
+  bool datagram_;
+  std::uint16_t identifier_;
+  std::uint16_t next_sequence_;
+
+  // The requests in flight, with a free list of unused entries.
+  std::vector<request> requests_;
+  std::vector<std::uint32_t> free_;
+
+  // Maps an identifier and sequence number to a request, using linear
+  // probing.
+  std::vector<table_entry> table_;
+  std::size_t table_mask_;
+
+  // The requests whose timeout falls in each tick, modulo the wheel size.
+  std::vector<std::vector<wheel_entry>> wheel_;
+  std::size_t wheel_mask_;
+  std::uint64_t timeout_ticks_;
+  std::uint64_t current_tick_;
+  clock_type::time_point start_;
+  asio::steady_timer timer_;
+  bool timer_pending_;
+
+  // Targets waiting to be sent, and the allowance of the rate limit.
+  std::deque<asio::ip::address_v4> queue_;
+  double credit_;
+  clock_type::time_point credit_time_;
+  bool send_pending_;
+
+  std::array<unsigned char, 64> send_buffer_;
+  std::array<unsigned char, 65536> receive_buffer_;
+  asio::ip::icmp::endpoint sender_;
+  rtt_histogram histogram_;
+};
+
+#endif // PROBE_ENGINE_HPP
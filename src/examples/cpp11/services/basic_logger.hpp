@@ -59,10 +59,11 @@ public:
     service_.use_file(impl_, file);
   }
 
-  /// Log a message.
-  void log(const std::string& message)
+  /// Log a message made up of the given arguments.
+  template <typename... Args>
+  void log(const Args&... args)
   {
-    service_.log(impl_, message);
+    service_.log(impl_, args...);
   }
 
 private:
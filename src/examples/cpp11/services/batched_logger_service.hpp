@@ -0,0 +1,760 @@
+//
+// batched_logger_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef SERVICES_BATCHED_LOGGER_SERVICE_HPP
+#define SERVICES_BATCHED_LOGGER_SERVICE_HPP
+
+#include <asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace services {
+namespace batched_logger_detail {
+
+/// Codec for a signed or unsigned integer argument.
+template <typename T>
+struct integer_codec
+{
+  typedef typename std::conditional<std::is_signed<T>::value,
+      long long, unsigned long long>::type stored_type;
+
+  static std::size_t size(T)
+  {
+    return sizeof(stored_type);
+  }
+
+  static void encode(unsigned char*& p, T value)
+  {
+    stored_type v = value;
+    std::memcpy(p, &v, sizeof(v));
+    p += sizeof(v);
+  }
+
+  static void decode(const unsigned char*& p, std::string& out)
+  {
+    stored_type v;
+    std::memcpy(&v, p, sizeof(v));
+    p += sizeof(v);
+    char buf[32];
+    int n = std::snprintf(buf, sizeof(buf),
+        std::is_signed<T>::value ? "%lld" : "%llu", v);
+    out.append(buf, n);
+  }
+};
+
+/// Codec for a floating point argument.
+struct floating_codec
+{
+  static std::size_t size(double)
+  {
+    return sizeof(double);
+  }
+
+  static void encode(unsigned char*& p, double value)
+  {
+    std::memcpy(p, &value, sizeof(value));
+    p += sizeof(value);
+  }
+
+  static void decode(const unsigned char*& p, std::string& out)
+  {
+    double v;
+    std::memcpy(&v, p, sizeof(v));
+    p += sizeof(v);
+    char buf[32];
+    int n = std::snprintf(buf, sizeof(buf), "%g", v);
+    out.append(buf, n);
+  }
+};
+
+/// Codec for a boolean argument.
+struct bool_codec
+{
+  static std::size_t size(bool)
+  {
+    return 1;
+  }
+
+  static void encode(unsigned char*& p, bool value)
+  {
+    *p++ = value ? 1 : 0;
+  }
+
+  static void decode(const unsigned char*& p, std::string& out)
+  {
+    out += *p++ ? "true" : "false";
+  }
+};
+
+/// Codec for a single character argument.
+struct char_codec
+{
+  static std::size_t size(char)
+  {
+    return 1;
+  }
+
+  static void encode(unsigned char*& p, char value)
+  {
+    *p++ = static_cast<unsigned char>(value);
+  }
+
+  static void decode(const unsigned char*& p, std::string& out)
+  {
+    out += static_cast<char>(*p++);
+  }
+};
+
+/// Codec for a string argument. The characters are copied into the record.
+struct string_codec
+{
+  static std::size_t size(const char* s)
+  {
+    return sizeof(std::uint32_t) + std::strlen(s);
+  }
+
+  static std::size_t size(const std::string& s)
+  {
+    return sizeof(std::uint32_t) + s.size();
+  }
+
+  static void encode(unsigned char*& p, const char* s)
+  {
+    encode(p, s, std::strlen(s));
+  }
+
+  static void encode(unsigned char*& p, const std::string& s)
+  {
+    encode(p, s.data(), s.size());
+  }
+
+  static void encode(unsigned char*& p, const char* s, std::size_t n)
+  {
+    std::uint32_t length = static_cast<std::uint32_t>(n);
+    std::memcpy(p, &length, sizeof(length));
+    std::memcpy(p + sizeof(length), s, n);
+    p += sizeof(length) + n;
+  }
+
+  static void decode(const unsigned char*& p, std::string& out)
+  {
+    std::uint32_t length;
+    std::memcpy(&length, p, sizeof(length));
+    out.append(reinterpret_cast<const char*>(p + sizeof(length)), length);
+    p += sizeof(length) + length;
+  }
+};
+
+/// Selects the codec used to store an argument of type T until it is
+/// formatted. Arguments of other types are formatted eagerly, using
+/// operator<<, by prepare_argument.
+template <typename T>
+struct codec_for
+{
+  typedef typename std::conditional<
+      std::is_same<T, bool>::value, bool_codec,
+      typename std::conditional<
+        std::is_same<T, char>::value, char_codec,
+        typename std::conditional<
+          std::is_integral<T>::value, integer_codec<T>,
+          typename std::conditional<
+            std::is_floating_point<T>::value, floating_codec,
+            string_codec
+          >::type
+        >::type
+      >::type
+    >::type type;
+};
+
+/// Passes through arguments that have a codec.
+template <typename T>
+inline typename std::enable_if<
+    std::is_arithmetic<T>::value
+      || std::is_same<T, std::string>::value
+      || std::is_same<T, const char*>::value
+      || std::is_same<T, char*>::value,
+    const T&>::type
+prepare_argument(const T& arg)
+{
+  return arg;
+}
+
+/// Decays string literals and character arrays to pointers.
+inline const char* prepare_argument(const char* arg)
+{
+  return arg;
+}
+
+/// Formats all other arguments immediately.
+template <typename T>
+inline typename std::enable_if<
+    !std::is_arithmetic<T>::value
+      && !std::is_same<T, std::string>::value
+      && !std::is_same<T, const char*>::value
+      && !std::is_same<T, char*>::value
+      && !std::is_array<T>::value,
+    std::string>::type
+prepare_argument(const T& arg)
+{
+  std::ostringstream os;
+  os << arg;
+  return os.str();
+}
+
+/// Appends the arguments stored in a record to the output.
+template <typename... Args>
+void format_arguments(const unsigned char* p, std::string& out)
+{
+  int unused[] = { 0, (codec_for<Args>::type::decode(p, out), 0)... };
+  (void)unused;
+}
+
+} // namespace batched_logger_detail
+
+/// Service implementation for a high-volume logger.
+/**
+ * Each thread that logs is given its own lock-free ring buffer, so that
+ * threads do not contend with each other. A log call copies its arguments
+ * into the calling thread's ring buffer and returns; the arguments are
+ * formatted later on a background thread, which coalesces the output of many
+ * log calls into a single large write.
+ *
+ * The service is configured using the execution context's configuration:
+ *
+ * @li @c logger.ring_size: The size in bytes of each thread's ring buffer.
+ * Defaults to 1048576.
+ *
+ * @li @c logger.block_on_overflow: Whether a thread whose ring buffer is full
+ * waits for the background thread to make space (true), or discards the log
+ * message (false). Defaults to false.
+ *
+ * @li @c logger.flush_interval: The maximum time, in milliseconds, that a log
+ * message is held before being written. Defaults to 50.
+ *
+ * @li @c logger.batch_size: The number of bytes of formatted output that are
+ * accumulated before they are written. Defaults to 262144.
+ */
+class batched_logger_service
+  : public asio::execution_context::service
+{
+public:
+  /// The type used to identify this service in the execution context.
+  typedef batched_logger_service key_type;
+
+  /// The backend implementation of a logger.
+  struct logger_impl
+  {
+    explicit logger_impl(const std::string& ident) : identifier(ident) {}
+    std::string identifier;
+  };
+
+  /// The type for an implementation of the logger.
+  typedef logger_impl* impl_type;
+
+  /// Counters describing the service's activity.
+  struct statistics
+  {
+    /// The number of messages added to a ring buffer.
+    std::uint64_t logged;
+
+    /// The number of messages discarded because a ring buffer was full.
+    std::uint64_t dropped;
+
+    /// The number of times a thread waited for space in a ring buffer.
+    std::uint64_t blocked;
+
+    /// The number of writes made to the output file.
+    std::uint64_t writes;
+
+    /// The number of bytes written to the output file.
+    std::uint64_t bytes_written;
+  };
+
+  /// Constructor creates a thread to run a private io_context.
+  batched_logger_service(asio::execution_context& context)
+    : asio::execution_context::service(context),
+      id_(next_id()),
+      ring_size_(round_up_to_power_of_two(
+            asio::config(context).get("logger", "ring_size", 1048576U))),
+      block_on_overflow_(
+          asio::config(context).get("logger", "block_on_overflow", false)),
+      flush_interval_(
+          asio::config(context).get("logger", "flush_interval", 50U)),
+      batch_size_(asio::config(context).get("logger", "batch_size", 262144U)),
+      drain_pending_(false),
+      writes_(0),
+      bytes_written_(0),
+      file_(0),
+      stopped_(false),
+      work_io_context_(),
+      work_(asio::make_work_guard(work_io_context_)),
+      flush_timer_(work_io_context_),
+      work_thread_([this]{ work_io_context_.run(); })
+  {
+    asio::post(work_io_context_, [this]{ start_flush_timer(); });
+  }
+
+  batched_logger_service(const batched_logger_service&) = delete;
+  batched_logger_service& operator=(const batched_logger_service&) = delete;
+
+  /// Destructor writes any remaining messages and shuts down the private
+  /// io_context.
+  ~batched_logger_service()
+  {
+    asio::post(work_io_context_,
+        [this]
+        {
+          stopped_ = true;
+          flush_timer_.cancel();
+          drain();
+          close_file();
+        });
+    work_.reset();
+    if (work_thread_.joinable())
+      work_thread_.join();
+
+    for (std::size_t i = 0; i < retired_.size(); ++i)
+      delete retired_[i];
+  }
+
+  /// Destroy all user-defined handler objects owned by the service.
+  void shutdown()
+  {
+  }
+
+  /// Return a null logger implementation.
+  impl_type null() const
+  {
+    return 0;
+  }
+
+  /// Create a new logger implementation.
+  void create(impl_type& impl, const std::string& identifier)
+  {
+    impl = new logger_impl(identifier);
+  }
+
+  /// Destroy a logger implementation.
+  void destroy(impl_type& impl)
+  {
+    // Messages that refer to the implementation may still be waiting in a
+    // ring buffer, so it is deleted by the background thread once they have
+    // been written.
+    std::lock_guard<std::mutex> lock(mutex_);
+    retired_.push_back(impl);
+    impl = null();
+  }
+
+  /// Set the output file for the logger. As with logger_service, the output
+  /// file is shared by all logger instances.
+  void use_file(impl_type& /*impl*/, const std::string& file)
+  {
+    // Pass the work of opening the file to the background thread.
+    asio::post(work_io_context_,
+        [this, file]
+        {
+          drain();
+          close_file();
+          file_ = std::fopen(file.c_str(), "w");
+          if (file_)
+            std::setvbuf(file_, 0, _IONBF, 0);
+        });
+  }
+
+  /// Log a message made up of the given arguments.
+  template <typename... Args>
+  void log(impl_type& impl, const Args&... args)
+  {
+    log_prepared(impl, batched_logger_detail::prepare_argument(args)...);
+  }
+
+  /// Get the service's counters.
+  statistics get_statistics()
+  {
+    statistics s = statistics();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t i = 0; i < rings_.size(); ++i)
+    {
+      s.logged += rings_[i]->logged.load(std::memory_order_relaxed);
+      s.dropped += rings_[i]->dropped.load(std::memory_order_relaxed);
+      s.blocked += rings_[i]->blocked.load(std::memory_order_relaxed);
+    }
+    s.writes = writes_.load(std::memory_order_relaxed);
+    s.bytes_written = bytes_written_.load(std::memory_order_relaxed);
+    return s;
+  }
+
+private:
+  /// The function used to format a record's arguments.
+  typedef void (*format_function)(const unsigned char*, std::string&);
+
+  /// The header at the start of each record in a ring buffer. The arguments
+  /// follow the header.
+  struct record_header
+  {
+    /// The size of the record, including the header.
+    std::uint32_t size;
+
+    /// Whether the record only fills the space at the end of the buffer.
+    std::uint32_t padding;
+
+    /// The function used to format the record's arguments.
+    format_function format;
+
+    /// The logger that created the record.
+    const logger_impl* impl;
+  };
+
+  /// Records are aligned so that each header may be accessed in place.
+  enum { record_alignment = alignof(record_header) };
+
+  /// A single producer, single consumer ring buffer of variable length
+  /// records. Positions increase monotonically and are reduced modulo the
+  /// buffer's size.
+  struct ring
+  {
+    explicit ring(std::size_t capacity)
+      : data(new unsigned char[capacity]),
+        capacity(capacity),
+        cached_head(0),
+        head(0),
+        tail(0),
+        logged(0),
+        dropped(0),
+        blocked(0)
+    {
+    }
+
+    std::unique_ptr<unsigned char[]> data;
+    const std::size_t capacity;
+
+    /// The producer's copy of the consumer's position.
+    std::size_t cached_head;
+
+    /// The consumer's position, on its own cache line.
+    char pad1[64];
+    std::atomic<std::size_t> head;
+
+    /// The producer's position, on its own cache line.
+    char pad2[64];
+    std::atomic<std::size_t> tail;
+    char pad3[64];
+
+    /// Counters, written only by the producer.
+    std::atomic<std::uint64_t> logged;
+    std::atomic<std::uint64_t> dropped;
+    std::atomic<std::uint64_t> blocked;
+  };
+
+  /// Adds a record for already prepared arguments to the calling thread's ring
+  /// buffer.
+  template <typename... Args>
+  void log_prepared(impl_type& impl, const Args&... args)
+  {
+    std::size_t sizes[] = { 0, codec_size(args)... };
+    std::size_t size = sizeof(record_header);
+    for (std::size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+      size += sizes[i];
+    size = (size + record_alignment - 1) & ~std::size_t(record_alignment - 1);
+
+    ring& r = this_thread_ring();
+    std::size_t tail = r.tail.load(std::memory_order_relaxed);
+    std::size_t pad = 0;
+    while (!reserve(r, tail, size, pad))
+    {
+      if (!block_on_overflow_ || size > r.capacity / 2)
+      {
+        increment(r.dropped);
+        return;
+      }
+
+      // Wait for the background thread to make space.
+      increment(r.blocked);
+      request_drain();
+      std::this_thread::yield();
+    }
+
+    // Fill the unusable space at the end of the buffer, if any.
+    if (pad)
+    {
+      record_header* h = reinterpret_cast<record_header*>(
+          r.data.get() + (tail & (r.capacity - 1)));
+      h->size = static_cast<std::uint32_t>(pad);
+      h->padding = 1;
+    }
+
+    unsigned char* p = r.data.get() + ((tail + pad) & (r.capacity - 1));
+    record_header* h = new (p) record_header;
+    h->size = static_cast<std::uint32_t>(size);
+    h->padding = 0;
+    h->format = &batched_logger_detail::format_arguments<Args...>;
+    h->impl = impl;
+    p += sizeof(record_header);
+    int unused[] = { 0, (codec_encode(p, args), 0)... };
+    (void)unused;
+
+    r.tail.store(tail + pad + size, std::memory_order_release);
+    increment(r.logged);
+
+    // Wake the background thread early if the buffer is half full.
+    tail += pad + size;
+    if (tail - r.cached_head > r.capacity / 2)
+    {
+      r.cached_head = r.head.load(std::memory_order_acquire);
+      if (tail - r.cached_head > r.capacity / 2)
+        request_drain();
+    }
+  }
+
+  template <typename T>
+  static std::size_t codec_size(const T& arg)
+  {
+    return batched_logger_detail::codec_for<T>::type::size(arg);
+  }
+
+  template <typename T>
+  static void codec_encode(unsigned char*& p, const T& arg)
+  {
+    batched_logger_detail::codec_for<T>::type::encode(p, arg);
+  }
+
+  /// Determines whether there is room for a record in the ring buffer. If the
+  /// record does not fit before the end of the buffer, pad is set to the size
+  /// of the space to be skipped.
+  static bool reserve(ring& r, std::size_t tail,
+      std::size_t size, std::size_t& pad)
+  {
+    std::size_t offset = tail & (r.capacity - 1);
+    pad = (r.capacity - offset < size) ? r.capacity - offset : 0;
+    if (tail + pad + size - r.cached_head <= r.capacity)
+      return true;
+    r.cached_head = r.head.load(std::memory_order_acquire);
+    return tail + pad + size - r.cached_head <= r.capacity;
+  }
+
+  /// Increments a counter that has only one writer.
+  static void increment(std::atomic<std::uint64_t>& counter)
+  {
+    counter.store(counter.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
+  }
+
+  /// Returns the ring buffer owned by the calling thread, creating it if
+  /// required.
+  ring& this_thread_ring()
+  {
+    struct entry { unsigned long id; ring* r; };
+    static thread_local entry last = { 0, 0 };
+    static thread_local std::vector<entry> entries;
+
+    if (last.id == id_)
+      return *last.r;
+
+    for (std::size_t i = 0; i < entries.size(); ++i)
+    {
+      if (entries[i].id == id_)
+      {
+        last = entries[i];
+        return *last.r;
+      }
+    }
+
+    std::unique_ptr<ring> r(new ring(ring_size_));
+    std::lock_guard<std::mutex> lock(mutex_);
+    rings_.push_back(std::move(r));
+    last.id = id_;
+    last.r = rings_.back().get();
+    entries.push_back(last);
+    return *last.r;
+  }
+
+  /// Schedules a drain on the background thread, unless one is pending.
+  void request_drain()
+  {
+    if (!drain_pending_.exchange(true, std::memory_order_acq_rel))
+      asio::post(work_io_context_, [this]{ drain(); });
+  }
+
+  /// Starts the timer used to write messages periodically.
+  void start_flush_timer()
+  {
+    flush_timer_.expires_after(std::chrono::milliseconds(flush_interval_));
+    flush_timer_.async_wait(
+        [this](asio::error_code ec)
+        {
+          if (!ec && !stopped_)
+          {
+            drain();
+            start_flush_timer();
+          }
+        });
+  }
+
+  /// Formats and writes all messages in the ring buffers. Called only on the
+  /// background thread.
+  void drain()
+  {
+    drain_pending_.store(false, std::memory_order_release);
+
+    std::vector<logger_impl*> retired;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      retired.swap(retired_);
+      for (std::size_t i = drain_rings_.size(); i < rings_.size(); ++i)
+        drain_rings_.push_back(rings_[i].get());
+    }
+
+    for (std::size_t i = 0; i < drain_rings_.size(); ++i)
+      drain_ring(*drain_rings_[i]);
+    write_batch();
+
+    // Loggers destroyed before this drain began have no messages left.
+    for (std::size_t i = 0; i < retired.size(); ++i)
+      delete retired[i];
+  }
+
+  /// Formats the messages in a single ring buffer.
+  void drain_ring(ring& r)
+  {
+    std::size_t head = r.head.load(std::memory_order_relaxed);
+    std::size_t tail = r.tail.load(std::memory_order_acquire);
+    while (head != tail)
+    {
+      const unsigned char* p = r.data.get() + (head & (r.capacity - 1));
+      const record_header* h = reinterpret_cast<const record_header*>(p);
+      if (!h->padding)
+      {
+        batch_ += h->impl->identifier;
+        batch_ += ": ";
+        h->format(p + sizeof(record_header), batch_);
+        batch_ += '\n';
+      }
+      head += h->size;
+
+      if (batch_.size() >= batch_size_)
+      {
+        r.head.store(head, std::memory_order_release);
+        write_batch();
+      }
+    }
+    r.head.store(head, std::memory_order_release);
+  }
+
+  /// Writes the formatted messages to the output file.
+  void write_batch()
+  {
+    if (batch_.empty())
+      return;
+
+    if (file_)
+    {
+      std::size_t n = std::fwrite(batch_.data(), 1, batch_.size(), file_);
+      writes_.store(writes_.load(std::memory_order_relaxed) + 1,
+          std::memory_order_relaxed);
+      bytes_written_.store(bytes_written_.load(std::memory_order_relaxed) + n,
+          std::memory_order_relaxed);
+    }
+
+    batch_.clear();
+  }
+
+  /// Closes the output file.
+  void close_file()
+  {
+    if (file_)
+    {
+      std::fclose(file_);
+      file_ = 0;
+    }
+  }
+
+  static unsigned long next_id()
+  {
+    static std::atomic<unsigned long> id(0);
+    return ++id;
+  }
+
+  static std::size_t round_up_to_power_of_two(std::size_t n)
+  {
+    std::size_t size = 4096;
+    while (size < n)
+      size <<= 1;
+    return size;
+  }
+
+  /// Uniquely identifies the service, so that a thread's ring buffer cannot
+  /// be mistaken for one belonging to another service at the same address.
+  const unsigned long id_;
+
+  /// The configuration.
+  const std::size_t ring_size_;
+  const bool block_on_overflow_;
+  const unsigned flush_interval_;
+  const std::size_t batch_size_;
+
+  /// Mutex to protect the list of ring buffers and retired loggers.
+  std::mutex mutex_;
+
+  /// The ring buffers of all threads that have logged.
+  std::vector<std::unique_ptr<ring>> rings_;
+
+  /// Loggers that have been destroyed, but that may still have messages in a
+  /// ring buffer.
+  std::vector<logger_impl*> retired_;
+
+  /// Whether a drain has been posted to the background thread.
+  std::atomic<bool> drain_pending_;
+
+  /// Counters, written only by the background thread.
+  std::atomic<std::uint64_t> writes_;
+  std::atomic<std::uint64_t> bytes_written_;
+
+  /// The ring buffers known to the background thread.
+  std::vector<ring*> drain_rings_;
+
+  /// Formatted messages waiting to be written.
+  std::string batch_;
+
+  /// The file to which log messages will be written.
+  std::FILE* file_;
+
+  /// Whether the service is being destroyed.
+  bool stopped_;
+
+  /// Private io_context used for formatting and writing messages.
+  asio::io_context work_io_context_;
+
+  /// Work for the private io_context to perform. If we do not give the
+  /// io_context some work to do then the io_context::run() function will exit
+  /// immediately.
+  asio::executor_work_guard<
+      asio::io_context::executor_type> work_;
+
+  /// Timer used to write messages periodically.
+  asio::steady_timer flush_timer_;
+
+  /// Thread used for running the work io_context's run loop.
+  std::thread work_thread_;
+};
+
+} // namespace services
+
+#endif // SERVICES_BATCHED_LOGGER_SERVICE_HPP
@@ -0,0 +1,86 @@
+//
+// log_flood.cpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <asio.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "logger.hpp"
+
+int main(int argc, char* argv[])
+{
+  if (argc != 5)
+  {
+    std::cerr << "Usage: log_flood <file> <threads> <lines> <drop|block>\n";
+    std::cerr << "For example:\n";
+    std::cerr << "  log_flood log.txt 4 1000000 block\n";
+    return 1;
+  }
+
+  int threads = std::atoi(argv[2]);
+  long lines = std::atol(argv[3]);
+  bool block = std::string(argv[4]) == "block";
+
+  typedef std::chrono::steady_clock clock_type;
+  clock_type::time_point start = clock_type::now();
+  clock_type::time_point logged;
+  services::batched_logger_service::statistics stats;
+
+  {
+    asio::io_context io_context(asio::config_from_string(
+          block ? "logger.block_on_overflow=1" : ""));
+
+    services::batched_logger logger(io_context, "log_flood");
+    logger.use_file(argv[1]);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+      workers.emplace_back(
+          [&io_context, t, lines]
+          {
+            services::batched_logger logger(io_context, "worker");
+            for (long i = 0; i < lines; ++i)
+              logger.log("thread ", t, " request ", i,
+                  " took ", i * 0.25, " ms");
+          });
+    }
+    for (std::size_t t = 0; t < workers.size(); ++t)
+      workers[t].join();
+
+    logged = clock_type::now();
+    logger.log("Finished");
+
+    // Destroying the io_context destroys the service, which writes any
+    // remaining messages.
+    asio::execution_context& context = io_context;
+    stats = asio::use_service<services::batched_logger_service>(
+        context).get_statistics();
+  }
+
+  clock_type::time_point written = clock_type::now();
+
+  double log_seconds = std::chrono::duration<double>(logged - start).count();
+  double total_seconds = std::chrono::duration<double>(written - start).count();
+
+  std::cout << "Logged " << stats.logged << " lines in " << log_seconds
+    << "s (" << stats.logged / log_seconds << " lines/s)\n";
+  std::ifstream file(argv[1], std::ios::binary | std::ios::ate);
+  std::cout << "Wrote " << file.tellg() << " bytes in " << total_seconds
+    << "s\n";
+  std::cout << "Dropped " << stats.dropped << " lines, blocked "
+    << stats.blocked << " times\n";
+
+  return 0;
+}
@@ -12,6 +12,7 @@
 #define SERVICES_LOGGER_HPP
 
 #include "basic_logger.hpp"
+#include "batched_logger_service.hpp"
 #include "logger_service.hpp"
 
 namespace services {
@@ -19,6 +20,9 @@ namespace services {
 /// Typedef for typical logger usage.
 typedef basic_logger<logger_service> logger;
 
+/// Typedef for high-volume logging.
+typedef basic_logger<batched_logger_service> batched_logger;
+
 } // namespace services
 
 #endif // SERVICES_LOGGER_HPP
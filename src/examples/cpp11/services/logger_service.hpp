@@ -95,12 +95,15 @@ public:
         std::bind(&logger_service::use_file_impl, this, file));
   }
 
-  /// Log a message.
-  void log(impl_type& impl, const std::string& message)
+  /// Log a message made up of the given arguments.
+  template <typename... Args>
+  void log(impl_type& impl, const Args&... args)
   {
     // Format the text to be logged.
     std::ostringstream os;
-    os << impl->identifier << ": " << message;
+    os << impl->identifier << ": ";
+    int unused[] = { 0, ((os << args), 0)... };
+    (void)unused;
 
     // Pass the work of writing to the file to the background thread.
     asio::post(work_io_context_,
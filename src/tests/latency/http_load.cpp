@@ -0,0 +1,290 @@
+//
+// http_load.cpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Generates HTTP/1.1 load against a server over persistent connections, in the
+// manner of wrk. Each thread runs its own io_context with a share of the
+// connections, and each connection repeatedly writes a batch of pipelined GET
+// requests and waits for all of the replies. Reports the request rate, the
+// transfer rate and the distribution of the time taken by each batch.
+
+#include <asio/connect.hpp>
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+#include <asio/steady_timer.hpp>
+#include <asio/write.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using asio::ip::tcp;
+typedef std::chrono::steady_clock clock_type;
+
+// The results gathered by one thread.
+struct results
+{
+  results() : requests(0), bytes(0), errors(0) {}
+
+  std::size_t requests;
+  std::size_t bytes;
+  std::size_t errors;
+  std::vector<long long> batch_latencies; // In microseconds.
+};
+
+// A single persistent connection that sends batches of pipelined requests.
+class client_connection
+{
+public:
+  client_connection(asio::io_context& ioc, const std::string& batch,
+      std::size_t pipeline, const bool& stopped, results& r)
+    : socket_(ioc),
+      batch_(batch),
+      pipeline_(pipeline),
+      stopped_(stopped),
+      results_(r),
+      outstanding_(0)
+  {
+  }
+
+  void start(const tcp::resolver::results_type& endpoints)
+  {
+    asio::async_connect(socket_, endpoints,
+        [this](asio::error_code ec, const tcp::endpoint&)
+        {
+          if (ec)
+          {
+            ++results_.errors;
+            return;
+          }
+
+          socket_.set_option(tcp::no_delay(true));
+          write_batch();
+        });
+  }
+
+  void stop()
+  {
+    asio::error_code ignored_ec;
+    socket_.close(ignored_ec);
+  }
+
+private:
+  void write_batch()
+  {
+    if (stopped_)
+      return;
+
+    outstanding_ = pipeline_;
+    batch_start_ = clock_type::now();
+    asio::async_write(socket_, asio::buffer(batch_),
+        [this](asio::error_code ec, std::size_t)
+        {
+          if (ec)
+            return fail();
+          read();
+        });
+  }
+
+  void read()
+  {
+    socket_.async_read_some(asio::buffer(read_buffer_),
+        [this](asio::error_code ec, std::size_t n)
+        {
+          if (ec)
+            return fail();
+
+          results_.bytes += n;
+          input_.append(read_buffer_, n);
+          if (!parse_replies())
+            return fail();
+
+          if (outstanding_ > 0)
+            return read();
+
+          results_.batch_latencies.push_back(
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                clock_type::now() - batch_start_).count());
+          write_batch();
+        });
+  }
+
+  // Consume the complete replies in the input. Returns false if a reply is
+  // malformed or was not successful.
+  bool parse_replies()
+  {
+    std::size_t pos = 0;
+    while (outstanding_ > 0)
+    {
+      std::size_t headers_end = input_.find("\r\n\r\n", pos);
+      if (headers_end == std::string::npos)
+        break;
+
+      if (input_.compare(pos, 12, "HTTP/1.1 200") != 0)
+        return false;
+
+      std::size_t content_length = 0;
+      std::size_t line = input_.find("\r\n", pos);
+      while (line < headers_end)
+      {
+        static const char name[] = "\r\ncontent-length:";
+        const std::size_t name_len = sizeof(name) - 1;
+        bool match = line + name_len <= headers_end;
+        for (std::size_t i = 0; match && i < name_len; ++i)
+        {
+          char c = input_[line + i];
+          if (c >= 'A' && c <= 'Z')
+            c = static_cast<char>(c - 'A' + 'a');
+          match = (c == name[i]);
+        }
+        if (match)
+          content_length = std::strtoul(
+              input_.c_str() + line + name_len, 0, 10);
+        line = input_.find("\r\n", line + 2);
+      }
+
+      std::size_t reply_end = headers_end + 4 + content_length;
+      if (reply_end > input_.size())
+        break;
+
+      pos = reply_end;
+      --outstanding_;
+      ++results_.requests;
+    }
+
+    input_.erase(0, pos);
+    return true;
+  }
+
+  void fail()
+  {
+    if (!stopped_)
+      ++results_.errors;
+  }
+
+  tcp::socket socket_;
+  const std::string& batch_;
+  std::size_t pipeline_;
+  const bool& stopped_;
+  results& results_;
+  std::size_t outstanding_;
+  clock_type::time_point batch_start_;
+  char read_buffer_[65536];
+  std::string input_;
+};
+
+void run_thread(const std::string& host, const std::string& port,
+    const std::string& batch, std::size_t pipeline,
+    std::size_t num_connections, std::chrono::seconds duration, results& r)
+{
+  asio::io_context ioc(1);
+  tcp::resolver resolver(ioc);
+  tcp::resolver::results_type endpoints = resolver.resolve(host, port);
+
+  bool stopped = false;
+  std::vector<std::unique_ptr<client_connection>> connections;
+  for (std::size_t i = 0; i < num_connections; ++i)
+  {
+    connections.emplace_back(
+        new client_connection(ioc, batch, pipeline, stopped, r));
+    connections.back()->start(endpoints);
+  }
+
+  asio::steady_timer timer(ioc, duration);
+  timer.async_wait(
+      [&](asio::error_code)
+      {
+        stopped = true;
+        for (std::size_t i = 0; i < connections.size(); ++i)
+          connections[i]->stop();
+      });
+
+  ioc.run();
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 8)
+  {
+    std::fprintf(stderr,
+        "Usage: http_load <host> <port> <path> <connections> <pipeline> "
+        "<seconds> <threads>\n"
+        "For example:\n"
+        "  http_load 127.0.0.1 8080 /data_1K.html 64 16 10 2\n");
+    return 1;
+  }
+
+  std::string host = argv[1];
+  std::string port = argv[2];
+  std::string path = argv[3];
+  std::size_t num_connections = std::max(1, std::atoi(argv[4]));
+  std::size_t pipeline = std::max(1, std::atoi(argv[5]));
+  std::chrono::seconds duration(std::max(1, std::atoi(argv[6])));
+  std::size_t num_threads = std::max(1, std::atoi(argv[7]));
+  num_threads = std::min(num_threads, num_connections);
+
+  std::string request = "GET " + path + " HTTP/1.1\r\nHost: " + host + "\r\n\r\n";
+  std::string batch;
+  for (std::size_t i = 0; i < pipeline; ++i)
+    batch += request;
+
+  std::vector<results> thread_results(num_threads);
+  std::vector<std::thread> threads;
+  clock_type::time_point start = clock_type::now();
+  for (std::size_t i = 0; i < num_threads; ++i)
+  {
+    std::size_t n = num_connections / num_threads
+      + (i < num_connections % num_threads ? 1 : 0);
+    threads.emplace_back(run_thread, std::cref(host), std::cref(port),
+        std::cref(batch), pipeline, n, duration, std::ref(thread_results[i]));
+  }
+  for (std::size_t i = 0; i < threads.size(); ++i)
+    threads[i].join();
+  double elapsed = std::chrono::duration<double>(
+      clock_type::now() - start).count();
+
+  results total;
+  for (std::size_t i = 0; i < thread_results.size(); ++i)
+  {
+    total.requests += thread_results[i].requests;
+    total.bytes += thread_results[i].bytes;
+    total.errors += thread_results[i].errors;
+    total.batch_latencies.insert(total.batch_latencies.end(),
+        thread_results[i].batch_latencies.begin(),
+        thread_results[i].batch_latencies.end());
+  }
+
+  std::printf("%zu connections, %zu requests per batch, %zu threads, "
+      "%.1f seconds\n", num_connections, pipeline, num_threads, elapsed);
+  std::printf("  requests/sec: %12.0f\n", total.requests / elapsed);
+  std::printf("  MB/sec:       %12.2f\n", total.bytes / elapsed / 1e6);
+  std::printf("  errors:       %12zu\n", total.errors);
+
+  std::vector<long long>& samples = total.batch_latencies;
+  if (!samples.empty())
+  {
+    std::sort(samples.begin(), samples.end());
+    const double percentiles[] = { 50.0, 90.0, 99.0, 99.9 };
+    std::printf("  batch latency (usec):\n");
+    for (std::size_t i = 0; i < sizeof(percentiles) / sizeof(double); ++i)
+    {
+      std::size_t index = static_cast<std::size_t>(
+          percentiles[i] / 100.0 * (samples.size() - 1));
+      std::printf("    p%-5g %10lld\n", percentiles[i], samples[index]);
+    }
+    std::printf("    max    %10lld\n", samples.back());
+  }
+
+  return 0;
+}
@@ -0,0 +1,147 @@
+//
+// mailbox_throughput.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures the rate at which messages are delivered to a large number of
+// actors, as in the executors/actor.cpp example. Each actor forwards every
+// message it receives to the next actor in a ring until the message's hop
+// count is exhausted. The actors are run first using asio::strand and then
+// using asio::experimental::mailbox.
+
+#include <asio/experimental/mailbox.hpp>
+#include <asio/post.hpp>
+#include <asio/strand.hpp>
+#include <asio/thread_pool.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+typedef std::chrono::steady_clock clock_type;
+
+template <typename Executor>
+class actor
+{
+public:
+  explicit actor(const Executor& ex)
+    : executor_(ex),
+      next_(0),
+      received_(0)
+  {
+  }
+
+  void set_next(actor* next)
+  {
+    next_ = next;
+  }
+
+  void send(long hops)
+  {
+    asio::post(executor_,
+        [this, hops]
+        {
+          ++received_;
+          if (hops > 0)
+            next_->send(hops - 1);
+        });
+  }
+
+  long received() const
+  {
+    return received_;
+  }
+
+private:
+  Executor executor_;
+  actor* next_;
+  long received_;
+};
+
+template <typename Executor, typename MakeExecutor>
+double run(long actors, long hops, int threads,
+    MakeExecutor make_executor, long& received)
+{
+  asio::thread_pool pool(threads);
+
+  std::vector<std::unique_ptr<actor<Executor>>> ring;
+  for (long i = 0; i < actors; ++i)
+    ring.emplace_back(new actor<Executor>(make_executor(pool)));
+  for (long i = 0; i < actors; ++i)
+    ring[i]->set_next(ring[(i + 1) % actors].get());
+
+  clock_type::time_point start = clock_type::now();
+
+  for (long i = 0; i < actors; ++i)
+    ring[i]->send(hops);
+  pool.join();
+
+  clock_type::time_point stop = clock_type::now();
+
+  received = 0;
+  for (long i = 0; i < actors; ++i)
+    received += ring[i]->received();
+
+  return std::chrono::duration<double, std::nano>(stop - start).count()
+    / static_cast<double>(received);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 5)
+  {
+    std::fprintf(stderr,
+        "Usage: mailbox_throughput <actors> <hops> <threads> <repeats>\n"
+        "For example:\n"
+        "  mailbox_throughput 100000 50 4 5\n");
+    return 1;
+  }
+
+  long actors = std::atol(argv[1]);
+  long hops = std::atol(argv[2]);
+  int threads = std::atoi(argv[3]);
+  int repeats = std::atoi(argv[4]);
+
+  typedef asio::strand<asio::thread_pool::executor_type> strand_type;
+  typedef asio::experimental::mailbox<
+    asio::thread_pool::executor_type> mailbox_type;
+
+  double best_strand = 0.0;
+  double best_mailbox = 0.0;
+  long received_strand = 0;
+  long received_mailbox = 0;
+  for (int i = 0; i < repeats; ++i)
+  {
+    double s = run<strand_type>(actors, hops, threads,
+        [](asio::thread_pool& p){ return asio::make_strand(p); },
+        received_strand);
+    double m = run<mailbox_type>(actors, hops, threads,
+        [](asio::thread_pool& p){ return asio::experimental::make_mailbox(p); },
+        received_mailbox);
+
+    if (i == 0 || s < best_strand)
+      best_strand = s;
+    if (i == 0 || m < best_mailbox)
+      best_mailbox = m;
+  }
+
+  if (received_strand != received_mailbox)
+  {
+    std::fprintf(stderr, "Mismatched message count\n");
+    return 1;
+  }
+
+  std::printf("strand:  %8.2f ns/msg %10.0f msgs/s\n",
+      best_strand, 1e9 / best_strand);
+  std::printf("mailbox: %8.2f ns/msg %10.0f msgs/s\n",
+      best_mailbox, 1e9 / best_mailbox);
+
+  return 0;
+}
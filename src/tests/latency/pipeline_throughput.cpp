@@ -0,0 +1,238 @@
+//
+// pipeline_throughput.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures the throughput of a three stage filter, transform and write
+// pipeline. The pipeline is built first from a thread per stage connected by
+// mutex and condition variable queues, as in the executors/pipeline.cpp
+// example, and then using asio::experimental::make_pipeline on a thread pool.
+
+#include <asio/experimental/pipeline.hpp>
+#include <asio/thread_pool.hpp>
+#include <asio/use_future.hpp>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+typedef std::chrono::steady_clock clock_type;
+
+const std::size_t queue_capacity = 1024;
+
+std::string make_line(long i)
+{
+  char buf[64];
+  std::snprintf(buf, sizeof(buf), "%ld log entry from the ingest path", i);
+  return buf;
+}
+
+bool keep(const std::string& line)
+{
+  return line[0] != '7';
+}
+
+std::string transform(std::string line)
+{
+  for (std::size_t i = 0; i < line.size(); ++i)
+    line[i] = static_cast<char>(std::toupper(line[i]));
+  return line;
+}
+
+// A bounded queue protected by a mutex, with condition variables to block
+// producers when it is full and consumers when it is empty.
+template <typename T>
+class locked_queue
+{
+public:
+  void push(T value)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [this]{ return queue_.size() < queue_capacity; });
+    queue_.push_back(std::move(value));
+    not_empty_.notify_one();
+  }
+
+  bool pop(T& value)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this]{ return !queue_.empty() || closed_; });
+    if (queue_.empty())
+      return false;
+    value = std::move(queue_.front());
+    queue_.pop_front();
+    not_full_.notify_one();
+    return true;
+  }
+
+  void close()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    not_empty_.notify_all();
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+  std::deque<T> queue_;
+  bool closed_ = false;
+};
+
+double run_locked(long items, std::size_t& written)
+{
+  locked_queue<std::string> q1, q2, q3;
+  written = 0;
+
+  clock_type::time_point start = clock_type::now();
+
+  std::thread filter_thread(
+      [&]
+      {
+        std::string line;
+        while (q1.pop(line))
+          if (keep(line))
+            q2.push(std::move(line));
+        q2.close();
+      });
+
+  std::thread transform_thread(
+      [&]
+      {
+        std::string line;
+        while (q2.pop(line))
+          q3.push(transform(std::move(line)));
+        q3.close();
+      });
+
+  std::thread writer_thread(
+      [&]
+      {
+        std::string line;
+        while (q3.pop(line))
+          written += line.size();
+      });
+
+  for (long i = 0; i < items; ++i)
+    q1.push(make_line(i));
+  q1.close();
+
+  filter_thread.join();
+  transform_thread.join();
+  writer_thread.join();
+
+  clock_type::time_point stop = clock_type::now();
+
+  return std::chrono::duration<double, std::nano>(stop - start).count()
+    / static_cast<double>(items);
+}
+
+double run_pipeline(long items, std::size_t transform_parallelism,
+    std::size_t& written)
+{
+  asio::thread_pool pool(2 + transform_parallelism);
+  std::atomic<std::size_t> total(0);
+
+  clock_type::time_point start = clock_type::now();
+
+  auto p = asio::experimental::make_pipeline<std::string>(pool)
+    .queue_capacity(queue_capacity)
+    .stage<std::string>(
+        [](std::string line,
+          asio::experimental::pipeline_output<std::string>& out)
+        {
+          if (keep(line))
+            out.push(std::move(line));
+        })
+    .stage<std::string>(
+        [](std::string line,
+          asio::experimental::pipeline_output<std::string>& out)
+        {
+          out.push(transform(std::move(line)));
+        }, transform_parallelism)
+    .sink(
+        [&total](std::string line)
+        {
+          total.fetch_add(line.size(), std::memory_order_relaxed);
+        });
+
+  for (long i = 0; i < items; ++i)
+  {
+    std::string line = make_line(i);
+    while (!p.try_push(std::move(line)))
+      std::this_thread::yield();
+  }
+  p.close();
+  p.async_wait(asio::use_future).get();
+
+  clock_type::time_point stop = clock_type::now();
+
+  written = total.load();
+  pool.join();
+
+  return std::chrono::duration<double, std::nano>(stop - start).count()
+    / static_cast<double>(items);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3)
+  {
+    std::fprintf(stderr,
+        "Usage: pipeline_throughput <items> <repeats>\n"
+        "For example:\n"
+        "  pipeline_throughput 1000000 5\n");
+    return 1;
+  }
+
+  long items = std::atol(argv[1]);
+  int repeats = std::atoi(argv[2]);
+
+  double best_locked = 0.0;
+  double best_pipeline = 0.0;
+  double best_parallel = 0.0;
+  std::size_t written_locked = 0;
+  std::size_t written_pipeline = 0;
+  std::size_t written_parallel = 0;
+  for (int i = 0; i < repeats; ++i)
+  {
+    double locked = run_locked(items, written_locked);
+    double pipeline = run_pipeline(items, 1, written_pipeline);
+    double parallel = run_pipeline(items, 2, written_parallel);
+
+    if (i == 0 || locked < best_locked)
+      best_locked = locked;
+    if (i == 0 || pipeline < best_pipeline)
+      best_pipeline = pipeline;
+    if (i == 0 || parallel < best_parallel)
+      best_parallel = parallel;
+  }
+
+  if (written_locked != written_pipeline
+      || written_locked != written_parallel)
+  {
+    std::fprintf(stderr, "Mismatched output\n");
+    return 1;
+  }
+
+  std::printf("mutex/condvar threads:  %8.2f ns/item %10.0f items/s\n",
+      best_locked, 1e9 / best_locked);
+  std::printf("pipeline:               %8.2f ns/item %10.0f items/s\n",
+      best_pipeline, 1e9 / best_pipeline);
+  std::printf("pipeline, 2x transform: %8.2f ns/item %10.0f items/s\n",
+      best_parallel, 1e9 / best_parallel);
+
+  return 0;
+}
@@ -0,0 +1,128 @@
+//
+// priority_lanes.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures the queueing latency of control-plane handlers submitted to an
+// io_context that is saturated with bulk handlers, with and without the use of
+// the execution::priority property.
+
+#include <asio/execution/priority.hpp>
+#include <asio/executor_work_guard.hpp>
+#include <asio/io_context.hpp>
+#include <asio/post.hpp>
+#include <asio/require.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock clock_type;
+
+class bulk_work
+{
+public:
+  bulk_work(asio::io_context& ioc, std::atomic<bool>& done, int work_usec)
+    : ioc_(ioc),
+      done_(done),
+      work_usec_(work_usec)
+  {
+  }
+
+  void operator()() const
+  {
+    clock_type::time_point end =
+      clock_type::now() + std::chrono::microseconds(work_usec_);
+    while (clock_type::now() < end)
+      ;
+
+    if (!done_.load(std::memory_order_relaxed))
+      asio::post(ioc_, *this);
+  }
+
+private:
+  asio::io_context& ioc_;
+  std::atomic<bool>& done_;
+  int work_usec_;
+};
+
+template <typename Executor>
+std::vector<double> measure(const Executor& probe_ex, int samples)
+{
+  std::vector<double> latencies(samples);
+  for (int i = 0; i < samples; ++i)
+  {
+    std::atomic<bool> ran(false);
+    clock_type::time_point start = clock_type::now();
+    asio::post(probe_ex,
+        [&latencies, &ran, start, i]
+        {
+          latencies[i] = std::chrono::duration<double, std::micro>(
+              clock_type::now() - start).count();
+          ran.store(true, std::memory_order_release);
+        });
+    while (!ran.load(std::memory_order_acquire))
+      std::this_thread::yield();
+    std::this_thread::sleep_for(std::chrono::microseconds(500));
+  }
+  return latencies;
+}
+
+void report(const char* name, std::vector<double> latencies)
+{
+  std::sort(latencies.begin(), latencies.end());
+  std::size_t n = latencies.size();
+  std::printf("%-10s p50 %10.1f us  p99 %10.1f us  max %10.1f us\n", name,
+      latencies[n / 2], latencies[n * 99 / 100], latencies[n - 1]);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 5)
+  {
+    std::fprintf(stderr,
+        "Usage: priority_lanes <threads> <depth> <work_usec> <samples>\n"
+        "For example:\n"
+        "  priority_lanes 4 1000 10 1000\n");
+    return 1;
+  }
+
+  int threads = std::atoi(argv[1]);
+  int depth = std::atoi(argv[2]);
+  int work_usec = std::atoi(argv[3]);
+  int samples = std::atoi(argv[4]);
+
+  asio::io_context ioc;
+  std::atomic<bool> done(false);
+
+  asio::executor_work_guard<asio::io_context::executor_type> work =
+    asio::make_work_guard(ioc);
+
+  // Saturate the io_context with self-reposting bulk handlers.
+  for (int i = 0; i < depth; ++i)
+    asio::post(ioc, bulk_work(ioc, done, work_usec));
+
+  std::vector<std::thread> pool;
+  for (int i = 0; i < threads; ++i)
+    pool.emplace_back([&ioc]{ ioc.run(); });
+
+  report("normal", measure(ioc.get_executor(), samples));
+  report("priority", measure(
+        asio::require(ioc.get_executor(), asio::execution::priority(1)),
+        samples));
+
+  done = true;
+  work.reset();
+  for (std::size_t i = 0; i < pool.size(); ++i)
+    pool[i].join();
+
+  return 0;
+}
@@ -0,0 +1,264 @@
+//
+// ssl_handshake_flood.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures the round trip latency of a TCP echo connection served by a single
+// threaded io_context, while the same io_context accepts a flood of TLS
+// handshakes. The handshakes are run either inline on the I/O thread or with
+// their engine steps offloaded to a thread_pool.
+
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+#include <asio/read.hpp>
+#include <asio/ssl.hpp>
+#include <asio/thread_pool.hpp>
+#include <asio/write.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using asio::ip::tcp;
+typedef asio::ssl::stream<tcp::socket> ssl_socket;
+typedef std::chrono::steady_clock clock_type;
+
+// Creates a self-signed certificate, so that the benchmark needs no files.
+void use_self_signed_certificate(asio::ssl::context& ctx)
+{
+  EVP_PKEY* pkey = 0;
+  EVP_PKEY_CTX* kctx = ::EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, 0);
+  ::EVP_PKEY_keygen_init(kctx);
+  ::EVP_PKEY_CTX_set_rsa_keygen_bits(kctx, 2048);
+  ::EVP_PKEY_keygen(kctx, &pkey);
+  ::EVP_PKEY_CTX_free(kctx);
+
+  X509* cert = ::X509_new();
+  ::ASN1_INTEGER_set(::X509_get_serialNumber(cert), 1);
+  ::X509_gmtime_adj(X509_get_notBefore(cert), 0);
+  ::X509_gmtime_adj(X509_get_notAfter(cert), 3600);
+  ::X509_set_pubkey(cert, pkey);
+  X509_NAME* name = ::X509_get_subject_name(cert);
+  ::X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+      reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+  ::X509_set_issuer_name(cert, name);
+  ::X509_sign(cert, pkey, ::EVP_sha256());
+
+  ::SSL_CTX_use_certificate(ctx.native_handle(), cert);
+  ::SSL_CTX_use_PrivateKey(ctx.native_handle(), pkey);
+  ::X509_free(cert);
+  ::EVP_PKEY_free(pkey);
+}
+
+// Accepts TLS connections and performs the server side of the handshake.
+class tls_server
+{
+public:
+  tls_server(asio::io_context& ioc, asio::ssl::context& ctx,
+      asio::thread_pool* pool)
+    : acceptor_(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0)),
+      ctx_(ctx),
+      pool_(pool)
+  {
+    accept();
+  }
+
+  tcp::endpoint endpoint() const
+  {
+    return acceptor_.local_endpoint();
+  }
+
+private:
+  void accept()
+  {
+    acceptor_.async_accept(
+        [this](asio::error_code ec, tcp::socket socket)
+        {
+          if (ec)
+            return;
+
+          std::shared_ptr<ssl_socket> stream =
+            std::make_shared<ssl_socket>(std::move(socket), ctx_);
+          if (pool_)
+            stream->async_handshake(asio::ssl::stream_base::server,
+                pool_->get_executor(), [stream](asio::error_code){});
+          else
+            stream->async_handshake(asio::ssl::stream_base::server,
+                [stream](asio::error_code){});
+
+          accept();
+        });
+  }
+
+  tcp::acceptor acceptor_;
+  asio::ssl::context& ctx_;
+  asio::thread_pool* pool_;
+};
+
+// Echoes data on a single plain TCP connection.
+class echo_server
+{
+public:
+  explicit echo_server(asio::io_context& ioc)
+    : acceptor_(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0)),
+      socket_(ioc)
+  {
+    acceptor_.async_accept(socket_,
+        [this](asio::error_code ec)
+        {
+          if (!ec)
+            read();
+        });
+  }
+
+  tcp::endpoint endpoint() const
+  {
+    return acceptor_.local_endpoint();
+  }
+
+private:
+  void read()
+  {
+    socket_.async_read_some(asio::buffer(data_),
+        [this](asio::error_code ec, std::size_t n)
+        {
+          if (!ec)
+            asio::async_write(socket_, asio::buffer(data_, n),
+                [this](asio::error_code ec, std::size_t)
+                {
+                  if (!ec)
+                    read();
+                });
+        });
+  }
+
+  tcp::acceptor acceptor_;
+  tcp::socket socket_;
+  char data_[1024];
+};
+
+// Repeatedly connects to the TLS server and performs a client handshake.
+class flood_client
+{
+public:
+  flood_client(asio::io_context& ioc, asio::ssl::context& ctx,
+      const tcp::endpoint& endpoint, std::atomic<bool>& done)
+    : ioc_(ioc),
+      ctx_(ctx),
+      endpoint_(endpoint),
+      done_(done)
+  {
+  }
+
+  void start()
+  {
+    if (done_.load(std::memory_order_relaxed))
+      return;
+
+    stream_.reset(new ssl_socket(ioc_, ctx_));
+    stream_->lowest_layer().async_connect(endpoint_,
+        [this](asio::error_code ec)
+        {
+          if (ec)
+            return start();
+
+          stream_->async_handshake(asio::ssl::stream_base::client,
+              [this](asio::error_code)
+              {
+                start();
+              });
+        });
+  }
+
+private:
+  asio::io_context& ioc_;
+  asio::ssl::context& ctx_;
+  tcp::endpoint endpoint_;
+  std::atomic<bool>& done_;
+  std::unique_ptr<ssl_socket> stream_;
+};
+
+int main(int argc, char* argv[])
+{
+  if (argc != 5)
+  {
+    std::fprintf(stderr,
+        "Usage: ssl_handshake_flood <connections> <samples> "
+        "{inline|offload} <pool_threads>\n"
+        "For example:\n"
+        "  ssl_handshake_flood 32 2000 offload 2\n");
+    return 1;
+  }
+
+  int connections = std::atoi(argv[1]);
+  int samples = std::atoi(argv[2]);
+  bool offload = (std::strcmp(argv[3], "offload") == 0);
+  int pool_threads = std::atoi(argv[4]);
+
+  asio::ssl::context server_ctx(asio::ssl::context::tls_server);
+  use_self_signed_certificate(server_ctx);
+  asio::ssl::context client_ctx(asio::ssl::context::tls_client);
+  client_ctx.set_verify_mode(asio::ssl::verify_none);
+
+  // The io_context under test runs on a single thread.
+  asio::io_context server_ioc(1);
+  asio::thread_pool pool(pool_threads);
+  tls_server tls(server_ioc, server_ctx, offload ? &pool : 0);
+  echo_server echo(server_ioc);
+  std::thread server_thread([&server_ioc]{ server_ioc.run(); });
+
+  // The handshake flood is generated by a separate io_context and thread.
+  asio::io_context flood_ioc(1);
+  std::atomic<bool> done(false);
+  std::vector<std::unique_ptr<flood_client>> clients;
+  for (int i = 0; i < connections; ++i)
+  {
+    clients.emplace_back(new flood_client(
+          flood_ioc, client_ctx, tls.endpoint(), done));
+    clients.back()->start();
+  }
+  std::thread flood_thread([&flood_ioc]{ flood_ioc.run(); });
+
+  // Measure the echo round trip time from a blocking client.
+  asio::io_context probe_ioc;
+  tcp::socket probe(probe_ioc);
+  probe.connect(echo.endpoint());
+  probe.set_option(tcp::no_delay(true));
+
+  char data[64] = "";
+  std::vector<double> latencies(samples);
+  for (int i = 0; i < samples; ++i)
+  {
+    clock_type::time_point start = clock_type::now();
+    asio::write(probe, asio::buffer(data));
+    asio::read(probe, asio::buffer(data));
+    latencies[i] = std::chrono::duration<double, std::micro>(
+        clock_type::now() - start).count();
+    std::this_thread::sleep_for(std::chrono::microseconds(500));
+  }
+
+  done = true;
+  flood_ioc.stop();
+  flood_thread.join();
+  server_ioc.stop();
+  server_thread.join();
+  pool.join();
+
+  std::sort(latencies.begin(), latencies.end());
+  std::size_t n = latencies.size();
+  std::printf("%-8s p50 %10.1f us  p99 %10.1f us  max %10.1f us\n",
+      offload ? "offload" : "inline", latencies[n / 2],
+      latencies[n * 99 / 100], latencies[n - 1]);
+
+  return 0;
+}
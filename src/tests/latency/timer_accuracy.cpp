@@ -0,0 +1,100 @@
+//
+// timer_accuracy.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures how late a steady_timer's completion handler runs relative to the
+// timer's expiry time, with the reactor's timer busy-waiting configured by the
+// "reactor" / "timer_spin_usec" option.
+
+#include <asio/config.hpp>
+#include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock clock_type;
+
+class pacer
+{
+public:
+  pacer(asio::io_context& ioc, int samples, int interval_usec)
+    : timer_(ioc),
+      interval_(interval_usec),
+      latencies_(samples),
+      next_(0)
+  {
+  }
+
+  void start()
+  {
+    timer_.expires_after(interval_);
+    timer_.async_wait(
+        [this](asio::error_code ec)
+        {
+          if (ec)
+            return;
+
+          latencies_[next_] = std::chrono::duration<double, std::micro>(
+              clock_type::now() - timer_.expiry()).count();
+          if (++next_ < latencies_.size())
+            start();
+        });
+  }
+
+  std::vector<double>& latencies()
+  {
+    return latencies_;
+  }
+
+private:
+  asio::steady_timer timer_;
+  std::chrono::microseconds interval_;
+  std::vector<double> latencies_;
+  std::size_t next_;
+};
+
+int main(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::fprintf(stderr,
+        "Usage: timer_accuracy <samples> <interval_usec> <spin_usec>\n"
+        "For example:\n"
+        "  timer_accuracy 10000 200 50\n");
+    return 1;
+  }
+
+  int samples = std::atoi(argv[1]);
+  int interval_usec = std::atoi(argv[2]);
+  std::string spin_usec = argv[3];
+
+  asio::io_context ioc(
+      asio::config_from_string("reactor.timer_spin_usec=" + spin_usec));
+
+  pacer p(ioc, samples, interval_usec);
+  p.start();
+
+  clock_type::time_point start = clock_type::now();
+  ioc.run();
+  double elapsed = std::chrono::duration<double>(
+      clock_type::now() - start).count();
+
+  std::vector<double>& latencies = p.latencies();
+  std::sort(latencies.begin(), latencies.end());
+  std::size_t n = latencies.size();
+  std::printf("spin %6s us  p50 %8.1f us  p99 %8.1f us  max %8.1f us"
+      "  rate %8.0f/s\n", spin_usec.c_str(), latencies[n / 2],
+      latencies[n * 99 / 100], latencies[n - 1], n / elapsed);
+
+  return 0;
+}
@@ -0,0 +1,99 @@
+//
+// trace_propagation.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures the per-step cost of a composed operation whose completion handler
+// has an associated trace context, compared with one that does not. Each step
+// of the composed operation posts itself back to the io_context, so the cost
+// of every intermediate handler is included.
+
+#include <asio/bind_trace_context.hpp>
+#include <asio/compose.hpp>
+#include <asio/io_context.hpp>
+#include <asio/post.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+typedef std::chrono::steady_clock clock_type;
+
+struct post_loop
+{
+  asio::io_context& ioc_;
+  long remaining_;
+
+  template <typename Self>
+  void operator()(Self& self)
+  {
+    if (remaining_-- > 0)
+      asio::post(ioc_, std::move(self));
+    else
+      self.complete();
+  }
+};
+
+template <typename CompletionToken>
+auto async_post_loop(asio::io_context& ioc, long steps,
+    CompletionToken&& token)
+  -> decltype(
+    asio::async_compose<CompletionToken, void()>(
+      std::declval<post_loop>(), token, ioc))
+{
+  return asio::async_compose<CompletionToken, void()>(
+      post_loop{ioc, steps}, token, ioc);
+}
+
+template <typename Handler>
+double run(long steps, Handler handler)
+{
+  asio::io_context ioc(1);
+  async_post_loop(ioc, steps, handler);
+
+  clock_type::time_point start = clock_type::now();
+  ioc.run();
+  clock_type::time_point stop = clock_type::now();
+
+  return std::chrono::duration<double, std::nano>(stop - start).count()
+    / static_cast<double>(steps);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3)
+  {
+    std::fprintf(stderr,
+        "Usage: trace_propagation <steps> <repeats>\n"
+        "For example:\n"
+        "  trace_propagation 1000000 5\n");
+    return 1;
+  }
+
+  long steps = std::atol(argv[1]);
+  int repeats = std::atoi(argv[2]);
+
+  double best_plain = 0.0;
+  double best_traced = 0.0;
+  for (int i = 0; i < repeats; ++i)
+  {
+    double plain = run(steps, []{});
+    double traced = run(steps,
+        asio::bind_trace_context(asio::trace_context(1, 1), []{}));
+
+    if (i == 0 || plain < best_plain)
+      best_plain = plain;
+    if (i == 0 || traced < best_traced)
+      best_traced = traced;
+  }
+
+  std::printf("untraced: %8.2f ns/step\n", best_plain);
+  std::printf("traced:   %8.2f ns/step\n", best_traced);
+  std::printf("overhead: %8.2f ns/step\n", best_traced - best_plain);
+
+  return 0;
+}
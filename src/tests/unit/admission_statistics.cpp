@@ -0,0 +1,416 @@
+//
+// admission_statistics.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/admission_statistics.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include "asio/config.hpp"
+#include "asio/defer.hpp"
+#include "asio/executor_work_guard.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/post.hpp"
+#include "asio/thread.hpp"
+#include "asio/thread_pool.hpp"
+#include "unit_test.hpp"
+
+using namespace asio;
+namespace bindns = std;
+
+void increment(int* count)
+{
+  ++(*count);
+}
+
+void default_statistics_test()
+{
+  io_context ioc;
+  admission_statistics stats = get_admission_statistics(ioc);
+  ASIO_CHECK(stats.outstanding_work == 0);
+  ASIO_CHECK(stats.handlers_queued == 0);
+  ASIO_CHECK(stats.handlers_over_limit == 0);
+  ASIO_CHECK(stats.handlers_blocked == 0);
+  ASIO_CHECK(stats.handlers_rejected == 0);
+  ASIO_CHECK(stats.handlers_shed == 0);
+  ASIO_CHECK(stats.accepts_over_limit == 0);
+  ASIO_CHECK(stats.reads_over_limit == 0);
+  ASIO_CHECK(stats.accepts_in_flight == 0);
+  ASIO_CHECK(stats.reads_in_flight == 0);
+
+  int count = 0;
+  post(ioc, bindns::bind(increment, &count));
+  post(ioc, bindns::bind(increment, &count));
+  stats = get_admission_statistics(ioc);
+  ASIO_CHECK(stats.outstanding_work == 2);
+  ASIO_CHECK(stats.handlers_over_limit == 0);
+
+  ioc.run();
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(get_admission_statistics(ioc).outstanding_work == 0);
+}
+
+void observe_handler_limit_test()
+{
+  io_context ioc(config_from_string(
+        "admission.handler_limit=2\n"
+        "admission.enforce=0"));
+
+  // Limits that are not enforced are only counted.
+  int count = 0;
+  for (int i = 0; i < 5; ++i)
+    post(ioc, bindns::bind(increment, &count));
+
+  admission_statistics stats = get_admission_statistics(ioc);
+  ASIO_CHECK(stats.outstanding_work == 5);
+  ASIO_CHECK(stats.handlers_queued == 5);
+  ASIO_CHECK(stats.handlers_over_limit == 3);
+
+  ioc.run();
+  ASIO_CHECK(count == 5);
+  ASIO_CHECK(get_admission_statistics(ioc).handlers_queued == 0);
+}
+
+void unattended_handler_limit_test()
+{
+  io_context ioc(config_from_string("admission.handler_limit=4"));
+
+  // No thread is running the io_context, so the producer is not blocked.
+  int count = 0;
+  for (int i = 0; i < 8; ++i)
+    post(ioc, bindns::bind(increment, &count));
+
+  admission_statistics stats = get_admission_statistics(ioc);
+  ASIO_CHECK(stats.handlers_queued == 8);
+  ASIO_CHECK(stats.handlers_over_limit == 4);
+  ASIO_CHECK(stats.handlers_blocked == 0);
+
+  ioc.run();
+  ASIO_CHECK(count == 8);
+  ASIO_CHECK(get_admission_statistics(ioc).handlers_queued == 0);
+}
+
+void handle_read(const asio::error_code&, std::size_t)
+{
+}
+
+void pending_work_not_queued_test()
+{
+  io_context ioc(config_from_string("admission.handler_limit=1"));
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::socket client(ioc);
+  client.connect(acceptor.local_endpoint());
+  ip::tcp::socket server(ioc);
+  acceptor.accept(server);
+
+  // Work guards and pending reads are outstanding work, but are not queued.
+  executor_work_guard<io_context::executor_type> work = make_work_guard(ioc);
+  char buf[1];
+  server.async_read_some(asio::buffer(buf), handle_read);
+
+  int count = 0;
+  post(ioc, bindns::bind(increment, &count));
+  admission_statistics stats = get_admission_statistics(ioc);
+  ASIO_CHECK(stats.outstanding_work == 3);
+  ASIO_CHECK(stats.handlers_queued == 1);
+  ASIO_CHECK(stats.handlers_over_limit == 0);
+
+  ioc.poll();
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(get_admission_statistics(ioc).handlers_queued == 0);
+
+  server.close();
+  work.reset();
+  ioc.restart();
+  ioc.run();
+}
+
+void set_flag(std::atomic<bool>* flag)
+{
+  *flag = true;
+}
+
+void record_queued(io_context* ioc, int* count, long* max_queued)
+{
+  long queued = get_admission_statistics(*ioc).handlers_queued;
+  if (queued > *max_queued)
+    *max_queued = queued;
+  ++(*count);
+
+  // Simulate a slow consumer.
+  std::chrono::steady_clock::time_point end =
+    std::chrono::steady_clock::now() + std::chrono::microseconds(100);
+  while (std::chrono::steady_clock::now() < end)
+    ;
+}
+
+void enforce_handler_limit_test()
+{
+  io_context ioc(config_from_string("admission.handler_limit=3"));
+  executor_work_guard<io_context::executor_type> work = make_work_guard(ioc);
+  asio::thread runner(bindns::bind(
+        static_cast<io_context::count_type (io_context::*)()>(
+          &io_context::run), &ioc));
+
+  // Wait until the runner is running the io_context.
+  std::atomic<bool> running(false);
+  post(ioc, bindns::bind(set_flag, &running));
+  while (!running)
+    std::this_thread::yield();
+
+  // A producer outside the io_context is blocked while the limit is reached.
+  int count = 0;
+  long max_queued = 0;
+  for (int i = 0; i < 50; ++i)
+    post(ioc, bindns::bind(record_queued, &ioc, &count, &max_queued));
+
+  work.reset();
+  runner.join();
+
+  ASIO_CHECK(count == 50);
+  ASIO_CHECK(max_queued <= 3);
+  admission_statistics stats = get_admission_statistics(ioc);
+  ASIO_CHECK(stats.handlers_over_limit > 0);
+  ASIO_CHECK(stats.handlers_blocked > 0);
+  ASIO_CHECK(stats.handlers_queued == 0);
+}
+
+void wait_for_flag(std::atomic<bool>* started, std::atomic<bool>* release)
+{
+  *started = true;
+  while (!*release)
+    std::this_thread::yield();
+}
+
+void stop_and_release(io_context* ioc, std::atomic<bool>* release)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ioc->stop();
+  *release = true;
+}
+
+void stop_releases_blocked_producer_test()
+{
+  io_context ioc(config_from_string("admission.handler_limit=1"));
+  executor_work_guard<io_context::executor_type> work = make_work_guard(ioc);
+  asio::thread runner(bindns::bind(
+        static_cast<io_context::count_type (io_context::*)()>(
+          &io_context::run), &ioc));
+
+  // Occupy the runner, then fill the queue.
+  std::atomic<bool> started(false), release(false);
+  post(ioc, bindns::bind(wait_for_flag, &started, &release));
+  while (!started)
+    std::this_thread::yield();
+  int count = 0;
+  post(ioc, bindns::bind(increment, &count));
+
+  // The next producer is blocked until the runner stops.
+  asio::thread stopper(bindns::bind(stop_and_release, &ioc, &release));
+  post(ioc, bindns::bind(increment, &count));
+  runner.join();
+  stopper.join();
+
+  admission_statistics stats = get_admission_statistics(ioc);
+  ASIO_CHECK(stats.handlers_blocked == 1);
+  ASIO_CHECK(stats.handlers_queued == 2);
+
+  work.reset();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(count == 2);
+}
+
+void reject_handler_limit_test()
+{
+  io_context ioc(config_from_string(
+        "admission.handler_limit=1\n"
+        "admission.handler_policy=reject"));
+
+  int count = 0;
+  post(ioc, bindns::bind(increment, &count));
+
+  asio::error_code ec;
+  try
+  {
+    post(ioc, bindns::bind(increment, &count));
+  }
+  catch (asio::system_error& e)
+  {
+    ec = e.code();
+  }
+  ASIO_CHECK(ec == asio::error::no_buffer_space);
+
+  // Continuations are never refused.
+  defer(ioc, bindns::bind(increment, &count));
+
+  admission_statistics stats = get_admission_statistics(ioc);
+  ASIO_CHECK(stats.handlers_queued == 2);
+  ASIO_CHECK(stats.handlers_over_limit == 1);
+  ASIO_CHECK(stats.handlers_rejected == 1);
+
+  ioc.run();
+  ASIO_CHECK(count == 2);
+}
+
+void thread_pool_shed_handler_limit_test()
+{
+  thread_pool pool(1, config_from_string(
+        "admission.handler_limit=1\n"
+        "admission.handler_policy=shed"));
+
+  // Occupy the pool's thread, so that the queue fills.
+  std::atomic<bool> started(false), release(false);
+  post(pool, bindns::bind(wait_for_flag, &started, &release));
+  while (!started)
+    std::this_thread::yield();
+
+  int count = 0;
+  post(pool, bindns::bind(increment, &count));
+  post(pool, bindns::bind(increment, &count));
+  release = true;
+  pool.join();
+
+  ASIO_CHECK(count == 1);
+  admission_statistics stats = get_admission_statistics(pool);
+  ASIO_CHECK(stats.handlers_over_limit == 1);
+  ASIO_CHECK(stats.handlers_shed == 1);
+  ASIO_CHECK(stats.handlers_queued == 0);
+}
+
+void record_error(const asio::error_code& err, asio::error_code* result)
+{
+  *result = err;
+}
+
+void accept_limit_test()
+{
+  io_context ioc(config_from_string(
+        "admission.accept_limit=1\n"
+        "admission.read_limit=1"));
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::socket s1(ioc);
+  ip::tcp::socket s2(ioc);
+  ip::tcp::socket s3(ioc);
+
+  // Other outstanding work does not count towards the accept limit.
+  executor_work_guard<io_context::executor_type> work = make_work_guard(ioc);
+  int count = 0;
+  post(ioc, bindns::bind(increment, &count));
+
+  asio::error_code ec1, ec2, ec3;
+  acceptor.async_accept(s1, bindns::bind(record_error,
+        bindns::placeholders::_1, &ec1));
+
+  // The first accept is in flight, so the second exceeds the limit.
+  acceptor.async_accept(s2, bindns::bind(record_error,
+        bindns::placeholders::_1, &ec2));
+
+  ioc.poll();
+  ASIO_CHECK(!ec1);
+  ASIO_CHECK(ec2 == asio::error::no_buffer_space);
+  admission_statistics stats = get_admission_statistics(ioc);
+  ASIO_CHECK(stats.accepts_over_limit == 1);
+  ASIO_CHECK(stats.accepts_in_flight == 1);
+
+  // Accepts are not subject to the read limit.
+  ASIO_CHECK(stats.reads_over_limit == 0);
+  ASIO_CHECK(stats.reads_in_flight == 0);
+
+  // Once the first accept completes, a new one is admitted.
+  ip::tcp::socket client(ioc);
+  client.connect(acceptor.local_endpoint());
+  ioc.restart();
+  while (get_admission_statistics(ioc).accepts_in_flight != 0)
+    ioc.run_one();
+  ASIO_CHECK(!ec1);
+  ASIO_CHECK(s1.is_open());
+
+  acceptor.async_accept(s3, bindns::bind(record_error,
+        bindns::placeholders::_1, &ec3));
+  ASIO_CHECK(get_admission_statistics(ioc).accepts_in_flight == 1);
+
+  acceptor.close();
+  work.reset();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(ec3 == asio::error::operation_aborted);
+  ASIO_CHECK(get_admission_statistics(ioc).accepts_in_flight == 0);
+  ASIO_CHECK(get_admission_statistics(ioc).accepts_over_limit == 1);
+}
+
+void record_read(const asio::error_code& err,
+    std::size_t, asio::error_code* result)
+{
+  *result = err;
+}
+
+void read_limit_test()
+{
+  io_context ioc(config_from_string("admission.read_limit=1"));
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::socket client(ioc);
+  client.connect(acceptor.local_endpoint());
+  ip::tcp::socket server(ioc);
+  acceptor.accept(server);
+
+  // Waits do not count towards the read limit.
+  asio::error_code wait_ec;
+  client.async_wait(ip::tcp::socket::wait_read,
+      bindns::bind(record_error, bindns::placeholders::_1, &wait_ec));
+
+  char buf1[1], buf2[1];
+  asio::error_code ec1, ec2;
+  server.async_read_some(asio::buffer(buf1), bindns::bind(record_read,
+        bindns::placeholders::_1, bindns::placeholders::_2, &ec1));
+
+  // The first read is in flight, so the second exceeds the limit.
+  client.async_read_some(asio::buffer(buf2), bindns::bind(record_read,
+        bindns::placeholders::_1, bindns::placeholders::_2, &ec2));
+
+  ioc.poll();
+  ASIO_CHECK(ec2 == asio::error::no_buffer_space);
+  admission_statistics stats = get_admission_statistics(ioc);
+  ASIO_CHECK(stats.reads_over_limit == 1);
+  ASIO_CHECK(stats.reads_in_flight == 1);
+
+  server.close();
+  client.close();
+  ioc.run();
+  ASIO_CHECK(ec1 == asio::error::operation_aborted);
+  ASIO_CHECK(wait_ec == asio::error::operation_aborted);
+  ASIO_CHECK(get_admission_statistics(ioc).reads_in_flight == 0);
+}
+
+ASIO_TEST_SUITE
+(
+  "admission_statistics",
+  ASIO_TEST_CASE(default_statistics_test)
+  ASIO_TEST_CASE(observe_handler_limit_test)
+  ASIO_TEST_CASE(unattended_handler_limit_test)
+  ASIO_TEST_CASE(pending_work_not_queued_test)
+  ASIO_TEST_CASE(enforce_handler_limit_test)
+  ASIO_TEST_CASE(stop_releases_blocked_producer_test)
+  ASIO_TEST_CASE(reject_handler_limit_test)
+  ASIO_TEST_CASE(thread_pool_shed_handler_limit_test)
+  ASIO_TEST_CASE(accept_limit_test)
+  ASIO_TEST_CASE(read_limit_test)
+)
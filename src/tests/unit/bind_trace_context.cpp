@@ -0,0 +1,247 @@
+//
+// bind_trace_context.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/bind_trace_context.hpp"
+
+#include "asio/compose.hpp"
+#include "asio/deferred.hpp"
+#include "asio/detached.hpp"
+#include "asio/experimental/parallel_group.hpp"
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/steady_timer.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_CO_AWAIT)
+# include "asio/co_spawn.hpp"
+# include "asio/use_awaitable.hpp"
+#endif // defined(ASIO_HAS_CO_AWAIT)
+
+using namespace asio;
+
+void bind_trace_context_to_function_object_test()
+{
+  io_context ioc;
+  trace_context tc(1234, 5678);
+
+  trace_context seen;
+  post(ioc,
+      bind_trace_context(tc,
+        [&]{ seen = trace_context::current(); }));
+
+  ASIO_CHECK(!trace_context::current());
+
+  ioc.run();
+
+  ASIO_CHECK(seen == tc);
+  ASIO_CHECK(!trace_context::current());
+
+  // The innermost binding is current while the target runs.
+  trace_context tc2(4321, 8765);
+  auto bound = bind_trace_context(tc,
+      bind_trace_context(tc2,
+        [&]{ seen = trace_context::current(); }));
+  ASIO_CHECK(get_associated_trace_context(bound) == tc);
+  bound();
+  ASIO_CHECK(seen == tc2);
+  ASIO_CHECK(!trace_context::current());
+}
+
+void partial_bind_trace_context_test()
+{
+  io_context ioc;
+  trace_context tc(1234);
+
+  trace_context seen;
+  post(ioc,
+      bind_trace_context(tc)(
+        [&]{ seen = trace_context::current(); }));
+
+  ioc.run();
+
+  ASIO_CHECK(seen == tc);
+  ASIO_CHECK(seen.trace_id() == 1234);
+  ASIO_CHECK(seen.span_id() == 0);
+}
+
+struct two_step_wait
+{
+  steady_timer& timer_;
+  trace_context* step_contexts_;
+  trace_context* associated_contexts_;
+  int step_;
+
+  template <typename Self>
+  void operator()(Self& self, asio::error_code = asio::error_code())
+  {
+    step_contexts_[step_] = trace_context::current();
+    associated_contexts_[step_] = get_associated_trace_context(self);
+    if (step_++ < 2)
+    {
+      timer_.expires_after(asio::chrono::milliseconds(1));
+      timer_.async_wait(std::move(self));
+    }
+    else
+      self.complete();
+  }
+};
+
+template <typename CompletionToken>
+auto async_two_step_wait(steady_timer& timer,
+    trace_context* step_contexts, trace_context* associated_contexts,
+    CompletionToken&& token)
+  -> decltype(
+    asio::async_compose<CompletionToken, void()>(
+      declval<two_step_wait>(), token, timer))
+{
+  return asio::async_compose<CompletionToken, void()>(
+      two_step_wait{timer, step_contexts, associated_contexts, 0},
+      token, timer);
+}
+
+void compose_trace_context_test()
+{
+  io_context ioc;
+  steady_timer timer(ioc);
+  trace_context tc(42, 1);
+
+  trace_context step_contexts[3];
+  trace_context associated_contexts[3];
+  trace_context seen;
+  async_two_step_wait(timer, step_contexts, associated_contexts,
+      bind_trace_context(tc,
+        [&]{ seen = trace_context::current(); }));
+
+  ioc.run();
+
+  for (int i = 0; i < 3; ++i)
+  {
+    ASIO_CHECK(step_contexts[i] == tc);
+    ASIO_CHECK(associated_contexts[i] == tc);
+  }
+  ASIO_CHECK(seen == tc);
+
+  // Without a bound trace context, the composed operation neither sets nor
+  // clears the current trace context.
+  async_two_step_wait(timer, step_contexts, associated_contexts,
+      [&]{ seen = trace_context::current(); });
+
+  ioc.restart();
+  ioc.run();
+
+  for (int i = 0; i < 3; ++i)
+  {
+    ASIO_CHECK(!step_contexts[i]);
+    ASIO_CHECK(!associated_contexts[i]);
+  }
+  ASIO_CHECK(!seen);
+}
+
+void parallel_group_trace_context_test()
+{
+  io_context ioc;
+  steady_timer timer1(ioc);
+  steady_timer timer2(ioc);
+  trace_context tc(7, 8);
+
+  trace_context step_contexts1[3];
+  trace_context associated_contexts1[3];
+  trace_context step_contexts2[3];
+  trace_context associated_contexts2[3];
+  trace_context seen;
+
+  experimental::make_parallel_group(
+      async_two_step_wait(timer1,
+        step_contexts1, associated_contexts1, deferred),
+      async_two_step_wait(timer2,
+        step_contexts2, associated_contexts2, deferred)
+    ).async_wait(
+      experimental::wait_for_all(),
+      bind_trace_context(tc,
+        [&](std::array<std::size_t, 2>)
+        {
+          seen = trace_context::current();
+        }));
+
+  ioc.run();
+
+  for (int i = 0; i < 3; ++i)
+  {
+    ASIO_CHECK(step_contexts1[i] == tc);
+    ASIO_CHECK(associated_contexts1[i] == tc);
+    ASIO_CHECK(step_contexts2[i] == tc);
+    ASIO_CHECK(associated_contexts2[i] == tc);
+  }
+  ASIO_CHECK(seen == tc);
+}
+
+#if defined(ASIO_HAS_CO_AWAIT)
+
+awaitable<trace_context> nested_coroutine()
+{
+  steady_timer timer(co_await this_coro::executor);
+  timer.expires_after(asio::chrono::milliseconds(1));
+  co_await timer.async_wait(use_awaitable);
+  co_return trace_context::current();
+}
+
+awaitable<void> traced_coroutine(trace_context* contexts)
+{
+  contexts[0] = trace_context::current();
+
+  steady_timer timer(co_await this_coro::executor);
+  timer.expires_after(asio::chrono::milliseconds(1));
+  co_await timer.async_wait(use_awaitable);
+
+  contexts[1] = trace_context::current();
+  contexts[2] = co_await nested_coroutine();
+  contexts[3] = co_await co_spawn(
+      co_await this_coro::executor, nested_coroutine(), use_awaitable);
+}
+
+void co_spawn_trace_context_test()
+{
+  io_context ioc;
+  trace_context tc(99, 100);
+
+  trace_context contexts[4];
+  co_spawn(ioc, traced_coroutine(contexts),
+      bind_trace_context(tc, detached));
+
+  ioc.run();
+
+  for (int i = 0; i < 4; ++i)
+    ASIO_CHECK(contexts[i] == tc);
+  ASIO_CHECK(!trace_context::current());
+}
+
+#else // defined(ASIO_HAS_CO_AWAIT)
+
+void co_spawn_trace_context_test()
+{
+}
+
+#endif // defined(ASIO_HAS_CO_AWAIT)
+
+ASIO_TEST_SUITE
+(
+  "bind_trace_context",
+  ASIO_TEST_CASE(bind_trace_context_to_function_object_test)
+  ASIO_TEST_CASE(partial_bind_trace_context_test)
+  ASIO_TEST_CASE(compose_trace_context_test)
+  ASIO_TEST_CASE(parallel_group_trace_context_test)
+  ASIO_TEST_CASE(co_spawn_trace_context_test)
+)
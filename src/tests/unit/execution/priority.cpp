@@ -0,0 +1,111 @@
+//
+// priority.cpp
+// ~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/execution/priority.hpp"
+
+#include "asio/io_context.hpp"
+#include "asio/prefer.hpp"
+#include "asio/query.hpp"
+#include "asio/require.hpp"
+#include "../unit_test.hpp"
+
+namespace exec = asio::execution;
+
+struct ex_nq_nr
+{
+  template <typename F>
+  void execute(const F&) const
+  {
+  }
+
+  friend bool operator==(const ex_nq_nr&, const ex_nq_nr&) noexcept
+  {
+    return true;
+  }
+
+  friend bool operator!=(const ex_nq_nr&, const ex_nq_nr&) noexcept
+  {
+    return false;
+  }
+};
+
+#if !defined(ASIO_HAS_DEDUCED_EXECUTION_IS_EXECUTOR_TRAIT)
+
+namespace asio {
+namespace execution {
+
+template <>
+struct is_executor<ex_nq_nr> : asio::true_type
+{
+};
+
+} // namespace execution
+} // namespace asio
+
+#endif // !defined(ASIO_HAS_DEDUCED_EXECUTION_IS_EXECUTOR_TRAIT)
+
+void test_property_value()
+{
+  constexpr exec::priority_t p0 = exec::priority;
+  constexpr exec::priority_t p2 = exec::priority(2);
+
+  ASIO_CHECK(p0.value() == 0);
+  ASIO_CHECK(p2.value() == 2);
+  ASIO_CHECK(exec::priority_t::is_requirable);
+  ASIO_CHECK(exec::priority_t::is_preferable);
+}
+
+void test_can_require()
+{
+  ASIO_CHECK((!asio::can_require<ex_nq_nr, exec::priority_t>::value));
+  ASIO_CHECK((asio::can_prefer<ex_nq_nr, exec::priority_t>::value));
+  ASIO_CHECK((asio::can_require<
+        asio::io_context::executor_type, exec::priority_t>::value));
+}
+
+void test_io_context_executor()
+{
+  asio::io_context ctx;
+  asio::io_context::executor_type ex1 = ctx.get_executor();
+
+  ASIO_CHECK(asio::query(ex1, exec::priority) == 0);
+
+  auto ex2 = asio::require(ex1, exec::priority(2));
+  ASIO_CHECK(asio::query(ex2, exec::priority) == 2);
+  ASIO_CHECK(&asio::query(ex2, exec::context) == &ctx);
+
+  auto ex3 = asio::require(ex2, exec::blocking.never);
+  ASIO_CHECK(asio::query(ex3, exec::priority) == 2);
+  ASIO_CHECK(asio::query(ex3, exec::blocking) == exec::blocking.never);
+
+  auto ex4 = asio::require(ex3, exec::priority(1));
+  ASIO_CHECK(asio::query(ex4, exec::priority) == 1);
+  ASIO_CHECK(ex3 != ex4);
+
+  auto ex5 = asio::prefer(ex1, exec::priority(3));
+  ASIO_CHECK(asio::query(ex5, exec::priority) == 3);
+
+  auto ex6 = asio::prefer(ex_nq_nr(), exec::priority(3));
+  (void)ex6;
+}
+
+ASIO_TEST_SUITE
+(
+  "priority",
+  ASIO_TEST_CASE(test_property_value)
+  ASIO_TEST_CASE(test_can_require)
+  ASIO_TEST_CASE(test_io_context_executor)
+)
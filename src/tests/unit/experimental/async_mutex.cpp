@@ -0,0 +1,300 @@
+//
+// experimental/async_mutex.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/experimental/async_mutex.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "asio/bind_cancellation_slot.hpp"
+#include "asio/bind_immediate_executor.hpp"
+#include "asio/cancellation_signal.hpp"
+#include "asio/error.hpp"
+#include "asio/inline_executor.hpp"
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/thread_pool.hpp"
+#include "../unit_test.hpp"
+
+#if defined(ASIO_HAS_CO_AWAIT)
+# include "asio/co_spawn.hpp"
+# include "asio/detached.hpp"
+# include "asio/steady_timer.hpp"
+# include "asio/use_awaitable.hpp"
+#endif // defined(ASIO_HAS_CO_AWAIT)
+
+using namespace asio;
+using namespace asio::experimental;
+
+void lock_unlock_test()
+{
+  io_context ctx;
+  async_mutex mtx(ctx);
+
+  ASIO_CHECK(!mtx.is_locked());
+
+  bool locked = false;
+  mtx.async_lock(
+      bind_immediate_executor(inline_executor(),
+        [&](asio::error_code ec){ locked = !ec; }));
+  ASIO_CHECK(locked);
+  ASIO_CHECK(mtx.is_locked());
+  ASIO_CHECK(!mtx.try_lock());
+
+  std::vector<int> order;
+  for (int i = 0; i < 3; ++i)
+    mtx.async_lock([&, i](asio::error_code ec){ if (!ec) order.push_back(i); });
+
+  ctx.restart();
+  ctx.poll();
+  ASIO_CHECK(order.empty());
+
+  // Ownership passes to each waiter in turn.
+  for (int i = 0; i < 3; ++i)
+  {
+    mtx.unlock();
+    ASIO_CHECK(mtx.is_locked());
+    ctx.restart();
+    ctx.poll();
+    ASIO_CHECK(order.size() == static_cast<std::size_t>(i + 1));
+    ASIO_CHECK(order[i] == i);
+  }
+
+  mtx.unlock();
+  ASIO_CHECK(!mtx.is_locked());
+  ASIO_CHECK(mtx.try_lock());
+  mtx.unlock();
+}
+
+void cancelled_lock_test()
+{
+  io_context ctx;
+  async_mutex mtx(ctx);
+
+  ASIO_CHECK(mtx.try_lock());
+
+  cancellation_signal sig;
+  asio::error_code ec1, ec2;
+  mtx.async_lock(
+      bind_cancellation_slot(sig.slot(),
+        [&](asio::error_code ec){ ec1 = ec; }));
+  mtx.async_lock([&](asio::error_code ec){ ec2 = ec; });
+
+  sig.emit(cancellation_type::partial);
+  ctx.poll();
+  ASIO_CHECK(ec1 == asio::error::operation_aborted);
+
+  mtx.unlock();
+  ctx.restart();
+  ctx.poll();
+  ASIO_CHECK(!ec2);
+  ASIO_CHECK(mtx.is_locked());
+
+  mtx.unlock();
+  ASIO_CHECK(!mtx.is_locked());
+}
+
+void concurrent_lock_test()
+{
+  thread_pool pool(4);
+  async_mutex mtx(pool);
+
+  int counter = 0;
+  bool inside = false;
+
+  struct lock_loop
+  {
+    async_mutex* mtx_;
+    int* counter_;
+    bool* inside_;
+    int remaining_;
+
+    void operator()(asio::error_code ec)
+    {
+      ASIO_CHECK(!ec);
+      ASIO_CHECK(!*inside_);
+      *inside_ = true;
+      ++*counter_;
+      *inside_ = false;
+      mtx_->unlock();
+      if (--remaining_ > 0)
+        mtx_->async_lock(*this);
+    }
+  };
+
+  for (int i = 0; i < 8; ++i)
+  {
+    post(pool,
+        [&]
+        {
+          mtx.async_lock(lock_loop{&mtx, &counter, &inside, 500});
+        });
+  }
+
+  pool.join();
+
+  ASIO_CHECK(counter == 4000);
+  ASIO_CHECK(!mtx.is_locked());
+}
+
+struct critical_section
+{
+  std::atomic<int> inside_;
+  std::atomic<int> violations_;
+
+  void enter()
+  {
+    if (inside_.fetch_add(1) != 0)
+      ++violations_;
+  }
+
+  void leave()
+  {
+    inside_.fetch_sub(1);
+  }
+};
+
+void cancel_unlock_race_test()
+{
+  thread_pool pool(4);
+  async_mutex mtx(pool);
+
+  critical_section cs;
+  cs.inside_ = 0;
+  cs.violations_ = 0;
+
+  for (int i = 0; i < 2000; ++i)
+  {
+    std::atomic<int> remaining(4);
+
+    // The lock is held while a waiter is queued.
+    ASIO_CHECK(mtx.try_lock());
+    cs.enter();
+
+    cancellation_signal sig;
+    mtx.async_lock(
+        bind_cancellation_slot(sig.slot(),
+          [&](asio::error_code ec)
+          {
+            if (!ec)
+            {
+              cs.enter();
+              cs.leave();
+              mtx.unlock();
+            }
+            --remaining;
+          }));
+
+    // Cancel the waiter while the lock is released and contended.
+    post(pool,
+        [&]
+        {
+          sig.emit(cancellation_type::partial);
+          --remaining;
+        });
+
+    post(pool,
+        [&]
+        {
+          cs.leave();
+          mtx.unlock();
+          --remaining;
+        });
+
+    post(pool,
+        [&]
+        {
+          if (mtx.try_lock())
+          {
+            cs.enter();
+            cs.leave();
+            mtx.unlock();
+            --remaining;
+          }
+          else
+          {
+            mtx.async_lock(
+                [&](asio::error_code ec)
+                {
+                  ASIO_CHECK(!ec);
+                  cs.enter();
+                  cs.leave();
+                  mtx.unlock();
+                  --remaining;
+                });
+          }
+        });
+
+    while (remaining != 0)
+      std::this_thread::yield();
+  }
+
+  pool.join();
+
+  ASIO_CHECK(cs.violations_ == 0);
+  ASIO_CHECK(!mtx.is_locked());
+}
+
+#if defined(ASIO_HAS_CO_AWAIT)
+
+awaitable<void> locked_writer(async_mutex& mtx,
+    std::vector<int>& output, int id)
+{
+  steady_timer timer(co_await this_coro::executor);
+  for (int i = 0; i < 3; ++i)
+  {
+    co_await mtx.async_lock(use_awaitable);
+    output.push_back(id);
+    timer.expires_after(asio::chrono::milliseconds(1));
+    co_await timer.async_wait(use_awaitable);
+    output.push_back(id);
+    mtx.unlock();
+  }
+}
+
+void coroutine_lock_test()
+{
+  io_context ctx;
+  async_mutex mtx(ctx);
+
+  std::vector<int> output;
+  co_spawn(ctx, locked_writer(mtx, output, 1), detached);
+  co_spawn(ctx, locked_writer(mtx, output, 2), detached);
+  ctx.run();
+
+  // Each pair of entries is written while holding the lock.
+  ASIO_CHECK(output.size() == 12);
+  for (std::size_t i = 0; i + 1 < output.size(); i += 2)
+    ASIO_CHECK(output[i] == output[i + 1]);
+}
+
+#else // defined(ASIO_HAS_CO_AWAIT)
+
+void coroutine_lock_test()
+{
+}
+
+#endif // defined(ASIO_HAS_CO_AWAIT)
+
+ASIO_TEST_SUITE
+(
+  "experimental/async_mutex",
+  ASIO_TEST_CASE(lock_unlock_test)
+  ASIO_TEST_CASE(cancelled_lock_test)
+  ASIO_TEST_CASE(concurrent_lock_test)
+  ASIO_TEST_CASE(cancel_unlock_race_test)
+  ASIO_TEST_CASE(coroutine_lock_test)
+)
@@ -0,0 +1,136 @@
+//
+// experimental/async_rate_limiter.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/experimental/async_rate_limiter.hpp"
+
+#include <vector>
+#include "asio/bind_cancellation_slot.hpp"
+#include "asio/bind_immediate_executor.hpp"
+#include "asio/cancellation_signal.hpp"
+#include "asio/error.hpp"
+#include "asio/inline_executor.hpp"
+#include "asio/io_context.hpp"
+#include "../unit_test.hpp"
+
+using namespace asio;
+using namespace asio::experimental;
+
+typedef async_rate_limiter::clock_type clock_type;
+
+void burst_test()
+{
+  io_context ctx;
+  async_rate_limiter limiter(ctx, 10, asio::chrono::seconds(1), 5);
+
+  ASIO_CHECK(limiter.burst() == 5);
+
+  // The bucket starts full.
+  int completed = 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    limiter.async_acquire(1,
+        bind_immediate_executor(inline_executor(),
+          [&](asio::error_code ec)
+          {
+            ASIO_CHECK(!ec);
+            ++completed;
+          }));
+  }
+  ASIO_CHECK(completed == 3);
+  ASIO_CHECK(limiter.try_acquire(2));
+  ASIO_CHECK(!limiter.try_acquire());
+
+  // Asking for more than the burst size can never succeed.
+  asio::error_code ec1;
+  limiter.async_acquire(6,
+      bind_immediate_executor(inline_executor(),
+        [&](asio::error_code ec){ ec1 = ec; }));
+  ASIO_CHECK(ec1 == asio::error::invalid_argument);
+}
+
+void waiting_acquire_test()
+{
+  io_context ctx;
+  async_rate_limiter limiter(ctx, 100, asio::chrono::seconds(1), 1);
+
+  clock_type::time_point start = clock_type::now();
+
+  std::vector<int> order;
+  for (int i = 0; i < 4; ++i)
+  {
+    limiter.async_acquire(1,
+        [&, i](asio::error_code ec)
+        {
+          ASIO_CHECK(!ec);
+          order.push_back(i);
+        });
+  }
+
+  // Waiters block new acquisitions so that they are not starved.
+  ASIO_CHECK(!limiter.try_acquire());
+
+  ctx.run();
+
+  ASIO_CHECK(order.size() == 4);
+  for (int i = 0; i < 4; ++i)
+    ASIO_CHECK(order[i] == i);
+
+  // One token was available immediately, and the others arrive at 10ms
+  // intervals.
+  ASIO_CHECK(clock_type::now() - start >= asio::chrono::milliseconds(30));
+}
+
+void cancelled_acquire_test()
+{
+  io_context ctx;
+  async_rate_limiter limiter(ctx, 1, asio::chrono::seconds(60), 1);
+
+  ASIO_CHECK(limiter.try_acquire());
+
+  cancellation_signal sig;
+  asio::error_code ec1, ec2, ec3;
+  limiter.async_acquire(1,
+      bind_cancellation_slot(sig.slot(),
+        [&](asio::error_code ec){ ec1 = ec; }));
+  limiter.async_acquire(1, [&](asio::error_code ec){ ec2 = ec; });
+
+  sig.emit(cancellation_type::terminal);
+  ctx.poll();
+  ASIO_CHECK(ec1 == asio::error::operation_aborted);
+  ASIO_CHECK(!ec2);
+
+  ASIO_CHECK(limiter.cancel() == 1);
+  ctx.poll();
+  ASIO_CHECK(ec2 == asio::error::operation_aborted);
+
+  // Destroying the rate limiter cancels waiting operations.
+  {
+    async_rate_limiter limiter2(ctx, 1, asio::chrono::seconds(60), 1);
+    ASIO_CHECK(limiter2.try_acquire());
+    limiter2.async_acquire(1, [&](asio::error_code ec){ ec3 = ec; });
+  }
+  ctx.restart();
+  ctx.run();
+  ASIO_CHECK(ec3 == asio::error::operation_aborted);
+}
+
+ASIO_TEST_SUITE
+(
+  "experimental/async_rate_limiter",
+  ASIO_TEST_CASE(burst_test)
+  ASIO_TEST_CASE(waiting_acquire_test)
+  ASIO_TEST_CASE(cancelled_acquire_test)
+)
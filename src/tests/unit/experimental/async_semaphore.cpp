@@ -0,0 +1,263 @@
+//
+// experimental/async_semaphore.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/experimental/async_semaphore.hpp"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "asio/bind_allocator.hpp"
+#include "asio/bind_cancellation_slot.hpp"
+#include "asio/bind_immediate_executor.hpp"
+#include "asio/cancellation_signal.hpp"
+#include "asio/error.hpp"
+#include "asio/inline_executor.hpp"
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/thread_pool.hpp"
+#include "../unit_test.hpp"
+
+using namespace asio;
+using namespace asio::experimental;
+
+struct allocation_counts
+{
+  int total;
+  int live;
+};
+
+template <typename T>
+class counting_allocator
+{
+public:
+  typedef T value_type;
+
+  explicit counting_allocator(allocation_counts* counts)
+    : counts_(counts)
+  {
+  }
+
+  template <typename U>
+  counting_allocator(const counting_allocator<U>& other)
+    : counts_(other.counts_)
+  {
+  }
+
+  T* allocate(std::size_t n)
+  {
+    ++counts_->total;
+    ++counts_->live;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n)
+  {
+    --counts_->live;
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  bool operator==(const counting_allocator& other) const
+  {
+    return counts_ == other.counts_;
+  }
+
+  bool operator!=(const counting_allocator& other) const
+  {
+    return counts_ != other.counts_;
+  }
+
+  allocation_counts* counts_;
+};
+
+void uncontended_acquire_test()
+{
+  io_context ctx;
+  allocation_counts counts = { 0, 0 };
+  async_semaphore sem(ctx, 2);
+
+  ASIO_CHECK(sem.available() == 2);
+
+  int completed = 0;
+  for (int i = 0; i < 2; ++i)
+  {
+    sem.async_acquire(
+        bind_immediate_executor(inline_executor(),
+          bind_allocator(counting_allocator<int>(&counts),
+            [&](asio::error_code ec)
+            {
+              ASIO_CHECK(!ec);
+              ++completed;
+            })));
+  }
+
+  ASIO_CHECK(completed == 2);
+  ASIO_CHECK(counts.total == 0);
+  ASIO_CHECK(sem.available() == 0);
+  ASIO_CHECK(!sem.try_acquire());
+
+  sem.release();
+  ASIO_CHECK(sem.available() == 1);
+  ASIO_CHECK(sem.try_acquire());
+  ASIO_CHECK(sem.available() == 0);
+
+  // Without an immediate executor, the handler is not called from inside the
+  // initiating function.
+  sem.release();
+  bool acquired = false;
+  sem.async_acquire([&](asio::error_code ec){ acquired = !ec; });
+  ASIO_CHECK(!acquired);
+  ctx.restart();
+  ctx.run();
+  ASIO_CHECK(acquired);
+}
+
+void waiting_acquire_test()
+{
+  io_context ctx;
+  allocation_counts counts = { 0, 0 };
+  async_semaphore sem(ctx, 1);
+
+  ASIO_CHECK(sem.try_acquire());
+
+  std::vector<int> order;
+  for (int i = 0; i < 3; ++i)
+  {
+    sem.async_acquire(
+        bind_allocator(counting_allocator<int>(&counts),
+          [&, i](asio::error_code ec)
+          {
+            ASIO_CHECK(!ec);
+            order.push_back(i);
+          }));
+  }
+
+  ASIO_CHECK(counts.live == 3);
+  ctx.poll();
+  ASIO_CHECK(order.empty());
+
+  // Permits are handed to waiters in order, and never through the count.
+  sem.release();
+  ASIO_CHECK(sem.available() == 0);
+  ASIO_CHECK(!sem.try_acquire());
+  ctx.poll();
+  ASIO_CHECK(order.size() == 1);
+  ASIO_CHECK(order[0] == 0);
+
+  sem.release(3);
+  ASIO_CHECK(sem.available() == 1);
+  ctx.poll();
+  ASIO_CHECK(order.size() == 3);
+  ASIO_CHECK(order[1] == 1);
+  ASIO_CHECK(order[2] == 2);
+  ASIO_CHECK(counts.live == 0);
+}
+
+void cancelled_acquire_test()
+{
+  io_context ctx;
+  async_semaphore sem(ctx, 0);
+
+  cancellation_signal sig;
+  asio::error_code ec1, ec2, ec3;
+  sem.async_acquire(
+      bind_cancellation_slot(sig.slot(),
+        [&](asio::error_code ec){ ec1 = ec; }));
+  sem.async_acquire([&](asio::error_code ec){ ec2 = ec; });
+
+  sig.emit(cancellation_type::terminal);
+  ctx.poll();
+  ASIO_CHECK(ec1 == asio::error::operation_aborted);
+
+  // The cancelled operation no longer waits for a permit.
+  sem.release();
+  ctx.poll();
+  ASIO_CHECK(!ec2);
+  ASIO_CHECK(sem.available() == 0);
+
+  sem.async_acquire([&](asio::error_code ec){ ec3 = ec; });
+  ASIO_CHECK(sem.cancel() == 1);
+  ctx.restart();
+  ctx.poll();
+  ASIO_CHECK(ec3 == asio::error::operation_aborted);
+
+  sem.release();
+  ASIO_CHECK(sem.available() == 1);
+
+  // Destroying the semaphore cancels waiting operations.
+  asio::error_code ec4;
+  {
+    async_semaphore sem2(ctx, 0);
+    sem2.async_acquire([&](asio::error_code ec){ ec4 = ec; });
+  }
+  ctx.restart();
+  ctx.poll();
+  ASIO_CHECK(ec4 == asio::error::operation_aborted);
+}
+
+void concurrent_acquire_test()
+{
+  thread_pool pool(4);
+  async_semaphore sem(pool, 2);
+
+  std::atomic<int> holders(0);
+  std::atomic<int> max_holders(0);
+  std::atomic<int> remaining(4000);
+
+  struct acquire_loop
+  {
+    async_semaphore* sem_;
+    std::atomic<int>* holders_;
+    std::atomic<int>* max_holders_;
+    std::atomic<int>* remaining_;
+
+    void operator()(asio::error_code ec)
+    {
+      ASIO_CHECK(!ec);
+      int n = ++*holders_;
+      int max = max_holders_->load();
+      while (n > max && !max_holders_->compare_exchange_weak(max, n)) {}
+      --*holders_;
+      sem_->release();
+      if (--*remaining_ > 0)
+        sem_->async_acquire(*this);
+    }
+  };
+
+  for (int i = 0; i < 8; ++i)
+  {
+    post(pool,
+        [&]
+        {
+          sem.async_acquire(
+              acquire_loop{&sem, &holders, &max_holders, &remaining});
+        });
+  }
+
+  pool.join();
+
+  ASIO_CHECK(max_holders.load() <= 2);
+  ASIO_CHECK(max_holders.load() >= 1);
+  ASIO_CHECK(sem.available() == 2);
+}
+
+ASIO_TEST_SUITE
+(
+  "experimental/async_semaphore",
+  ASIO_TEST_CASE(uncontended_acquire_test)
+  ASIO_TEST_CASE(waiting_acquire_test)
+  ASIO_TEST_CASE(cancelled_acquire_test)
+  ASIO_TEST_CASE(concurrent_acquire_test)
+)
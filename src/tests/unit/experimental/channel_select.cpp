@@ -0,0 +1,313 @@
+//
+// experimental/channel_select.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/experimental/channel_select.hpp"
+
+#include <memory>
+#include <string>
+#include "asio/bind_allocator.hpp"
+#include "asio/bind_cancellation_slot.hpp"
+#include "asio/bind_immediate_executor.hpp"
+#include "asio/cancellation_signal.hpp"
+#include "asio/error.hpp"
+#include "asio/experimental/channel.hpp"
+#include "asio/experimental/concurrent_channel.hpp"
+#include "asio/inline_executor.hpp"
+#include "asio/io_context.hpp"
+#include "../unit_test.hpp"
+
+using namespace asio;
+using namespace asio::experimental;
+
+struct allocation_counts
+{
+  int total;
+  int live;
+};
+
+template <typename T>
+class counting_allocator
+{
+public:
+  typedef T value_type;
+
+  explicit counting_allocator(allocation_counts* counts)
+    : counts_(counts)
+  {
+  }
+
+  template <typename U>
+  counting_allocator(const counting_allocator<U>& other)
+    : counts_(other.counts_)
+  {
+  }
+
+  T* allocate(std::size_t n)
+  {
+    ++counts_->total;
+    ++counts_->live;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n)
+  {
+    --counts_->live;
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  bool operator==(const counting_allocator& other) const
+  {
+    return counts_ == other.counts_;
+  }
+
+  bool operator!=(const counting_allocator& other) const
+  {
+    return counts_ != other.counts_;
+  }
+
+  allocation_counts* counts_;
+};
+
+void ready_select_test()
+{
+  io_context ctx;
+  allocation_counts counts = { 0, 0 };
+
+  channel<void(asio::error_code, std::string)> ch1(ctx, 1);
+  channel<void(asio::error_code, std::string)> ch2(ctx, 1);
+
+  bool b1 = ch2.try_send(asio::error_code(), "hello");
+  ASIO_CHECK(b1);
+
+  std::size_t index1 = 0;
+  std::string s1;
+  make_channel_select(ch1, ch2).async_receive(
+      bind_immediate_executor(inline_executor(),
+        bind_allocator(counting_allocator<int>(&counts),
+          [&](std::size_t index, asio::error_code ec, std::string s)
+          {
+            ASIO_CHECK(!ec);
+            index1 = index;
+            s1 = std::move(s);
+          })));
+
+  ASIO_CHECK(index1 == 1);
+  ASIO_CHECK(s1 == "hello");
+  ASIO_CHECK(counts.total == 0);
+  ASIO_CHECK(!ch2.ready());
+
+  // When several channels are ready, the first is chosen.
+  ch1.try_send(asio::error_code(), "one");
+  ch2.try_send(asio::error_code(), "two");
+
+  make_channel_select(ch1, ch2).async_receive(
+      bind_immediate_executor(inline_executor(),
+        bind_allocator(counting_allocator<int>(&counts),
+          [&](std::size_t index, asio::error_code, std::string s)
+          {
+            index1 = index;
+            s1 = std::move(s);
+          })));
+
+  ASIO_CHECK(index1 == 0);
+  ASIO_CHECK(s1 == "one");
+  ASIO_CHECK(counts.total == 0);
+  ASIO_CHECK(ch2.ready());
+}
+
+void waiting_select_test()
+{
+  io_context ctx;
+  allocation_counts counts = { 0, 0 };
+
+  channel<void(asio::error_code, std::string)> ch1(ctx);
+  channel<void(asio::error_code, std::string)> ch2(ctx);
+
+  std::size_t index1 = 0;
+  std::string s1;
+  make_channel_select(ch1, ch2).async_receive(
+      bind_allocator(counting_allocator<int>(&counts),
+        [&](std::size_t index, asio::error_code ec, std::string s)
+        {
+          ASIO_CHECK(!ec);
+          index1 = index;
+          s1 = std::move(s);
+        }));
+
+  ASIO_CHECK(counts.total == 1);
+  ASIO_CHECK(counts.live == 1);
+
+  bool b1 = ch2.try_send(asio::error_code(), "hello");
+  ASIO_CHECK(b1);
+
+  ctx.run();
+
+  ASIO_CHECK(index1 == 1);
+  ASIO_CHECK(s1 == "hello");
+
+  // The branch left waiting on the first channel is discarded, rather than
+  // consuming the next message sent to it.
+  bool b2 = ch1.try_send(asio::error_code(), "lost");
+  ASIO_CHECK(!b2);
+  ASIO_CHECK(counts.live == 0);
+
+  std::string s2;
+  ch1.async_receive(
+      [&](asio::error_code, std::string s)
+      {
+        s2 = std::move(s);
+      });
+
+  bool b3 = ch1.try_send(asio::error_code(), "world");
+  ASIO_CHECK(b3);
+
+  ctx.restart();
+  ctx.run();
+
+  ASIO_CHECK(s2 == "world");
+}
+
+void closed_select_test()
+{
+  io_context ctx;
+
+  channel<void(asio::error_code, std::string)> ch1(ctx);
+  channel<void(asio::error_code, std::string)> ch2(ctx);
+
+  std::size_t index1 = 99;
+  asio::error_code ec1;
+  make_channel_select(ch1, ch2).async_receive(
+      [&](std::size_t index, asio::error_code ec, std::string)
+      {
+        index1 = index;
+        ec1 = ec;
+      });
+
+  ch1.close();
+
+  ctx.run();
+
+  ASIO_CHECK(index1 == 0);
+  ASIO_CHECK(ec1 == asio::experimental::error::channel_closed);
+
+  bool b1 = ch2.try_send(asio::error_code(), "hello");
+  ASIO_CHECK(!b1);
+}
+
+void cancelled_select_test()
+{
+  io_context ctx;
+  allocation_counts counts = { 0, 0 };
+  cancellation_signal sig;
+
+  {
+    channel<void(asio::error_code, std::string)> ch1(ctx);
+    channel<void(asio::error_code, std::string)> ch2(ctx);
+
+    std::size_t index1 = 0;
+    asio::error_code ec1;
+    make_channel_select(ch1, ch2).async_receive(
+        bind_cancellation_slot(sig.slot(),
+          bind_allocator(counting_allocator<int>(&counts),
+            [&](std::size_t index, asio::error_code ec, std::string)
+            {
+              index1 = index;
+              ec1 = ec;
+            })));
+
+    sig.emit(cancellation_type::terminal);
+
+    ctx.run();
+
+    ASIO_CHECK(index1 == 2);
+    ASIO_CHECK(ec1 == asio::experimental::error::channel_cancelled);
+
+    bool b1 = ch1.try_send(asio::error_code(), "hello");
+    ASIO_CHECK(!b1);
+  }
+
+  // The memory is released once the channels and the slot have let go.
+  ASIO_CHECK(counts.live == 1);
+  sig.slot().clear();
+  ASIO_CHECK(counts.live == 0);
+}
+
+void mixed_select_test()
+{
+  io_context ctx;
+
+  channel<void(asio::error_code, int)> ch1(ctx);
+  concurrent_channel<void(asio::error_code, int)> ch2(ctx);
+  channel<void(asio::error_code, int)> ch3(ctx);
+
+  std::size_t index1 = 0;
+  int i1 = 0;
+  make_channel_select(ch1, ch2, ch3).async_receive(
+      [&](std::size_t index, asio::error_code, int i)
+      {
+        index1 = index;
+        i1 = i;
+      });
+
+  ch2.async_send(asio::error_code(), 42, [](asio::error_code){});
+
+  ctx.run();
+
+  ASIO_CHECK(index1 == 1);
+  ASIO_CHECK(i1 == 42);
+}
+
+void select_loop_test()
+{
+  io_context ctx;
+  allocation_counts counts = { 0, 0 };
+
+  channel<void(asio::error_code, int)> ch1(ctx);
+  channel<void(asio::error_code, int)> ch2(ctx);
+
+  int sum = 0;
+  for (int i = 0; i < 100; ++i)
+  {
+    make_channel_select(ch1, ch2).async_receive(
+        bind_allocator(counting_allocator<int>(&counts),
+          [&](std::size_t index, asio::error_code, int value)
+          {
+            ASIO_CHECK(index == 1);
+            sum += value;
+          }));
+
+    ch2.try_send(asio::error_code(), i);
+
+    ctx.restart();
+    ctx.run();
+
+    // Only the most recent select's losing branch is still waiting.
+    ASIO_CHECK(counts.live <= 1);
+  }
+
+  ASIO_CHECK(sum == 4950);
+}
+
+ASIO_TEST_SUITE
+(
+  "experimental/channel_select",
+  ASIO_TEST_CASE(ready_select_test)
+  ASIO_TEST_CASE(waiting_select_test)
+  ASIO_TEST_CASE(closed_select_test)
+  ASIO_TEST_CASE(cancelled_select_test)
+  ASIO_TEST_CASE(mixed_select_test)
+  ASIO_TEST_CASE(select_loop_test)
+)
@@ -0,0 +1,281 @@
+//
+// experimental/connection_pool.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/experimental/connection_pool.hpp"
+
+#include <vector>
+#include "asio/error.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+#include "../unit_test.hpp"
+
+using namespace asio;
+using namespace asio::experimental;
+using asio::ip::tcp;
+
+// Accepts connections and keeps them open until the server is destroyed.
+class server
+{
+public:
+  explicit server(io_context& ctx)
+    : acceptor_(ctx, tcp::endpoint(ip::address_v4::loopback(), 0))
+  {
+  }
+
+  tcp::endpoint endpoint() const
+  {
+    return acceptor_.local_endpoint();
+  }
+
+  void accept(std::size_t n)
+  {
+    if (n == 0)
+      return;
+
+    acceptor_.async_accept(
+        [this, n](asio::error_code ec, tcp::socket s)
+        {
+          ASIO_CHECK(!ec);
+          sockets_.push_back(std::move(s));
+          accept(n - 1);
+        });
+  }
+
+  std::vector<tcp::socket>& sockets()
+  {
+    return sockets_;
+  }
+
+private:
+  tcp::acceptor acceptor_;
+  std::vector<tcp::socket> sockets_;
+};
+
+void preconnect_test()
+{
+  io_context ctx;
+  server srv(ctx);
+  tcp_connection_pool pool(ctx);
+
+  srv.accept(3);
+  pool.preconnect(srv.endpoint(), 3);
+  ASIO_CHECK(pool.idle(srv.endpoint()) == 0);
+
+  ctx.run();
+
+  ASIO_CHECK(pool.idle(srv.endpoint()) == 3);
+  ASIO_CHECK(srv.sockets().size() == 3);
+
+  // Setting a lower minimum does not close idle connections.
+  pool.preconnect(srv.endpoint(), 1);
+  ASIO_CHECK(pool.idle(srv.endpoint()) == 3);
+
+  pool.clear();
+  ASIO_CHECK(pool.idle(srv.endpoint()) == 0);
+}
+
+void acquire_test()
+{
+  io_context ctx;
+  server srv(ctx);
+  tcp_connection_pool pool(ctx);
+
+  srv.accept(1);
+  pool.preconnect(srv.endpoint(), 1);
+  ctx.run();
+  ASIO_CHECK(pool.idle(srv.endpoint()) == 1);
+
+  // An idle connection is handed out as an immediate completion, and a
+  // replacement is established in the background.
+  srv.accept(1);
+  bool acquired = false;
+  tcp::socket socket(ctx);
+  pool.async_acquire(srv.endpoint(),
+      [&](asio::error_code ec, tcp::socket s)
+      {
+        ASIO_CHECK(!ec);
+        acquired = true;
+        socket = std::move(s);
+      });
+  ASIO_CHECK(!acquired);
+  ASIO_CHECK(pool.idle(srv.endpoint()) == 0);
+
+  ctx.restart();
+  ctx.run();
+
+  ASIO_CHECK(acquired);
+  ASIO_CHECK(pool.idle(srv.endpoint()) == 1);
+  ASIO_CHECK(srv.sockets().size() == 2);
+
+  // The acquired connection is the first one that was accepted.
+  char data = 'x';
+  asio::write(socket, asio::buffer(&data, 1));
+  char received = 0;
+  asio::read(srv.sockets()[0], asio::buffer(&received, 1));
+  ASIO_CHECK(received == 'x');
+
+  pool.release(srv.endpoint(), std::move(socket));
+  ASIO_CHECK(pool.idle(srv.endpoint()) == 2);
+}
+
+void acquire_without_idle_test()
+{
+  io_context ctx;
+  server srv(ctx);
+  tcp_connection_pool pool(ctx);
+
+  srv.accept(1);
+
+  bool acquired = false;
+  pool.async_acquire(srv.endpoint(),
+      [&](asio::error_code ec, tcp::socket s)
+      {
+        ASIO_CHECK(!ec);
+        ASIO_CHECK(s.is_open());
+        acquired = true;
+      });
+
+  ctx.run();
+
+  ASIO_CHECK(acquired);
+  ASIO_CHECK(pool.idle(srv.endpoint()) == 0);
+  ASIO_CHECK(srv.sockets().size() == 1);
+}
+
+void dead_connection_test()
+{
+  io_context ctx;
+  server srv(ctx);
+  tcp_connection_pool pool(ctx);
+
+  srv.accept(2);
+  pool.preconnect(srv.endpoint(), 2);
+  ctx.run();
+  ASIO_CHECK(pool.idle(srv.endpoint()) == 2);
+  pool.preconnect(srv.endpoint(), 0);
+
+  // The peer closes one connection and sends unsolicited data on the other.
+  srv.sockets()[0].close();
+  char data = 'x';
+  asio::write(srv.sockets()[1], asio::buffer(&data, 1));
+
+  // Both idle connections are discarded, and a new connection established.
+  srv.accept(1);
+  bool acquired = false;
+  tcp::endpoint local;
+  pool.async_acquire(srv.endpoint(),
+      [&](asio::error_code ec, tcp::socket s)
+      {
+        ASIO_CHECK(!ec);
+        acquired = true;
+        local = s.local_endpoint();
+      });
+
+  ctx.restart();
+  ctx.run();
+
+  ASIO_CHECK(acquired);
+  ASIO_CHECK(pool.idle(srv.endpoint()) == 0);
+  ASIO_CHECK(srv.sockets().size() == 3);
+  ASIO_CHECK(srv.sockets()[2].remote_endpoint() == local);
+}
+
+void release_test()
+{
+  io_context ctx;
+  server srv(ctx);
+  tcp_connection_pool pool(ctx, 1);
+
+  srv.accept(2);
+  std::vector<tcp::socket> sockets;
+  for (int i = 0; i < 2; ++i)
+  {
+    pool.async_acquire(srv.endpoint(),
+        [&](asio::error_code ec, tcp::socket s)
+        {
+          ASIO_CHECK(!ec);
+          sockets.push_back(std::move(s));
+        });
+  }
+  ctx.run();
+  ASIO_CHECK(sockets.size() == 2);
+
+  // Connections beyond the maximum are closed.
+  pool.release(srv.endpoint(), std::move(sockets[0]));
+  pool.release(srv.endpoint(), std::move(sockets[1]));
+  ASIO_CHECK(pool.idle(srv.endpoint()) == 1);
+
+  // Closed connections are not kept.
+  tcp::socket closed(ctx);
+  pool.clear();
+  pool.release(srv.endpoint(), std::move(closed));
+  ASIO_CHECK(pool.idle(srv.endpoint()) == 0);
+}
+
+void connect_error_test()
+{
+  io_context ctx;
+  tcp::endpoint endpoint;
+  {
+    server srv(ctx);
+    endpoint = srv.endpoint();
+  }
+
+  tcp_connection_pool pool(ctx);
+  asio::error_code result;
+  pool.async_acquire(endpoint,
+      [&](asio::error_code ec, tcp::socket s)
+      {
+        result = ec;
+        ASIO_CHECK(!s.is_open());
+      });
+
+  ctx.run();
+
+  ASIO_CHECK(result == asio::error::connection_refused);
+  ASIO_CHECK(pool.idle(endpoint) == 0);
+}
+
+void destroy_test()
+{
+  io_context ctx;
+  server srv(ctx);
+
+  srv.accept(2);
+  {
+    tcp_connection_pool pool(ctx);
+    pool.preconnect(srv.endpoint(), 2);
+  }
+
+  // Background connections complete after the pool is destroyed.
+  ctx.run();
+
+  ASIO_CHECK(srv.sockets().size() == 2);
+}
+
+ASIO_TEST_SUITE
+(
+  "experimental/connection_pool",
+  ASIO_TEST_CASE(preconnect_test)
+  ASIO_TEST_CASE(acquire_test)
+  ASIO_TEST_CASE(acquire_without_idle_test)
+  ASIO_TEST_CASE(dead_connection_test)
+  ASIO_TEST_CASE(release_test)
+  ASIO_TEST_CASE(connect_error_test)
+  ASIO_TEST_CASE(destroy_test)
+)
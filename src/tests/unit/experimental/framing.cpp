@@ -0,0 +1,409 @@
+//
+// experimental/framing.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/experimental/framing.hpp"
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/write.hpp"
+#include "../unit_test.hpp"
+
+using namespace asio;
+using namespace asio::experimental;
+using asio::ip::tcp;
+
+// Creates a pair of connected sockets.
+void connect_pair(io_context& ctx, tcp::socket& a, tcp::socket& b)
+{
+  tcp::acceptor acceptor(ctx, tcp::endpoint(ip::address_v4::loopback(), 0));
+  a.connect(acceptor.local_endpoint());
+  acceptor.accept(b);
+}
+
+std::vector<std::string> frames_of(const std::string& data,
+    std::size_t n, const frame_prefix& prefix)
+{
+  std::vector<std::string> frames;
+  for (const_buffer frame : frame_sequence(buffer(data, n), prefix))
+  {
+    frames.push_back(std::string(
+          static_cast<const char*>(frame.data()), frame.size()));
+  }
+  return frames;
+}
+
+void prefix_test()
+{
+  const std::size_t lengths[] = { 0, 1, 127, 128, 255, 300, 65535, 1000000 };
+  frame_prefix prefixes[] =
+  {
+    frame_prefix(),
+    frame_prefix::fixed(1),
+    frame_prefix::fixed(2, frame_prefix::little_endian),
+    frame_prefix::fixed(8),
+    frame_prefix::varint()
+  };
+
+  for (std::size_t p = 0; p < sizeof(prefixes) / sizeof(prefixes[0]); ++p)
+  {
+    for (std::size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); ++l)
+    {
+      if (lengths[l] > prefixes[p].max_frame_size())
+        continue;
+
+      unsigned char data[16];
+      std::size_t n = prefixes[p].encode(lengths[l], data);
+      ASIO_CHECK(n == prefixes[p].encoded_size(lengths[l]));
+      ASIO_CHECK(n <= prefixes[p].max_size());
+
+      std::size_t length = 0;
+      asio::error_code ec;
+      ASIO_CHECK(prefixes[p].decode(data, n - 1, length, ec) == 0);
+      ASIO_CHECK(!ec);
+      ASIO_CHECK(prefixes[p].decode(data, n, length, ec) == n);
+      ASIO_CHECK(!ec);
+      ASIO_CHECK(length == lengths[l]);
+    }
+  }
+
+  // Byte order.
+  unsigned char data[4];
+  frame_prefix::fixed(2).encode(0x0102, data);
+  ASIO_CHECK(data[0] == 0x01 && data[1] == 0x02);
+  frame_prefix::fixed(2, frame_prefix::little_endian).encode(0x0102, data);
+  ASIO_CHECK(data[0] == 0x02 && data[1] == 0x01);
+  ASIO_CHECK(frame_prefix::varint().encode(300, data) == 2);
+  ASIO_CHECK(data[0] == 0xAC && data[1] == 0x02);
+
+  // Limits.
+  ASIO_CHECK(frame_prefix::fixed(1).max_frame_size() == 255);
+  frame_prefix limited = frame_prefix::varint();
+  limited.max_frame_size(1000);
+  std::size_t length = 0;
+  asio::error_code ec;
+  limited.encode(1001, data);
+  ASIO_CHECK(limited.decode(data, 2, length, ec) == 0);
+  ASIO_CHECK(ec == asio::error::message_size);
+
+  // A length that is too large is rejected before the prefix is complete.
+  unsigned char overlong[11];
+  for (std::size_t i = 0; i < sizeof(overlong); ++i)
+    overlong[i] = 0xFF;
+  ec = asio::error_code();
+  ASIO_CHECK(frame_prefix::varint().decode(
+        overlong, sizeof(overlong), length, ec) == 0);
+  ASIO_CHECK(ec == asio::error::message_size);
+
+  bool thrown = false;
+  try
+  {
+    frame_prefix::fixed(3);
+  }
+  catch (std::out_of_range&)
+  {
+    thrown = true;
+  }
+  ASIO_CHECK(thrown);
+}
+
+void frame_sequence_test()
+{
+  frame_prefix prefix = frame_prefix::varint();
+  std::string data;
+  data.append("\x03" "abc", 4);
+  data.append("\x00", 1);
+  data.append("\x02" "de", 3);
+  data.append("\x05" "fg", 3);
+
+  std::vector<std::string> frames = frames_of(data, data.size(), prefix);
+  ASIO_CHECK(frames.size() == 3);
+  ASIO_CHECK(frames[0] == "abc");
+  ASIO_CHECK(frames[1].empty());
+  ASIO_CHECK(frames[2] == "de");
+
+  // The payloads refer to the underlying data.
+  frame_sequence sequence(buffer(data), prefix);
+  ASIO_CHECK(sequence.begin()->data() == data.data() + 1);
+
+  ASIO_CHECK(frames_of(data, 0, prefix).empty());
+  ASIO_CHECK(frames_of(data, 2, prefix).empty());
+}
+
+void read_write_test()
+{
+  io_context ctx;
+  tcp::socket a(ctx), b(ctx);
+  connect_pair(ctx, a, b);
+
+  frame_prefix prefix;
+  std::string large(100000, 'x');
+  std::vector<const_buffer> out;
+  out.push_back(buffer("one", 3));
+  out.push_back(buffer(large));
+  out.push_back(const_buffer());
+  out.push_back(buffer("four", 4));
+
+  asio::error_code write_ec;
+  std::size_t written = 0;
+  async_write_frames(a, out, prefix,
+      [&](asio::error_code ec, std::size_t n)
+      {
+        write_ec = ec;
+        written = n;
+      });
+
+  std::string data;
+  std::vector<std::string> frames;
+  std::function<void()> read_more = [&]
+  {
+    async_read_frame(b, dynamic_buffer(data), prefix,
+        [&](asio::error_code ec, std::size_t n)
+        {
+          ASIO_CHECK(!ec);
+          std::vector<std::string> f = frames_of(data, n, prefix);
+          frames.insert(frames.end(), f.begin(), f.end());
+          data.erase(0, n);
+          if (frames.size() < 4)
+            read_more();
+        });
+  };
+  read_more();
+
+  ctx.run();
+
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(written == 4 * 4 + 3 + large.size() + 4);
+  ASIO_CHECK(frames.size() == 4);
+  ASIO_CHECK(frames[0] == "one");
+  ASIO_CHECK(frames[1] == large);
+  ASIO_CHECK(frames[2].empty());
+  ASIO_CHECK(frames[3] == "four");
+  ASIO_CHECK(data.empty());
+}
+
+void batched_read_test()
+{
+  io_context ctx;
+  tcp::socket a(ctx), b(ctx);
+  connect_pair(ctx, a, b);
+
+  // Many small frames are obtained with a single read.
+  frame_prefix prefix = frame_prefix::fixed(2);
+  std::string encoded;
+  for (int i = 0; i < 20; ++i)
+    encoded.append("\x00\x0a" "0123456789", 12);
+  encoded.append("\x00\x07" "partial", 9);
+  asio::write(a, buffer(encoded, encoded.size() - 3));
+
+  std::string data;
+  std::size_t bytes = 0;
+  async_read_frame(b, dynamic_buffer(data), prefix,
+      [&](asio::error_code ec, std::size_t n)
+      {
+        ASIO_CHECK(!ec);
+        bytes = n;
+      });
+  ctx.run();
+
+  ASIO_CHECK(bytes == 20 * 12);
+  ASIO_CHECK(frames_of(data, bytes, prefix).size() == 20);
+  ASIO_CHECK(data.size() == encoded.size() - 3);
+
+  // A read when the buffer already holds a complete frame completes without
+  // reading, but not from within the initiating function.
+  bool called = false;
+  async_read_frame(b, dynamic_buffer(data), prefix,
+      [&](asio::error_code ec, std::size_t n)
+      {
+        ASIO_CHECK(!ec);
+        ASIO_CHECK(n == 20 * 12);
+        called = true;
+      });
+  ASIO_CHECK(!called);
+  ctx.restart();
+  ctx.run();
+  ASIO_CHECK(called);
+
+  // The remainder of the incomplete frame is read.
+  data.erase(0, bytes);
+  asio::write(a, buffer(encoded.data() + encoded.size() - 3, 3));
+  std::vector<std::string> frames;
+  async_read_frame(b, dynamic_buffer(data), prefix,
+      [&](asio::error_code ec, std::size_t n)
+      {
+        ASIO_CHECK(!ec);
+        frames = frames_of(data, n, prefix);
+      });
+  ctx.restart();
+  ctx.run();
+
+  ASIO_CHECK(frames.size() == 1);
+  ASIO_CHECK(frames[0] == "partial");
+}
+
+void error_test()
+{
+  io_context ctx;
+  tcp::socket a(ctx), b(ctx);
+  connect_pair(ctx, a, b);
+
+  // A payload that the prefix cannot represent is not written.
+  std::string large(256, 'x');
+  asio::error_code write_ec;
+  std::size_t written = 1;
+  async_write_frames(a, buffer(large), frame_prefix::fixed(1),
+      [&](asio::error_code ec, std::size_t n)
+      {
+        write_ec = ec;
+        written = n;
+      });
+  ctx.run();
+  ASIO_CHECK(write_ec == asio::error::message_size);
+  ASIO_CHECK(written == 0);
+
+  // A frame that exceeds the maximum frame size.
+  frame_prefix limited;
+  limited.max_frame_size(100);
+  asio::write(a, buffer("\x00\x00\x01\x00", 4));
+  std::string data;
+  asio::error_code read_ec;
+  async_read_frame(b, dynamic_buffer(data), limited,
+      [&](asio::error_code ec, std::size_t n)
+      {
+        read_ec = ec;
+        ASIO_CHECK(n == 0);
+      });
+  ctx.restart();
+  ctx.run();
+  ASIO_CHECK(read_ec == asio::error::message_size);
+
+  // A frame that does not fit in the buffer.
+  read_ec = asio::error_code();
+  async_read_frame(b, dynamic_buffer(data, 100), frame_prefix(),
+      [&](asio::error_code ec, std::size_t n)
+      {
+        read_ec = ec;
+        ASIO_CHECK(n == 0);
+      });
+  ctx.restart();
+  ctx.run();
+  ASIO_CHECK(read_ec == asio::error::message_size);
+
+  // The peer closes the connection part way through a frame.
+  asio::write(a, buffer("\x00\x00\x00\x05" "ab", 6));
+  a.close();
+  data.clear();
+  read_ec = asio::error_code();
+  async_read_frame(b, dynamic_buffer(data), frame_prefix(),
+      [&](asio::error_code ec, std::size_t n)
+      {
+        read_ec = ec;
+        ASIO_CHECK(n == 0);
+      });
+  ctx.restart();
+  ctx.run();
+  ASIO_CHECK(read_ec == asio::error::eof);
+}
+
+// A stream that records, but never performs, any I/O requested of it.
+class recording_stream
+{
+public:
+  typedef io_context::executor_type executor_type;
+
+  explicit recording_stream(io_context& ctx)
+    : executor_(ctx.get_executor()),
+      io_count_(0)
+  {
+  }
+
+  executor_type get_executor() noexcept
+  {
+    return executor_;
+  }
+
+  template <typename MutableBufferSequence, typename ReadHandler>
+  void async_read_some(const MutableBufferSequence&, ReadHandler&&)
+  {
+    ++io_count_;
+  }
+
+  template <typename ConstBufferSequence, typename WriteHandler>
+  void async_write_some(const ConstBufferSequence&, WriteHandler&&)
+  {
+    ++io_count_;
+  }
+
+  int io_count() const
+  {
+    return io_count_;
+  }
+
+private:
+  executor_type executor_;
+  int io_count_;
+};
+
+void immediate_completion_test()
+{
+  io_context ctx;
+  recording_stream stream(ctx);
+
+  // A read when the buffer already holds a complete frame does not perform
+  // any I/O on the stream.
+  std::string data("\x00\x00\x00\x02hi", 6);
+  bool read_called = false;
+  async_read_frame(stream, dynamic_buffer(data), frame_prefix(),
+      [&](asio::error_code ec, std::size_t n)
+      {
+        ASIO_CHECK(!ec);
+        ASIO_CHECK(n == 6);
+        read_called = true;
+      });
+  ASIO_CHECK(!read_called);
+
+  // Nor does a write of a frame that the prefix cannot represent.
+  std::string large(256, 'x');
+  bool write_called = false;
+  async_write_frames(stream, buffer(large), frame_prefix::fixed(1),
+      [&](asio::error_code ec, std::size_t n)
+      {
+        ASIO_CHECK(ec == asio::error::message_size);
+        ASIO_CHECK(n == 0);
+        write_called = true;
+      });
+  ASIO_CHECK(!write_called);
+
+  ctx.run();
+  ASIO_CHECK(read_called);
+  ASIO_CHECK(write_called);
+  ASIO_CHECK(stream.io_count() == 0);
+}
+
+ASIO_TEST_SUITE
+(
+  "experimental/framing",
+  ASIO_TEST_CASE(prefix_test)
+  ASIO_TEST_CASE(frame_sequence_test)
+  ASIO_TEST_CASE(read_write_test)
+  ASIO_TEST_CASE(batched_read_test)
+  ASIO_TEST_CASE(error_test)
+  ASIO_TEST_CASE(immediate_completion_test)
+)
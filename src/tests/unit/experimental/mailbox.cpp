@@ -0,0 +1,217 @@
+//
+// experimental/mailbox.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/experimental/mailbox.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "asio/config.hpp"
+#include "asio/dispatch.hpp"
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/thread_pool.hpp"
+#include "../unit_test.hpp"
+
+using namespace asio;
+using namespace asio::experimental;
+
+static_assert(execution::is_executor<mailbox<io_context::executor_type>>::value,
+    "mailbox must satisfy the executor concept");
+
+void increment(int* count)
+{
+  ++(*count);
+}
+
+void record(std::string* s, char c)
+{
+  s->push_back(c);
+}
+
+void check_in_mailbox(mailbox<io_context::executor_type> m, bool* in)
+{
+  *in = m.running_in_this_thread();
+}
+
+void mailbox_basic_test()
+{
+  io_context ioc;
+  mailbox<io_context::executor_type> m = make_mailbox(ioc);
+  mailbox<io_context::executor_type> m2 = m;
+
+  ASIO_CHECK(m == m2);
+  ASIO_CHECK(m != make_mailbox(ioc));
+  ASIO_CHECK(&m.context() == &ioc);
+  ASIO_CHECK(!m.running_in_this_thread());
+
+  int count = 0;
+  bool in = false;
+  post(m, std::bind(increment, &count));
+  post(m, std::bind(check_in_mailbox, m, &in));
+
+  // No handlers can be called until run() is called.
+  ASIO_CHECK(count == 0);
+
+  ioc.run();
+
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(in);
+}
+
+void mailbox_dispatch_test()
+{
+  io_context ioc;
+  mailbox<io_context::executor_type> m = make_mailbox(ioc);
+  std::string s;
+
+  post(m,
+      [&]
+      {
+        // A dispatch from within the mailbox runs immediately, while a post
+        // runs after the messages that are already queued.
+        post(m, std::bind(record, &s, 'c'));
+        dispatch(m, std::bind(record, &s, 'a'));
+        record(&s, 'b');
+      });
+
+  ioc.run();
+
+  ASIO_CHECK(s == "abc");
+}
+
+void mailbox_batch_test()
+{
+  io_context ioc(config_from_string("mailbox.max_messages_per_turn=2"));
+  mailbox<io_context::executor_type> m = make_mailbox(ioc);
+  std::string s;
+
+  for (char c = '1'; c <= '5'; ++c)
+    post(m, std::bind(record, &s, c));
+  post(ioc, std::bind(record, &s, 'x'));
+
+  ioc.run();
+
+  // The mailbox yields to other work after each batch of two messages.
+  ASIO_CHECK(s == "12x345");
+
+  io_context ioc2(config_from_string("mailbox.max_messages_per_turn=0"));
+  mailbox<io_context::executor_type> m2 = make_mailbox(ioc2);
+  s.clear();
+
+  for (char c = '1'; c <= '5'; ++c)
+    post(m2, std::bind(record, &s, c));
+  post(ioc2, std::bind(record, &s, 'x'));
+
+  ioc2.run();
+
+  // A limit of zero runs all pending messages on each turn.
+  ASIO_CHECK(s == "12345x");
+}
+
+void mailbox_ordering_test()
+{
+  const int senders = 4;
+  const int messages = 10000;
+  const int actors = 8;
+
+  thread_pool pool(4);
+
+  struct actor
+  {
+    explicit actor(thread_pool& p)
+      : mailbox_(make_mailbox(p)),
+        last_(senders, -1),
+        active_(0),
+        ordered_(true),
+        exclusive_(true)
+    {
+    }
+
+    mailbox<thread_pool::executor_type> mailbox_;
+    std::vector<int> last_;
+    std::atomic<int> active_;
+    bool ordered_;
+    bool exclusive_;
+  };
+
+  std::vector<std::unique_ptr<actor>> a;
+  for (int i = 0; i < actors; ++i)
+    a.emplace_back(new actor(pool));
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < senders; ++t)
+  {
+    threads.emplace_back(
+        [&a, t]
+        {
+          for (int i = 0; i < messages; ++i)
+          {
+            actor* target = a[i % actors].get();
+            post(target->mailbox_,
+                [target, t, i]
+                {
+                  if (target->active_.fetch_add(1) != 0)
+                    target->exclusive_ = false;
+                  if (target->last_[t] >= i)
+                    target->ordered_ = false;
+                  target->last_[t] = i;
+                  target->active_.fetch_sub(1);
+                });
+          }
+        });
+  }
+  for (std::size_t t = 0; t < threads.size(); ++t)
+    threads[t].join();
+
+  pool.join();
+
+  for (int i = 0; i < actors; ++i)
+  {
+    ASIO_CHECK(a[i]->ordered_);
+    ASIO_CHECK(a[i]->exclusive_);
+    for (int t = 0; t < senders; ++t)
+      ASIO_CHECK(a[i]->last_[t] / actors == (messages - 1) / actors);
+  }
+}
+
+void mailbox_destroy_test()
+{
+  int count = 0;
+
+  {
+    io_context ioc;
+    mailbox<io_context::executor_type> m = make_mailbox(ioc);
+    for (int i = 0; i < 10; ++i)
+      post(m, std::bind(increment, &count));
+  }
+
+  // Messages that were never run are destroyed without being invoked.
+  ASIO_CHECK(count == 0);
+}
+
+ASIO_TEST_SUITE
+(
+  "experimental/mailbox",
+  ASIO_TEST_CASE(mailbox_basic_test)
+  ASIO_TEST_CASE(mailbox_dispatch_test)
+  ASIO_TEST_CASE(mailbox_batch_test)
+  ASIO_TEST_CASE(mailbox_ordering_test)
+  ASIO_TEST_CASE(mailbox_destroy_test)
+)
@@ -0,0 +1,214 @@
+//
+// experimental/pipeline.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/experimental/pipeline.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "asio/error.hpp"
+#include "asio/io_context.hpp"
+#include "asio/strand.hpp"
+#include "asio/thread_pool.hpp"
+#include "asio/use_future.hpp"
+#include "../unit_test.hpp"
+
+using namespace asio;
+using namespace asio::experimental;
+
+void ordered_stages_test()
+{
+  io_context ctx;
+  std::vector<std::string> output;
+
+  auto p = make_pipeline<int>(ctx)
+    .stage<int>(
+        [](int i, pipeline_output<int>& out)
+        {
+          if (i % 2 == 0)
+            out.push(i);
+        })
+    .stage<std::string>(
+        [](int i, pipeline_output<std::string>& out)
+        {
+          out.emplace(std::to_string(i));
+        })
+    .sink(
+        [&](std::string s)
+        {
+          output.push_back(std::move(s));
+        });
+
+  for (int i = 0; i < 100; ++i)
+    ASIO_CHECK(p.try_push(i));
+
+  bool finished = false;
+  p.close();
+  p.async_wait([&](asio::error_code ec){ finished = !ec; });
+  ASIO_CHECK(!p.try_push(100));
+
+  ctx.run();
+
+  ASIO_CHECK(finished);
+  ASIO_CHECK(output.size() == 50);
+  for (std::size_t i = 0; i < output.size(); ++i)
+    ASIO_CHECK(output[i] == std::to_string(i * 2));
+}
+
+void backpressure_test()
+{
+  io_context ctx;
+  std::vector<int> output;
+  std::size_t in_flight = 0;
+  std::size_t max_in_flight = 0;
+
+  auto p = make_pipeline<int>(ctx)
+    .queue_capacity(4)
+    .batch_size(2)
+    .stage<int>(
+        [&](int i, pipeline_output<int>& out)
+        {
+          if (++in_flight > max_in_flight)
+            max_in_flight = in_flight;
+          out.push(i);
+        })
+    .sink(
+        [&](int i)
+        {
+          --in_flight;
+          output.push_back(i);
+        });
+
+  // Only the first stage's queue capacity may be pushed without running.
+  int pushed = 0;
+  while (p.try_push(pushed))
+    ++pushed;
+  ASIO_CHECK(pushed == 4);
+
+  struct push_loop
+  {
+    basic_pipeline<int, io_context::executor_type>* p_;
+    int next_;
+
+    void operator()(asio::error_code ec)
+    {
+      ASIO_CHECK(!ec);
+      if (++next_ < 1000)
+        p_->async_push(next_, *this);
+      else
+        p_->close();
+    }
+  };
+
+  p.async_push(pushed, push_loop{&p, pushed});
+  ctx.run();
+
+  ASIO_CHECK(output.size() == 1000);
+  for (std::size_t i = 0; i < output.size(); ++i)
+    ASIO_CHECK(output[i] == static_cast<int>(i));
+
+  // Values between the stages are bounded by the queue capacity and the
+  // worker's batch.
+  ASIO_CHECK(max_in_flight <= 6);
+
+  // Pushing after the pipeline is closed fails.
+  asio::error_code push_ec;
+  p.async_push(0, [&](asio::error_code ec){ push_ec = ec; });
+  ctx.restart();
+  ctx.run();
+  ASIO_CHECK(push_ec == asio::error::operation_aborted);
+}
+
+void parallel_stages_test()
+{
+  thread_pool pool(4);
+  std::atomic<long> count(0);
+  std::atomic<long> sum(0);
+
+  auto p = make_pipeline<int>(pool.get_executor())
+    .queue_capacity(64)
+    .batch_size(8)
+    .stage<long>(
+        [](int i, pipeline_output<long>& out)
+        {
+          out.push(static_cast<long>(i) * 2);
+        }, 4)
+    .stage<long>(make_strand(pool),
+        [](long i, pipeline_output<long>& out)
+        {
+          out.push(i + 1);
+        })
+    .sink(
+        [&](long i)
+        {
+          ++count;
+          sum += i;
+        }, 2);
+
+  std::vector<std::thread> producers;
+  for (int t = 0; t < 2; ++t)
+  {
+    producers.emplace_back(
+        [&p, t]
+        {
+          for (int i = t; i < 20000; i += 2)
+            while (!p.try_push(i))
+              std::this_thread::yield();
+        });
+  }
+  for (std::size_t t = 0; t < producers.size(); ++t)
+    producers[t].join();
+
+  p.close();
+  p.async_wait(use_future).get();
+
+  ASIO_CHECK(count.load() == 20000);
+  ASIO_CHECK(sum.load() == 20000L * 19999L + 20000L);
+
+  pool.join();
+}
+
+void destroy_closes_test()
+{
+  io_context ctx;
+  int processed = 0;
+  asio::error_code ec1 = asio::error::would_block;
+
+  {
+    auto p = make_pipeline<int>(ctx)
+      .sink([&](int){ ++processed; });
+
+    for (int i = 0; i < 10; ++i)
+      ASIO_CHECK(p.try_push(i));
+
+    p.async_wait([&](asio::error_code ec){ ec1 = ec; });
+  }
+
+  // Values pushed before the pipeline was destroyed are still processed.
+  ctx.run();
+  ASIO_CHECK(processed == 10);
+  ASIO_CHECK(!ec1);
+}
+
+ASIO_TEST_SUITE
+(
+  "experimental/pipeline",
+  ASIO_TEST_CASE(ordered_stages_test)
+  ASIO_TEST_CASE(backpressure_test)
+  ASIO_TEST_CASE(parallel_stages_test)
+  ASIO_TEST_CASE(destroy_closes_test)
+)
@@ -18,6 +18,7 @@
 
 #include <functional>
 #include <sstream>
+#include <vector>
 #include "asio/bind_executor.hpp"
 #include "asio/dispatch.hpp"
 #include "asio/post.hpp"
@@ -264,6 +265,129 @@ void io_context_test()
   ASIO_CHECK(exception_count == 2);
 }
 
+void io_context_idle_threads_test()
+{
+  io_context ioc(asio::config_from_string(
+        "scheduler.idle_spin_threads=1\n"
+        "scheduler.idle_spin_count=1000"));
+  int count = 0;
+  int count2 = 0;
+  int count3 = 0;
+  executor_work_guard<io_context::executor_type> w = make_work_guard(ioc);
+  thread thread1(bindns::bind(io_context_run, &ioc));
+  thread thread2(bindns::bind(io_context_run, &ioc));
+  thread thread3(bindns::bind(io_context_run, &ioc));
+  asio::post(ioc, bindns::bind(start_sleep_increments, &ioc, &count));
+  asio::post(ioc, bindns::bind(start_sleep_increments, &ioc, &count2));
+  asio::post(ioc, bindns::bind(start_sleep_increments, &ioc, &count3));
+  w.reset();
+  thread1.join();
+  thread2.join();
+  thread3.join();
+
+  // The run() calls will not return until all work has finished.
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 3);
+  ASIO_CHECK(count2 == 3);
+  ASIO_CHECK(count3 == 3);
+
+  // Idle threads that time out must remove themselves from the idle stack.
+  io_context ioc2(asio::config_from_string("scheduler.wait_usec=100"));
+  count = 0;
+  count2 = 0;
+  asio::post(ioc2, bindns::bind(start_sleep_increments, &ioc2, &count));
+  asio::post(ioc2, bindns::bind(start_sleep_increments, &ioc2, &count2));
+  thread thread4(bindns::bind(io_context_run, &ioc2));
+  thread thread5(bindns::bind(io_context_run, &ioc2));
+  thread4.join();
+  thread5.join();
+
+  ASIO_CHECK(ioc2.stopped());
+  ASIO_CHECK(count == 3);
+  ASIO_CHECK(count2 == 3);
+}
+
+void record(std::vector<int>* order, int value)
+{
+  order->push_back(value);
+}
+
+void record_then_dispatch(io_context* ioc, std::vector<int>* order,
+    int value, int priority)
+{
+  order->push_back(value);
+  asio::require(ioc->get_executor(),
+      asio::execution::priority(priority)
+    ).execute(bindns::bind(record, order, value + 1));
+  order->push_back(value + 2);
+}
+
+void io_context_priority_test()
+{
+  io_context ioc;
+  std::vector<int> order;
+
+  asio::post(ioc, bindns::bind(record, &order, 0));
+  asio::post(ioc, bindns::bind(record, &order, 1));
+  asio::post(asio::require(ioc.get_executor(),
+        asio::execution::priority(1)), bindns::bind(record, &order, 2));
+  asio::post(asio::require(ioc.get_executor(),
+        asio::execution::priority(2)), bindns::bind(record, &order, 3));
+  asio::post(asio::require(ioc.get_executor(),
+        asio::execution::priority(1)), bindns::bind(record, &order, 4));
+  ioc.run();
+
+  // Higher priority handlers overtake queued lower priority handlers.
+  ASIO_CHECK(order.size() == 5);
+  ASIO_CHECK(order[0] == 3);
+  ASIO_CHECK(order[1] == 2);
+  ASIO_CHECK(order[2] == 4);
+  ASIO_CHECK(order[3] == 0);
+  ASIO_CHECK(order[4] == 1);
+
+  // A prioritised function submitted from a lower priority handler is queued
+  // rather than being invoked immediately.
+  order.clear();
+  ioc.restart();
+  asio::post(ioc, bindns::bind(record_then_dispatch, &ioc, &order, 10, 1));
+  ioc.run();
+
+  ASIO_CHECK(order.size() == 3);
+  ASIO_CHECK(order[0] == 10);
+  ASIO_CHECK(order[1] == 12);
+  ASIO_CHECK(order[2] == 11);
+
+  // A function of equal priority may be invoked immediately.
+  order.clear();
+  ioc.restart();
+  asio::post(asio::require(ioc.get_executor(), asio::execution::priority(1)),
+      bindns::bind(record_then_dispatch, &ioc, &order, 20, 1));
+  ioc.run();
+
+  ASIO_CHECK(order.size() == 3);
+  ASIO_CHECK(order[0] == 20);
+  ASIO_CHECK(order[1] == 21);
+  ASIO_CHECK(order[2] == 22);
+
+  // Normal priority work runs after a bounded number of prioritised handlers.
+  io_context ioc2(asio::config_from_string(
+        "scheduler.priority_burst_limit=2"));
+  order.clear();
+  asio::post(ioc2, bindns::bind(record, &order, 0));
+  for (int i = 1; i <= 5; ++i)
+    asio::post(asio::require(ioc2.get_executor(),
+          asio::execution::priority(1)), bindns::bind(record, &order, i));
+  ioc2.run();
+
+  ASIO_CHECK(order.size() == 6);
+  ASIO_CHECK(order[0] == 1);
+  ASIO_CHECK(order[1] == 2);
+  ASIO_CHECK(order[2] == 0);
+  ASIO_CHECK(order[3] == 3);
+  ASIO_CHECK(order[4] == 4);
+  ASIO_CHECK(order[5] == 5);
+}
+
 class test_service : public asio::io_context::service
 {
 public:
@@ -705,6 +829,8 @@ ASIO_TEST_SUITE
 (
   "io_context",
   ASIO_TEST_CASE(io_context_test)
+  ASIO_TEST_CASE(io_context_idle_threads_test)
+  ASIO_TEST_CASE(io_context_priority_test)
   ASIO_TEST_CASE(io_context_service_test)
   ASIO_TEST_CASE(io_context_executor_query_test)
   ASIO_TEST_CASE(io_context_executor_execute_test)
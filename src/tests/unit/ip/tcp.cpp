@@ -19,10 +19,15 @@
 // Test that header file is self-contained.
 #include "asio/ip/tcp.hpp"
 
+#include <chrono>
 #include <cstring>
 #include <functional>
+#include <string>
+#include <thread>
+#include <vector>
 #include "asio/io_context.hpp"
 #include "asio/read.hpp"
+#include "asio/thread.hpp"
 #include "asio/write.hpp"
 #include "../unit_test.hpp"
 #include "../archetypes/async_result.hpp"
@@ -66,6 +71,17 @@ void test()
     (void)static_cast<bool>(!no_delay1);
     (void)static_cast<bool>(no_delay1.value());
 
+#if defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
+    // not_sent_low_watermark class.
+
+    ip::tcp::not_sent_low_watermark not_sent_low_watermark1(16384);
+    sock.set_option(not_sent_low_watermark1);
+    ip::tcp::not_sent_low_watermark not_sent_low_watermark2;
+    sock.get_option(not_sent_low_watermark2);
+    not_sent_low_watermark1 = 8192;
+    (void)static_cast<int>(not_sent_low_watermark1.value());
+#endif // defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
+
     ip::tcp::endpoint ep;
     (void)static_cast<std::size_t>(std::hash<ip::tcp::endpoint>()(ep));
   }
@@ -122,6 +138,20 @@ void test()
   ASIO_CHECK(!no_delay4.value());
   ASIO_CHECK(!static_cast<bool>(no_delay4));
   ASIO_CHECK(!no_delay4);
+
+#if defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
+  // not_sent_low_watermark class.
+
+  ip::tcp::not_sent_low_watermark not_sent_low_watermark1(16384);
+  ASIO_CHECK(not_sent_low_watermark1.value() == 16384);
+  sock.set_option(not_sent_low_watermark1, ec);
+  ASIO_CHECK(!ec);
+
+  ip::tcp::not_sent_low_watermark not_sent_low_watermark2;
+  sock.get_option(not_sent_low_watermark2, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(not_sent_low_watermark2.value() == 16384);
+#endif // defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
 }
 
 } // namespace ip_tcp_runtime
@@ -358,6 +388,11 @@ void test()
     socket1.native_non_blocking(true);
     socket1.native_non_blocking(false, ec);
 
+    bool auto_cork1 = socket1.auto_cork();
+    (void)auto_cork1;
+    socket1.auto_cork(true);
+    socket1.auto_cork(false, ec);
+
     ip::tcp::endpoint endpoint1 = socket1.local_endpoint();
     (void)endpoint1;
     ip::tcp::endpoint endpoint2 = socket1.local_endpoint(ec);
@@ -577,6 +612,20 @@ void handle_write(const asio::error_code& err,
   ASIO_CHECK(bytes_transferred == sizeof(write_data));
 }
 
+void handle_read_corked(const asio::error_code& err,
+    size_t bytes_transferred, bool* called)
+{
+  *called = true;
+  ASIO_CHECK(!err);
+  ASIO_CHECK(bytes_transferred == 2 * sizeof(write_data));
+}
+
+void handle_wait(const asio::error_code& err, bool* called)
+{
+  *called = true;
+  ASIO_CHECK(!err);
+}
+
 void handle_read_cancel(const asio::error_code& err,
     size_t bytes_transferred, bool* called)
 {
@@ -659,6 +708,70 @@ void test()
   ASIO_CHECK(write_completed);
   ASIO_CHECK(memcmp(read_buffer, write_data, sizeof(write_data)) == 0);
 
+  // Writes started together in auto-cork mode.
+
+  asio::error_code ec;
+  server_side_socket.auto_cork(true, ec);
+  ASIO_CHECK(!ec || ec == asio::error::operation_not_supported);
+  ASIO_CHECK(server_side_socket.auto_cork() == !ec);
+
+  char corked_read_buffer[2 * sizeof(write_data)];
+  bool corked_read_completed = false;
+  asio::async_read(client_side_socket,
+      asio::buffer(corked_read_buffer),
+      bindns::bind(handle_read_corked,
+        _1, _2, &corked_read_completed));
+
+  bool corked_write1_completed = false;
+  server_side_socket.async_write_some(
+      asio::buffer(write_data),
+      bindns::bind(handle_write,
+        _1, _2, &corked_write1_completed));
+
+  bool corked_write2_completed = false;
+  server_side_socket.async_write_some(
+      asio::buffer(write_data),
+      bindns::bind(handle_write,
+        _1, _2, &corked_write2_completed));
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(corked_read_completed);
+  ASIO_CHECK(corked_write1_completed);
+  ASIO_CHECK(corked_write2_completed);
+  ASIO_CHECK(memcmp(corked_read_buffer,
+        write_data, sizeof(write_data)) == 0);
+  ASIO_CHECK(memcmp(corked_read_buffer + sizeof(write_data),
+        write_data, sizeof(write_data)) == 0);
+
+  // A wait queued behind a write in auto-cork mode must not hold back the
+  // written data.
+
+  bool corked_write3_completed = false;
+  server_side_socket.async_write_some(
+      asio::buffer(write_data),
+      bindns::bind(handle_write,
+        _1, _2, &corked_write3_completed));
+
+  bool corked_wait_completed = false;
+  server_side_socket.async_wait(ip::tcp::socket::wait_write,
+      bindns::bind(handle_wait, _1, &corked_wait_completed));
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(corked_write3_completed);
+  ASIO_CHECK(corked_wait_completed);
+
+  for (int i = 0; i < 50 && client_side_socket.available() == 0; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  ASIO_CHECK(client_side_socket.available() == sizeof(write_data));
+
+  std::size_t corked_bytes = asio::read(client_side_socket,
+      asio::buffer(corked_read_buffer, sizeof(write_data)));
+  ASIO_CHECK(corked_bytes == sizeof(write_data));
+  ASIO_CHECK(memcmp(corked_read_buffer,
+        write_data, sizeof(write_data)) == 0);
+
   // Cancelled read.
 
   bool read_cancel_completed = false;
@@ -690,6 +803,7 @@ void test()
   ioc.restart();
   ioc.run();
   ASIO_CHECK(read_eof_completed);
+  ASIO_CHECK(!server_side_socket.auto_cork());
 }
 
 } // namespace ip_tcp_socket_runtime
@@ -1273,6 +1387,90 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// ip_tcp_iostream_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the ip::tcp::iostream
+// class, including reads and writes that bypass the stream buffer.
+
+namespace ip_tcp_iostream_runtime {
+
+void test()
+{
+#if !defined(ASIO_NO_IOSTREAM)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+
+  ip::tcp::iostream ios;
+  ios.rdbuf()->buffer_size(64);
+  ASIO_CHECK(ios.rdbuf()->buffer_size() == 64);
+
+  ios.connect(acceptor.local_endpoint());
+  ASIO_CHECK(!ios.error());
+  ip::tcp::socket server(ioc);
+  acceptor.accept(server);
+
+  std::vector<char> data(100000);
+  for (std::size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>('A' + i % 26);
+
+  // A small write is buffered, and a large one is sent directly.
+  std::vector<char> received(3 + data.size());
+  asio::thread reader(
+      [&]{ asio::read(server, asio::buffer(received)); });
+  ios << "abc";
+  ios.write(&data[0], static_cast<std::streamsize>(data.size()));
+  ios.flush();
+  reader.join();
+  ASIO_CHECK(!!ios);
+  ASIO_CHECK(memcmp(&received[0], "abc", 3) == 0);
+  ASIO_CHECK(memcmp(&received[3], &data[0], data.size()) == 0);
+
+  // A small read is buffered, and a large one is received directly.
+  asio::thread writer(
+      [&]{ asio::write(server, asio::buffer(received)); });
+  char prefix[3] = "";
+  ios.read(prefix, 3);
+  std::vector<char> read_data(data.size());
+  ios.read(&read_data[0], static_cast<std::streamsize>(read_data.size()));
+  writer.join();
+  ASIO_CHECK(!!ios);
+  ASIO_CHECK(ios.gcount() == static_cast<std::streamsize>(data.size()));
+  ASIO_CHECK(memcmp(prefix, "abc", 3) == 0);
+  ASIO_CHECK(read_data == data);
+
+  // Changing the buffer size retains unread input.
+  asio::write(server, asio::buffer("hello world\n", 12));
+  std::string word;
+  ios >> word;
+  ASIO_CHECK(word == "hello");
+  ios.rdbuf()->buffer_size(2);
+  ASIO_CHECK(ios.rdbuf()->buffer_size() == 2);
+  ios >> word;
+  ASIO_CHECK(word == "world");
+  ios.rdbuf()->buffer_size(4096);
+  ASIO_CHECK(ios.rdbuf()->buffer_size() == 4096);
+  asio::write(server, asio::buffer("again\n", 6));
+  ios >> word;
+  ASIO_CHECK(word == "again");
+
+  // End of file is reported after a partial large read.
+  asio::write(server, asio::buffer(data, 1000));
+  server.close();
+  ios.read(&read_data[0], static_cast<std::streamsize>(read_data.size()));
+  ASIO_CHECK(ios.eof());
+  ASIO_CHECK(ios.gcount() == 1001);
+  ASIO_CHECK(ios.error() == asio::error::eof);
+#endif // !defined(ASIO_NO_IOSTREAM)
+}
+
+} // namespace ip_tcp_iostream_runtime
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "ip/tcp",
@@ -1286,4 +1484,5 @@ ASIO_TEST_SUITE
   ASIO_COMPILE_TEST_CASE(ip_tcp_resolver_entry_compile::test)
   ASIO_COMPILE_TEST_CASE(ip_tcp_resolver_entry_compile::test)
   ASIO_COMPILE_TEST_CASE(ip_tcp_iostream_compile::test)
+  ASIO_TEST_CASE(ip_tcp_iostream_runtime::test)
 )
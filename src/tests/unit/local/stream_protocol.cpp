@@ -17,7 +17,11 @@
 #include "asio/local/stream_protocol.hpp"
 
 #include <cstring>
+#include <memory>
+#include "asio/config.hpp"
 #include "asio/io_context.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/write.hpp"
 #include "../unit_test.hpp"
 
 //------------------------------------------------------------------------------
@@ -212,8 +216,129 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// local_stream_protocol_socket_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the
+// local::stream_protocol::socket class when the reactor limits the number of
+// consecutive speculative completions.
+
+namespace local_stream_protocol_socket_runtime {
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+
+struct read_chain
+{
+  asio::local::stream_protocol::socket* socket_;
+  char* data_;
+  int* count_;
+
+  void operator()(const asio::error_code& err, std::size_t n)
+  {
+    ASIO_CHECK(!err);
+    ASIO_CHECK(n == 1);
+    if (++*count_ < 8)
+      socket_->async_read_some(asio::buffer(data_ + *count_, 1), *this);
+  }
+};
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+void test()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  using namespace asio;
+  namespace local = asio::local;
+  typedef local::stream_protocol sp;
+
+  io_context ioc(config_from_string("reactor.max_speculative_completions=2"));
+  sp::socket s1(ioc);
+  sp::socket s2(ioc);
+  local::connect_pair(s1, s2);
+
+  const char write_data[8] = { 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h' };
+  asio::write(s1, asio::buffer(write_data));
+
+  char read_data[8] = "";
+  int count = 0;
+  read_chain chain = { &s2, read_data, &count };
+  s2.async_read_some(asio::buffer(read_data, 1), chain);
+  ioc.run();
+
+  // Operations that exceed the budget wait for the reactor but still complete.
+  ASIO_CHECK(count == 8);
+  ASIO_CHECK(memcmp(read_data, write_data, sizeof(write_data)) == 0);
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+} // namespace local_stream_protocol_socket_runtime
+
+//------------------------------------------------------------------------------
+
+// local_stream_protocol_socket_async_close test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that sockets destroyed while the asynchronous
+// close option is enabled are closed, and that outstanding operations on
+// both ends of the connection complete.
+
+namespace local_stream_protocol_socket_async_close {
+
+void test()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  using namespace asio;
+  namespace local = asio::local;
+  typedef local::stream_protocol sp;
+
+  io_context ioc(config_from_string("reactor.async_close=1"));
+
+  const int pair_count = 64;
+  std::unique_ptr<sp::socket> s1[pair_count];
+  std::unique_ptr<sp::socket> s2[pair_count];
+  char read_data[pair_count][1];
+  asio::error_code read_ec[pair_count];
+  asio::error_code aborted_ec[pair_count];
+  for (int i = 0; i < pair_count; ++i)
+  {
+    s1[i].reset(new sp::socket(ioc));
+    s2[i].reset(new sp::socket(ioc));
+    local::connect_pair(*s1[i], *s2[i]);
+
+    s1[i]->async_read_some(asio::buffer(read_data[i]),
+        [&aborted_ec, i](const asio::error_code& err, std::size_t)
+        {
+          aborted_ec[i] = err;
+        });
+
+    s2[i]->async_read_some(asio::buffer(read_data[i]),
+        [&read_ec, i](const asio::error_code& err, std::size_t)
+        {
+          read_ec[i] = err;
+        });
+  }
+
+  // Destroying one end aborts its own operation and, once the descriptor has
+  // been closed, the peer sees end-of-file.
+  for (int i = 0; i < pair_count; ++i)
+    s1[i].reset();
+
+  ioc.run();
+
+  for (int i = 0; i < pair_count; ++i)
+  {
+    ASIO_CHECK(aborted_ec[i] == asio::error::operation_aborted);
+    ASIO_CHECK(read_ec[i] == asio::error::eof);
+  }
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+} // namespace local_stream_protocol_socket_async_close
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "local/stream_protocol",
   ASIO_COMPILE_TEST_CASE(local_stream_protocol_socket_compile::test)
+  ASIO_TEST_CASE(local_stream_protocol_socket_runtime::test)
+  ASIO_TEST_CASE(local_stream_protocol_socket_async_close::test)
 )
@@ -0,0 +1,122 @@
+//
+// post_bulk.cpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/post_bulk.hpp"
+
+#include <atomic>
+#include <vector>
+#include "asio/bind_executor.hpp"
+#include "asio/io_context.hpp"
+#include "asio/strand.hpp"
+#include "asio/thread_pool.hpp"
+#include "unit_test.hpp"
+
+using namespace asio;
+
+struct mark_index
+{
+  std::vector<std::atomic<int>>* marks_;
+
+  void operator()(std::size_t i) const
+  {
+    ++(*marks_)[i];
+  }
+};
+
+bool all_marked_once(const std::vector<std::atomic<int>>& marks)
+{
+  for (std::size_t i = 0; i < marks.size(); ++i)
+    if (marks[i] != 1)
+      return false;
+  return true;
+}
+
+void post_bulk_io_context_test()
+{
+  io_context ioc;
+  std::vector<std::atomic<int>> marks(1000);
+  int handler_count = 0;
+
+  post_bulk(ioc.get_executor(), marks.size(),
+      mark_index{&marks}, [&]{ ++handler_count; });
+
+  // No functions can be called until run() is called.
+  ASIO_CHECK(marks[0] == 0);
+  ASIO_CHECK(handler_count == 0);
+
+  ioc.run();
+
+  ASIO_CHECK(all_marked_once(marks));
+  ASIO_CHECK(handler_count == 1);
+
+  handler_count = 0;
+  ioc.restart();
+  post_bulk(ioc, 0, mark_index{&marks}, [&]{ ++handler_count; });
+  ioc.run();
+
+  // An empty range completes immediately.
+  ASIO_CHECK(handler_count == 1);
+  ASIO_CHECK(all_marked_once(marks));
+}
+
+void post_bulk_thread_pool_test()
+{
+  thread_pool pool(4);
+  io_context ioc;
+  std::vector<std::atomic<int>> marks(100000);
+  std::atomic<int> handler_count(0);
+  bool handler_on_ioc = false;
+
+  post_bulk(pool.get_executor(), marks.size(), mark_index{&marks},
+      bind_executor(ioc, [&]
+        {
+          ++handler_count;
+          handler_on_ioc = ioc.get_executor().running_in_this_thread();
+        }));
+
+  // The completion handler holds outstanding work on its associated executor.
+  ioc.run();
+  pool.join();
+
+  ASIO_CHECK(all_marked_once(marks));
+  ASIO_CHECK(handler_count == 1);
+  ASIO_CHECK(handler_on_ioc);
+}
+
+void post_bulk_strand_test()
+{
+  thread_pool pool(4);
+  strand<thread_pool::executor_type> s = make_strand(pool);
+  std::vector<int> values(1000);
+  std::size_t sum = 0;
+
+  // No synchronisation is needed when the bulk task runs on a strand.
+  post_bulk(s, values.size(),
+      [&](std::size_t i){ values[i] = static_cast<int>(i); sum += i; },
+      []{});
+  pool.join();
+
+  ASIO_CHECK(sum == 1000 * 999 / 2);
+  ASIO_CHECK(values[999] == 999);
+}
+
+ASIO_TEST_SUITE
+(
+  "post_bulk",
+  ASIO_TEST_CASE(post_bulk_io_context_test)
+  ASIO_TEST_CASE(post_bulk_thread_pool_test)
+  ASIO_TEST_CASE(post_bulk_strand_test)
+)
@@ -0,0 +1,136 @@
+//
+// certificate_store.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ssl/certificate_store.hpp"
+
+#include <string>
+#include "asio/ssl/context.hpp"
+#include "../unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// ssl_certificate_store_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a certificate store may be populated and then
+// shared between contexts, after which it is immutable.
+
+namespace ssl_certificate_store_runtime {
+
+// Create a self-signed certificate in PEM format.
+std::string make_certificate_pem()
+{
+  EVP_PKEY* pkey = 0;
+  EVP_PKEY_CTX* kctx = ::EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, 0);
+  ::EVP_PKEY_keygen_init(kctx);
+  ::EVP_PKEY_CTX_set_rsa_keygen_bits(kctx, 2048);
+  ::EVP_PKEY_keygen(kctx, &pkey);
+  ::EVP_PKEY_CTX_free(kctx);
+
+  X509* cert = ::X509_new();
+  ::ASN1_INTEGER_set(::X509_get_serialNumber(cert), 1);
+  ::X509_gmtime_adj(X509_get_notBefore(cert), 0);
+  ::X509_gmtime_adj(X509_get_notAfter(cert), 3600);
+  ::X509_set_pubkey(cert, pkey);
+  X509_NAME* name = ::X509_get_subject_name(cert);
+  ::X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+      reinterpret_cast<const unsigned char*>("test CA"), -1, -1, 0);
+  ::X509_set_issuer_name(cert, name);
+  ::X509_sign(cert, pkey, ::EVP_sha256());
+
+  BIO* bio = ::BIO_new(::BIO_s_mem());
+  ::PEM_write_bio_X509(bio, cert);
+  char* data = 0;
+  long length = BIO_get_mem_data(bio, &data);
+  std::string pem(data, length);
+
+  ::BIO_free(bio);
+  ::X509_free(cert);
+  ::EVP_PKEY_free(pkey);
+  return pem;
+}
+
+void test()
+{
+  using namespace asio;
+  namespace ssl = asio::ssl;
+
+  std::string pem = make_certificate_pem();
+
+  ssl::certificate_store store;
+  ASIO_CHECK(store.native_handle() != 0);
+  ASIO_CHECK(store.size() == 0);
+
+  store.add_certificate_authority(buffer(pem));
+  ASIO_CHECK(store.size() == 1);
+
+  asio::error_code ec;
+  store.add_certificate_authority(buffer("not a certificate"), ec);
+  ASIO_CHECK(!!ec);
+  ASIO_CHECK(store.size() == 1);
+
+  // Copies refer to the same underlying store.
+  ssl::certificate_store store2(store);
+  ASIO_CHECK(store2.native_handle() == store.native_handle());
+
+  ssl::certificate_store store3;
+  store3 = store2;
+  ASIO_CHECK(store3.native_handle() == store.native_handle());
+
+  ssl::certificate_store store4(static_cast<ssl::certificate_store&&>(store3));
+  ASIO_CHECK(store4.native_handle() == store.native_handle());
+
+  // Contexts share the store, and keep it alive.
+  ssl::context ctx1(ssl::context::tls_client);
+  ssl::context ctx2(ssl::context::tls_client);
+  {
+    ssl::certificate_store shared;
+    shared.add_certificate_authority(buffer(pem));
+    ctx1.set_certificate_store(shared);
+    ctx2.set_certificate_store(shared, ec);
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(::SSL_CTX_get_cert_store(ctx1.native_handle())
+        == shared.native_handle());
+
+    // An attached store may no longer be modified, either directly or through
+    // a context that uses it.
+    ASIO_CHECK(shared.frozen());
+    shared.add_certificate_authority(buffer(pem), ec);
+    ASIO_CHECK(ec == asio::error::no_permission);
+    shared.set_default_verify_paths(ec);
+    ASIO_CHECK(ec == asio::error::no_permission);
+    ctx2.add_certificate_authority(buffer(pem), ec);
+    ASIO_CHECK(ec == asio::error::no_permission);
+    ctx2.load_verify_file("nonexistent-file.pem", ec);
+    ASIO_CHECK(ec == asio::error::no_permission);
+    ASIO_CHECK(shared.size() == 1);
+  }
+  ASIO_CHECK(!store.frozen());
+  ASIO_CHECK(::SSL_CTX_get_cert_store(ctx1.native_handle())
+      == ::SSL_CTX_get_cert_store(ctx2.native_handle()));
+
+  store.load_verify_file("nonexistent-file.pem", ec);
+  ASIO_CHECK(!!ec);
+}
+
+} // namespace ssl_certificate_store_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "ssl/certificate_store",
+  ASIO_TEST_CASE(ssl_certificate_store_runtime::test)
+)
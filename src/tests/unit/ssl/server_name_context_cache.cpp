@@ -0,0 +1,174 @@
+//
+// server_name_context_cache.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ssl/server_name_context_cache.hpp"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include "asio/io_context.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
+#include "asio/ssl/stream.hpp"
+#include "../unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// ssl_server_name_context_cache_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that server handshakes are switched to the context
+// created for the requested host name, and that the context is created once.
+
+namespace ssl_server_name_context_cache_runtime {
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+
+// Use a self-signed certificate for the context.
+void use_self_signed_certificate(asio::ssl::context& ctx)
+{
+  EVP_PKEY* pkey = 0;
+  EVP_PKEY_CTX* kctx = ::EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, 0);
+  ::EVP_PKEY_keygen_init(kctx);
+  ::EVP_PKEY_CTX_set_rsa_keygen_bits(kctx, 2048);
+  ::EVP_PKEY_keygen(kctx, &pkey);
+  ::EVP_PKEY_CTX_free(kctx);
+
+  X509* cert = ::X509_new();
+  ::ASN1_INTEGER_set(::X509_get_serialNumber(cert), 1);
+  ::X509_gmtime_adj(X509_get_notBefore(cert), 0);
+  ::X509_gmtime_adj(X509_get_notAfter(cert), 3600);
+  ::X509_set_pubkey(cert, pkey);
+  X509_NAME* name = ::X509_get_subject_name(cert);
+  ::X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+      reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+  ::X509_set_issuer_name(cert, name);
+  ::X509_sign(cert, pkey, ::EVP_sha256());
+
+  ::SSL_CTX_use_certificate(ctx.native_handle(), cert);
+  ::SSL_CTX_use_PrivateKey(ctx.native_handle(), pkey);
+  ::X509_free(cert);
+  ::EVP_PKEY_free(pkey);
+}
+
+struct context_factory
+{
+  asio::ssl::context* server_ctx;
+  int* calls;
+
+  std::shared_ptr<asio::ssl::context> operator()(const std::string& host)
+  {
+    ++*calls;
+    std::shared_ptr<asio::ssl::context> ctx;
+    if (host == "known.example")
+    {
+      ctx = std::make_shared<asio::ssl::context>(
+          asio::ssl::context::tls_server);
+      ::SSL_CTX_use_certificate(ctx->native_handle(),
+          ::SSL_CTX_get0_certificate(server_ctx->native_handle()));
+      ::SSL_CTX_use_PrivateKey(ctx->native_handle(),
+          ::SSL_CTX_get0_privatekey(server_ctx->native_handle()));
+    }
+    return ctx;
+  }
+};
+
+void handshake_error_handler(asio::error_code* out, asio::error_code ec)
+{
+  *out = ec;
+}
+
+// Perform a handshake requesting the given host name, and return the context
+// used by the server.
+SSL_CTX* handshake(asio::ssl::context& server_ctx,
+    asio::ssl::context& client_ctx, const char* host)
+{
+  typedef asio::ssl::stream<asio::local::stream_protocol::socket> stream_type;
+
+  asio::io_context ioc;
+  stream_type server(ioc, server_ctx);
+  stream_type client(ioc, client_ctx);
+  asio::local::connect_pair(server.next_layer(), client.next_layer());
+
+  ::SSL_set_tlsext_host_name(client.native_handle(), host);
+
+  asio::error_code server_ec = asio::error::would_block;
+  asio::error_code client_ec = asio::error::would_block;
+  server.async_handshake(asio::ssl::stream_base::server,
+      std::bind(handshake_error_handler, &server_ec, std::placeholders::_1));
+  client.async_handshake(asio::ssl::stream_base::client,
+      std::bind(handshake_error_handler, &client_ec, std::placeholders::_1));
+  ioc.run();
+
+  ASIO_CHECK(!server_ec);
+  ASIO_CHECK(!client_ec);
+
+  return ::SSL_get_SSL_CTX(server.native_handle());
+}
+
+void test()
+{
+  using namespace asio;
+  namespace ssl = asio::ssl;
+
+  ssl::context server_ctx(ssl::context::tls_server);
+  use_self_signed_certificate(server_ctx);
+  ssl::context client_ctx(ssl::context::tls_client);
+  client_ctx.set_verify_mode(ssl::verify_none);
+
+  int calls = 0;
+  context_factory factory = { &server_ctx, &calls };
+  ssl::server_name_context_cache cache(server_ctx, factory);
+  ASIO_CHECK(cache.size() == 0);
+
+  SSL_CTX* used = handshake(server_ctx, client_ctx, "known.example");
+  ASIO_CHECK(calls == 1);
+  ASIO_CHECK(cache.size() == 1);
+  std::shared_ptr<ssl::context> known = cache.get("known.example");
+  ASIO_CHECK(known != 0);
+  ASIO_CHECK(used == known->native_handle());
+  ASIO_CHECK(calls == 1);
+
+  used = handshake(server_ctx, client_ctx, "known.example");
+  ASIO_CHECK(calls == 1);
+  ASIO_CHECK(used == known->native_handle());
+
+  used = handshake(server_ctx, client_ctx, "unknown.example");
+  ASIO_CHECK(calls == 2);
+  ASIO_CHECK(cache.size() == 1);
+  ASIO_CHECK(used == server_ctx.native_handle());
+
+  used = handshake(server_ctx, client_ctx, "unknown.example");
+  ASIO_CHECK(calls == 3);
+  ASIO_CHECK(cache.size() == 1);
+}
+
+#else // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+void test()
+{
+}
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+} // namespace ssl_server_name_context_cache_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "ssl/server_name_context_cache",
+  ASIO_TEST_CASE(ssl_server_name_context_cache_runtime::test)
+)
@@ -16,6 +16,8 @@
 // Test that header file is self-contained.
 #include "asio/ssl/stream.hpp"
 
+#include <cstring>
+#include <functional>
 #include "asio.hpp"
 #include "asio/ssl.hpp"
 #include "../archetypes/async_result.hpp"
@@ -136,6 +138,14 @@ void test()
     int i2 = stream1.async_handshake(ssl::stream_base::server, lazy);
     (void)i2;
 
+    stream1.async_handshake(ssl::stream_base::client,
+        ioc.get_executor(), handshake_handler);
+    stream1.async_handshake(ssl::stream_base::server,
+        ioc.get_executor(), handshake_handler);
+    int i11 = stream1.async_handshake(ssl::stream_base::client,
+        ioc.get_executor(), lazy);
+    (void)i11;
+
     stream1.async_handshake(ssl::stream_base::client,
         buffer(mutable_char_buffer), buffered_handshake_handler);
     stream1.async_handshake(ssl::stream_base::server,
@@ -192,8 +202,130 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// ssl_stream_engine_executor_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a handshake performed with an engine
+// executor runs its engine steps on that executor, and completes on the
+// stream's executor.
+
+namespace ssl_stream_engine_executor_runtime {
+
+// Create a self-signed certificate.
+X509* make_certificate(EVP_PKEY** pkey)
+{
+  EVP_PKEY_CTX* kctx = ::EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, 0);
+  ::EVP_PKEY_keygen_init(kctx);
+  ::EVP_PKEY_CTX_set_rsa_keygen_bits(kctx, 2048);
+  ::EVP_PKEY_keygen(kctx, pkey);
+  ::EVP_PKEY_CTX_free(kctx);
+
+  X509* cert = ::X509_new();
+  ::ASN1_INTEGER_set(::X509_get_serialNumber(cert), 1);
+  ::X509_gmtime_adj(X509_get_notBefore(cert), 0);
+  ::X509_gmtime_adj(X509_get_notAfter(cert), 3600);
+  ::X509_set_pubkey(cert, *pkey);
+  X509_NAME* name = ::X509_get_subject_name(cert);
+  ::X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+      reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+  ::X509_set_issuer_name(cert, name);
+  ::X509_sign(cert, *pkey, ::EVP_sha256());
+  return cert;
+}
+
+// The executor on which engine steps are expected to run.
+asio::thread_pool::executor_type* engine_executor = 0;
+int engine_steps = 0;
+int misplaced_engine_steps = 0;
+
+void info_callback(const SSL*, int where, int)
+{
+  // The callback is invoked from within SSL_do_handshake, and so from within
+  // an engine step.
+  if ((where & SSL_CB_LOOP) != 0)
+  {
+    ++engine_steps;
+    if (!engine_executor->running_in_this_thread())
+      ++misplaced_engine_steps;
+  }
+}
+
+void handshake_handler(asio::io_context* ioc,
+    asio::error_code* out, bool* on_io_executor, asio::error_code ec)
+{
+  *out = ec;
+  *on_io_executor = ioc->get_executor().running_in_this_thread();
+}
+
+void test()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  using namespace asio;
+  namespace ssl = asio::ssl;
+  typedef ssl::stream<local::stream_protocol::socket> stream_type;
+
+  EVP_PKEY* pkey = 0;
+  X509* cert = make_certificate(&pkey);
+
+  ssl::context server_ctx(ssl::context::tls_server);
+  ::SSL_CTX_use_certificate(server_ctx.native_handle(), cert);
+  ::SSL_CTX_use_PrivateKey(server_ctx.native_handle(), pkey);
+  ::SSL_CTX_set_info_callback(server_ctx.native_handle(), info_callback);
+
+  ssl::context client_ctx(ssl::context::tls_client);
+  ::SSL_CTX_set_info_callback(client_ctx.native_handle(), info_callback);
+
+  thread_pool pool(1);
+  thread_pool::executor_type pool_ex = pool.get_executor();
+  engine_executor = &pool_ex;
+
+  io_context ioc;
+  stream_type server(ioc, server_ctx);
+  stream_type client(ioc, client_ctx);
+  local::connect_pair(server.next_layer(), client.next_layer());
+
+  asio::error_code server_ec = asio::error::would_block;
+  asio::error_code client_ec = asio::error::would_block;
+  bool server_on_io_executor = false;
+  bool client_on_io_executor = false;
+  server.async_handshake(ssl::stream_base::server, pool_ex,
+      std::bind(handshake_handler, &ioc, &server_ec,
+        &server_on_io_executor, std::placeholders::_1));
+  client.async_handshake(ssl::stream_base::client, pool_ex,
+      std::bind(handshake_handler, &ioc, &client_ec,
+        &client_on_io_executor, std::placeholders::_1));
+
+  // While an engine step runs on the pool, the io_context has nothing else to
+  // do. The run() call must nonetheless wait for both handshakes to finish.
+  ioc.run();
+
+  ASIO_CHECK(!server_ec);
+  ASIO_CHECK(!client_ec);
+  ASIO_CHECK(server_on_io_executor);
+  ASIO_CHECK(client_on_io_executor);
+  ASIO_CHECK(engine_steps > 0);
+  ASIO_CHECK(misplaced_engine_steps == 0);
+
+  // The streams remain usable on the io_context after the handshake.
+  const char request[] = "ping";
+  char reply[sizeof(request)] = "";
+  asio::write(client, asio::buffer(request));
+  asio::read(server, asio::buffer(reply));
+  ASIO_CHECK(memcmp(request, reply, sizeof(request)) == 0);
+
+  engine_executor = 0;
+  pool.join();
+  ::X509_free(cert);
+  ::EVP_PKEY_free(pkey);
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+} // namespace ssl_stream_engine_executor_runtime
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "ssl/stream",
   ASIO_COMPILE_TEST_CASE(ssl_stream_compile::test)
+  ASIO_TEST_CASE(ssl_stream_engine_executor_runtime::test)
 )
@@ -0,0 +1,190 @@
+//
+// verification_cache.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ssl/verification_cache.hpp"
+
+#include <functional>
+#include <string>
+#include "asio/io_context.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
+#include "asio/ssl/context.hpp"
+#include "asio/ssl/host_name_verification.hpp"
+#include "asio/ssl/stream.hpp"
+#include "../unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// ssl_verification_cache_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a certificate verified for a host name is
+// accepted on later handshakes without verifying its chain.
+
+namespace ssl_verification_cache_runtime {
+
+// Create a self-signed certificate for the host name "localhost".
+X509* make_certificate(EVP_PKEY** pkey)
+{
+  EVP_PKEY_CTX* kctx = ::EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, 0);
+  ::EVP_PKEY_keygen_init(kctx);
+  ::EVP_PKEY_CTX_set_rsa_keygen_bits(kctx, 2048);
+  ::EVP_PKEY_keygen(kctx, pkey);
+  ::EVP_PKEY_CTX_free(kctx);
+
+  X509* cert = ::X509_new();
+  ::ASN1_INTEGER_set(::X509_get_serialNumber(cert), 1);
+  ::X509_gmtime_adj(X509_get_notBefore(cert), 0);
+  ::X509_gmtime_adj(X509_get_notAfter(cert), 3600);
+  ::X509_set_pubkey(cert, *pkey);
+  X509_NAME* name = ::X509_get_subject_name(cert);
+  ::X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+      reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+  ::X509_set_issuer_name(cert, name);
+  ::X509_sign(cert, *pkey, ::EVP_sha256());
+  return cert;
+}
+
+void handshake_error_handler(asio::error_code* out, asio::error_code ec)
+{
+  *out = ec;
+}
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+
+// Perform a handshake, and return whether the client accepted the server.
+template <typename VerifyCallback>
+bool handshake(asio::ssl::context& server_ctx,
+    asio::ssl::context& client_ctx, VerifyCallback callback)
+{
+  typedef asio::ssl::stream<asio::local::stream_protocol::socket> stream_type;
+
+  asio::io_context ioc;
+  stream_type server(ioc, server_ctx);
+  stream_type client(ioc, client_ctx);
+  asio::local::connect_pair(server.next_layer(), client.next_layer());
+
+  client.set_verify_mode(asio::ssl::verify_peer);
+  client.set_verify_callback(callback);
+
+  asio::error_code server_ec = asio::error::would_block;
+  asio::error_code client_ec = asio::error::would_block;
+  server.async_handshake(asio::ssl::stream_base::server,
+      std::bind(handshake_error_handler, &server_ec, std::placeholders::_1));
+  client.async_handshake(asio::ssl::stream_base::client,
+      std::bind(handshake_error_handler, &client_ec, std::placeholders::_1));
+  ioc.run();
+
+  return !client_ec;
+}
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+void test()
+{
+  using namespace asio;
+  namespace ssl = asio::ssl;
+
+  EVP_PKEY* pkey = 0;
+  X509* cert = make_certificate(&pkey);
+
+  // The cache holds a bounded number of entries.
+  ssl::verification_cache small_cache(1);
+  ASIO_CHECK(!small_cache.contains(cert, "localhost"));
+  small_cache.insert(cert, "localhost");
+  ASIO_CHECK(small_cache.contains(cert, "localhost"));
+  ASIO_CHECK(!small_cache.contains(cert, "otherhost"));
+  small_cache.insert(cert, "otherhost");
+  ASIO_CHECK(small_cache.size() == 1);
+  ASIO_CHECK(small_cache.contains(cert, "otherhost"));
+  ASIO_CHECK(!small_cache.contains(cert, "localhost"));
+  small_cache.clear();
+  ASIO_CHECK(small_cache.size() == 0);
+
+  // Entries expire after the maximum age.
+  ssl::verification_cache expired_cache(16, std::chrono::seconds(0));
+  expired_cache.insert(cert, "localhost");
+  ASIO_CHECK(!expired_cache.contains(cert, "localhost"));
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  ssl::context server_ctx(ssl::context::tls_server);
+  ::SSL_CTX_use_certificate(server_ctx.native_handle(), cert);
+  ::SSL_CTX_use_PrivateKey(server_ctx.native_handle(), pkey);
+
+  ssl::context trusting_ctx(ssl::context::tls_client);
+  ::X509_STORE_add_cert(
+      ::SSL_CTX_get_cert_store(trusting_ctx.native_handle()), cert);
+
+  ssl::context untrusting_ctx(ssl::context::tls_client);
+
+  // The first handshake verifies the chain and populates the cache.
+  ssl::verification_cache cache;
+  ASIO_CHECK(handshake(server_ctx, trusting_ctx,
+        ssl::host_name_verification("localhost", cache)));
+  ASIO_CHECK(cache.size() == 1);
+
+  // Without the cache, the chain cannot be verified by the client that does
+  // not trust the certificate.
+  ASIO_CHECK(!handshake(server_ctx, untrusting_ctx,
+        ssl::host_name_verification("localhost")));
+
+  // With the cache, verification of the chain is skipped.
+  ASIO_CHECK(handshake(server_ctx, untrusting_ctx,
+        ssl::host_name_verification("localhost", cache)));
+
+  // The cached result applies only to the host name that was verified.
+  ASIO_CHECK(!handshake(server_ctx, trusting_ctx,
+        ssl::host_name_verification("otherhost", cache)));
+  ASIO_CHECK(!handshake(server_ctx, untrusting_ctx,
+        ssl::host_name_verification("otherhost", cache)));
+  ASIO_CHECK(cache.size() == 1);
+
+  // A context-wide verify callback also uses the cache.
+  untrusting_ctx.set_verify_mode(ssl::verify_peer);
+  untrusting_ctx.set_verify_callback(
+      ssl::host_name_verification("localhost", cache));
+  {
+    typedef ssl::stream<local::stream_protocol::socket> stream_type;
+
+    io_context ioc;
+    stream_type server(ioc, server_ctx);
+    stream_type client(ioc, untrusting_ctx);
+    local::connect_pair(server.next_layer(), client.next_layer());
+
+    asio::error_code server_ec = asio::error::would_block;
+    asio::error_code client_ec = asio::error::would_block;
+    server.async_handshake(ssl::stream_base::server,
+        std::bind(handshake_error_handler, &server_ec, std::placeholders::_1));
+    client.async_handshake(ssl::stream_base::client,
+        std::bind(handshake_error_handler, &client_ec, std::placeholders::_1));
+    ioc.run();
+
+    ASIO_CHECK(!client_ec);
+  }
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+  ::X509_free(cert);
+  ::EVP_PKEY_free(pkey);
+}
+
+} // namespace ssl_verification_cache_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "ssl/verification_cache",
+  ASIO_TEST_CASE(ssl_verification_cache_runtime::test)
+)
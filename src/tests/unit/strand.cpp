@@ -18,6 +18,8 @@
 
 #include <functional>
 #include <sstream>
+#include <vector>
+#include "asio/config.hpp"
 #include "asio/executor.hpp"
 #include "asio/io_context.hpp"
 #include "asio/dispatch.hpp"
@@ -430,6 +432,51 @@ void strand_execute_test()
   ASIO_CHECK(count == 1);
 }
 
+void record(std::vector<int>* order, int value)
+{
+  order->push_back(value);
+}
+
+void record_and_post_marker(io_context* ioc, std::vector<int>* order)
+{
+  order->push_back(0);
+  post(*ioc, bindns::bind(record, order, -1));
+}
+
+void post_batch(io_context* ioc,
+    strand<io_context::executor_type>* s, std::vector<int>* order)
+{
+  post(*s, bindns::bind(record_and_post_marker, ioc, order));
+  for (int i = 1; i < 6; ++i)
+    post(*s, bindns::bind(record, order, i));
+}
+
+void strand_handler_budget_test()
+{
+  io_context ioc1;
+  strand<io_context::executor_type> s1 = make_strand(ioc1);
+  std::vector<int> order1;
+  post(s1, bindns::bind(post_batch, &ioc1, &s1, &order1));
+  ioc1.run();
+
+  // With no limit, the strand runs all of its ready handlers in one turn.
+  ASIO_CHECK(order1.size() == 7);
+  ASIO_CHECK(order1[6] == -1);
+
+  io_context ioc2(config_from_string("strand.max_handlers_per_turn=2"));
+  strand<io_context::executor_type> s2 = make_strand(ioc2);
+  std::vector<int> order2;
+  post(s2, bindns::bind(post_batch, &ioc2, &s2, &order2));
+  ioc2.run();
+
+  // The strand yields after two handlers, allowing the other work to run.
+  ASIO_CHECK(order2.size() == 7);
+  ASIO_CHECK(order2[2] == -1);
+  for (int i = 0, j = 0; i < 7; ++i)
+    if (order2[i] != -1)
+      ASIO_CHECK(order2[i] == j++);
+}
+
 ASIO_TEST_SUITE
 (
   "strand",
@@ -437,4 +484,5 @@ ASIO_TEST_SUITE
   ASIO_COMPILE_TEST_CASE(strand_conversion_test)
   ASIO_TEST_CASE(strand_query_test)
   ASIO_TEST_CASE(strand_execute_test)
+  ASIO_TEST_CASE(strand_handler_budget_test)
 )
@@ -24,6 +24,7 @@
 #include <functional>
 #include "asio/bind_cancellation_slot.hpp"
 #include "asio/cancellation_signal.hpp"
+#include "asio/config.hpp"
 #include "asio/executor_work_guard.hpp"
 #include "asio/io_context.hpp"
 #include "asio/thread.hpp"
@@ -488,6 +489,51 @@ void system_timer_op_cancel_test()
   ASIO_CHECK(ioc.stopped());
 }
 
+struct record_expiry_lateness
+{
+  asio::system_timer* timer;
+  asio::system_timer::duration* lateness;
+
+  void operator()(asio::error_code)
+  {
+    *lateness = asio::system_timer::clock_type::now() - timer->expiry();
+  }
+};
+
+void system_timer_spin_test_with_config(const char* config)
+{
+  asio::io_context ioc(asio::config_from_string{config});
+
+  // Timers must not complete before their expiry time, whether or not they
+  // expire within the interval for which the reactor busy-waits.
+  for (int i = 0; i < 10; ++i)
+  {
+    asio::system_timer t1(ioc, asio::chrono::microseconds(100 * i));
+    asio::system_timer t2(ioc, asio::chrono::milliseconds(3 + i));
+    asio::system_timer::duration lateness1(-1);
+    asio::system_timer::duration lateness2(-1);
+    record_expiry_lateness handler1 = { &t1, &lateness1 };
+    record_expiry_lateness handler2 = { &t2, &lateness2 };
+    t1.async_wait(handler1);
+    t2.async_wait(handler2);
+
+    ioc.restart();
+    ioc.run();
+
+    ASIO_CHECK(lateness1 >= asio::system_timer::duration::zero());
+    ASIO_CHECK(lateness2 >= asio::system_timer::duration::zero());
+  }
+}
+
+void system_timer_spin_test()
+{
+  system_timer_spin_test_with_config("reactor.timer_spin_usec=1000");
+  system_timer_spin_test_with_config(
+      "reactor.timer_spin_usec=1000\nreactor.timer_spin_calibrate=0");
+  system_timer_spin_test_with_config(
+      "reactor.timer_spin_usec=2000\nreactor.use_timerfd=0");
+}
+
 ASIO_TEST_SUITE
 (
   "system_timer",
@@ -497,4 +543,5 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(system_timer_thread_test)
   ASIO_TEST_CASE(system_timer_move_test)
   ASIO_TEST_CASE(system_timer_op_cancel_test)
+  ASIO_TEST_CASE(system_timer_spin_test)
 )
@@ -0,0 +1,61 @@
+//
+// trace_context.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/trace_context.hpp"
+
+#include "unit_test.hpp"
+
+void trace_context_value_test()
+{
+  asio::trace_context tc1;
+  ASIO_CHECK(!tc1);
+  ASIO_CHECK(tc1.trace_id() == 0);
+  ASIO_CHECK(tc1.span_id() == 0);
+
+  asio::trace_context tc2(1, 2);
+  ASIO_CHECK(!!tc2);
+  ASIO_CHECK(tc2.trace_id() == 1);
+  ASIO_CHECK(tc2.span_id() == 2);
+  ASIO_CHECK(tc1 != tc2);
+  ASIO_CHECK(tc2 == asio::trace_context(1, 2));
+  ASIO_CHECK(tc2 != asio::trace_context(1, 3));
+}
+
+void trace_context_current_test()
+{
+  ASIO_CHECK(!asio::trace_context::current());
+
+  {
+    asio::detail::trace_context_scope scope1(asio::trace_context(1, 2));
+    ASIO_CHECK(asio::trace_context::current() == asio::trace_context(1, 2));
+
+    {
+      asio::detail::trace_context_scope scope2(asio::trace_context(3, 4));
+      ASIO_CHECK(asio::trace_context::current() == asio::trace_context(3, 4));
+    }
+
+    ASIO_CHECK(asio::trace_context::current() == asio::trace_context(1, 2));
+  }
+
+  ASIO_CHECK(!asio::trace_context::current());
+}
+
+ASIO_TEST_SUITE
+(
+  "trace_context",
+  ASIO_TEST_CASE(trace_context_value_test)
+  ASIO_TEST_CASE(trace_context_current_test)
+)
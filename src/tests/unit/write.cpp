@@ -21,8 +21,12 @@
 #include <functional>
 #include <vector>
 #include "archetypes/async_result.hpp"
+#include "asio/bind_allocator.hpp"
 #include "asio/io_context.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
 #include "asio/post.hpp"
+#include "asio/read.hpp"
 #include "asio/streambuf.hpp"
 #include "unit_test.hpp"
 
@@ -4941,6 +4945,118 @@ void test_4_arg_streambuf_async_write()
 #endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
 }
 
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+
+template <typename T>
+class counting_allocator
+{
+public:
+  typedef T value_type;
+
+  counting_allocator(int* allocations, int* deallocations)
+    : allocations_(allocations),
+      deallocations_(deallocations)
+  {
+  }
+
+  template <typename U>
+  counting_allocator(const counting_allocator<U>& other)
+    : allocations_(other.allocations_),
+      deallocations_(other.deallocations_)
+  {
+  }
+
+  bool operator==(const counting_allocator& other) const
+  {
+    return allocations_ == other.allocations_;
+  }
+
+  bool operator!=(const counting_allocator& other) const
+  {
+    return allocations_ != other.allocations_;
+  }
+
+  T* allocate(std::size_t n)
+  {
+    ++*allocations_;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n)
+  {
+    ++*deallocations_;
+    std::allocator<T>().deallocate(p, n);
+  }
+
+private:
+  template <typename> friend class counting_allocator;
+
+  int* allocations_;
+  int* deallocations_;
+};
+
+struct one_byte_at_a_time
+{
+  std::size_t total_;
+
+  explicit one_byte_at_a_time(std::size_t total)
+    : total_(total)
+  {
+  }
+
+  std::size_t operator()(const asio::error_code& ec, std::size_t n) const
+  {
+    return ec || n == total_ ? 0 : 1;
+  }
+};
+
+void async_transfer_handler(const asio::error_code& e,
+    size_t bytes_transferred, asio::error_code* out_error,
+    size_t* out_bytes_transferred)
+{
+  *out_error = e;
+  *out_bytes_transferred = bytes_transferred;
+}
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+void test_async_write_reuses_op_storage()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  namespace bindns = std;
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  asio::io_context ioc;
+  asio::local::stream_protocol::socket s1(ioc);
+  asio::local::stream_protocol::socket s2(ioc);
+  asio::local::connect_pair(s1, s2);
+
+  const char data[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  char received[sizeof(data)] = "";
+  asio::error_code error;
+  std::size_t bytes_transferred = 0;
+  int allocations = 0;
+  int deallocations = 0;
+  asio::async_write(s1, asio::buffer(data), one_byte_at_a_time(sizeof(data)),
+      asio::bind_allocator(
+        counting_allocator<void>(&allocations, &deallocations),
+        bindns::bind(async_transfer_handler,
+          _1, _2, &error, &bytes_transferred)));
+  ioc.run();
+
+  ASIO_CHECK(!error);
+  ASIO_CHECK(bytes_transferred == sizeof(data));
+  asio::read(s2, asio::buffer(received));
+  ASIO_CHECK(memcmp(received, data, sizeof(data)) == 0);
+
+  // Each of the single byte transfers reuses the memory of the previous one,
+  // and the memory is returned to the allocator before the handler is called.
+  ASIO_CHECK(allocations == 1);
+  ASIO_CHECK(deallocations == 1);
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
 ASIO_TEST_SUITE
 (
   "write",
@@ -4976,4 +5092,5 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(test_4_arg_vector_buffers_async_write)
   ASIO_TEST_CASE(test_4_arg_dynamic_string_async_write)
   ASIO_TEST_CASE(test_4_arg_streambuf_async_write)
+  ASIO_TEST_CASE(test_async_write_reuses_op_storage)
 )